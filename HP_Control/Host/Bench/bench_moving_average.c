@@ -0,0 +1,70 @@
+/*!
+ * @file bench_moving_average.c
+ *
+ * @brief 滑动平均PC端基准：增量累加和(PlatformFilter_MovingAverageUpdate)与逐窗口重算
+ *        (PlatformFilter_MovingAverage)的单次更新耗时随窗口大小的变化
+ *
+ * PC端耗时只反映相对趋势（与窗口无关/线性增长），目标板绝对耗时用perf_bench测量
+ */
+
+#include "host_bench.h"
+#include "common_types.h"
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define BENCH_MA_UPDATES        2000000U
+
+/* ==========================================  Variables  =========================================== */
+
+static float g_bench_input[1024];
+static volatile float g_bench_sink;
+
+/* ==========================================  Functions  =========================================== */
+
+static double Bench_Incremental(uint8_t window)
+{
+    platform_moving_average_t ma;
+    float acc = 0.0f;
+
+    PlatformFilter_MovingAverageInit(&ma, window);
+    uint64_t t0 = HostBench_NowNs();
+    for (uint32_t n = 0U; n < BENCH_MA_UPDATES; n++) {
+        acc += PlatformFilter_MovingAverageUpdate(&ma, g_bench_input[n & 1023U]);
+    }
+    uint64_t t1 = HostBench_NowNs();
+    g_bench_sink = acc;
+    return (double)(t1 - t0) / BENCH_MA_UPDATES;
+}
+
+static double Bench_FullWindow(uint8_t window)
+{
+    float buffer[PLATFORM_MA_MAX_WINDOW];
+    uint8_t index = 0U;
+    float acc = 0.0f;
+
+    memset(buffer, 0, sizeof(buffer));
+    uint64_t t0 = HostBench_NowNs();
+    for (uint32_t n = 0U; n < BENCH_MA_UPDATES; n++) {
+        acc += PlatformFilter_MovingAverage(buffer, &index, window, g_bench_input[n & 1023U]);
+    }
+    uint64_t t1 = HostBench_NowNs();
+    g_bench_sink = acc;
+    return (double)(t1 - t0) / BENCH_MA_UPDATES;
+}
+
+int main(void)
+{
+    for (uint32_t i = 0U; i < 1024U; i++) {
+        g_bench_input[i] = 10.0f + (float)((i * 2654435761U) >> 24) * (1.0f / 256.0f);
+    }
+
+    printf("moving average, ns/update (%u updates)\n", (unsigned)BENCH_MA_UPDATES);
+    printf("  window  incremental  full-window\n");
+    for (uint32_t window = 4U; window <= PLATFORM_MA_MAX_WINDOW; window *= 2U) {
+        double inc = Bench_Incremental((uint8_t)window);
+        double full = Bench_FullWindow((uint8_t)window);
+        printf("  %6u  %11.2f  %11.2f\n", (unsigned)window, inc, full);
+    }
+    return 0;
+}
@@ -0,0 +1,46 @@
+/*!
+ * @file bench_perf.c
+ *
+ * @brief 热点函数基准(perf_bench)的PC端运行程序：按目标板流程启动后、调度前运行PerfBench_Run
+ *
+ * 说明：
+ * - 与HP_PERF_BENCH=1固件相同：SystemStartup完成任务注册，随后测量（PC端单位为纳秒）
+ * - 启动过程的App层打印丢弃，标准输出只保留"PERF ..."结果行，便于与基线diff（make perf）
+ */
+
+#include "host_bench.h"
+#include "host_fake.h"
+#include "host_app.h"
+#include "perf_bench.h"
+#include <fcntl.h>
+#include <unistd.h>
+
+/* ==========================================  Functions  =========================================== */
+
+int main(void)
+{
+    HostFake_Reset();
+    HostFlash_EraseAll();
+
+    // 启动打印重定向到/dev/null
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (saved >= 0 && null_fd >= 0) {
+        dup2(null_fd, STDOUT_FILENO);
+    }
+    SystemStartup();
+    fflush(stdout);
+    if (saved >= 0 && null_fd >= 0) {
+        dup2(saved, STDOUT_FILENO);
+    }
+    if (null_fd >= 0) {
+        close(null_fd);
+    }
+    if (saved >= 0) {
+        close(saved);
+    }
+
+    PerfBench_Run();
+    return 0;
+}
@@ -0,0 +1,22 @@
+/*!
+ * @file host_bench.h
+ * @brief PC端基准计时（单调时钟，纳秒）
+ *
+ * 基准程序结果输出到标准输出；App层printf同样输出到标准输出，需要时由基准程序自行区分
+ */
+
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static inline uint64_t HostBench_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#endif /* HOST_BENCH_H */
@@ -0,0 +1,76 @@
+/*!
+ * @file core_cm4.h
+ * @brief PC端构建用的Cortex-M4内核头替身
+ *
+ * 说明：
+ * - 只提供App层与驱动头文件用到的内核接口，由ac7840x.h按原路径包含
+ * - NVIC使能/挂起状态由fake_nvic.c维护：中断被屏蔽期间到来的事件挂起，重新使能时立即执行
+ * - 屏障与NOP为空操作；PC端为单线程，中断只在虚拟时钟推进或重新使能时派发
+ * - 不提供SysTick/DWT/SCB等寄存器；直接访问内核寄存器的代码不能在PC端编译
+ */
+
+#ifndef CORE_CM4_H
+#define CORE_CM4_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+
+/* ============================================  Define  ============================================ */
+
+#define __CORTEX_M                        (4U)
+
+#define __I                               volatile const
+#define __O                               volatile
+#define __IO                              volatile
+#define __IM                              volatile const
+#define __OM                              volatile
+#define __IOM                             volatile
+
+#define __ASM                             __asm__
+#define __INLINE                          inline
+#define __STATIC_INLINE                   static inline
+#define __STATIC_FORCEINLINE              static inline
+#define __WEAK                            __attribute__((weak))
+#define __PACKED                          __attribute__((packed))
+#define __ALIGNED(x)                      __attribute__((aligned(x)))
+
+#define __NOP()                           do { } while (0)
+#define __WFI()                           do { } while (0)
+#define __DSB()                           __sync_synchronize()
+#define __DMB()                           __sync_synchronize()
+#define __ISB()                           __sync_synchronize()
+
+/* ==========================================  Functions  =========================================== */
+
+void HostNvic_EnableIRQ(IRQn_Type irq);
+void HostNvic_DisableIRQ(IRQn_Type irq);
+void HostNvic_ClearPendingIRQ(IRQn_Type irq);
+void HostNvic_SetPendingIRQ(IRQn_Type irq);
+uint32_t HostNvic_GetEnableIRQ(IRQn_Type irq);
+void HostNvic_SetPriority(IRQn_Type irq, uint32_t priority);
+uint32_t HostNvic_GetPrimask(void);
+void HostNvic_SetPrimask(uint32_t primask);
+void HostNvic_SystemReset(void);
+
+static inline void NVIC_EnableIRQ(IRQn_Type irq) { HostNvic_EnableIRQ(irq); }
+static inline void NVIC_DisableIRQ(IRQn_Type irq) { HostNvic_DisableIRQ(irq); }
+static inline void NVIC_ClearPendingIRQ(IRQn_Type irq) { HostNvic_ClearPendingIRQ(irq); }
+static inline void NVIC_SetPendingIRQ(IRQn_Type irq) { HostNvic_SetPendingIRQ(irq); }
+static inline uint32_t NVIC_GetEnableIRQ(IRQn_Type irq) { return HostNvic_GetEnableIRQ(irq); }
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { HostNvic_SetPriority(irq, priority); }
+static inline void NVIC_SystemReset(void) { HostNvic_SystemReset(); }
+
+static inline uint32_t __get_PRIMASK(void) { return HostNvic_GetPrimask(); }
+static inline void __set_PRIMASK(uint32_t primask) { HostNvic_SetPrimask(primask); }
+static inline void __disable_irq(void) { HostNvic_SetPrimask(1U); }
+static inline void __enable_irq(void) { HostNvic_SetPrimask(0U); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CORE_CM4_H */
@@ -0,0 +1,43 @@
+/*!
+ * @file host_app.h
+ * @brief PC端构建访问main.c入口的声明（main.c无头文件，这里与其定义保持一致）
+ *
+ * 说明：
+ * - PC端构建中main.c的main()更名为HP_FirmwareMain（Makefile中-Dmain=HP_FirmwareMain），不被调用
+ * - 仿真先调用SystemStartup完成与目标板相同的初始化与任务注册，
+ *   再由HostApp_RunMs按虚拟时钟驱动任务分发（替代永不返回的OptimizedTaskScheduler_MainLoop）
+ */
+
+#ifndef HOST_APP_H
+#define HOST_APP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ==========================================  Variables  =========================================== */
+
+extern bool g_systemEnabled;
+
+/* ==========================================  Functions  =========================================== */
+
+/* main.c */
+void SystemStartup(void);
+void Task_10ms_SendSensorData(void);
+void Task_50ms_SafetyCheck(void);
+void CAN_RxCallback(uint32_t msg_id, const uint8_t* data, uint8_t length);
+
+/*!
+ * @brief 按虚拟时钟运行任务调度ms毫秒：有任务到期则分发，否则推进1ms（期间派发定时器/PWM中断）
+ */
+void HostApp_RunMs(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_APP_H */
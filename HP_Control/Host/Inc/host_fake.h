@@ -0,0 +1,150 @@
+/*!
+ * @file host_fake.h
+ * @brief PC端外设替身控制接口 - 虚拟时钟、NVIC、GPIO、PWM、ADC、CAN、Flash、ACMP
+ *
+ * 功能模块：
+ * - 替身实现App层用到的GPIO_DRV/PWM_DRV/ADC_DRV/CAN_DRV/CKGEN/TIMER_DRV/FLASH_DRV/ACMP_DRV/OSIF接口，
+ *   App源码与驱动头文件不做修改即可在Linux上编译运行
+ * - 虚拟时钟以纳秒计，只在HostClock_Advance*或OSIF_TimeDelay中推进；推进期间按时间顺序派发
+ *   定时器通道中断与PWM溢出中断（NVIC屏蔽时挂起，重新使能后立即执行）
+ * - 本文件中的HostXxx_接口只供测试与仿真驱动使用，App层不得调用
+ *
+ * 典型用法：
+ *   HostFake_Reset();                 // 清零虚拟时钟与全部替身状态
+ *   Sensor_Init(); ValveControl_Init();
+ *   HostClock_AdvanceMs(1U);          // 推进1ms，期间到期的中断依次执行
+ */
+
+#ifndef HOST_FAKE_H
+#define HOST_FAKE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+#include "ac7840x.h"
+
+/* ============================================  Define  ============================================ */
+
+#define HOST_SYSTEM_CLOCK_HZ              120000000U  // 系统时钟(Hz)，与SYSTEM_CLOCK_FREQ_HZ一致
+#define HOST_BUS_CLOCK_HZ                 60000000U   // 总线/定时器/CAN时钟(Hz)，CKGEN_DRV_GetFreq对其余时钟均返回该值
+#define HOST_IRQ_COUNT                    128U        // 替身NVIC支持的外设中断数
+#define HOST_CAN_TX_LOG_SIZE              256U        // CAN发送记录深度（满后丢弃最旧的帧）
+#define HOST_CAN_RX_QUEUE_SIZE            16U         // CAN接收缓冲深度
+#define HOST_DFLASH_SIZE                  (16UL * DFLASH_PAGE_SIZE) // 仿真的数据Flash大小（自DFLASH_BASE_ADDRESS起）
+
+/* ===========================================  Typedef  ============================================ */
+
+typedef void (*host_isr_t)(void);
+
+/*!
+ * @brief CAN帧记录
+ */
+typedef struct {
+    uint32_t id;
+    uint8_t data[8];
+    uint8_t length;
+    bool extended;
+    uint64_t time_ns;                         // 发送/接收时的虚拟时间
+} host_can_frame_t;
+
+/* ==========================================  Functions  =========================================== */
+
+/* ==================== 全局 ==================== */
+
+/*!
+ * @brief 清零虚拟时钟与全部替身状态（测试用例开始时调用）
+ */
+void HostFake_Reset(void);
+
+/* ==================== 虚拟时钟 ==================== */
+
+uint64_t HostClock_NowNs(void);
+uint32_t HostClock_NowMs(void);
+
+/*!
+ * @brief 推进虚拟时钟，期间到期的定时器/PWM中断按时间顺序执行
+ */
+void HostClock_AdvanceNs(uint64_t ns);
+void HostClock_AdvanceUs(uint32_t us);
+void HostClock_AdvanceMs(uint32_t ms);
+
+/* ==================== NVIC ==================== */
+
+/*!
+ * @brief 注册中断服务函数（由各外设替身在初始化时注册）
+ */
+void HostNvic_SetHandler(IRQn_Type irq, host_isr_t isr);
+
+/*!
+ * @brief 外设产生中断请求：使能且未屏蔽时立即执行，否则挂起
+ */
+void HostNvic_Raise(IRQn_Type irq);
+
+uint32_t HostNvic_GetPendingIRQ(IRQn_Type irq);
+
+/* ==================== GPIO ==================== */
+
+/*!
+ * @brief 读取端口输出锁存值（SetPins/ClearPins结果）
+ */
+uint32_t HostGpio_GetOutput(const GPIO_Type *base);
+
+/*!
+ * @brief 设置外部输入电平（GPIO_DRV_ReadPins返回输出锁存与外部输入的或）
+ */
+void HostGpio_SetInput(const GPIO_Type *base, uint32_t pin, bool high);
+
+/* ==================== PWM ==================== */
+
+uint16_t HostPwm_GetMaxCount(uint8_t instance);
+uint16_t HostPwm_GetChannelCount(uint8_t instance, uint8_t channel);
+uint32_t HostPwm_GetChannelDither(uint8_t instance, uint8_t dither_reg);
+uint32_t HostPwm_GetOverflowCount(uint8_t instance);
+
+/* ==================== ADC ==================== */
+
+/*!
+ * @brief 设置ADC输入通道的转换结果（软件触发转换后写入对应序列结果）
+ */
+void HostAdc_SetCode(uint32_t instance, uint32_t channel, uint16_t code);
+
+/* ==================== CAN ==================== */
+
+/*!
+ * @brief 模拟总线收到一帧：放入接收缓冲并按接收中断调用驱动回调
+ * @return false: 未初始化或接收缓冲满
+ */
+bool HostCan_Receive(uint32_t id, const uint8_t *data, uint8_t length, bool extended);
+
+/*!
+ * @brief 取出最早一帧发送记录
+ */
+bool HostCan_PopTx(host_can_frame_t *frame);
+
+/*!
+ * @brief 查找指定ID最近一次发送的帧（不移出记录）
+ */
+bool HostCan_FindLastTx(uint32_t id, host_can_frame_t *frame);
+
+uint32_t HostCan_GetTxCount(void);
+
+/* ==================== Flash ==================== */
+
+/*!
+ * @brief 擦除全部仿真数据Flash（HostFake_Reset不清Flash，便于测试掉电保持）
+ */
+void HostFlash_EraseAll(void);
+
+/* ==================== ACMP ==================== */
+
+void HostAcmp_SetOutput(uint32_t instance, bool high);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKE_H */
@@ -0,0 +1,68 @@
+/*!
+ * @file host_sim.h
+ * @brief PC端液压闭环仿真 - 整机固件 + 外设替身 + 液压对象模型(plant_model)，快于实时运行
+ *
+ * 功能模块：
+ * - HostSim_Start：模拟重新上电，清零替身与数据Flash，按目标板流程SystemStartup（HP_PLANT_SIM=1，传感器码值来自对象模型）
+ * - HostSim_SetCommand：按上位机方式打包gcu_control帧，经CAN替身接收中断进入CAN_RxCallback，
+ *   之后每HOST_SIM_COMMAND_PERIOD_MS重发一次（与上位机周期一致），HostSim_StopCommands停止重发
+ * - HostSim_RunMs：按虚拟时钟运行任务调度、采集流与PWM中断，同时记录模型油压极值
+ * - 对象模型由Sensor_GetPlantModel访问，可修改参数（如溢流阀开启压力）构造故障工况
+ */
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+#include "plant_model.h"
+
+/* ============================================  Define  ============================================ */
+
+#define HOST_SIM_COMMAND_PERIOD_MS        100U        // 上位机gcu_control下发周期(ms)
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 上位机控制命令（物理量，打包时按DBC编码）
+ */
+typedef struct {
+    bool system_enable;
+    bool reversal_enable;
+    uint8_t reversal_freq_hz;
+    bool cooler;
+    float bypass_duty;                        // 开环开度；本地压力闭环时为开度上限(%)
+    uint8_t mode;                             // PCTRL_MODE_OPEN_LOOP / PCTRL_MODE_PRESSURE
+    float setpoint_mpa;                       // 本地压力闭环设定值(MPa)
+    uint8_t min_duty;                         // 本地压力闭环开度下限(%)
+} host_sim_command_t;
+
+/*!
+ * @brief 仿真统计（HostSim_ResetStats后重新记录）
+ */
+typedef struct {
+    float oil_pressure_min;                   // 模型油压最小值(MPa)
+    float oil_pressure_max;                   // 模型油压最大值(MPa)
+    float bypass_duty_max;                    // 旁通阀开度最大值(%)
+} host_sim_stats_t;
+
+/* ==========================================  Functions  =========================================== */
+
+void HostSim_Start(void);
+void HostSim_SetCommand(const host_sim_command_t *cmd);
+void HostSim_StopCommands(void);
+void HostSim_RunMs(uint32_t ms);
+plant_model_t* HostSim_Plant(void);
+void HostSim_ResetStats(void);
+const host_sim_stats_t* HostSim_GetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_SIM_H */
@@ -0,0 +1,53 @@
+/*!
+ * @file fake_acmp.c
+ *
+ * @brief PC端ACMP替身：比较器输出由HostAcmp_SetOutput设置，DAC配置只记录
+ */
+
+#include "fake_internal.h"
+#include "acmp_drv.h"
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define HOST_ACMP_INSTANCE_COUNT          1U          // ACMP0
+
+/* ==========================================  Variables  =========================================== */
+
+static bool g_acmp_output[HOST_ACMP_INSTANCE_COUNT];
+static acmp_dac_t g_acmp_dac[HOST_ACMP_INSTANCE_COUNT];
+
+/* ==========================================  Functions  =========================================== */
+
+void HostAcmp_Reset(void)
+{
+    memset(g_acmp_output, 0, sizeof(g_acmp_output));
+    memset(g_acmp_dac, 0, sizeof(g_acmp_dac));
+}
+
+void HostAcmp_SetOutput(uint32_t instance, bool high)
+{
+    if (instance < HOST_ACMP_INSTANCE_COUNT) {
+        g_acmp_output[instance] = high;
+    }
+}
+
+/* ==================== ACMP_DRV接口 ==================== */
+
+status_t ACMP_DRV_ConfigDAC(const uint32_t instance, const acmp_dac_t *config)
+{
+    if (instance >= HOST_ACMP_INSTANCE_COUNT) {
+        return STATUS_ERROR;
+    }
+    g_acmp_dac[instance] = *config;
+    return STATUS_SUCCESS;
+}
+
+status_t ACMP_DRV_GetOutputData(const uint32_t instance, uint8_t *flags)
+{
+    if (instance >= HOST_ACMP_INSTANCE_COUNT) {
+        return STATUS_ERROR;
+    }
+    *flags = g_acmp_output[instance] ? 1U : 0U;
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,121 @@
+/*!
+ * @file fake_adc.c
+ *
+ * @brief PC端ADC替身：软件触发立即完成，序列结果取自HostAdc_SetCode设置的通道码值
+ *
+ * 说明：
+ * - 规则组软件触发转换全部已配置的规则序列，注入组软件触发转换全部已配置的注入序列
+ * - 转换完成标志在触发后立即置位，直到ADC_DRV_ClearConvCompleteFlag清除
+ * - 硬件触发（PDT/CTU）与转换完成中断不仿真
+ */
+
+#include "fake_internal.h"
+#include "adc_drv.h"
+#include <string.h>
+
+/* ===========================================  Typedef  ============================================ */
+
+typedef struct {
+    bool configured[ADC_SEQ_MAX];
+    uint8_t seq_channel[ADC_SEQ_MAX];
+    bool complete[ADC_SEQ_MAX];
+    uint16_t result[ADC_SEQ_MAX];
+    uint16_t code[ADC_CH_MAX];
+} host_adc_t;
+
+/* ==========================================  Variables  =========================================== */
+
+static host_adc_t g_adc[ADC_INSTANCE_MAX];
+
+/* ==========================================  Functions  =========================================== */
+
+static void HostAdc_Convert(uint32_t instance, uint32_t first, uint32_t last)
+{
+    host_adc_t *adc = &g_adc[instance];
+
+    for (uint32_t seq = first; seq <= last; seq++) {
+        if (adc->configured[seq]) {
+            adc->result[seq] = adc->code[adc->seq_channel[seq]];
+            adc->complete[seq] = true;
+        }
+    }
+}
+
+void HostAdc_Reset(void)
+{
+    memset(g_adc, 0, sizeof(g_adc));
+}
+
+void HostAdc_SetCode(uint32_t instance, uint32_t channel, uint16_t code)
+{
+    if (instance < ADC_INSTANCE_MAX && channel < (uint32_t)ADC_CH_MAX) {
+        g_adc[instance].code[channel] = code;
+    }
+}
+
+/* ==================== ADC_DRV接口 ==================== */
+
+void ADC_DRV_InitConverterStruct(adc_converter_config_t * const config)
+{
+    memset(config, 0, sizeof(*config));
+}
+
+void ADC_DRV_Init(const uint32_t instance)
+{
+    if (instance < ADC_INSTANCE_MAX) {
+        memset(g_adc[instance].configured, 0, sizeof(g_adc[instance].configured));
+        memset(g_adc[instance].complete, 0, sizeof(g_adc[instance].complete));
+    }
+}
+
+void ADC_DRV_ConfigConverter(const uint32_t instance, const adc_converter_config_t * const config)
+{
+    (void)instance;
+    (void)config;
+}
+
+void ADC_DRV_InitChanStruct(adc_chan_config_t * const config)
+{
+    memset(config, 0, sizeof(*config));
+}
+
+void ADC_DRV_ConfigChan(const uint32_t instance, const adc_sequence_t seqIndex, const adc_chan_config_t * const config)
+{
+    if (instance < ADC_INSTANCE_MAX && seqIndex < ADC_SEQ_MAX && config->channel < ADC_CH_MAX) {
+        g_adc[instance].configured[seqIndex] = true;
+        g_adc[instance].seq_channel[seqIndex] = (uint8_t)config->channel;
+    }
+}
+
+void ADC_DRV_SoftwareStartRegularConvert(uint32_t instance)
+{
+    if (instance < ADC_INSTANCE_MAX) {
+        HostAdc_Convert(instance, ADC_RSEQ_0, ADC_RSEQ_31);
+    }
+}
+
+void ADC_DRV_SoftwareStartInjectConvert(uint32_t instance)
+{
+    if (instance < ADC_INSTANCE_MAX) {
+        HostAdc_Convert(instance, ADC_ISEQ_0, ADC_ISEQ_3);
+    }
+}
+
+bool ADC_DRV_GetConvCompleteFlag(const uint32_t instance, const adc_sequence_t seqIndex)
+{
+    return instance < ADC_INSTANCE_MAX && seqIndex < ADC_SEQ_MAX && g_adc[instance].complete[seqIndex];
+}
+
+void ADC_DRV_ClearConvCompleteFlag(const uint32_t instance, const adc_sequence_t seqIndex)
+{
+    if (instance < ADC_INSTANCE_MAX && seqIndex < ADC_SEQ_MAX) {
+        g_adc[instance].complete[seqIndex] = false;
+    }
+}
+
+void ADC_DRV_GetSeqResult(const uint32_t instance, const adc_sequence_t seqIndex, uint16_t * const result)
+{
+    if (instance < ADC_INSTANCE_MAX && seqIndex < ADC_SEQ_MAX) {
+        *result = g_adc[instance].result[seqIndex];
+    }
+}
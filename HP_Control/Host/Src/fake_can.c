@@ -0,0 +1,215 @@
+/*!
+ * @file fake_can.c
+ *
+ * @brief PC端CAN替身：发送记录、接收缓冲与接收中断
+ *
+ * 说明：
+ * - 发送立即完成，帧记入发送记录（HostCan_PopTx/HostCan_FindLastTx读取）
+ * - HostCan_Receive放入接收缓冲并请求CAN中断，中断服务以CAN_EVENT_RECEIVE_DONE调用驱动回调，
+ *   回调内CAN_DRV_Receive取帧，与目标板接收路径一致
+ * - CAN_DRV_GetBase返回内存中的寄存器影子，App层读取的BOFF/STBY/IDLE位由替身维护
+ */
+
+#include "fake_internal.h"
+#include "can_drv.h"
+#include <string.h>
+
+/* ==========================================  Variables  =========================================== */
+
+static CAN_Type g_can_regs[CAN_INSTANCE_MAX];
+static const IRQn_Type g_can_irq[CAN_INSTANCE_MAX] = CAN_IRQS;
+static bool g_can_initialized[CAN_INSTANCE_MAX];
+static can_callback_t g_can_callback[CAN_INSTANCE_MAX];
+
+// 接收缓冲（只仿真CAN0，App层只使用CAN_INSTANCE 0）
+static host_can_frame_t g_can_rx[HOST_CAN_RX_QUEUE_SIZE];
+static uint32_t g_can_rx_head = 0U;
+static uint32_t g_can_rx_count = 0U;
+
+// 发送记录
+static host_can_frame_t g_can_tx[HOST_CAN_TX_LOG_SIZE];
+static uint32_t g_can_tx_head = 0U;
+static uint32_t g_can_tx_count = 0U;
+static uint32_t g_can_tx_total = 0U;
+
+/* ==========================================  Functions  =========================================== */
+
+static void HostCan0_Isr(void)
+{
+    while (g_can_rx_count > 0U && g_can_callback[0] != NULL) {
+        uint32_t before = g_can_rx_count;
+        g_can_callback[0](0U, CAN_EVENT_RECEIVE_DONE, 0U);
+        if (g_can_rx_count == before) {
+            break;      // 回调未取帧，留待下次中断
+        }
+    }
+}
+
+void HostCan_Reset(void)
+{
+    memset(g_can_regs, 0, sizeof(g_can_regs));
+    memset(g_can_initialized, 0, sizeof(g_can_initialized));
+    memset(g_can_callback, 0, sizeof(g_can_callback));
+    g_can_rx_head = 0U;
+    g_can_rx_count = 0U;
+    g_can_tx_head = 0U;
+    g_can_tx_count = 0U;
+    g_can_tx_total = 0U;
+    HostNvic_SetHandler(g_can_irq[0], HostCan0_Isr);
+}
+
+bool HostCan_Receive(uint32_t id, const uint8_t *data, uint8_t length, bool extended)
+{
+    if (!g_can_initialized[0] || g_can_rx_count >= HOST_CAN_RX_QUEUE_SIZE || length > 8U) {
+        return false;
+    }
+
+    host_can_frame_t *frame = &g_can_rx[(g_can_rx_head + g_can_rx_count) % HOST_CAN_RX_QUEUE_SIZE];
+    memset(frame, 0, sizeof(*frame));
+    frame->id = id;
+    frame->length = length;
+    frame->extended = extended;
+    frame->time_ns = HostClock_NowNs();
+    if (length > 0U) {
+        memcpy(frame->data, data, length);
+    }
+    g_can_rx_count++;
+    HostNvic_Raise(g_can_irq[0]);
+    return true;
+}
+
+bool HostCan_PopTx(host_can_frame_t *frame)
+{
+    if (g_can_tx_count == 0U) {
+        return false;
+    }
+    *frame = g_can_tx[g_can_tx_head];
+    g_can_tx_head = (g_can_tx_head + 1U) % HOST_CAN_TX_LOG_SIZE;
+    g_can_tx_count--;
+    return true;
+}
+
+bool HostCan_FindLastTx(uint32_t id, host_can_frame_t *frame)
+{
+    for (uint32_t n = g_can_tx_count; n > 0U; n--) {
+        const host_can_frame_t *f = &g_can_tx[(g_can_tx_head + n - 1U) % HOST_CAN_TX_LOG_SIZE];
+        if (f->id == id) {
+            *frame = *f;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t HostCan_GetTxCount(void)
+{
+    return g_can_tx_total;
+}
+
+/* ==================== CAN_DRV接口 ==================== */
+
+void CAN_DRV_GetDefaultConfig(can_user_config_t *config)
+{
+    memset(config, 0, sizeof(*config));
+}
+
+status_t CAN_DRV_Init(uint8_t instance, const can_user_config_t *config)
+{
+    if (instance >= CAN_INSTANCE_MAX) {
+        return STATUS_ERROR;
+    }
+    memset(&g_can_regs[instance], 0, sizeof(CAN_Type));
+    g_can_regs[instance].CTRL0 = CAN_CTRL0_IDLE_Msk;
+    g_can_callback[instance] = config->callback;
+    g_can_initialized[instance] = true;
+    NVIC_EnableIRQ(g_can_irq[instance]);
+    return STATUS_SUCCESS;
+}
+
+status_t CAN_DRV_Deinit(uint8_t instance)
+{
+    if (instance >= CAN_INSTANCE_MAX) {
+        return STATUS_ERROR;
+    }
+    g_can_initialized[instance] = false;
+    NVIC_DisableIRQ(g_can_irq[instance]);
+    return STATUS_SUCCESS;
+}
+
+CAN_Type *CAN_DRV_GetBase(uint8_t instance)
+{
+    return &g_can_regs[(instance < CAN_INSTANCE_MAX) ? instance : 0U];
+}
+
+status_t CAN_DRV_SetStandby(uint8_t instance, bool enable)
+{
+    if (instance >= CAN_INSTANCE_MAX) {
+        return STATUS_ERROR;
+    }
+    if (enable) {
+        g_can_regs[instance].CTRL0 |= CAN_CTRL0_STBY_Msk;
+    } else {
+        g_can_regs[instance].CTRL0 &= ~CAN_CTRL0_STBY_Msk;
+    }
+    return STATUS_SUCCESS;
+}
+
+status_t CAN_DRV_Send(uint8_t instance, const can_msg_info_t *info, can_transmit_buff_t type)
+{
+    (void)type;
+    if (instance >= CAN_INSTANCE_MAX || !g_can_initialized[instance] || info->DLC > 8U) {
+        return STATUS_ERROR;
+    }
+
+    if (g_can_tx_count == HOST_CAN_TX_LOG_SIZE) {
+        g_can_tx_head = (g_can_tx_head + 1U) % HOST_CAN_TX_LOG_SIZE;
+        g_can_tx_count--;
+    }
+    host_can_frame_t *frame = &g_can_tx[(g_can_tx_head + g_can_tx_count) % HOST_CAN_TX_LOG_SIZE];
+    memset(frame, 0, sizeof(*frame));
+    frame->id = info->ID;
+    frame->length = info->DLC;
+    frame->extended = (info->IDE != 0U);
+    frame->time_ns = HostClock_NowNs();
+    if (info->DATA != NULL && info->DLC > 0U) {
+        memcpy(frame->data, info->DATA, info->DLC);
+    }
+    g_can_tx_count++;
+    g_can_tx_total++;
+    return STATUS_SUCCESS;
+}
+
+bool CAN_DRV_IsTransmitBusy(uint8_t instance, can_transmit_buff_t type)
+{
+    (void)instance;
+    (void)type;
+    return false;
+}
+
+can_rbuf_status_t CAN_DRV_GetRbufStatus(uint8_t instance)
+{
+    return (instance == 0U && g_can_rx_count > 0U) ? CAN_RSTAT_LESS_ALMOST : CAN_RSTAT_EMPTY;
+}
+
+status_t CAN_DRV_Receive(uint8_t instance, can_msg_info_t *info)
+{
+    if (instance != 0U || g_can_rx_count == 0U) {
+        return STATUS_ERROR;
+    }
+
+    const host_can_frame_t *frame = &g_can_rx[g_can_rx_head];
+    info->ID = frame->id;
+    info->DLC = frame->length;
+    info->IDE = frame->extended ? 1U : 0U;
+    info->RTR = 0U;
+    info->FDF = 0U;
+    info->BRS = 0U;
+    info->ESI = 0U;
+    info->RTS = 0U;
+    if (info->DATA != NULL && frame->length > 0U) {
+        memcpy(info->DATA, frame->data, frame->length);
+    }
+    g_can_rx_head = (g_can_rx_head + 1U) % HOST_CAN_RX_QUEUE_SIZE;
+    g_can_rx_count--;
+    return STATUS_SUCCESS;
+}
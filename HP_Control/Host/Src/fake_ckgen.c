@@ -0,0 +1,50 @@
+/*!
+ * @file fake_ckgen.c
+ *
+ * @brief PC端CKGEN替身：时钟配置恒成功，核心时钟为HOST_SYSTEM_CLOCK_HZ，其余时钟为HOST_BUS_CLOCK_HZ
+ */
+
+#include "fake_internal.h"
+#include "ckgen_drv.h"
+
+/* ==========================================  Functions  =========================================== */
+
+status_t CKGEN_SYS_Init(clock_manager_user_config_t const **clockConfigsPtr,
+                        uint8_t configsNumber,
+                        clock_manager_callback_user_config_t **callbacksPtr,
+                        uint8_t callbacksNumber)
+{
+    (void)clockConfigsPtr;
+    (void)configsNumber;
+    (void)callbacksPtr;
+    (void)callbacksNumber;
+    return STATUS_SUCCESS;
+}
+
+status_t CKGEN_DRV_UpdateConfiguration(uint8_t targetConfigIndex, clock_manager_policy_t policy)
+{
+    (void)targetConfigIndex;
+    (void)policy;
+    return STATUS_SUCCESS;
+}
+
+status_t CKGEN_DRV_GetFreq(clock_names_t clockName, uint32_t *frequency)
+{
+    if (frequency == NULL) {
+        return STATUS_ERROR;
+    }
+    *frequency = (clockName == CORE_CLK) ? HOST_SYSTEM_CLOCK_HZ : HOST_BUS_CLOCK_HZ;
+    return STATUS_SUCCESS;
+}
+
+void CKGEN_DRV_Enable(ckgen_clock_t module, bool enable)
+{
+    (void)module;
+    (void)enable;
+}
+
+void CKGEN_DRV_SoftReset(ckgen_softreset_t module, bool enable)
+{
+    (void)module;
+    (void)enable;
+}
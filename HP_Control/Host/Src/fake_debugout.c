@@ -0,0 +1,14 @@
+/*!
+ * @file fake_debugout.c
+ *
+ * @brief PC端调试串口替身：printf直接输出到标准输出，InitDebug为空操作
+ */
+
+#include "fake_internal.h"
+#include "debugout_ac7840x.h"
+
+/* ==========================================  Functions  =========================================== */
+
+void InitDebug(void)
+{
+}
@@ -0,0 +1,101 @@
+/*!
+ * @file fake_flash.c
+ *
+ * @brief PC端Flash替身：内存中的数据Flash（自DFLASH_BASE_ADDRESS起HOST_DFLASH_SIZE字节）
+ *
+ * 说明：
+ * - 上电内容为擦除态0xFF；编程只能把1写成0（与NOR Flash一致），未擦除即编程会暴露为数据错误
+ * - 擦除以DFLASH_PAGE_SIZE为单位，地址需页对齐；编程地址需按DFLASH_WRITE_UNIT_SIZE对齐
+ * - HostFake_Reset不清Flash，测试可验证标定掉电保持；需要空片时调用HostFlash_EraseAll
+ */
+
+#include "fake_internal.h"
+#include "flash_drv.h"
+#include <string.h>
+
+/* ==========================================  Variables  =========================================== */
+
+static uint8_t g_dflash[HOST_DFLASH_SIZE];
+static bool g_dflash_ready = false;
+static bool g_dflash_unlocked = false;
+
+/* ==========================================  Functions  =========================================== */
+
+static bool HostFlash_Range(uint32_t addr, uint32_t size)
+{
+    if (!g_dflash_ready) {
+        HostFlash_EraseAll();
+    }
+    return addr >= DFLASH_BASE_ADDRESS && size <= HOST_DFLASH_SIZE &&
+           addr - DFLASH_BASE_ADDRESS <= HOST_DFLASH_SIZE - size;
+}
+
+void HostFlash_EraseAll(void)
+{
+    memset(g_dflash, 0xFF, sizeof(g_dflash));
+    g_dflash_ready = true;
+}
+
+/* ==================== FLASH_DRV接口 ==================== */
+
+void FLASH_DRV_GetDefaultConfig(flash_user_config_t * const config)
+{
+    memset(config, 0, sizeof(*config));
+    config->dFlashBase = DFLASH_BASE_ADDRESS;
+}
+
+void FLASH_DRV_Init(const flash_user_config_t * const userConfig, flash_config_t * const config)
+{
+    memset(config, 0, sizeof(*config));
+    config->pFlashBase = userConfig->pFlashBase;
+    config->pFlashSize = userConfig->pFlashSize;
+    config->dFlashBase = DFLASH_BASE_ADDRESS;
+    config->dFlashSize = HOST_DFLASH_SIZE;
+    config->callback = userConfig->callback;
+}
+
+status_t FLASH_DRV_UnlockCtrl(void)
+{
+    g_dflash_unlocked = true;
+    return STATUS_SUCCESS;
+}
+
+void FLASH_DRV_LockCtrl(void)
+{
+    g_dflash_unlocked = false;
+}
+
+status_t FLASH_DRV_Read(const flash_config_t *config, uint32_t addr, uint8_t *data, uint32_t size)
+{
+    (void)config;
+    if (!HostFlash_Range(addr, size)) {
+        return STATUS_ERROR;
+    }
+    memcpy(data, &g_dflash[addr - DFLASH_BASE_ADDRESS], size);
+    return STATUS_SUCCESS;
+}
+
+status_t FLASH_DRV_EraseSector(const flash_config_t *config, uint32_t addr, uint32_t size)
+{
+    (void)config;
+    if (!g_dflash_unlocked || !HostFlash_Range(addr, size) ||
+        ((addr - DFLASH_BASE_ADDRESS) % DFLASH_PAGE_SIZE) != 0U) {
+        return STATUS_ERROR;
+    }
+    memset(&g_dflash[addr - DFLASH_BASE_ADDRESS], 0xFF, size);
+    return STATUS_SUCCESS;
+}
+
+status_t FLASH_DRV_Program(const flash_config_t *config, uint32_t addr, uint32_t size, const uint8_t *data)
+{
+    (void)config;
+    if (!g_dflash_unlocked || !HostFlash_Range(addr, size) ||
+        ((addr - DFLASH_BASE_ADDRESS) % DFLASH_WRITE_UNIT_SIZE) != 0U) {
+        return STATUS_ERROR;
+    }
+    uint8_t *dst = &g_dflash[addr - DFLASH_BASE_ADDRESS];
+    for (uint32_t i = 0U; i < size; i++) {
+        dst[i] &= data[i];
+    }
+    return STATUS_SUCCESS;
+}
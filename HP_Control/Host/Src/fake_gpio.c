@@ -0,0 +1,106 @@
+/*!
+ * @file fake_gpio.c
+ *
+ * @brief PC端GPIO替身：每个端口一个输出锁存与一个外部输入电平
+ */
+
+#include "fake_internal.h"
+#include "gpio_drv.h"
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define HOST_GPIO_PORT_COUNT              5U          // PORTA~PORTE
+
+/* ==========================================  Variables  =========================================== */
+
+static uint32_t g_gpio_output[HOST_GPIO_PORT_COUNT];
+static uint32_t g_gpio_input[HOST_GPIO_PORT_COUNT];
+
+/* ==========================================  Functions  =========================================== */
+
+static int32_t HostGpio_PortIndex(const GPIO_Type *base)
+{
+    static const GPIO_Type *const ports[HOST_GPIO_PORT_COUNT] = {GPIOA, GPIOB, GPIOC, GPIOD, GPIOE};
+
+    for (uint32_t i = 0U; i < HOST_GPIO_PORT_COUNT; i++) {
+        if (ports[i] == base) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+void HostGpio_Reset(void)
+{
+    memset(g_gpio_output, 0, sizeof(g_gpio_output));
+    memset(g_gpio_input, 0, sizeof(g_gpio_input));
+}
+
+uint32_t HostGpio_GetOutput(const GPIO_Type *base)
+{
+    int32_t port = HostGpio_PortIndex(base);
+    return (port < 0) ? 0U : g_gpio_output[port];
+}
+
+void HostGpio_SetInput(const GPIO_Type *base, uint32_t pin, bool high)
+{
+    int32_t port = HostGpio_PortIndex(base);
+    if (port < 0 || pin >= 32U) {
+        return;
+    }
+    if (high) {
+        g_gpio_input[port] |= 1UL << pin;
+    } else {
+        g_gpio_input[port] &= ~(1UL << pin);
+    }
+}
+
+/* ==================== GPIO_DRV接口 ==================== */
+
+status_t GPIO_DRV_Init(uint32_t pinCount, const gpio_settings_config_t config[])
+{
+    for (uint32_t i = 0U; i < pinCount; i++) {
+        int32_t port = HostGpio_PortIndex(config[i].gpioBase);
+        if (port < 0) {
+            return STATUS_ERROR;
+        }
+        if (config[i].direction == GPIO_OUTPUT_DIRECTION) {
+            if (config[i].initValue != 0U) {
+                g_gpio_output[port] |= 1UL << config[i].pinPortIdx;
+            } else {
+                g_gpio_output[port] &= ~(1UL << config[i].pinPortIdx);
+            }
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+void GPIO_DRV_SetMuxModeSel(PORT_Type * const base, uint32_t pin, port_mux_t mux)
+{
+    (void)base;
+    (void)pin;
+    (void)mux;
+}
+
+void GPIO_DRV_SetPins(GPIO_Type * const base, gpio_channel_type_t pins)
+{
+    int32_t port = HostGpio_PortIndex(base);
+    if (port >= 0) {
+        g_gpio_output[port] |= pins;
+    }
+}
+
+void GPIO_DRV_ClearPins(GPIO_Type * const base, gpio_channel_type_t pins)
+{
+    int32_t port = HostGpio_PortIndex(base);
+    if (port >= 0) {
+        g_gpio_output[port] &= ~pins;
+    }
+}
+
+gpio_channel_type_t GPIO_DRV_ReadPins(const GPIO_Type * const base)
+{
+    int32_t port = HostGpio_PortIndex(base);
+    return (port < 0) ? 0U : (g_gpio_output[port] | g_gpio_input[port]);
+}
@@ -0,0 +1,46 @@
+/*!
+ * @file fake_internal.h
+ * @brief PC端外设替身之间的内部接口（虚拟时钟调度定时器/PWM事件、统一复位）
+ */
+
+#ifndef FAKE_INTERNAL_H
+#define FAKE_INTERNAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include "host_fake.h"
+
+/* ============================================  Define  ============================================ */
+
+#define HOST_NO_EVENT                     UINT64_MAX  // 无待触发事件
+
+/* ==========================================  Functions  =========================================== */
+
+void HostNvic_Reset(void);
+void HostGpio_Reset(void);
+void HostPwm_Reset(void);
+void HostAdc_Reset(void);
+void HostCan_Reset(void);
+void HostTimer_Reset(void);
+void HostAcmp_Reset(void);
+
+/*!
+ * @brief 最近一个到期事件的虚拟时间(ns)，无事件返回HOST_NO_EVENT
+ */
+uint64_t HostTimer_NextEventNs(void);
+uint64_t HostPwm_NextEventNs(void);
+
+/*!
+ * @brief 处理所有在now_ns及之前到期的事件（产生中断请求并排定下一周期）
+ */
+void HostTimer_Expire(uint64_t now_ns);
+void HostPwm_Expire(uint64_t now_ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FAKE_INTERNAL_H */
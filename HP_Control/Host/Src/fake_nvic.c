@@ -0,0 +1,139 @@
+/*!
+ * @file fake_nvic.c
+ *
+ * @brief PC端NVIC替身：中断使能/挂起状态与派发
+ *
+ * 说明：
+ * - 外设替身通过HostNvic_Raise产生中断请求；使能且PRIMASK未置位时立即执行，否则挂起
+ * - 重新使能或清除PRIMASK时执行挂起的中断，对应硬件中电平标志保持到中断被服务
+ * - 中断服务中不再嵌套派发（所有外设中断同优先级，与目标板一致）
+ */
+
+#include "fake_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==========================================  Variables  =========================================== */
+
+static host_isr_t g_nvic_handler[HOST_IRQ_COUNT];
+static bool g_nvic_enabled[HOST_IRQ_COUNT];
+static bool g_nvic_pending[HOST_IRQ_COUNT];
+static uint32_t g_nvic_primask = 0U;
+static bool g_nvic_in_isr = false;
+
+/* ==========================================  Functions  =========================================== */
+
+static bool HostNvic_Valid(IRQn_Type irq)
+{
+    return (int32_t)irq >= 0 && (uint32_t)irq < HOST_IRQ_COUNT;
+}
+
+/*!
+ * @brief 依次执行所有可执行的挂起中断
+ */
+static void HostNvic_Dispatch(void)
+{
+    if (g_nvic_in_isr || g_nvic_primask != 0U) {
+        return;
+    }
+    bool again = true;
+    while (again) {
+        again = false;
+        for (uint32_t i = 0U; i < HOST_IRQ_COUNT; i++) {
+            if (g_nvic_pending[i] && g_nvic_enabled[i] && g_nvic_primask == 0U) {
+                g_nvic_pending[i] = false;
+                if (g_nvic_handler[i] != NULL) {
+                    g_nvic_in_isr = true;
+                    g_nvic_handler[i]();
+                    g_nvic_in_isr = false;
+                }
+                again = true;
+            }
+        }
+    }
+}
+
+void HostNvic_Reset(void)
+{
+    memset(g_nvic_enabled, 0, sizeof(g_nvic_enabled));
+    memset(g_nvic_pending, 0, sizeof(g_nvic_pending));
+    g_nvic_primask = 0U;
+    g_nvic_in_isr = false;
+    // 中断服务函数由外设替身在模块加载时注册，复位后保留
+}
+
+void HostNvic_SetHandler(IRQn_Type irq, host_isr_t isr)
+{
+    if (HostNvic_Valid(irq)) {
+        g_nvic_handler[irq] = isr;
+    }
+}
+
+void HostNvic_Raise(IRQn_Type irq)
+{
+    if (HostNvic_Valid(irq)) {
+        g_nvic_pending[irq] = true;
+        HostNvic_Dispatch();
+    }
+}
+
+uint32_t HostNvic_GetPendingIRQ(IRQn_Type irq)
+{
+    return (HostNvic_Valid(irq) && g_nvic_pending[irq]) ? 1U : 0U;
+}
+
+void HostNvic_EnableIRQ(IRQn_Type irq)
+{
+    if (HostNvic_Valid(irq)) {
+        g_nvic_enabled[irq] = true;
+        HostNvic_Dispatch();
+    }
+}
+
+void HostNvic_DisableIRQ(IRQn_Type irq)
+{
+    if (HostNvic_Valid(irq)) {
+        g_nvic_enabled[irq] = false;
+    }
+}
+
+void HostNvic_ClearPendingIRQ(IRQn_Type irq)
+{
+    if (HostNvic_Valid(irq)) {
+        g_nvic_pending[irq] = false;
+    }
+}
+
+void HostNvic_SetPendingIRQ(IRQn_Type irq)
+{
+    HostNvic_Raise(irq);
+}
+
+uint32_t HostNvic_GetEnableIRQ(IRQn_Type irq)
+{
+    return (HostNvic_Valid(irq) && g_nvic_enabled[irq]) ? 1U : 0U;
+}
+
+void HostNvic_SetPriority(IRQn_Type irq, uint32_t priority)
+{
+    (void)irq;
+    (void)priority;
+}
+
+uint32_t HostNvic_GetPrimask(void)
+{
+    return g_nvic_primask;
+}
+
+void HostNvic_SetPrimask(uint32_t primask)
+{
+    g_nvic_primask = primask & 1U;
+    HostNvic_Dispatch();
+}
+
+void HostNvic_SystemReset(void)
+{
+    fprintf(stderr, "[HOST] NVIC_SystemReset called\n");
+    exit(EXIT_FAILURE);
+}
@@ -0,0 +1,97 @@
+/*!
+ * @file fake_osif.c
+ *
+ * @brief PC端OSIF替身：虚拟时钟
+ *
+ * 说明：
+ * - OSIF_GetMilliseconds返回虚拟时间，App层所有时间戳都来自这里
+ * - 虚拟时钟只在HostClock_Advance*或OSIF_TimeDelay中推进，推进期间按时间顺序派发定时器/PWM中断
+ * - 中断服务中调用OSIF_TimeDelay只推进时间、不再派发，避免重入
+ */
+
+#include "fake_internal.h"
+#include "osif.h"
+
+/* ==========================================  Variables  =========================================== */
+
+static uint64_t g_clock_now_ns = 0U;
+static bool g_clock_advancing = false;
+
+/* ==========================================  Functions  =========================================== */
+
+void HostFake_Reset(void)
+{
+    g_clock_now_ns = 0U;
+    g_clock_advancing = false;
+    HostNvic_Reset();
+    HostGpio_Reset();
+    HostPwm_Reset();
+    HostAdc_Reset();
+    HostCan_Reset();
+    HostTimer_Reset();
+    HostAcmp_Reset();
+}
+
+uint64_t HostClock_NowNs(void)
+{
+    return g_clock_now_ns;
+}
+
+uint32_t HostClock_NowMs(void)
+{
+    return (uint32_t)(g_clock_now_ns / 1000000U);
+}
+
+void HostClock_AdvanceNs(uint64_t ns)
+{
+    uint64_t target = g_clock_now_ns + ns;
+
+    if (g_clock_advancing) {
+        g_clock_now_ns = target;
+        return;
+    }
+
+    g_clock_advancing = true;
+    for (;;) {
+        uint64_t t_timer = HostTimer_NextEventNs();
+        uint64_t t_pwm = HostPwm_NextEventNs();
+        uint64_t next = (t_timer < t_pwm) ? t_timer : t_pwm;
+        if (next == HOST_NO_EVENT || next > target) {
+            break;
+        }
+        if (next > g_clock_now_ns) {
+            g_clock_now_ns = next;
+        }
+        if (t_timer <= t_pwm) {
+            HostTimer_Expire(g_clock_now_ns);
+        } else {
+            HostPwm_Expire(g_clock_now_ns);
+        }
+    }
+    if (target > g_clock_now_ns) {
+        g_clock_now_ns = target;
+    }
+    g_clock_advancing = false;
+}
+
+void HostClock_AdvanceUs(uint32_t us)
+{
+    HostClock_AdvanceNs((uint64_t)us * 1000U);
+}
+
+void HostClock_AdvanceMs(uint32_t ms)
+{
+    HostClock_AdvanceNs((uint64_t)ms * 1000000U);
+}
+
+/* ==================== OSIF接口 ==================== */
+
+uint32_t OSIF_GetMilliseconds(void)
+{
+    return HostClock_NowMs();
+}
+
+void OSIF_TimeDelay(const uint32_t delay)
+{
+    HostClock_AdvanceMs(delay);
+}
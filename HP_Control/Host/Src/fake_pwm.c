@@ -0,0 +1,195 @@
+/*!
+ * @file fake_pwm.c
+ *
+ * @brief PC端PWM替身：计数寄存器影子与溢出中断
+ *
+ * 说明：
+ * - PWM_DRV_SimplyInit后计数器开始运行，周期 = (MOD + 1 + MOD抖动/32) / (系统时钟 / (CLKPSC + 1))
+ * - 使能溢出中断时每个周期产生一次溢出中断请求，由NVIC替身派发到已安装的溢出回调
+ * - 故障输入不仿真，清故障标志为空操作
+ */
+
+#include "fake_internal.h"
+#include "pwm_common.h"
+#include "pwm_output.h"
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define HOST_PWM_DITHER_STEPS             32.0      // MOD抖动分辨率（1/32计数）
+#define HOST_PWM_DITHER_REG_COUNT         4U        // 通道抖动寄存器数（每个寄存器2个通道）
+
+/* ===========================================  Typedef  ============================================ */
+
+typedef struct {
+    bool running;
+    bool overflow_irq_en;
+    uint16_t clk_psc;
+    uint16_t max_count;
+    uint8_t max_count_dither;
+    uint16_t ch_count[PWM_CHANNEL_MAX];
+    uint32_t ch_dither[HOST_PWM_DITHER_REG_COUNT];
+    bool match_trigger[PWM_CHANNEL_MAX];
+    pwm_callback_t overflow_callback;
+    double next_overflow_ns;
+    uint32_t overflow_count;
+} host_pwm_t;
+
+/* ==========================================  Variables  =========================================== */
+
+static host_pwm_t g_pwm[PWM_INSTANCE_MAX];
+static const IRQn_Type g_pwm_overflow_irq[PWM_INSTANCE_MAX] = PWM_OVERFLOW_IRQS;
+
+/* ==========================================  Functions  =========================================== */
+
+static double HostPwm_PeriodNs(const host_pwm_t *pwm)
+{
+    double counts = (double)pwm->max_count + 1.0 + (double)pwm->max_count_dither / HOST_PWM_DITHER_STEPS;
+    double clock_hz = (double)HOST_SYSTEM_CLOCK_HZ / ((double)pwm->clk_psc + 1.0);
+    return counts * 1.0e9 / clock_hz;
+}
+
+static void HostPwm_OverflowIsr(uint8_t instance)
+{
+    host_pwm_t *pwm = &g_pwm[instance];
+    uint32_t dir = 0U;
+
+    if (pwm->overflow_callback != NULL) {
+        pwm->overflow_callback(instance, 1U, &dir);
+    }
+}
+
+static void HostPwm0_OverflowIsr(void) { HostPwm_OverflowIsr(0U); }
+static void HostPwm1_OverflowIsr(void) { HostPwm_OverflowIsr(1U); }
+static void HostPwm2_OverflowIsr(void) { HostPwm_OverflowIsr(2U); }
+static void HostPwm3_OverflowIsr(void) { HostPwm_OverflowIsr(3U); }
+static void HostPwm4_OverflowIsr(void) { HostPwm_OverflowIsr(4U); }
+static void HostPwm5_OverflowIsr(void) { HostPwm_OverflowIsr(5U); }
+
+void HostPwm_Reset(void)
+{
+    static const host_isr_t isr[PWM_INSTANCE_MAX] = {
+        HostPwm0_OverflowIsr, HostPwm1_OverflowIsr, HostPwm2_OverflowIsr,
+        HostPwm3_OverflowIsr, HostPwm4_OverflowIsr, HostPwm5_OverflowIsr
+    };
+
+    memset(g_pwm, 0, sizeof(g_pwm));
+    for (uint32_t i = 0U; i < PWM_INSTANCE_MAX; i++) {
+        HostNvic_SetHandler(g_pwm_overflow_irq[i], isr[i]);
+    }
+}
+
+uint64_t HostPwm_NextEventNs(void)
+{
+    uint64_t next = HOST_NO_EVENT;
+
+    for (uint32_t i = 0U; i < PWM_INSTANCE_MAX; i++) {
+        if (g_pwm[i].running && g_pwm[i].overflow_irq_en) {
+            uint64_t t = (uint64_t)g_pwm[i].next_overflow_ns;
+            if (t < next) {
+                next = t;
+            }
+        }
+    }
+    return next;
+}
+
+void HostPwm_Expire(uint64_t now_ns)
+{
+    for (uint32_t i = 0U; i < PWM_INSTANCE_MAX; i++) {
+        host_pwm_t *pwm = &g_pwm[i];
+        while (pwm->running && pwm->overflow_irq_en && (uint64_t)pwm->next_overflow_ns <= now_ns) {
+            pwm->next_overflow_ns += HostPwm_PeriodNs(pwm);
+            pwm->overflow_count++;
+            HostNvic_Raise(g_pwm_overflow_irq[i]);
+        }
+    }
+}
+
+uint16_t HostPwm_GetMaxCount(uint8_t instance)
+{
+    return (instance < PWM_INSTANCE_MAX) ? g_pwm[instance].max_count : 0U;
+}
+
+uint16_t HostPwm_GetChannelCount(uint8_t instance, uint8_t channel)
+{
+    return (instance < PWM_INSTANCE_MAX && channel < PWM_CHANNEL_MAX) ? g_pwm[instance].ch_count[channel] : 0U;
+}
+
+uint32_t HostPwm_GetChannelDither(uint8_t instance, uint8_t dither_reg)
+{
+    return (instance < PWM_INSTANCE_MAX && dither_reg < HOST_PWM_DITHER_REG_COUNT) ? g_pwm[instance].ch_dither[dither_reg] : 0U;
+}
+
+uint32_t HostPwm_GetOverflowCount(uint8_t instance)
+{
+    return (instance < PWM_INSTANCE_MAX) ? g_pwm[instance].overflow_count : 0U;
+}
+
+/* ==================== PWM_DRV接口 ==================== */
+
+void PWM_DRV_SimplyInit(const uint8_t instance, const pwm_simply_config_t *config)
+{
+    host_pwm_t *pwm = &g_pwm[instance];
+
+    pwm->clk_psc = config->clkPsc;
+    pwm->max_count = config->maxValue;
+    pwm->max_count_dither = config->modDitherValue;
+    memcpy(pwm->ch_count, config->chValue, sizeof(pwm->ch_count));
+    pwm->overflow_callback = config->overflowCallback;
+    pwm->overflow_irq_en = config->overflowInterrupEn;
+    pwm->running = true;
+    pwm->next_overflow_ns = (double)HostClock_NowNs() + HostPwm_PeriodNs(pwm);
+    if (config->overflowInterrupEn) {
+        NVIC_EnableIRQ(g_pwm_overflow_irq[instance]);
+    } else {
+        NVIC_DisableIRQ(g_pwm_overflow_irq[instance]);
+    }
+}
+
+void PWM_DRV_InstallOverflowCallback(const uint8_t instance, const pwm_callback_t func)
+{
+    g_pwm[instance].overflow_callback = func;
+}
+
+void PWM_DRV_SetMaxCountValue(const uint8_t instance, uint16_t value)
+{
+    g_pwm[instance].max_count = value;
+}
+
+void PWM_DRV_SetMaxCountDitherValue(const uint8_t instance, uint8_t maxCountDitherValue)
+{
+    g_pwm[instance].max_count_dither = maxCountDitherValue;
+}
+
+void PWM_DRV_SetChannelCountValue(const uint8_t instance, pwm_channel_type_t channel, uint16_t value)
+{
+    if ((uint32_t)channel < PWM_CHANNEL_MAX) {
+        g_pwm[instance].ch_count[channel] = value;
+    }
+}
+
+void PWM_DRV_SetChannelCounterDitherValue(const uint8_t instance, uint8_t ditherRegNum, uint32_t channelDitherValue)
+{
+    if (ditherRegNum < HOST_PWM_DITHER_REG_COUNT) {
+        g_pwm[instance].ch_dither[ditherRegNum] = channelDitherValue;
+    }
+}
+
+void PWM_DRV_SetMatchTrigger(const uint8_t instance, pwm_channel_type_t channel, bool state)
+{
+    if ((uint32_t)channel < PWM_CHANNEL_MAX) {
+        g_pwm[instance].match_trigger[channel] = state;
+    }
+}
+
+void PWM_DRV_ClearFaultFlag(const uint8_t instance)
+{
+    (void)instance;
+}
+
+void PWM_DRV_ClearFaultChannelFlag(const uint8_t instance, pwm_fault_channel_type_t channel)
+{
+    (void)instance;
+    (void)channel;
+}
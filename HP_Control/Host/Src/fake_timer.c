@@ -0,0 +1,186 @@
+/*!
+ * @file fake_timer.c
+ *
+ * @brief PC端TIMER替身：周期计数通道与通道中断
+ *
+ * 说明：
+ * - 计数时钟为HOST_BUS_CLOCK_HZ，每(装载值+1)个计数产生一次超时
+ * - 运行中修改装载值在本周期结束后生效（与硬件一致，换向阀逐相预装依赖该行为）
+ * - 超时置中断标志并向NVIC替身请求中断；中断服务先清标志再调用通道回调，与驱动TIMER_DRV_IRQHandler一致
+ */
+
+#include "fake_internal.h"
+#include "timer_drv.h"
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define HOST_TIMER_MAX_COUNT              0xFFFFFFFFULL
+
+/* ===========================================  Typedef  ============================================ */
+
+typedef struct {
+    bool running;
+    bool irq_en;
+    uint32_t load;                            // 当前周期装载值
+    uint32_t next_load;                       // 下一周期装载值
+    uint64_t period_start_ns;                 // 当前周期起点
+    timer_callback_t callback;
+} host_timer_channel_t;
+
+/* ==========================================  Variables  =========================================== */
+
+static host_timer_channel_t g_timer[TIMER_CHANNEL_MAX];
+static uint32_t g_timer_flags = 0U;
+static const IRQn_Type g_timer_irq[TIMER_CHANNEL_MAX] = TIMER_IRQS;
+
+/* ==========================================  Functions  =========================================== */
+
+static uint64_t HostTimer_ExpiryNs(const host_timer_channel_t *ch)
+{
+    return ch->period_start_ns + (((uint64_t)ch->load + 1U) * 1000000000ULL) / HOST_BUS_CLOCK_HZ;
+}
+
+static void HostTimer_ChannelIsr(uint32_t channel)
+{
+    uint32_t mask = 1UL << channel;
+    uint32_t wpara = g_timer_flags & mask;
+
+    if (wpara != 0U) {
+        g_timer_flags &= ~mask;
+        if (g_timer[channel].callback != NULL) {
+            g_timer[channel].callback(NULL, wpara, 0U);
+        }
+    }
+}
+
+static void HostTimer0_Isr(void) { HostTimer_ChannelIsr(0U); }
+static void HostTimer1_Isr(void) { HostTimer_ChannelIsr(1U); }
+static void HostTimer2_Isr(void) { HostTimer_ChannelIsr(2U); }
+static void HostTimer3_Isr(void) { HostTimer_ChannelIsr(3U); }
+
+void HostTimer_Reset(void)
+{
+    static const host_isr_t isr[TIMER_CHANNEL_MAX] = {HostTimer0_Isr, HostTimer1_Isr, HostTimer2_Isr, HostTimer3_Isr};
+
+    memset(g_timer, 0, sizeof(g_timer));
+    g_timer_flags = 0U;
+    for (uint32_t i = 0U; i < TIMER_CHANNEL_MAX; i++) {
+        HostNvic_SetHandler(g_timer_irq[i], isr[i]);
+    }
+}
+
+uint64_t HostTimer_NextEventNs(void)
+{
+    uint64_t next = HOST_NO_EVENT;
+
+    for (uint32_t i = 0U; i < TIMER_CHANNEL_MAX; i++) {
+        if (g_timer[i].running) {
+            uint64_t t = HostTimer_ExpiryNs(&g_timer[i]);
+            if (t < next) {
+                next = t;
+            }
+        }
+    }
+    return next;
+}
+
+void HostTimer_Expire(uint64_t now_ns)
+{
+    for (uint32_t i = 0U; i < TIMER_CHANNEL_MAX; i++) {
+        host_timer_channel_t *ch = &g_timer[i];
+        while (ch->running && HostTimer_ExpiryNs(ch) <= now_ns) {
+            ch->period_start_ns = HostTimer_ExpiryNs(ch);
+            ch->load = ch->next_load;
+            if (ch->irq_en) {
+                g_timer_flags |= 1UL << i;
+                HostNvic_Raise(g_timer_irq[i]);
+            }
+        }
+    }
+}
+
+/* ==================== TIMER_DRV接口 ==================== */
+
+void TIMER_DRV_GetDefaultChanConfig(timer_user_channel_config_t *const config)
+{
+    memset(config, 0, sizeof(*config));
+    config->timerMode = TIMER_PERIODIC_COUNTER;
+    config->periodUnits = TIMER_PERIOD_UNITS_MICROSECONDS;
+    config->period = 1000000U;
+    config->triggerSource = TIMER_TRIGGER_SOURCE_EXTERNAL;
+    config->isInterruptEnabled = true;
+}
+
+void TIMER_DRV_Init(uint8_t instance, bool enableRunInDebug)
+{
+    (void)instance;
+    (void)enableRunInDebug;
+}
+
+void TIMER_DRV_SetPeriodByCount(uint8_t instance, uint32_t channel, uint32_t count)
+{
+    (void)instance;
+    if (channel >= TIMER_CHANNEL_MAX) {
+        return;
+    }
+    g_timer[channel].next_load = count;
+    if (!g_timer[channel].running) {
+        g_timer[channel].load = count;
+    }
+}
+
+status_t TIMER_DRV_InitChannel(uint8_t instance, uint32_t channel,
+                               const timer_user_channel_config_t *userChannelConfig)
+{
+    if (channel >= TIMER_CHANNEL_MAX || ((channel == 0U) && userChannelConfig->chainChannel)) {
+        return STATUS_ERROR;
+    }
+
+    if (userChannelConfig->periodUnits == TIMER_PERIOD_UNITS_MICROSECONDS) {
+        uint64_t count = ((uint64_t)userChannelConfig->period * HOST_BUS_CLOCK_HZ) / 1000000U;
+        if (count == 0U || count - 1U > HOST_TIMER_MAX_COUNT) {
+            return STATUS_ERROR;
+        }
+        TIMER_DRV_SetPeriodByCount(instance, channel, (uint32_t)(count - 1U));
+    } else {
+        TIMER_DRV_SetPeriodByCount(instance, channel, userChannelConfig->period);
+    }
+
+    g_timer[channel].callback = userChannelConfig->callback;
+    g_timer[channel].irq_en = userChannelConfig->isInterruptEnabled;
+    if (userChannelConfig->isInterruptEnabled) {
+        NVIC_EnableIRQ(g_timer_irq[channel]);
+    } else {
+        NVIC_DisableIRQ(g_timer_irq[channel]);
+    }
+    return STATUS_SUCCESS;
+}
+
+void TIMER_DRV_StartChannels(uint8_t instance, uint32_t mask)
+{
+    (void)instance;
+    for (uint32_t i = 0U; i < TIMER_CHANNEL_MAX; i++) {
+        if ((mask & (1UL << i)) != 0U && !g_timer[i].running) {
+            g_timer[i].running = true;
+            g_timer[i].load = g_timer[i].next_load;
+            g_timer[i].period_start_ns = HostClock_NowNs();
+        }
+    }
+}
+
+void TIMER_DRV_StopChannels(uint8_t instance, uint32_t mask)
+{
+    (void)instance;
+    for (uint32_t i = 0U; i < TIMER_CHANNEL_MAX; i++) {
+        if ((mask & (1UL << i)) != 0U) {
+            g_timer[i].running = false;
+        }
+    }
+}
+
+void TIMER_DRV_ClearInterruptFlag(uint8_t instance, uint32_t mask)
+{
+    (void)instance;
+    g_timer_flags &= ~mask;
+}
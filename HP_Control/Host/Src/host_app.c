@@ -0,0 +1,23 @@
+/*!
+ * @file host_app.c
+ *
+ * @brief PC端任务驱动：以虚拟时钟代替OptimizedTaskScheduler_MainLoop的休眠循环
+ */
+
+#include "host_app.h"
+#include "host_fake.h"
+#include "optimized_task_scheduler.h"
+
+/* ==========================================  Functions  =========================================== */
+
+void HostApp_RunMs(uint32_t ms)
+{
+    uint64_t end_ns = HostClock_NowNs() + (uint64_t)ms * 1000000U;
+
+    while (HostClock_NowNs() < end_ns) {
+        uint32_t next_task_time = UINT32_MAX;
+        if (!OptimizedTaskScheduler_Dispatch(HostClock_NowMs(), &next_task_time)) {
+            HostClock_AdvanceMs(1U);
+        }
+    }
+}
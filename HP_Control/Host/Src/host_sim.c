@@ -0,0 +1,125 @@
+/*!
+ * @file host_sim.c
+ *
+ * @brief PC端液压闭环仿真实现
+ *
+ * 说明：
+ * - 每1ms推进一次任务调度并按上位机周期重发控制命令，统计在每个1ms片结束时采样模型状态
+ * - 控制命令经gcu_control_pack打包后走CAN替身接收路径，覆盖DBC解包与CAN_RxCallback
+ */
+
+#include "host_sim.h"
+#include "host_app.h"
+#include "host_fake.h"
+#include "sensor.h"
+#include "valve_control.h"
+#include "pressure_control.h"
+#include "can_config.h"
+#include "gcu_control_dbc.h"
+#include <string.h>
+
+/* ==========================================  Variables  =========================================== */
+
+static host_sim_command_t g_sim_command;
+static bool g_sim_command_active = false;
+static uint32_t g_sim_command_elapsed_ms = 0U;
+static host_sim_stats_t g_sim_stats;
+
+/* ==========================================  Functions  =========================================== */
+
+static void HostSim_SendCommand(void)
+{
+    gcu_control_t msg;
+    uint8_t data[8];
+
+    memset(&msg, 0, sizeof(msg));
+    msg.ctrl_system_enable = g_sim_command.system_enable ? 1U : 0U;
+    msg.ctrl_reversal_valve_enable = g_sim_command.reversal_enable ? 1U : 0U;
+    msg.ctrl_reversal_valve_freq = g_sim_command.reversal_freq_hz;
+    msg.ctrl_cooler_enable = g_sim_command.cooler ? 1U : 0U;
+    msg.ctrl_bypass_valve_duty = gcu_control_ctrl_bypass_valve_duty_encode((double)g_sim_command.bypass_duty);
+    msg.ctrl_reserved = (uint32_t)g_sim_command.mode & PCTRL_CMD_MODE_MASK;
+    if (g_sim_command.mode == PCTRL_MODE_PRESSURE) {
+        uint32_t setpoint_raw = (uint32_t)(g_sim_command.setpoint_mpa / PCTRL_CMD_SETPOINT_SCALE + 0.5f);
+        msg.ctrl_reserved |= (setpoint_raw & PCTRL_CMD_SETPOINT_MASK) << PCTRL_CMD_SETPOINT_SHIFT;
+        msg.ctrl_reserved |= ((uint32_t)g_sim_command.min_duty & PCTRL_CMD_MIN_DUTY_MASK) << PCTRL_CMD_MIN_DUTY_SHIFT;
+    }
+
+    if (gcu_control_pack(data, &msg, sizeof(data)) > 0) {
+        (void)HostCan_Receive(CAN_MSG_GCU_CONTROL_ID, data, 8U, true);
+    }
+    g_sim_command_elapsed_ms = 0U;
+}
+
+static void HostSim_Sample(void)
+{
+    const plant_model_t *plant = Sensor_GetPlantModel();
+    float duty = ValveControl_GetBypassValveDuty();
+
+    if (plant->oil_pressure_mpa < g_sim_stats.oil_pressure_min) {
+        g_sim_stats.oil_pressure_min = plant->oil_pressure_mpa;
+    }
+    if (plant->oil_pressure_mpa > g_sim_stats.oil_pressure_max) {
+        g_sim_stats.oil_pressure_max = plant->oil_pressure_mpa;
+    }
+    if (duty > g_sim_stats.bypass_duty_max) {
+        g_sim_stats.bypass_duty_max = duty;
+    }
+}
+
+void HostSim_Start(void)
+{
+    // 模拟重新上电：CAN_Config_Init只初始化一次、压力采集流运行标志不随初始化清除，
+    // 替身复位前先注销/停止，其余模块由SystemStartup重新初始化
+    (void)CAN_Config_Deinit();
+    Sensor_StopPressureStream();
+    HostFake_Reset();
+    HostFlash_EraseAll();
+    memset(&g_sim_command, 0, sizeof(g_sim_command));
+    g_sim_command_active = false;
+    g_sim_command_elapsed_ms = 0U;
+    SystemStartup();
+    HostSim_ResetStats();
+}
+
+void HostSim_SetCommand(const host_sim_command_t *cmd)
+{
+    g_sim_command = *cmd;
+    g_sim_command_active = true;
+    HostSim_SendCommand();
+}
+
+void HostSim_StopCommands(void)
+{
+    g_sim_command_active = false;
+}
+
+void HostSim_RunMs(uint32_t ms)
+{
+    for (uint32_t i = 0U; i < ms; i++) {
+        HostApp_RunMs(1U);
+        HostSim_Sample();
+        if (g_sim_command_active && ++g_sim_command_elapsed_ms >= HOST_SIM_COMMAND_PERIOD_MS) {
+            HostSim_SendCommand();
+        }
+    }
+}
+
+plant_model_t* HostSim_Plant(void)
+{
+    return Sensor_GetPlantModel();
+}
+
+void HostSim_ResetStats(void)
+{
+    const plant_model_t *plant = Sensor_GetPlantModel();
+
+    g_sim_stats.oil_pressure_min = plant->oil_pressure_mpa;
+    g_sim_stats.oil_pressure_max = plant->oil_pressure_mpa;
+    g_sim_stats.bypass_duty_max = ValveControl_GetBypassValveDuty();
+}
+
+const host_sim_stats_t* HostSim_GetStats(void)
+{
+    return &g_sim_stats;
+}
@@ -0,0 +1,46 @@
+/*!
+ * @file host_test.h
+ * @brief PC端测试断言（每个测试程序一个main，失败计数非零时返回1）
+ *
+ * App层的printf输出到标准输出（make test重定向到日志），断言失败与汇总输出到标准错误
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <math.h>
+
+static int g_ht_checks = 0;
+static int g_ht_failures = 0;
+
+#define HT_CHECK(cond) do { \
+    g_ht_checks++; \
+    if (!(cond)) { \
+        g_ht_failures++; \
+        fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+#define HT_CHECK_NEAR(a, b, tol) do { \
+    double ht_a_ = (double)(a); \
+    double ht_b_ = (double)(b); \
+    g_ht_checks++; \
+    if (!(fabs(ht_a_ - ht_b_) <= (double)(tol))) { \
+        g_ht_failures++; \
+        fprintf(stderr, "%s:%d: CHECK_NEAR failed: %s=%g %s=%g tol=%g\n", \
+                __FILE__, __LINE__, #a, ht_a_, #b, ht_b_, (double)(tol)); \
+    } \
+} while (0)
+
+#define HT_RUN(fn) do { \
+    int ht_before_ = g_ht_failures; \
+    fn(); \
+    fprintf(stderr, "  %-40s %s\n", #fn, (g_ht_failures == ht_before_) ? "ok" : "FAILED"); \
+} while (0)
+
+#define HT_RESULT(name) \
+    (fprintf(stderr, "%s: %d checks, %d failures\n", (name), g_ht_checks, g_ht_failures), \
+     (g_ht_failures == 0) ? 0 : 1)
+
+#endif /* HOST_TEST_H */
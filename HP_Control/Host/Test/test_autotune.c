@@ -0,0 +1,296 @@
+/*!
+ * @file test_autotune.c
+ *
+ * @brief 继电器自整定回归测试：整机固件 + 液压对象模型，经CAN参数帧启动/中止/保存整定
+ */
+
+#include "host_test.h"
+#include "host_sim.h"
+#include "host_fake.h"
+#include "host_app.h"
+#include "calib_store.h"
+#include "can_config.h"
+#include "pressure_control.h"
+#include "valve_control.h"
+#include "common_types.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define TEST_SETPOINT_MPA                 10.0f
+#define TEST_RELAY_AMPLITUDE              50U         // 继电器幅值 5.0%
+#define TEST_RELAY_HYSTERESIS             5U          // 滞环 0.05MPa
+#define TEST_RELAY_DEVIATION              20U         // 允许偏差 2.0MPa
+
+/* ==========================================  Functions  =========================================== */
+
+static void Test_SendParam(const uint8_t *data)
+{
+    HT_CHECK(HostCan_Receive(CAN_MSG_PARAM_SET_ID, data, 8U, true));
+}
+
+static void Test_SendTuneStart(uint8_t rule, uint8_t bias, uint8_t amplitude, uint8_t deviation)
+{
+    uint8_t data[8] = { PCTRL_CMD_TUNE_START, rule, bias, amplitude, TEST_RELAY_HYSTERESIS, deviation, 0U, 0U };
+    Test_SendParam(data);
+}
+
+static void Test_SendTuneCmd(uint8_t cmd)
+{
+    uint8_t data[8] = { cmd, 0U, 0U, 0U, 0U, 0U, 0U, 0U };
+    Test_SendParam(data);
+}
+
+/*!
+ * @brief 取最近一帧应答并检查命令字与结果码
+ */
+static bool Test_LastAck(uint8_t cmd, uint8_t result, host_can_frame_t *frame)
+{
+    if (!HostCan_FindLastTx(CAN_MSG_PARAM_ACK_ID, frame)) {
+        return false;
+    }
+    return frame->extended && frame->length == 8U && frame->data[0] == cmd && frame->data[1] == result;
+}
+
+/*!
+ * @brief 上电后进入10MPa本地压力闭环并稳定
+ */
+static host_sim_command_t Test_StartPressureLoop(void)
+{
+    host_sim_command_t cmd;
+
+    HostSim_Start();
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.system_enable = true;
+    cmd.bypass_duty = 50.0f;
+    cmd.mode = PCTRL_MODE_OPEN_LOOP;
+    HostSim_SetCommand(&cmd);
+    HostSim_RunMs(2000U);
+
+    cmd.mode = PCTRL_MODE_PRESSURE;
+    cmd.setpoint_mpa = TEST_SETPOINT_MPA;
+    cmd.bypass_duty = 100.0f;
+    cmd.min_duty = 0U;
+    HostSim_SetCommand(&cmd);
+    HostSim_RunMs(3000U);
+    return cmd;
+}
+
+/*!
+ * @brief 运行直到试验结束，返回用时(ms)；超过limit_ms仍未结束返回limit_ms
+ * 试验期间的旁通阀开度范围写入duty_min/duty_max
+ */
+static uint32_t Test_RunUntilTuneEnd(uint32_t limit_ms, float *duty_min, float *duty_max)
+{
+    uint32_t elapsed = 0U;
+
+    *duty_min = ValveControl_GetBypassValveDuty();
+    *duty_max = *duty_min;
+    while (elapsed < limit_ms && PressureControl_GetTuneResult()->state == PLATFORM_TUNE_RUNNING) {
+        float duty = ValveControl_GetBypassValveDuty();
+        if (duty < *duty_min) *duty_min = duty;
+        if (duty > *duty_max) *duty_max = duty;
+        HostSim_RunMs(1U);
+        elapsed++;
+    }
+    // 结束通知由后台任务发送
+    HostSim_RunMs(20U);
+    return elapsed;
+}
+
+static void Test_RelayTune(void)
+{
+    host_can_frame_t frame;
+    pressure_control_status_t status;
+    platform_gain_set_t gains;
+
+    host_sim_command_t cmd = Test_StartPressureLoop();
+    HT_CHECK(PressureControl_IsRunning());
+    HT_CHECK_NEAR(HostSim_Plant()->oil_pressure_mpa, TEST_SETPOINT_MPA, 0.2);
+
+    // 尚未整定时无结果可保存
+    Test_SendTuneCmd(PCTRL_CMD_TUNE_STORE);
+    HostSim_RunMs(20U);
+    HT_CHECK(Test_LastAck(PCTRL_CMD_TUNE_STORE, PCTRL_RESULT_NO_RESULT, &frame));
+
+    // 继电器上下限超出开度范围时拒绝
+    Test_SendTuneStart((uint8_t)PLATFORM_TUNE_RULE_TYREUS_LUYBEN_PI, 45U, 100U, TEST_RELAY_DEVIATION);
+    HostSim_RunMs(20U);
+    HT_CHECK(Test_LastAck(PCTRL_CMD_TUNE_START, PCTRL_RESULT_BAD_PARAM, &frame));
+    HT_CHECK(PressureControl_GetTuneResult()->state != PLATFORM_TUNE_RUNNING);
+
+    // 以当前开度为偏置启动试验
+    Test_SendTuneStart((uint8_t)PLATFORM_TUNE_RULE_TYREUS_LUYBEN_PI, PCTRL_TUNE_BIAS_CURRENT,
+                       TEST_RELAY_AMPLITUDE, TEST_RELAY_DEVIATION);
+    HostSim_RunMs(20U);
+    HT_CHECK(Test_LastAck(PCTRL_CMD_TUNE_START, PCTRL_RESULT_OK, &frame));
+    HT_CHECK(PressureControl_GetTuneResult()->state == PLATFORM_TUNE_RUNNING);
+
+    // 试验中再次启动返回忙
+    Test_SendTuneStart((uint8_t)PLATFORM_TUNE_RULE_TYREUS_LUYBEN_PI, PCTRL_TUNE_BIAS_CURRENT,
+                       TEST_RELAY_AMPLITUDE, TEST_RELAY_DEVIATION);
+    HostSim_RunMs(20U);
+    HT_CHECK(Test_LastAck(PCTRL_CMD_TUNE_START, PCTRL_RESULT_BUSY, &frame));
+
+    // 试验期间开度只在继电器两档之间切换，油压在设定值附近等幅振荡
+    HostSim_ResetStats();
+    float duty_min;
+    float duty_max;
+    uint32_t elapsed = Test_RunUntilTuneEnd(20000U, &duty_min, &duty_max);
+    const platform_relay_tune_t *tune = PressureControl_GetTuneResult();
+    printf("relay tune: %u ms, ku=%.3f %%/MPa, tu=%.4f s, kp=%.3f, ki=%.3f, ff=%.2f, p=[%.3f, %.3f]\n",
+           (unsigned)elapsed, (double)tune->ku, (double)tune->tu, (double)tune->gains.kp,
+           (double)tune->gains.ki, (double)tune->gains.feedforward,
+           (double)HostSim_GetStats()->oil_pressure_min, (double)HostSim_GetStats()->oil_pressure_max);
+    HT_CHECK(tune->state == PLATFORM_TUNE_DONE);
+    HT_CHECK(tune->cycles >= PCTRL_TUNE_SETTLE_CYCLES + PCTRL_TUNE_MEASURE_CYCLES);
+    HT_CHECK_NEAR(duty_min, tune->config.bias - tune->config.amplitude, 0.01);
+    HT_CHECK_NEAR(duty_max, tune->config.bias + tune->config.amplitude, 0.01);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_min > TEST_SETPOINT_MPA - TEST_RELAY_DEVIATION * 0.1f);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_max < TEST_SETPOINT_MPA + TEST_RELAY_DEVIATION * 0.1f);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_max - HostSim_GetStats()->oil_pressure_min > 0.1f);
+
+    // 结果合理：Ku/Tu为正，PI规则无微分项，前馈取继电器偏置
+    HT_CHECK(tune->ku > 0.0f);
+    HT_CHECK(tune->tu > 0.0f && tune->tu < 1.0f);
+    HT_CHECK(tune->gains.kp > 0.0f && tune->gains.kp < tune->ku);
+    HT_CHECK(tune->gains.ki > 0.0f);
+    HT_CHECK(tune->gains.kd == 0.0f);
+    HT_CHECK_NEAR(tune->gains.feedforward, tune->config.bias, 1.0);
+
+    // 结束通知：携带Ku(0.01%/MPa)与Tu(ms)
+    HT_CHECK(Test_LastAck(PCTRL_CMD_TUNE_STATUS, PCTRL_RESULT_OK, &frame));
+    HT_CHECK(frame.data[2] == (uint8_t)PLATFORM_TUNE_DONE);
+    HT_CHECK_NEAR((double)(frame.data[4] | (frame.data[5] << 8)), tune->ku * 100.0, 1.0);
+    HT_CHECK_NEAR((double)(frame.data[6] | (frame.data[7] << 8)), tune->tu * 1000.0, 1.0);
+
+    // 试验结束后无扰切回PID，油压回到设定值
+    HostSim_RunMs(3000U);
+    HT_CHECK(PressureControl_IsRunning());
+    HT_CHECK_NEAR(HostSim_Plant()->oil_pressure_mpa, TEST_SETPOINT_MPA, 0.2);
+
+    // 保存到调度表：建立1×1表，调度周期内切换到整定参数，闭环仍收敛
+    HT_CHECK(!CalibStore_LookupGains(40.0f, TEST_SETPOINT_MPA, &gains));
+    Test_SendTuneCmd(PCTRL_CMD_TUNE_STORE);
+    HostSim_RunMs(20U);
+    HT_CHECK(Test_LastAck(PCTRL_CMD_TUNE_STORE, PCTRL_RESULT_OK, &frame));
+    HT_CHECK(CalibStore_LookupGains(40.0f, TEST_SETPOINT_MPA, &gains));
+    HT_CHECK(gains.kp == tune->gains.kp);
+    HT_CHECK(gains.ki == tune->gains.ki);
+
+    // 切换参数（含前馈）无扰：油压不因调度切换而波动
+    HostSim_ResetStats();
+    HostSim_RunMs(1000U);
+    PressureControl_GetStatus(&status);
+    HT_CHECK(status.kp == tune->gains.kp);
+    HT_CHECK(status.ki == tune->gains.ki);
+    HT_CHECK(status.feedforward == tune->gains.feedforward);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_min > TEST_SETPOINT_MPA - 0.1f);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_max < TEST_SETPOINT_MPA + 0.1f);
+
+    // 整定参数下设定值阶跃：超调受限，1s内稳定无持续振荡
+    cmd.setpoint_mpa = 12.0f;
+    HostSim_SetCommand(&cmd);
+    HostSim_ResetStats();
+    HostSim_RunMs(1000U);
+    printf("tuned step: p=[%.3f, %.3f]\n", (double)HostSim_GetStats()->oil_pressure_min,
+           (double)HostSim_GetStats()->oil_pressure_max);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_max < 13.0f);
+    HostSim_ResetStats();
+    HostSim_RunMs(1000U);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_min > 11.9f);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_max < 12.1f);
+}
+
+static void Test_TuneRules(void)
+{
+    platform_gain_set_t pi = { 0 };
+    float ku = 0.0f;
+    float tu = 0.0f;
+    float duty_min;
+    float duty_max;
+
+    // 同一对象不同规则：Ku/Tu一致，Z-N PI比Tyreus-Luyben更激进，Z-N PID带微分
+    for (uint8_t rule = (uint8_t)PLATFORM_TUNE_RULE_TYREUS_LUYBEN_PI; rule <= (uint8_t)PLATFORM_TUNE_RULE_ZN_PID; rule++) {
+        Test_StartPressureLoop();
+        Test_SendTuneStart(rule, PCTRL_TUNE_BIAS_CURRENT, TEST_RELAY_AMPLITUDE, TEST_RELAY_DEVIATION);
+        HostSim_RunMs(20U);
+        (void)Test_RunUntilTuneEnd(20000U, &duty_min, &duty_max);
+
+        const platform_relay_tune_t *tune = PressureControl_GetTuneResult();
+        HT_CHECK(tune->state == PLATFORM_TUNE_DONE);
+        if (rule == (uint8_t)PLATFORM_TUNE_RULE_TYREUS_LUYBEN_PI) {
+            pi = tune->gains;
+            ku = tune->ku;
+            tu = tune->tu;
+            continue;
+        }
+        HT_CHECK_NEAR(tune->ku, ku, ku * 0.1);
+        HT_CHECK_NEAR(tune->tu, tu, tu * 0.1);
+        if (rule == (uint8_t)PLATFORM_TUNE_RULE_ZN_PI) {
+            HT_CHECK(tune->gains.kp > pi.kp);
+            HT_CHECK(tune->gains.kd == 0.0f);
+        } else {
+            HT_CHECK(tune->gains.kd > 0.0f);
+        }
+    }
+}
+
+static void Test_TuneAbort(void)
+{
+    host_can_frame_t frame;
+    float duty_min;
+    float duty_max;
+
+    // 上位机中止：立即退出继电器输出，闭环继续
+    host_sim_command_t cmd = Test_StartPressureLoop();
+    Test_SendTuneStart((uint8_t)PLATFORM_TUNE_RULE_TYREUS_LUYBEN_PI, PCTRL_TUNE_BIAS_CURRENT,
+                       TEST_RELAY_AMPLITUDE, TEST_RELAY_DEVIATION);
+    HostSim_RunMs(20U);
+    HT_CHECK(PressureControl_GetTuneResult()->state == PLATFORM_TUNE_RUNNING);
+    Test_SendTuneCmd(PCTRL_CMD_TUNE_ABORT);
+    HostSim_RunMs(20U);
+    HT_CHECK(PressureControl_GetTuneResult()->state == PLATFORM_TUNE_FAILED);
+    HT_CHECK(Test_LastAck(PCTRL_CMD_TUNE_ABORT, PCTRL_RESULT_OK, &frame));
+    HT_CHECK(frame.data[2] == (uint8_t)PLATFORM_TUNE_FAILED);
+    HostSim_RunMs(3000U);
+    HT_CHECK(PressureControl_IsRunning());
+    HT_CHECK_NEAR(HostSim_Plant()->oil_pressure_mpa, TEST_SETPOINT_MPA, 0.2);
+
+    // 失败结果不能保存
+    Test_SendTuneCmd(PCTRL_CMD_TUNE_STORE);
+    HostSim_RunMs(20U);
+    HT_CHECK(Test_LastAck(PCTRL_CMD_TUNE_STORE, PCTRL_RESULT_NO_RESULT, &frame));
+
+    // 允许偏差过小：油压越界，试验失败并切回PID
+    Test_SendTuneStart((uint8_t)PLATFORM_TUNE_RULE_TYREUS_LUYBEN_PI, PCTRL_TUNE_BIAS_CURRENT,
+                       TEST_RELAY_AMPLITUDE, 1U);
+    HostSim_RunMs(20U);
+    (void)Test_RunUntilTuneEnd(20000U, &duty_min, &duty_max);
+    HT_CHECK(PressureControl_GetTuneResult()->state == PLATFORM_TUNE_FAILED);
+    HT_CHECK(Test_LastAck(PCTRL_CMD_TUNE_STATUS, PCTRL_RESULT_NO_RESULT, &frame));
+    HostSim_RunMs(3000U);
+    HT_CHECK(PressureControl_IsRunning());
+    HT_CHECK_NEAR(HostSim_Plant()->oil_pressure_mpa, TEST_SETPOINT_MPA, 0.2);
+
+    // 上位机关闭系统：闭环停止，试验随之中止并发送结束通知
+    Test_SendTuneStart((uint8_t)PLATFORM_TUNE_RULE_TYREUS_LUYBEN_PI, PCTRL_TUNE_BIAS_CURRENT,
+                       TEST_RELAY_AMPLITUDE, TEST_RELAY_DEVIATION);
+    HostSim_RunMs(20U);
+    HT_CHECK(PressureControl_GetTuneResult()->state == PLATFORM_TUNE_RUNNING);
+    cmd.system_enable = false;
+    HostSim_SetCommand(&cmd);
+    HostSim_RunMs(20U);
+    HT_CHECK(!PressureControl_IsRunning());
+    HT_CHECK(PressureControl_GetTuneResult()->state == PLATFORM_TUNE_FAILED);
+    HT_CHECK(Test_LastAck(PCTRL_CMD_TUNE_STATUS, PCTRL_RESULT_NO_RESULT, &frame));
+}
+
+int main(void)
+{
+    HT_RUN(Test_RelayTune);
+    HT_RUN(Test_TuneRules);
+    HT_RUN(Test_TuneAbort);
+    return HT_RESULT("test_autotune");
+}
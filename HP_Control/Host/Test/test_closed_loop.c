@@ -0,0 +1,199 @@
+/*!
+ * @file test_closed_loop.c
+ *
+ * @brief 液压闭环回归测试：整机固件 + 对象模型，按上位机CAN命令运行典型工况
+ */
+
+#include "host_test.h"
+#include "host_sim.h"
+#include "host_app.h"
+#include "sensor.h"
+#include "valve_control.h"
+#include "pressure_control.h"
+#include "common_types.h"
+#include "host_fake.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* ==========================================  Functions  =========================================== */
+
+static host_sim_command_t Test_OpenLoop(float bypass_duty)
+{
+    host_sim_command_t cmd;
+
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.system_enable = true;
+    cmd.bypass_duty = bypass_duty;
+    cmd.mode = PCTRL_MODE_OPEN_LOOP;
+    return cmd;
+}
+
+static void Test_OpenLoopEquilibrium(void)
+{
+    HostSim_Start();
+
+    // 旁通阀全关：泵流量经溢流阀回油，油压稳定在溢流阀开启压力附近
+    host_sim_command_t cmd = Test_OpenLoop(0.0f);
+    HostSim_SetCommand(&cmd);
+    HostSim_RunMs(3000U);
+    HT_CHECK(g_systemEnabled);
+    HT_CHECK(HostSim_Plant()->oil_pressure_mpa > HostSim_Plant()->params.relief_crack_mpa);
+    HT_CHECK(HostSim_Plant()->oil_pressure_mpa < HostSim_Plant()->params.relief_crack_mpa + 2.0f);
+    HT_CHECK_NEAR(Sensor_GetOilPressure(), HostSim_Plant()->oil_pressure_mpa, 0.1);
+
+    // 旁通阀50%：泵流量大部分经旁通阀回油
+    cmd = Test_OpenLoop(50.0f);
+    HostSim_SetCommand(&cmd);
+    HostSim_RunMs(2000U);
+    HT_CHECK_NEAR(ValveControl_GetBypassValveDuty(), 50.0, 0.1);
+    HT_CHECK_NEAR(HostSim_Plant()->oil_pressure_mpa, 3.0, 0.5);
+    HT_CHECK_NEAR(Sensor_GetOilPressure(), HostSim_Plant()->oil_pressure_mpa, 0.1);
+}
+
+static void Test_PressureLoop(void)
+{
+    HostSim_Start();
+    host_sim_command_t cmd = Test_OpenLoop(50.0f);
+    HostSim_SetCommand(&cmd);
+    HostSim_RunMs(2000U);
+
+    // 本地压力闭环：10MPa设定值，3s内收敛，稳态偏差小于0.2MPa且无超调过大
+    cmd.mode = PCTRL_MODE_PRESSURE;
+    cmd.setpoint_mpa = 10.0f;
+    cmd.bypass_duty = 100.0f;
+    cmd.min_duty = 0U;
+    HostSim_SetCommand(&cmd);
+    HostSim_ResetStats();
+    HostSim_RunMs(3000U);
+    HT_CHECK(PressureControl_IsRunning());
+    HT_CHECK_NEAR(HostSim_Plant()->oil_pressure_mpa, 10.0, 0.2);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_max < 10.5f);
+
+    HostSim_ResetStats();
+    HostSim_RunMs(2000U);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_min > 9.8f);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_max < 10.2f);
+
+    // 回到开环：闭环停止，开度回到上位机给定值
+    cmd = Test_OpenLoop(50.0f);
+    HostSim_SetCommand(&cmd);
+    HostSim_RunMs(500U);
+    HT_CHECK(!PressureControl_IsRunning());
+    HT_CHECK_NEAR(ValveControl_GetBypassValveDuty(), 50.0, 0.1);
+}
+
+static void Test_OverpressureProtection(void)
+{
+    HostSim_Start();
+
+    // 溢流阀失效（开启压力高于超压阈值），上位机持续给定旁通阀全关：
+    // 安全任务按预测超压把旁通阀开到上限并关闭换向阀，油压始终低于超压阈值
+    HostSim_Plant()->params.relief_crack_mpa = 60.0f;
+    host_sim_command_t cmd = Test_OpenLoop(0.0f);
+    HostSim_SetCommand(&cmd);
+    HostSim_RunMs(3000U);
+    HT_CHECK_NEAR(HostSim_GetStats()->bypass_duty_max, BYPASS_VALVE_MAX_DUTY, 0.1);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_max < 45.0f);
+    HT_CHECK(ValveControl_GetDirectionalValveState() == VALVE_STATE_OFF);
+
+    // 对照：溢流阀正常时同样工况不触发保护
+    HostSim_Start();
+    HostSim_SetCommand(&cmd);
+    HostSim_RunMs(3000U);
+    HT_CHECK(HostSim_GetStats()->bypass_duty_max < 0.1f);
+}
+
+static void Test_CommandTimeout(void)
+{
+    HostSim_Start();
+    host_sim_command_t cmd = Test_OpenLoop(30.0f);
+    cmd.reversal_enable = true;
+    HostSim_SetCommand(&cmd);
+    HostSim_RunMs(1000U);
+    HT_CHECK_NEAR(ValveControl_GetBypassValveDuty(), 30.0, 0.1);
+    HT_CHECK(ValveControl_GetDirectionalValveState() == VALVE_STATE_ON);
+
+    // 上位机停止下发：超时(1s)后的首个安全检查周期关闭旁通阀、换向阀断电
+    HostSim_StopCommands();
+    HostSim_RunMs(900U);
+    HT_CHECK_NEAR(ValveControl_GetBypassValveDuty(), 30.0, 0.1);
+    HT_CHECK(ValveControl_GetDirectionalValveState() == VALVE_STATE_ON);
+    HostSim_RunMs(160U);
+    HT_CHECK_NEAR(ValveControl_GetBypassValveDuty(), 0.0, 0.1);
+    HT_CHECK(ValveControl_GetDirectionalValveState() == VALVE_STATE_OFF);
+
+    // 旁通阀关闭后油压上升，超压保护接管，换向阀保持断电
+    HostSim_ResetStats();
+    HostSim_RunMs(2000U);
+    HT_CHECK(HostSim_GetStats()->oil_pressure_max < 45.0f);
+    HT_CHECK(ValveControl_GetDirectionalValveState() == VALVE_STATE_OFF);
+}
+
+static void Test_SteadySensor(void)
+{
+    HostSim_Start();
+    host_sim_command_t cmd = Test_OpenLoop(30.0f);
+    cmd.reversal_enable = true;
+    HostSim_SetCommand(&cmd);
+
+    // 模型码值无噪声：LNG温度恒定超过卡滞窗口，卡滞位可诊断但不使通道无效，阀门保持
+    HostSim_RunMs(SENSOR_PLAUS_STUCK_WINDOW_MS + 2000U);
+    HT_CHECK((Sensor_GetPlausibilityFaults(ADC_CHANNEL_LNG_TEMP) & SENSOR_PLAUS_STUCK) != 0U);
+    HT_CHECK(Sensor_CheckDataValidity());
+    HT_CHECK(g_systemEnabled);
+    HT_CHECK_NEAR(ValveControl_GetBypassValveDuty(), 30.0, 0.1);
+    HT_CHECK(ValveControl_GetDirectionalValveState() == VALVE_STATE_ON);
+
+    // 码值恒定时8点平均电压等于当次码值换算的电压
+    uint16_t code = Sensor_GetPlausibilityState(ADC_CHANNEL_LNG_TEMP)->last_code;
+    HT_CHECK_NEAR(Sensor_GetAveragedVoltage(ADC_CHANNEL_LNG_TEMP), Sensor_ConvertAdcToVoltage(code), 1e-4);
+}
+
+static void Test_PlantSampleIrqState(void)
+{
+    const IRQn_Type irq = (IRQn_Type)((uint32_t)TIMER_CHANNEL0_IRQn + SENSOR_STREAM_TIMER_CHANNEL);
+    uint16_t raw[ADC_CHANNEL_COUNT];
+
+    // 模型采样期间屏蔽采集流中断，结束后恢复进入前的使能状态
+    HostSim_Start();
+    NVIC_DisableIRQ(irq);
+    HostClock_AdvanceMs(5U);
+    Sensor_GetAllADCValues(raw);
+    HT_CHECK(NVIC_GetEnableIRQ(irq) == 0U);
+
+    NVIC_EnableIRQ(irq);
+    HostClock_AdvanceMs(5U);
+    Sensor_GetAllADCValues(raw);
+    HT_CHECK(NVIC_GetEnableIRQ(irq) != 0U);
+}
+
+static void Test_FasterThanRealTime(void)
+{
+    struct timespec t0;
+    struct timespec t1;
+
+    HostSim_Start();
+    host_sim_command_t cmd = Test_OpenLoop(50.0f);
+    HostSim_SetCommand(&cmd);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    HostSim_RunMs(10000U);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    double wall_s = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    fprintf(stderr, "  10s simulated in %.3fs wall (%.0fx)\n", wall_s, 10.0 / wall_s);
+    HT_CHECK(wall_s < 10.0 / 20.0);
+}
+
+int main(void)
+{
+    HT_RUN(Test_OpenLoopEquilibrium);
+    HT_RUN(Test_PressureLoop);
+    HT_RUN(Test_OverpressureProtection);
+    HT_RUN(Test_CommandTimeout);
+    HT_RUN(Test_SteadySensor);
+    HT_RUN(Test_PlantSampleIrqState);
+    HT_RUN(Test_FasterThanRealTime);
+    return HT_RESULT("test_closed_loop");
+}
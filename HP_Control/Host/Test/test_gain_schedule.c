@@ -0,0 +1,313 @@
+/*!
+ * @file test_gain_schedule.c
+ *
+ * @brief 增益调度测试：调度表查表与双线性插值参考对比、区间缓存、运行中重新整定无跳变、
+ *        调度表随标定镜像CAN上传/DFlash保存/上电加载、v2镜像升级
+ */
+
+#include "host_test.h"
+#include "host_fake.h"
+#include "common_types.h"
+#include "calib_store.h"
+#include "flash_drv.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* ==========================================  Variables  =========================================== */
+
+static uint32_t g_rand_state = 77U;
+
+/* ==========================================  Functions  =========================================== */
+
+static float Test_Rand(float lo, float hi)
+{
+    g_rand_state = g_rand_state * 1664525U + 1013904223U;
+    return lo + (hi - lo) * (float)(g_rand_state >> 8) * (1.0f / 16777216.0f);
+}
+
+// 参考实现：线性搜索区间 + 双精度双线性插值，超出范围按边界钳位
+static double Ref_Locate(const float *points, uint8_t count, float value, uint8_t *segment)
+{
+    uint8_t seg = 0U;
+
+    if (count < 2U) {
+        *segment = 0U;
+        return 0.0;
+    }
+    while (seg + 2U < count && value >= points[seg + 1U]) {
+        seg++;
+    }
+    *segment = seg;
+    double frac = ((double)value - points[seg]) / ((double)points[seg + 1U] - points[seg]);
+    return (frac < 0.0) ? 0.0 : ((frac > 1.0) ? 1.0 : frac);
+}
+
+static double Ref_Lookup(const float *x_points, uint8_t x_count, const float *y_points, uint8_t y_count,
+                         const platform_gain_set_t *table, uint8_t stride, float x, float y)
+{
+    uint8_t ix;
+    uint8_t iy;
+    double fx = Ref_Locate(x_points, x_count, x, &ix);
+    double fy = Ref_Locate(y_points, y_count, y, &iy);
+    uint8_t ix1 = (x_count > 1U) ? ix + 1U : ix;
+    uint8_t iy1 = (y_count > 1U) ? iy + 1U : iy;
+    double v00 = table[ix * stride + iy].kp;
+    double v01 = table[ix * stride + iy1].kp;
+    double v10 = table[ix1 * stride + iy].kp;
+    double v11 = table[ix1 * stride + iy1].kp;
+
+    return (v00 * (1.0 - fy) + v01 * fy) * (1.0 - fx) + (v10 * (1.0 - fy) + v11 * fy) * fx;
+}
+
+static void Test_AxisValidation(void)
+{
+    platform_sched_axis_t axis;
+    static const float increasing[] = { -40.0f, 0.0f, 90.0f };
+    static const float repeated[] = { -40.0f, 0.0f, 0.0f };
+    static const float decreasing[] = { 90.0f, 0.0f };
+
+    HT_CHECK(PlatformSchedule_AxisInit(&axis, increasing, 3U) == PLATFORM_STATUS_OK);
+    HT_CHECK(PlatformSchedule_AxisInit(&axis, repeated, 3U) == PLATFORM_STATUS_INVALID_PARAM);
+    HT_CHECK(PlatformSchedule_AxisInit(&axis, decreasing, 2U) == PLATFORM_STATUS_INVALID_PARAM);
+    HT_CHECK(PlatformSchedule_AxisInit(&axis, increasing, 0U) == PLATFORM_STATUS_INVALID_PARAM);
+    HT_CHECK(PlatformSchedule_AxisInit(&axis, increasing, PLATFORM_SCHED_MAX_POINTS + 1U) == PLATFORM_STATUS_INVALID_PARAM);
+    HT_CHECK(PlatformSchedule_AxisInit(&axis, increasing, 1U) == PLATFORM_STATUS_OK);
+    HT_CHECK(PlatformSchedule_AxisLocate(&axis, 50.0f) == 0.0f);
+}
+
+static void Test_LookupMatchesReference(void)
+{
+    static const float temps[] = { -40.0f, -10.0f, 20.0f, 50.0f, 90.0f };
+    static const float pressures[] = { 5.0f, 10.0f, 20.0f };
+    platform_gain_set_t table[5 * 4];
+    platform_gain_schedule_t sched;
+    platform_gain_set_t gains;
+    int mismatches = 0;
+
+    for (uint32_t i = 0U; i < 5U * 4U; i++) {
+        table[i].kp = Test_Rand(0.5f, 5.0f);
+        table[i].ki = table[i].kp * 4.0f;
+        table[i].kd = 0.0f;
+        table[i].feedforward = Test_Rand(10.0f, 40.0f);
+    }
+
+    // 二维表（行跨度4大于压力断点数3）：随机跳变与缓慢扫描两种访问模式，含超出范围
+    HT_CHECK(PlatformSchedule_Init(&sched, temps, 5U, pressures, 3U, table, 4U) == PLATFORM_STATUS_OK);
+    for (uint32_t n = 0U; n < 20000U; n++) {
+        float x = (n < 10000U) ? Test_Rand(-60.0f, 110.0f) : -60.0f + 170.0f * (float)(n - 10000U) / 10000.0f;
+        float y = (n < 10000U) ? Test_Rand(0.0f, 30.0f) : 15.0f + 14.0f * ((n & 1024U) ? 1.0f : -1.0f) * 0.5f;
+        PlatformSchedule_Lookup(&sched, x, y, &gains);
+        double ref = Ref_Lookup(temps, 5U, pressures, 3U, table, 4U, x, y);
+        mismatches += (fabs((double)gains.kp - ref) > 1e-4);
+        mismatches += (fabs((double)gains.ki - 4.0 * ref) > 4e-4);
+    }
+    HT_CHECK(mismatches == 0);
+
+    // 节点处精确等于表值，区间缓存指向所在区间
+    PlatformSchedule_Lookup(&sched, 20.0f, 10.0f, &gains);
+    HT_CHECK(gains.kp == table[2 * 4 + 1].kp);
+    HT_CHECK(gains.feedforward == table[2 * 4 + 1].feedforward);
+    HT_CHECK(sched.axis_x.segment == 2U && sched.axis_y.segment == 1U);
+    PlatformSchedule_Lookup(&sched, 1000.0f, -1000.0f, &gains);
+    HT_CHECK(gains.kp == table[4 * 4 + 0].kp);
+
+    // 一维表：压力轴单点
+    mismatches = 0;
+    HT_CHECK(PlatformSchedule_Init(&sched, temps, 5U, pressures, 1U, table, 4U) == PLATFORM_STATUS_OK);
+    for (uint32_t n = 0U; n < 2000U; n++) {
+        float x = Test_Rand(-60.0f, 110.0f);
+        PlatformSchedule_Lookup(&sched, x, Test_Rand(0.0f, 30.0f), &gains);
+        mismatches += (fabs((double)gains.kp - Ref_Lookup(temps, 5U, pressures, 1U, table, 4U, x, 0.0f)) > 1e-4);
+    }
+    HT_CHECK(mismatches == 0);
+}
+
+static void Test_RetuneContinuity(void)
+{
+    platform_pid_config_t config;
+    platform_pidf_t pid;
+    platform_pidf_t reference;
+    float y = 0.0f;
+
+    memset(&config, 0, sizeof(config));
+    config.kp = 2.0f;
+    config.ki = 10.0f;
+    config.kd = 0.01f;
+    config.dt = 0.001f;
+    config.derivative_cutoff_hz = 50.0f;
+    config.output_min = 0.0f;
+    config.output_max = 100.0f;
+    HT_CHECK(PlatformPIDF_Init(&pid, &config) == PLATFORM_STATUS_OK);
+    for (int i = 0; i < 500; i++) {
+        float u = PlatformPIDF_Update(&pid, 10.0f, y, 20.0f);
+        y += (u * 0.3f - y) * 0.001f / 0.05f;
+    }
+
+    // 测量值不变时，重新整定kp/ki后的首步输出与原参数相同（比例项变化并入积分）
+    reference = pid;
+    float u_ref = PlatformPIDF_Update(&reference, 10.0f, pid.last_measurement, 20.0f);
+    config.kp = 5.0f;
+    config.ki = 25.0f;
+    HT_CHECK(PlatformPIDF_Retune(&pid, &config) == PLATFORM_STATUS_OK);
+    float u_new = PlatformPIDF_Update(&pid, 10.0f, pid.last_measurement, 20.0f);
+    HT_CHECK_NEAR(u_new, u_ref, 1e-4);
+
+    // kd变化时微分状态按新旧增益比例缩放
+    float derivative = pid.derivative;
+    config.kd = 0.03f;
+    HT_CHECK(PlatformPIDF_Retune(&pid, &config) == PLATFORM_STATUS_OK);
+    HT_CHECK_NEAR(pid.derivative, derivative * 3.0f, fabs(derivative) * 1e-5);
+
+    // 非法参数保持原参数
+    config.dt = 0.0f;
+    HT_CHECK(PlatformPIDF_Retune(&pid, &config) == PLATFORM_STATUS_INVALID_PARAM);
+    HT_CHECK(pid.kp == 5.0f);
+}
+
+static calib_image_t Test_ImageWithSchedule(void)
+{
+    calib_image_t image = *CalibStore_GetImage();
+    calib_gain_schedule_t *sched = &image.gain_schedule;
+
+    memset(sched, 0, sizeof(*sched));
+    sched->temp_points = 3U;
+    sched->pressure_points = 2U;
+    sched->temp_axis[0] = -20.0f;
+    sched->temp_axis[1] = 20.0f;
+    sched->temp_axis[2] = 60.0f;
+    sched->pressure_axis[0] = 5.0f;
+    sched->pressure_axis[1] = 15.0f;
+    for (uint8_t i = 0U; i < 3U; i++) {
+        for (uint8_t j = 0U; j < 2U; j++) {
+            sched->gains[i][j].kp = 1.0f + (float)i + 0.5f * (float)j;
+            sched->gains[i][j].ki = 10.0f * sched->gains[i][j].kp;
+            sched->gains[i][j].kd = 0.0f;
+            sched->gains[i][j].feedforward = 20.0f + (float)j * 10.0f;
+        }
+    }
+    image.header.crc32 = CalibStore_Crc32(CalibStore_Crc32(0U, (const uint8_t *)&image, offsetof(calib_image_header_t, crc32)),
+                                          (const uint8_t *)&image + sizeof(calib_image_header_t),
+                                          sizeof(calib_image_t) - sizeof(calib_image_header_t));
+    return image;
+}
+
+static void Test_CanUpload(const calib_image_t *image)
+{
+    uint8_t frame[8];
+
+    frame[0] = CALIB_CMD_BEGIN;
+    frame[1] = (uint8_t)(sizeof(calib_image_t) & 0xFFU);
+    frame[2] = (uint8_t)(sizeof(calib_image_t) >> 8);
+    HT_CHECK(CalibStore_HandleCanFrame(frame, 3U));
+    for (uint32_t offset = 0U; offset < sizeof(calib_image_t); offset += 5U) {
+        uint32_t count = (sizeof(calib_image_t) - offset < 5U) ? sizeof(calib_image_t) - offset : 5U;
+        frame[0] = CALIB_CMD_DATA;
+        frame[1] = (uint8_t)(offset & 0xFFU);
+        frame[2] = (uint8_t)(offset >> 8);
+        memcpy(&frame[3], (const uint8_t *)image + offset, count);
+        HT_CHECK(CalibStore_HandleCanFrame(frame, (uint8_t)(3U + count)));
+    }
+    frame[0] = CALIB_CMD_COMMIT;
+    memcpy(&frame[1], &image->header.crc32, 4U);
+    HT_CHECK(CalibStore_HandleCanFrame(frame, 5U));
+    CalibStore_Task(true);
+}
+
+static void Test_CalibrationPersistence(void)
+{
+    platform_gain_set_t gains;
+    platform_gain_set_t reloaded;
+
+    HostFake_Reset();
+    HostFlash_EraseAll();
+    CalibStore_Init();
+    HT_CHECK(CalibStore_GetImage()->header.version == CALIB_STORE_VERSION);
+    HT_CHECK(!CalibStore_LookupGains(20.0f, 10.0f, &gains));
+
+    // CAN上传带调度表的镜像，提交时校验、应用并写入DFlash
+    calib_image_t image = Test_ImageWithSchedule();
+    Test_CanUpload(&image);
+    HT_CHECK(!CalibStore_IsSavePending());
+    HT_CHECK(CalibStore_LookupGains(0.0f, 10.0f, &gains));
+    HT_CHECK_NEAR(gains.kp, 1.5 + 0.25, 1e-5);          // 油温-20~20中点，压力5~15中点
+    HT_CHECK_NEAR(gains.feedforward, 25.0, 1e-5);
+
+    // 重新上电从DFlash加载，查表结果一致
+    CalibStore_Init();
+    HT_CHECK(CalibStore_LookupGains(0.0f, 10.0f, &reloaded));
+    HT_CHECK(memcmp(&gains, &reloaded, sizeof(gains)) == 0);
+
+    // 自整定写入单个节点：立即生效，延时保存后掉电保持
+    platform_gain_set_t tuned = { 7.0f, 70.0f, 0.0f, 33.0f };
+    HT_CHECK(CalibStore_SetGainScheduleEntry(1U, 1U, &tuned, 0.0f, 0.0f) == CALIB_STATUS_OK);
+    HT_CHECK(CalibStore_SetGainScheduleEntry(3U, 0U, &tuned, 0.0f, 0.0f) == CALIB_STATUS_BAD_LENGTH);
+    tuned.kp = -1.0f;
+    HT_CHECK(CalibStore_SetGainScheduleEntry(0U, 0U, &tuned, 0.0f, 0.0f) == CALIB_STATUS_BAD_CONTENT);
+    HT_CHECK(CalibStore_LookupGains(20.0f, 15.0f, &gains));
+    HT_CHECK(gains.kp == 7.0f);
+    HT_CHECK(CalibStore_IsSavePending());
+    HT_CHECK(CalibStore_Save());
+    CalibStore_Init();
+    HT_CHECK(CalibStore_LookupGains(20.0f, 15.0f, &gains));
+    HT_CHECK(gains.kp == 7.0f);
+
+    // 非法调度表（断点不递增）被拒绝，原表保持
+    image = Test_ImageWithSchedule();
+    image.gain_schedule.temp_axis[2] = image.gain_schedule.temp_axis[1];
+    image.header.crc32 = CalibStore_Crc32(CalibStore_Crc32(0U, (const uint8_t *)&image, offsetof(calib_image_header_t, crc32)),
+                                          (const uint8_t *)&image + sizeof(calib_image_header_t),
+                                          sizeof(calib_image_t) - sizeof(calib_image_header_t));
+    HT_CHECK(CalibStore_Apply(&image) == CALIB_STATUS_BAD_CONTENT);
+    HT_CHECK(CalibStore_LookupGains(20.0f, 15.0f, &gains));
+    HT_CHECK(gains.kp == 7.0f);
+}
+
+static void Test_UpgradeFromV2(void)
+{
+    flash_config_t flash_config;
+    flash_user_config_t flash_user_config;
+    calib_image_t image;
+    platform_gain_set_t gains;
+
+    // DFlash中只有v2镜像（无调度表字段，其后为页内其他数据）：加载后升级为v3，不启用调度
+    HostFlash_EraseAll();
+    CalibStore_Init();
+    image = *CalibStore_GetImage();
+    memset(&image.gain_schedule, 0xA5, sizeof(image.gain_schedule));
+    image.header.version = 2U;
+    image.header.length = (uint16_t)offsetof(calib_image_t, gain_schedule);
+    image.header.sequence = 5U;
+    image.header.crc32 = CalibStore_Crc32(CalibStore_Crc32(0U, (const uint8_t *)&image, offsetof(calib_image_header_t, crc32)),
+                                          (const uint8_t *)&image + sizeof(calib_image_header_t),
+                                          image.header.length - sizeof(calib_image_header_t));
+
+    FLASH_DRV_GetDefaultConfig(&flash_user_config);
+    FLASH_DRV_Init(&flash_user_config, &flash_config);
+    HT_CHECK(FLASH_DRV_UnlockCtrl() == STATUS_SUCCESS);
+    HT_CHECK(FLASH_DRV_EraseSector(&flash_config, CALIB_STORE_PAGE_A_ADDR, DFLASH_PAGE_SIZE) == STATUS_SUCCESS);
+    HT_CHECK(FLASH_DRV_Program(&flash_config, CALIB_STORE_PAGE_A_ADDR, sizeof(image), (const uint8_t *)&image) == STATUS_SUCCESS);
+    FLASH_DRV_LockCtrl();
+
+    CalibStore_Init();
+    HT_CHECK(CalibStore_GetImage()->header.version == CALIB_STORE_VERSION);
+    HT_CHECK(CalibStore_GetImage()->header.sequence == 5U);
+    HT_CHECK(CalibStore_GetImage()->gain_schedule.temp_points == 0U);
+    HT_CHECK(!CalibStore_LookupGains(20.0f, 10.0f, &gains));
+
+    // 升级后保存为v3，再次加载不依赖旧页
+    HT_CHECK(CalibStore_Save());
+    CalibStore_Init();
+    HT_CHECK(CalibStore_GetImage()->header.sequence == 6U);
+    HT_CHECK(CalibStore_GetImage()->header.length == sizeof(calib_image_t));
+}
+
+int main(void)
+{
+    HT_RUN(Test_AxisValidation);
+    HT_RUN(Test_LookupMatchesReference);
+    HT_RUN(Test_RetuneContinuity);
+    HT_RUN(Test_CalibrationPersistence);
+    HT_RUN(Test_UpgradeFromV2);
+    return HT_RESULT("test_gain_schedule");
+}
@@ -0,0 +1,119 @@
+/*!
+ * @file test_host_build.c
+ *
+ * @brief PC端构建冒烟测试：虚拟时钟、外设替身与整机启动
+ */
+
+#include "host_test.h"
+#include "host_fake.h"
+#include "host_app.h"
+#include "common_types.h"
+#include "can_config.h"
+#include "gcu_control_dbc.h"
+#include "valve_control.h"
+#include "timer_drv.h"
+#include "osif.h"
+
+/* ==========================================  Variables  =========================================== */
+
+static uint32_t g_timer_calls = 0U;
+
+/* ==========================================  Functions  =========================================== */
+
+static void TimerCallback(void *device, uint32_t wpara, uint32_t lpara)
+{
+    (void)device;
+    (void)wpara;
+    (void)lpara;
+    g_timer_calls++;
+}
+
+static void Test_VirtualClock(void)
+{
+    HostFake_Reset();
+    HT_CHECK(OSIF_GetMilliseconds() == 0U);
+    HostClock_AdvanceMs(5U);
+    HT_CHECK(OSIF_GetMilliseconds() == 5U);
+    OSIF_TimeDelay(3U);
+    HT_CHECK(OSIF_GetMilliseconds() == 8U);
+    HostClock_AdvanceUs(999U);
+    HT_CHECK(OSIF_GetMilliseconds() == 8U);
+    HostClock_AdvanceUs(1U);
+    HT_CHECK(OSIF_GetMilliseconds() == 9U);
+}
+
+static void Test_TimerChannel(void)
+{
+    timer_user_channel_config_t config;
+
+    HostFake_Reset();
+    g_timer_calls = 0U;
+    TIMER_DRV_Init(0U, false);
+    TIMER_DRV_GetDefaultChanConfig(&config);
+    config.periodUnits = TIMER_PERIOD_UNITS_MICROSECONDS;
+    config.period = 100U;
+    config.callback = TimerCallback;
+    HT_CHECK(TIMER_DRV_InitChannel(0U, 2U, &config) == STATUS_SUCCESS);
+    TIMER_DRV_StartChannels(0U, 1UL << 2);
+
+    HostClock_AdvanceMs(1U);
+    HT_CHECK(g_timer_calls == 10U);
+
+    // 运行中修改周期：本周期结束后生效
+    TIMER_DRV_SetPeriodByCount(0U, 2U, HOST_BUS_CLOCK_HZ / 1000U - 1U);
+    HostClock_AdvanceUs(100U);
+    HT_CHECK(g_timer_calls == 11U);
+    HostClock_AdvanceUs(999U);
+    HT_CHECK(g_timer_calls == 11U);
+    HostClock_AdvanceUs(1U);
+    HT_CHECK(g_timer_calls == 12U);
+
+    // 屏蔽期间的中断挂起，重新使能后执行一次
+    NVIC_DisableIRQ(TIMER_CHANNEL2_IRQn);
+    HostClock_AdvanceMs(3U);
+    HT_CHECK(g_timer_calls == 12U);
+    NVIC_EnableIRQ(TIMER_CHANNEL2_IRQn);
+    HT_CHECK(g_timer_calls == 13U);
+
+    TIMER_DRV_StopChannels(0U, 1UL << 2);
+    HostClock_AdvanceMs(5U);
+    HT_CHECK(g_timer_calls == 13U);
+}
+
+static void Test_SystemStartup(void)
+{
+    host_can_frame_t frame;
+
+    HostFake_Reset();
+    HostFlash_EraseAll();
+    SystemStartup();
+
+    // 启动自检帧与外设初始状态
+    HT_CHECK(HostCan_FindLastTx(0x123U, &frame));
+    HT_CHECK(HostPwm_GetMaxCount(0U) == BYPASS_PWM_MAX_COUNT);
+    HT_CHECK(HostPwm_GetChannelCount(0U, 2U) == 0U);
+    HT_CHECK(!g_systemEnabled);
+
+    // 运行1s：传感器数据帧按自适应周期发送，PWM溢出中断按载波频率运行
+    uint32_t tx_before = HostCan_GetTxCount();
+    uint32_t overflow_before = HostPwm_GetOverflowCount(0U);
+    HostApp_RunMs(1000U);
+    HT_CHECK(HostCan_FindLastTx(CAN_MSG_GCU_DEBUG1_ID, &frame));
+    HT_CHECK(HostCan_GetTxCount() - tx_before >= 1000U / SENSOR_RATE_IDLE_PERIOD_MS);
+    HT_CHECK_NEAR((double)(HostPwm_GetOverflowCount(0U) - overflow_before),
+                  (double)SYSTEM_CLOCK_FREQ_HZ / (BYPASS_PWM_PRESCALER + 1U) / (BYPASS_PWM_MAX_COUNT + 1U), 2.0);
+
+    // 风冷器输出经GPIO替身可见
+    ValveControl_SetCooler(true);
+    HT_CHECK((HostGpio_GetOutput(GPIOE) & (1UL << 8)) != 0U);
+    ValveControl_SetCooler(false);
+    HT_CHECK((HostGpio_GetOutput(GPIOE) & (1UL << 8)) == 0U);
+}
+
+int main(void)
+{
+    HT_RUN(Test_VirtualClock);
+    HT_RUN(Test_TimerChannel);
+    HT_RUN(Test_SystemStartup);
+    return HT_RESULT("test_host_build");
+}
@@ -0,0 +1,175 @@
+/*!
+ * @file test_moving_average.c
+ *
+ * @brief 增量累加和滑动平均等价性测试：与逐窗口直接求和（double）对比
+ */
+
+#include "host_test.h"
+#include "common_types.h"
+#include "unified_filter.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* ==========================================  Variables  =========================================== */
+
+static uint32_t g_rand_state = 12345U;
+
+/* ==========================================  Functions  =========================================== */
+
+static float Test_Rand(float lo, float hi)
+{
+    g_rand_state = g_rand_state * 1664525U + 1013904223U;
+    return lo + (hi - lo) * (float)(g_rand_state >> 8) * (1.0f / 16777216.0f);
+}
+
+// 直接求和参考：history为全部输入，取最近min(n, window)个样本
+static double Test_Reference(const float *history, uint32_t n, uint32_t window)
+{
+    uint32_t count = (n < window) ? n : window;
+    double sum = 0.0;
+
+    for (uint32_t i = n - count; i < n; i++) {
+        sum += history[i];
+    }
+    return sum / count;
+}
+
+static void Test_WindowRounding(void)
+{
+    static const uint8_t requested[] = { 0U, 1U, 3U, 8U, 10U, 63U, 64U, 100U, 255U };
+    static const uint8_t expected[] = { 1U, 1U, 2U, 8U, 8U, 32U, 64U, 64U, 64U };
+    platform_moving_average_t ma;
+
+    for (uint32_t i = 0U; i < sizeof(requested); i++) {
+        PlatformFilter_MovingAverageInit(&ma, requested[i]);
+        HT_CHECK(ma.window == expected[i]);
+        HT_CHECK(ma.mask == (uint8_t)(expected[i] - 1U));
+    }
+    HT_CHECK(PlatformFilter_MovingAverageGet(&ma) == 0.0f);
+}
+
+static void Test_ChannelWindow(void)
+{
+    static const uint8_t rejected[] = { 0U, 3U, 10U, 63U, 100U, 128U };
+    filter_config_t config;
+    filter_config_t current;
+
+    UnifiedFilter_Init();
+    HT_CHECK(UnifiedFilter_GetChannelConfig(FILTER_CHANNEL_OIL_PRESSURE, &config));
+    HT_CHECK(config.filter_type == FILTER_TYPE_MOVING_AVERAGE);
+
+    // 通道配置不做隐式取整：非2的幂或超出上限的窗口被拒绝，原配置保持
+    for (uint32_t i = 0U; i < sizeof(rejected); i++) {
+        filter_config_t bad = config;
+        bad.window_size = rejected[i];
+        HT_CHECK(!UnifiedFilter_ConfigureChannel(FILTER_CHANNEL_OIL_PRESSURE, &bad));
+        HT_CHECK(UnifiedFilter_GetChannelConfig(FILTER_CHANNEL_OIL_PRESSURE, &current));
+        HT_CHECK(current.window_size == config.window_size);
+    }
+
+    // 合法窗口：读回的配置即实际生效的窗口
+    config.window_size = 16U;
+    HT_CHECK(UnifiedFilter_ConfigureChannel(FILTER_CHANNEL_OIL_PRESSURE, &config));
+    HT_CHECK(UnifiedFilter_GetChannelConfig(FILTER_CHANNEL_OIL_PRESSURE, &current));
+    HT_CHECK(current.window_size == 16U);
+    config.window_size = PLATFORM_MA_MAX_WINDOW;
+    HT_CHECK(UnifiedFilter_ConfigureChannel(FILTER_CHANNEL_OIL_PRESSURE, &config));
+    HT_CHECK(UnifiedFilter_GetChannelConfig(FILTER_CHANNEL_OIL_PRESSURE, &current));
+    HT_CHECK(current.window_size == PLATFORM_MA_MAX_WINDOW);
+}
+
+static void Test_Equivalence(void)
+{
+    static float history[5000];
+    platform_moving_average_t ma;
+
+    for (uint32_t window = 1U; window <= PLATFORM_MA_MAX_WINDOW; window *= 2U) {
+        int mismatches = 0;
+        PlatformFilter_MovingAverageInit(&ma, (uint8_t)window);
+        for (uint32_t n = 0U; n < 5000U; n++) {
+            // 油压量级信号叠加噪声与阶跃，覆盖填充期、稳态与跨越重算周期
+            history[n] = ((n / 700U) % 2U ? 35.0f : 5.0f) + Test_Rand(-0.5f, 0.5f);
+            float out = PlatformFilter_MovingAverageUpdate(&ma, history[n]);
+            double ref = Test_Reference(history, n + 1U, window);
+            if (fabs((double)out - ref) > 1e-4 * (1.0 + fabs(ref))) {
+                mismatches++;
+            }
+        }
+        HT_CHECK(mismatches == 0);
+        HT_CHECK(PlatformFilter_MovingAverageGet(&ma) == ma.sum * ma.inv_window);
+    }
+}
+
+static void Test_DriftBounded(void)
+{
+    platform_moving_average_t ma;
+    float window_values[64];
+    double max_err = 0.0;
+    double max_err_resummed = 0.0;
+
+    // 大偏置+小波动长期运行：增量和的舍入误差只在两次重算之间累积，重算后回到单次求和误差
+    PlatformFilter_MovingAverageInit(&ma, 64U);
+    for (uint32_t n = 0U; n < 2000000U; n++) {
+        float v = 40.0f + Test_Rand(-0.01f, 0.01f) + ((n & 1U) ? 1e-3f : -1e-3f) * (float)(n % 97U);
+        window_values[n & 63U] = v;
+        float out = PlatformFilter_MovingAverageUpdate(&ma, v);
+        bool resummed = (ma.resum_countdown == PLATFORM_MA_RESUM_PERIOD);
+        if (n >= 64U && (resummed || (n % 1000U) == 999U)) {
+            double ref = 0.0;
+            for (uint32_t i = 0U; i < 64U; i++) {
+                ref += window_values[i];
+            }
+            double err = fabs((double)out - ref / 64.0);
+            if (err > max_err) {
+                max_err = err;
+            }
+            if (resummed && err > max_err_resummed) {
+                max_err_resummed = err;
+            }
+        }
+    }
+    // 40MPa满量程下1e-3MPa远低于ADC分辨率
+    HT_CHECK(max_err < 1e-3);
+    HT_CHECK(max_err_resummed < 2e-5);
+}
+
+static void Test_CompatibilityHelpers(void)
+{
+    float buffer_p[10];
+    float buffer_u[10];
+    float history[200];
+    uint8_t index_p = 0U;
+    uint8_t index_u = 0U;
+    int mismatches = 0;
+
+    // 兼容接口窗口不要求2的幂，缓冲区需预先清零（填充期按全窗口平均）
+    memset(buffer_p, 0, sizeof(buffer_p));
+    memset(buffer_u, 0, sizeof(buffer_u));
+    memset(history, 0, sizeof(history));
+    for (uint32_t n = 0U; n < 200U; n++) {
+        history[n] = Test_Rand(0.0f, 20.0f);
+        float out_p = PlatformFilter_MovingAverage(buffer_p, &index_p, 10U, history[n]);
+        float out_u = UnifiedFilter_MovingAverage(buffer_u, &index_u, 10U, history[n]);
+        double ref = 0.0;
+        for (uint32_t i = 0U; i < 10U; i++) {
+            ref += (n >= i) ? history[n - i] : 0.0f;
+        }
+        ref /= 10.0;
+        if (fabs((double)out_p - ref) > 1e-4 || fabs((double)out_u - ref) > 1e-4) {
+            mismatches++;
+        }
+    }
+    HT_CHECK(mismatches == 0);
+    HT_CHECK(index_p == 0U && index_u == 0U);
+}
+
+int main(void)
+{
+    HT_RUN(Test_WindowRounding);
+    HT_RUN(Test_ChannelWindow);
+    HT_RUN(Test_Equivalence);
+    HT_RUN(Test_DriftBounded);
+    HT_RUN(Test_CompatibilityHelpers);
+    return HT_RESULT("test_moving_average");
+}
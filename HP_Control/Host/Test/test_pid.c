@@ -0,0 +1,220 @@
+/*!
+ * @file test_pid.c
+ *
+ * @brief 定周期PID测试（浮点PlatformPIDF与定点PlatformPIDQ）：
+ *        参数检查、测量值微分、反算抗饱和、前馈、无扰切换、浮点/定点一致性
+ */
+
+#include "host_test.h"
+#include "common_types.h"
+#include <stdint.h>
+#include <string.h>
+
+/* ==========================================  Functions  =========================================== */
+
+static platform_pid_config_t Test_Config(float kp, float ki, float kd)
+{
+    platform_pid_config_t config;
+
+    memset(&config, 0, sizeof(config));
+    config.kp = kp;
+    config.ki = ki;
+    config.kd = kd;
+    config.dt = 0.001f;
+    config.output_min = -1.0f;
+    config.output_max = 1.0f;
+    return config;
+}
+
+static void Test_InvalidConfig(void)
+{
+    platform_pidf_t pidf;
+    platform_pidq_t pidq;
+    platform_pid_config_t config = Test_Config(1.0f, 1.0f, 0.0f);
+
+    config.dt = 0.0f;
+    HT_CHECK(PlatformPIDF_Init(&pidf, &config) == PLATFORM_STATUS_INVALID_PARAM);
+    HT_CHECK(PlatformPIDQ_Init(&pidq, &config) == PLATFORM_STATUS_INVALID_PARAM);
+    config = Test_Config(1.0f, 1.0f, 0.0f);
+    config.output_min = config.output_max;
+    HT_CHECK(PlatformPIDF_Init(&pidf, &config) == PLATFORM_STATUS_INVALID_PARAM);
+    HT_CHECK(PlatformPIDQ_Init(&pidq, &config) == PLATFORM_STATUS_INVALID_PARAM);
+    HT_CHECK(PlatformPIDF_Init(NULL, &config) == PLATFORM_STATUS_INVALID_PARAM);
+    HT_CHECK(PlatformPIDF_Init(&pidf, NULL) == PLATFORM_STATUS_INVALID_PARAM);
+}
+
+static void Test_ProportionalIntegral(void)
+{
+    platform_pidf_t pid;
+    platform_pid_config_t config = Test_Config(2.0f, 50.0f, 0.0f);
+
+    HT_CHECK(PlatformPIDF_Init(&pid, &config) == PLATFORM_STATUS_OK);
+
+    // 首步：仅比例项；之后每步积分增加ki*dt*e
+    HT_CHECK_NEAR(PlatformPIDF_Update(&pid, 0.1f, 0.0f, 0.0f), 0.2, 1e-6);
+    HT_CHECK_NEAR(PlatformPIDF_Update(&pid, 0.1f, 0.0f, 0.0f), 0.2 + 50.0 * 0.001 * 0.1, 1e-6);
+    for (int i = 0; i < 98; i++) {
+        (void)PlatformPIDF_Update(&pid, 0.1f, 0.0f, 0.0f);
+    }
+    HT_CHECK_NEAR(pid.integral, 100.0 * 50.0 * 0.001 * 0.1, 1e-5);
+
+    // 输出限幅
+    HT_CHECK(PlatformPIDF_Update(&pid, 10.0f, 0.0f, 0.0f) == 1.0f);
+    HT_CHECK(PlatformPIDF_Update(&pid, -10.0f, 0.0f, 0.0f) == -1.0f);
+}
+
+static void Test_DerivativeOnMeasurement(void)
+{
+    platform_pidf_t pid;
+    platform_pid_config_t config = Test_Config(1.0f, 0.0f, 0.01f);
+
+    // 不滤波：设定值阶跃无微分冲击，测量值阶跃产生 -kd/dt*Δm
+    HT_CHECK(PlatformPIDF_Init(&pid, &config) == PLATFORM_STATUS_OK);
+    HT_CHECK_NEAR(PlatformPIDF_Update(&pid, 0.0f, 0.0f, 0.0f), 0.0, 1e-7);
+    HT_CHECK_NEAR(PlatformPIDF_Update(&pid, 0.5f, 0.0f, 0.0f), 0.5, 1e-6);
+    HT_CHECK_NEAR(PlatformPIDF_Update(&pid, 0.5f, 0.001f, 0.0f), 0.499 - 0.01 / 0.001 * 0.001, 1e-5);
+    HT_CHECK_NEAR(PlatformPIDF_Update(&pid, 0.5f, 0.001f, 0.0f), 0.499, 1e-5);
+
+    // 微分低通：首步为原始微分×beta，之后按一阶指数衰减
+    config.derivative_cutoff_hz = 50.0f;
+    HT_CHECK(PlatformPIDF_Init(&pid, &config) == PLATFORM_STATUS_OK);
+    float rc = 1.0f / (2.0f * 3.14159265f * 50.0f);
+    float beta = 0.001f / (0.001f + rc);
+    (void)PlatformPIDF_Update(&pid, 0.0f, 0.0f, 0.0f);
+    (void)PlatformPIDF_Update(&pid, 0.0f, 0.001f, 0.0f);
+    HT_CHECK_NEAR(pid.derivative, -0.01 * beta, 1e-6);
+    (void)PlatformPIDF_Update(&pid, 0.0f, 0.001f, 0.0f);
+    HT_CHECK_NEAR(pid.derivative, -0.01 * beta * (1.0 - beta), 1e-6);
+}
+
+static void Test_FeedForward(void)
+{
+    platform_pidf_t pid;
+    platform_pid_config_t config = Test_Config(1.0f, 0.0f, 0.0f);
+
+    HT_CHECK(PlatformPIDF_Init(&pid, &config) == PLATFORM_STATUS_OK);
+    HT_CHECK_NEAR(PlatformPIDF_Update(&pid, 0.2f, 0.1f, 0.3f), 0.4, 1e-6);
+    HT_CHECK(PlatformPIDF_Update(&pid, 0.2f, 0.1f, 2.0f) == 1.0f);
+}
+
+// 一阶对象 y' = (u - y)/tau，返回饱和期结束后输出离开上限所需步数
+static int Test_WindupRecovery(float tracking_gain)
+{
+    platform_pidf_t pid;
+    platform_pid_config_t config = Test_Config(1.0f, 20.0f, 0.0f);
+    float y = 0.0f;
+    float u = 0.0f;
+
+    config.tracking_gain = tracking_gain;
+    (void)PlatformPIDF_Init(&pid, &config);
+    // 不可达设定值持续1s，输出饱和
+    for (int i = 0; i < 1000; i++) {
+        u = PlatformPIDF_Update(&pid, 5.0f, y, 0.0f);
+        y += (u - y) * 0.001f / 0.05f;
+    }
+    // 设定值回到可达范围，统计输出脱离上限所需步数
+    for (int i = 0; i < 5000; i++) {
+        u = PlatformPIDF_Update(&pid, 0.5f, y, 0.0f);
+        y += (u - y) * 0.001f / 0.05f;
+        if (u < config.output_max) {
+            return i;
+        }
+    }
+    return 5000;
+}
+
+static void Test_AntiWindup(void)
+{
+    // 默认跟踪增益(ki/kp)：积分被限制在饱和边界附近，设定值回落后立即退出饱和；
+    // 跟踪增益极小（近似无抗饱和）时积分持续累积，退出饱和明显滞后
+    int recovery_default = Test_WindupRecovery(0.0f);
+    int recovery_weak = Test_WindupRecovery(0.01f);
+    HT_CHECK(recovery_default <= 2);
+    HT_CHECK(recovery_weak > 100);
+}
+
+static void Test_Bumpless(void)
+{
+    platform_pidf_t pidf;
+    platform_pidq_t pidq;
+    platform_pid_config_t config = Test_Config(3.0f, 40.0f, 0.002f);
+
+    config.derivative_cutoff_hz = 100.0f;
+    HT_CHECK(PlatformPIDF_Init(&pidf, &config) == PLATFORM_STATUS_OK);
+    HT_CHECK(PlatformPIDQ_Init(&pidq, &config) == PLATFORM_STATUS_OK);
+
+    // 手动→自动：首步输出等于切换前执行器输出
+    PlatformPIDF_Bumpless(&pidf, 0.4f, 0.3f, 0.1f, 0.65f);
+    HT_CHECK_NEAR(PlatformPIDF_Update(&pidf, 0.4f, 0.3f, 0.1f), 0.65, 1e-6);
+
+    PlatformPIDQ_Bumpless(&pidq, 13107, 9830, 3277, 21299);
+    HT_CHECK(PlatformPIDQ_Update(&pidq, 13107, 9830, 3277) == 21299);
+
+    // 复位后首步无微分冲击
+    PlatformPIDF_Reset(&pidf);
+    HT_CHECK_NEAR(PlatformPIDF_Update(&pidf, 0.1f, 0.2f, 0.0f), -0.3, 1e-6);
+}
+
+static void Test_FixedPointMatchesFloat(void)
+{
+    platform_pidf_t pidf;
+    platform_pidq_t pidq;
+    platform_pid_config_t config = Test_Config(1.5f, 30.0f, 0.001f);
+    float yf = 0.0f;
+    float yq = 0.0f;
+    double max_diff = 0.0;
+
+    // 同一对象、同一设定值序列（含饱和与恢复），定点输出与浮点输出在Q15分辨率量级内一致
+    config.derivative_cutoff_hz = 50.0f;
+    config.output_min = 0.0f;
+    config.output_max = 0.9f;
+    HT_CHECK(PlatformPIDF_Init(&pidf, &config) == PLATFORM_STATUS_OK);
+    HT_CHECK(PlatformPIDQ_Init(&pidq, &config) == PLATFORM_STATUS_OK);
+    for (int i = 0; i < 6000; i++) {
+        float sp = (i < 2000) ? 0.3f : ((i < 4000) ? 0.95f : 0.1f);
+        float ff = (i < 3000) ? 0.0f : 0.05f;
+        float uf = PlatformPIDF_Update(&pidf, sp, yf, ff);
+        int16_t uq = PlatformPIDQ_Update(&pidq, (int16_t)(sp * 32768.0f), (int16_t)(yq * 32768.0f),
+                                         (int16_t)(ff * 32768.0f));
+        yf += (uf - yf) * 0.001f / 0.05f;
+        yq += ((float)uq / 32768.0f - yq) * 0.001f / 0.05f;
+        double diff = fabs((double)yf - (double)yq);
+        if (diff > max_diff) {
+            max_diff = diff;
+        }
+    }
+    HT_CHECK(max_diff < 2e-3);
+    HT_CHECK_NEAR(yf, 0.1, 1e-3);
+    HT_CHECK_NEAR(yq, 0.1, 2e-3);
+}
+
+static void Test_FixedPointExtremes(void)
+{
+    platform_pidq_t pid;
+    platform_pid_config_t config = Test_Config(100.0f, 10000.0f, 1.0f);
+    int out_of_range = 0;
+
+    // 大增益、满量程反复阶跃：状态饱和而不回绕，输出始终在限值内
+    HT_CHECK(PlatformPIDQ_Init(&pid, &config) == PLATFORM_STATUS_OK);
+    for (int i = 0; i < 10000; i++) {
+        int16_t sp = (i & 64) ? INT16_MAX : INT16_MIN;
+        int16_t meas = (i & 1) ? INT16_MIN : INT16_MAX;
+        int16_t u = PlatformPIDQ_Update(&pid, sp, meas, (i & 2) ? INT16_MAX : INT16_MIN);
+        out_of_range += (u < pid.output_min || u > pid.output_max);
+    }
+    HT_CHECK(out_of_range == 0);
+    HT_CHECK(PlatformPIDQ_Update(&pid, INT16_MAX, INT16_MIN, 0) == pid.output_max);
+}
+
+int main(void)
+{
+    HT_RUN(Test_InvalidConfig);
+    HT_RUN(Test_ProportionalIntegral);
+    HT_RUN(Test_DerivativeOnMeasurement);
+    HT_RUN(Test_FeedForward);
+    HT_RUN(Test_AntiWindup);
+    HT_RUN(Test_Bumpless);
+    HT_RUN(Test_FixedPointMatchesFloat);
+    HT_RUN(Test_FixedPointExtremes);
+    return HT_RESULT("test_pid");
+}
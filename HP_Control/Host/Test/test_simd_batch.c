@@ -0,0 +1,316 @@
+/*!
+ * @file test_simd_batch.c
+ *
+ * @brief 打包SIMD与批量通道更新的位精确测试：
+ *        - dsp_simd.h的C实现与ARMv7E-M指令定义（逐半字模2^16/饱和、32位回绕累加）逐位一致
+ *        - 打包码值滑动和与逐通道标量滑动和逐位一致
+ *        - 批量四通道更新与各通道独立标量滤波逐位一致（无通道串扰、通道映射正确）
+ *        - 只计算已用节的Biquad与逐节标量级联逐位一致；Hampel窗口原位更新与整窗排序逐位一致
+ */
+
+#include "host_test.h"
+#include "dsp_simd.h"
+#include "unified_filter.h"
+#include "common_types.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==========================================  Variables  =========================================== */
+
+static uint32_t g_rand_state = 2024U;
+
+/* ==========================================  Functions  =========================================== */
+
+static uint32_t Test_Rand32(void)
+{
+    g_rand_state ^= g_rand_state << 13;
+    g_rand_state ^= g_rand_state >> 17;
+    g_rand_state ^= g_rand_state << 5;
+    return g_rand_state;
+}
+
+// 参考实现：按指令定义以64位整数计算，再截取/饱和到16位
+static int64_t Ref_Half(uint32_t x, int hi)
+{
+    uint32_t h = hi ? (x >> 16) : (x & 0xFFFFU);
+    return (h & 0x8000U) ? (int64_t)h - 65536 : (int64_t)h;
+}
+
+static uint32_t Ref_Wrap16(int64_t lo, int64_t hi)
+{
+    return ((uint32_t)(lo & 0xFFFF)) | ((uint32_t)(hi & 0xFFFF) << 16);
+}
+
+static int64_t Ref_Sat16(int64_t v)
+{
+    return (v > 32767) ? 32767 : ((v < -32768) ? -32768 : v);
+}
+
+static uint32_t Ref_Wrap32(int64_t v)
+{
+    return (uint32_t)(v & 0xFFFFFFFFLL);
+}
+
+static uint32_t Test_Operand(uint32_t n)
+{
+    // 前若干个取边界值（±32767/-32768/0/-1组合），其余随机
+    static const uint16_t edge[] = { 0x0000U, 0x0001U, 0x7FFFU, 0x8000U, 0x8001U, 0xFFFFU };
+    if (n < 36U) {
+        return (uint32_t)edge[n % 6U] | ((uint32_t)edge[n / 6U] << 16);
+    }
+    return Test_Rand32();
+}
+
+static void Test_DspIntrinsics(void)
+{
+    int mismatches = 0;
+
+    for (uint32_t i = 0U; i < 36U * 36U + 200000U; i++) {
+        uint32_t x = Test_Operand((i < 36U * 36U) ? i % 36U : 36U);
+        uint32_t y = Test_Operand((i < 36U * 36U) ? i / 36U : 36U);
+        int32_t acc = (int32_t)Test_Rand32();
+        int64_t xl = Ref_Half(x, 0), xh = Ref_Half(x, 1);
+        int64_t yl = Ref_Half(y, 0), yh = Ref_Half(y, 1);
+
+        mismatches += ((uint32_t)DSP_Smuad(x, y) != Ref_Wrap32(xl * yl + xh * yh));
+        mismatches += ((uint32_t)DSP_Smlad(x, y, acc) != Ref_Wrap32((int64_t)acc + xl * yl + xh * yh));
+        mismatches += ((uint32_t)DSP_Smusd(x, y) != Ref_Wrap32(xl * yl - xh * yh));
+        mismatches += ((uint32_t)DSP_Smusdx(x, y) != Ref_Wrap32(xl * yh - xh * yl));
+        mismatches += (DSP_Sadd16(x, y) != Ref_Wrap16(xl + yl, xh + yh));
+        mismatches += (DSP_Ssub16(x, y) != Ref_Wrap16(xl - yl, xh - yh));
+        mismatches += (DSP_Shadd16(x, y) != Ref_Wrap16((xl + yl) >> 1, (xh + yh) >> 1));
+        mismatches += (DSP_Shsub16(x, y) != Ref_Wrap16((xl - yl) >> 1, (xh - yh) >> 1));
+        mismatches += (DSP_Qadd16(x, y) != Ref_Wrap16(Ref_Sat16(xl + yl), Ref_Sat16(xh + yh)));
+        mismatches += (DSP_Qsub16(x, y) != Ref_Wrap16(Ref_Sat16(xl - yl), Ref_Sat16(xh - yh)));
+    }
+    HT_CHECK(DSP_SIMD_HW == 0);
+    HT_CHECK(mismatches == 0);
+}
+
+static void Test_PackedBoxcar(void)
+{
+    packed_boxcar_t bc;
+    uint16_t history[UNIFIED_FILTER_RAW_WINDOW][UNIFIED_FILTER_RAW_MAX_CHANNELS];
+    uint16_t codes[UNIFIED_FILTER_RAW_MAX_CHANNELS];
+    int mismatches = 0;
+
+    for (uint8_t channels = 1U; channels <= UNIFIED_FILTER_RAW_MAX_CHANNELS; channels++) {
+        UnifiedFilter_PackedBoxcarInit(&bc, channels);
+        HT_CHECK(bc.words == (channels + 1U) / 2U);
+        for (uint32_t n = 0U; n < 3000U; n++) {
+            for (uint8_t ch = 0U; ch < channels; ch++) {
+                // 含满量程连续段与高4位非零的码值（应被掩掉）
+                uint32_t r = Test_Rand32();
+                codes[ch] = ((n / 100U) % 3U == 1U) ? (uint16_t)(0xF000U | UNIFIED_FILTER_RAW_CODE_MASK) : (uint16_t)r;
+                history[n % UNIFIED_FILTER_RAW_WINDOW][ch] = codes[ch] & UNIFIED_FILTER_RAW_CODE_MASK;
+            }
+            UnifiedFilter_PackedBoxcarUpdate(&bc, codes);
+
+            uint32_t count = (n + 1U < UNIFIED_FILTER_RAW_WINDOW) ? n + 1U : UNIFIED_FILTER_RAW_WINDOW;
+            for (uint8_t ch = 0U; ch < channels; ch++) {
+                uint32_t sum = 0U;
+                for (uint32_t k = 0U; k < count; k++) {
+                    sum += history[k][ch];
+                }
+                uint16_t ref = (uint16_t)((sum * 8U) / count);
+                mismatches += (UnifiedFilter_PackedBoxcarGetQ3(&bc, ch) != ref);
+            }
+        }
+        HT_CHECK(UnifiedFilter_PackedBoxcarGetQ3(&bc, channels) == 0U);
+    }
+    HT_CHECK(mismatches == 0);
+}
+
+static void Test_BatchedChannels(void)
+{
+    static const filter_channel_t channels[FILTER_CHANNEL_COUNT] = {
+        FILTER_CHANNEL_OIL_TEMP, FILTER_CHANNEL_LNG_TEMP, FILTER_CHANNEL_OIL_PRESSURE, FILTER_CHANNEL_LNG_PRESSURE
+    };
+    static const float alphas[2] = { 0.1f, 0.35f };
+    static const uint8_t windows[2] = { 8U, 64U };
+    platform_moving_average_t ref_ma[2];
+    float ref_exp[2] = { 0.0f, 0.0f };
+    hampel_config_t no_spike;
+    int mismatches = 0;
+
+    // 温度通道取不同系数的指数滤波、压力通道取不同窗口的移动平均（缓冲区池两路），关闭尖峰剔除，
+    // 批量更新输出应与各通道独立标量滤波逐位相同
+    UnifiedFilter_Init();
+    memset(&no_spike, 0, sizeof(no_spike));
+    for (uint32_t i = 0U; i < FILTER_CHANNEL_COUNT; i++) {
+        filter_config_t config;
+        HT_CHECK(UnifiedFilter_GetChannelConfig(channels[i], &config));
+        if (i < 2U) {
+            config.filter_type = FILTER_TYPE_EXPONENTIAL;
+            config.alpha = alphas[i];
+        } else {
+            config.filter_type = FILTER_TYPE_MOVING_AVERAGE;
+            config.window_size = windows[i - 2U];
+            PlatformFilter_MovingAverageInit(&ref_ma[i - 2U], windows[i - 2U]);
+        }
+        config.enabled = true;
+        HT_CHECK(UnifiedFilter_ConfigureChannel(channels[i], &config));
+        (void)UnifiedFilter_ConfigureSpikeFilter(channels[i], &no_spike);
+    }
+
+    for (uint32_t n = 0U; n < 5000U; n++) {
+        float values[FILTER_CHANNEL_COUNT];
+        for (uint32_t i = 0U; i < FILTER_CHANNEL_COUNT; i++) {
+            values[channels[i]] = (float)(i * 10U) + (float)(Test_Rand32() >> 8) * (1.0f / 16777216.0f);
+        }
+        if (n & 1U) {
+            UnifiedFilter_UpdateChannels(values);
+        } else {
+            UnifiedFilter_UpdateData(values[FILTER_CHANNEL_OIL_TEMP], values[FILTER_CHANNEL_LNG_TEMP],
+                                     values[FILTER_CHANNEL_OIL_PRESSURE], values[FILTER_CHANNEL_LNG_PRESSURE]);
+        }
+        for (uint32_t i = 0U; i < FILTER_CHANNEL_COUNT; i++) {
+            float expected;
+            float actual = UnifiedFilter_GetFiltered(channels[i]);
+            if (i < 2U) {
+                ref_exp[i] = (n == 0U) ? values[channels[i]] : UnifiedFilter_Exponential(ref_exp[i], values[channels[i]], alphas[i]);
+                expected = ref_exp[i];
+            } else {
+                expected = PlatformFilter_MovingAverageUpdate(&ref_ma[i - 2U], values[channels[i]]);
+            }
+            mismatches += (memcmp(&expected, &actual, sizeof(float)) != 0);
+        }
+    }
+    HT_CHECK(mismatches == 0);
+    HT_CHECK(UnifiedFilter_GetFilteredOilTemperature() == UnifiedFilter_GetFiltered(FILTER_CHANNEL_OIL_TEMP));
+    HT_CHECK(UnifiedFilter_GetFilteredLNGPressure() == UnifiedFilter_GetFiltered(FILTER_CHANNEL_LNG_PRESSURE));
+}
+
+static int Test_CompareFloat(const void* a, const void* b)
+{
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+// 参考实现：每个采样整窗排序求中值和MAD
+static float Ref_Hampel(float* window, uint32_t* count, uint32_t* index, float value)
+{
+    float sorted[UNIFIED_FILTER_HAMPEL_WINDOW];
+    float dev[UNIFIED_FILTER_HAMPEL_WINDOW];
+
+    window[*index] = value;
+    *index = (*index + 1U) % UNIFIED_FILTER_HAMPEL_WINDOW;
+    if (*count < UNIFIED_FILTER_HAMPEL_WINDOW) {
+        (*count)++;
+        if (*count < UNIFIED_FILTER_HAMPEL_WINDOW) {
+            return value;
+        }
+    }
+    memcpy(sorted, window, sizeof(sorted));
+    qsort(sorted, UNIFIED_FILTER_HAMPEL_WINDOW, sizeof(float), Test_CompareFloat);
+    float median = sorted[UNIFIED_FILTER_HAMPEL_WINDOW / 2U];
+    for (uint32_t i = 0U; i < UNIFIED_FILTER_HAMPEL_WINDOW; i++) {
+        dev[i] = (sorted[i] > median) ? sorted[i] - median : median - sorted[i];
+    }
+    qsort(dev, UNIFIED_FILTER_HAMPEL_WINDOW, sizeof(float), Test_CompareFloat);
+    float limit = UNIFIED_FILTER_HAMPEL_THRESHOLD * UNIFIED_FILTER_MAD_SCALE * dev[UNIFIED_FILTER_HAMPEL_WINDOW / 2U];
+    if (limit < UNIFIED_FILTER_HAMPEL_MIN_DEV) {
+        limit = UNIFIED_FILTER_HAMPEL_MIN_DEV;
+    }
+    float deviation = value - median;
+    return (deviation > limit || deviation < -limit) ? median : value;
+}
+
+static void Test_HampelMatchesSort(void)
+{
+    hampel_config_t spike = {
+        .enabled = true,
+        .window_size = UNIFIED_FILTER_HAMPEL_WINDOW,
+        .threshold = UNIFIED_FILTER_HAMPEL_THRESHOLD,
+        .min_deviation = UNIFIED_FILTER_HAMPEL_MIN_DEV
+    };
+    filter_config_t config;
+    float window[UNIFIED_FILTER_HAMPEL_WINDOW];
+    uint32_t count = 0U;
+    uint32_t index = 0U;
+    int mismatches = 0;
+
+    // 指数滤波α=1时输出即尖峰剔除级输出；样本取少量离散值，窗口内重复值多，覆盖相等值的定位与移位
+    UnifiedFilter_Init();
+    HT_CHECK(UnifiedFilter_GetChannelConfig(FILTER_CHANNEL_OIL_PRESSURE, &config));
+    config.filter_type = FILTER_TYPE_EXPONENTIAL;
+    config.alpha = 1.0f;
+    HT_CHECK(UnifiedFilter_ConfigureChannel(FILTER_CHANNEL_OIL_PRESSURE, &config));
+    HT_CHECK(UnifiedFilter_ConfigureSpikeFilter(FILTER_CHANNEL_OIL_PRESSURE, &spike));
+
+    for (uint32_t n = 0U; n < 20000U; n++) {
+        uint32_t r = Test_Rand32();
+        float value = 10.0f + (float)(r & 7U) * 0.125f;
+        if ((r >> 8) % 13U == 0U) {
+            value += ((r >> 16) & 1U) ? 4.0f : -4.0f;  // 尖峰
+        }
+        float expected = Ref_Hampel(window, &count, &index, value);
+        UnifiedFilter_UpdateData(20.0f, -100.0f, value, 5.0f);
+        float actual = UnifiedFilter_GetFiltered(FILTER_CHANNEL_OIL_PRESSURE);
+        mismatches += (memcmp(&expected, &actual, sizeof(float)) != 0);
+    }
+    HT_CHECK(mismatches == 0);
+    HT_CHECK(UnifiedFilter_GetSpikeRejectCount(FILTER_CHANNEL_OIL_PRESSURE) > 0U);
+}
+
+static void Test_BiquadActiveSections(void)
+{
+    static const biquad_coeffs_t coeffs[2] = {
+        { 0.0675f, 0.1349f, 0.0675f, -1.1430f, 0.4128f },
+        { 0.2929f, 0.5858f, 0.2929f, -0.0000f, 0.1716f }
+    };
+    hampel_config_t no_spike;
+    filter_config_t config;
+    float z1[2];
+    float z2[2];
+    int mismatches = 0;
+
+    // 一个通道2节Biquad、其余通道非Biquad：只计算已用节，与逐节标量直接II型转置逐位一致
+    UnifiedFilter_Init();
+    memset(&no_spike, 0, sizeof(no_spike));
+    HT_CHECK(UnifiedFilter_GetChannelConfig(FILTER_CHANNEL_LNG_PRESSURE, &config));
+    config.filter_type = FILTER_TYPE_BIQUAD;
+    HT_CHECK(UnifiedFilter_ConfigureChannel(FILTER_CHANNEL_LNG_PRESSURE, &config));
+    HT_CHECK(UnifiedFilter_ConfigureSpikeFilter(FILTER_CHANNEL_LNG_PRESSURE, &no_spike));
+    HT_CHECK(UnifiedFilter_SetBiquad(FILTER_CHANNEL_LNG_PRESSURE, coeffs, 2U));
+
+    for (uint32_t n = 0U; n < 5000U; n++) {
+        float x = 5.0f + (float)(Test_Rand32() >> 8) * (1.0f / 16777216.0f);
+        float v = x;
+        for (uint32_t s = 0U; s < 2U; s++) {
+            const biquad_coeffs_t* k = &coeffs[s];
+            float out;
+            if (n == 0U) {
+                // 首个样本按直流稳态初始化（与引擎相同的换算）
+                out = v * (k->b0 + k->b1 + k->b2) / (1.0f + k->a1 + k->a2);
+                z1[s] = out - k->b0 * v;
+                z2[s] = k->b2 * v - k->a2 * out;
+            }
+            out = k->b0 * v + z1[s];
+            z1[s] = k->b1 * v - k->a1 * out + z2[s];
+            z2[s] = k->b2 * v - k->a2 * out;
+            v = out;
+        }
+        UnifiedFilter_UpdateData(20.0f, -100.0f, 10.0f, x);
+        float actual = UnifiedFilter_GetFiltered(FILTER_CHANNEL_LNG_PRESSURE);
+#if UNIFIED_FILTER_BIQUAD_Q31
+        mismatches += (actual > v + 1e-3f || actual < v - 1e-3f);  // 定点引擎只比较量化误差范围
+#else
+        mismatches += (memcmp(&v, &actual, sizeof(float)) != 0);
+#endif
+    }
+    HT_CHECK(mismatches == 0);
+    HT_CHECK_NEAR(UnifiedFilter_GetFiltered(FILTER_CHANNEL_OIL_PRESSURE), 10.0f, 1e-6f);
+}
+
+int main(void)
+{
+    HT_RUN(Test_DspIntrinsics);
+    HT_RUN(Test_PackedBoxcar);
+    HT_RUN(Test_BatchedChannels);
+    HT_RUN(Test_HampelMatchesSort);
+    HT_RUN(Test_BiquadActiveSections);
+    return HT_RESULT("test_simd_batch");
+}
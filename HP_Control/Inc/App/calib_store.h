@@ -0,0 +1,327 @@
+/*!
+ * @file calib_store.h
+ * @brief 传感器标定存储模块 - DFlash持久化的单板标定数据
+ *
+ * 功能模块：
+ * - 标定镜像（版本号 + CRC32校验）保存在DFlash的A/B两页中，交替写入，掉电不丢失
+ * - 每通道标定：压力传感器增益/偏移/多点曲线/自动调零修正，温度传感器偏移/PT1000电压-电阻标定点
+ * - 旁通阀压力闭环增益调度表（油温×工作压力），随标定镜像上传和保存
+ * - 上电时将标定镜像编译为查找表，采样转换只做一次查表+插值，无逐点计算开销
+ * - 运行中更新标定时，压力查找表编译到备用缓冲后整表切换（可在中断中转换）；温度查找表在
+ *   CalibStore_Task中分步编译（约0.3s），完成前温度转换使用旧表
+ * - 支持通过CAN(CAN_MSG_PARAM_SET_ID)在线上传、读回、保存、恢复出厂标定，无需重新烧录
+ *
+ * CAN参数服务协议（扩展帧，byte0为操作码，多字节数据均为小端）：
+ * - 0x10 BEGIN   : byte1-2 镜像长度                       - 开始上传，清空暂存区
+ * - 0x11 DATA    : byte1-2 偏移, byte3-7 数据(DLC-3字节)   - 写入暂存区（中断中直接处理，不应答）
+ * - 0x12 COMMIT  : byte1-4 镜像CRC32                       - 校验并应用暂存区，系统停机时写入DFlash
+ * - 0x13 DEFAULT : byte1 非0表示同时保存                   - 恢复出厂标定
+ * - 0x14 SAVE    : 无                                       - 将当前标定写入DFlash
+ * - 0x15 READ    : byte1-2 偏移                            - 读回当前标定镜像4字节
+ * 应答帧 CAN_MSG_PARAM_ACK_ID：byte0 操作码, byte1 状态, byte2-3 偏移/镜像长度, byte4-7 数据/版本/CRC32
+ */
+
+#ifndef CALIB_STORE_H
+#define CALIB_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+#include "common_types.h"
+#include "pt1000.h"
+
+/* ============================================  Define  ============================================ */
+
+/* ==================== 标定镜像参数 ==================== */
+#define CALIB_STORE_MAGIC                 0x424C4143U // 镜像标识 "CALB"
+#define CALIB_STORE_VERSION               3U          // 镜像结构版本，结构变化时递增
+#define CALIB_STORE_VERSION_MIN           1U          // 可加载的最低版本（v1无自动调零字段，v2无增益调度表，加载时升级）
+#define CALIB_CURVE_MAX_POINTS            8U          // 压力多点曲线最大点数
+#define CALIB_PT1000_MAX_POINTS           16U         // PT1000电压-电阻标定点最大数量
+
+#define CALIB_ZERO_TRIM_LSB_V             0.0001f     // 自动调零修正量分辨率(V)，0.1mV
+
+#define CALIB_SCHED_TEMP_POINTS           6U          // 增益调度表油温断点最大数量
+#define CALIB_SCHED_PRESSURE_POINTS       4U          // 增益调度表压力断点最大数量
+
+/* ==================== DFlash存储位置 ==================== */
+#define CALIB_STORE_PAGE_A_ADDR           (DFLASH_BASE_ADDRESS)                    // 标定镜像A页
+#define CALIB_STORE_PAGE_B_ADDR           (DFLASH_BASE_ADDRESS + DFLASH_PAGE_SIZE) // 标定镜像B页
+#define CALIB_STORE_SAVE_DELAY_MS         1000U       // 偏移量修改后延时保存，合并连续修改减少擦写
+
+/* ==================== 查找表参数 ==================== */
+#define CALIB_LUT_SHIFT                   3U          // 每个查表区间覆盖 2^3 = 8 个ADC码
+#define CALIB_LUT_SIZE                    ((4096U >> CALIB_LUT_SHIFT) + 1U) // 查表节点数（含末端节点）
+
+/* ==================== CAN参数服务操作码 ==================== */
+#define CALIB_CMD_BEGIN                   0x10U       // 开始上传标定镜像
+#define CALIB_CMD_DATA                    0x11U       // 标定镜像数据段
+#define CALIB_CMD_COMMIT                  0x12U       // 校验并应用标定镜像
+#define CALIB_CMD_DEFAULT                 0x13U       // 恢复出厂标定
+#define CALIB_CMD_SAVE                    0x14U       // 保存当前标定到DFlash
+#define CALIB_CMD_READ                    0x15U       // 读回当前标定镜像
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 压力标定通道
+ */
+typedef enum {
+    CALIB_PRESSURE_OIL = 0,                   // 油压
+    CALIB_PRESSURE_LNG,                       // LNG压力
+    CALIB_PRESSURE_COUNT
+} calib_pressure_channel_id_t;
+
+/*!
+ * @brief 温度标定通道
+ */
+typedef enum {
+    CALIB_TEMP_OIL = 0,                       // 油温
+    CALIB_TEMP_LNG,                           // LNG温度
+    CALIB_TEMP_COUNT
+} calib_temp_channel_id_t;
+
+/*!
+ * @brief 参数服务应答状态
+ */
+typedef enum {
+    CALIB_STATUS_OK = 0,                      // 成功（已应用并保存）
+    CALIB_STATUS_SAVE_PENDING,                // 已应用，系统运行中，停机后自动保存
+    CALIB_STATUS_BAD_LENGTH,                  // 长度/偏移错误
+    CALIB_STATUS_BAD_CRC,                     // CRC校验失败
+    CALIB_STATUS_BAD_CONTENT,                 // 标定内容不合理（版本、点数、单调性等）
+    CALIB_STATUS_FLASH_ERROR                  // DFlash擦写失败
+} calib_status_t;
+
+/*!
+ * @brief 曲线标定点
+ */
+typedef struct {
+    float x;                                  // 输入（电压V）
+    float y;                                  // 输出（压力MPa）
+} calib_point_t;
+
+/*!
+ * @brief 压力传感器标定（4-20mA变送器，0.8-4.0V）
+ * curve_points为0时使用线性标定 P = (V - zero_voltage) * gain + offset，
+ * 否则使用多点曲线分段线性插值后再加offset；
+ * 两种方式的输入电压V均先减去自动调零修正量 zero_trim * CALIB_ZERO_TRIM_LSB_V
+ */
+typedef struct {
+    float zero_voltage;                       // 零点电压(V)
+    float gain;                               // 增益(MPa/V)
+    float offset;                             // 附加偏移(MPa)
+    float min_voltage;                        // 低于该电压输出min_output（断线）
+    float max_voltage;                        // 高于该电压输出max_output（短路/满量程）
+    float min_output;                         // 输出下限(MPa)
+    float max_output;                         // 输出上限(MPa)
+    uint8_t curve_points;                     // 多点曲线点数（0或2~CALIB_CURVE_MAX_POINTS）
+    uint8_t reserved;
+    int16_t zero_trim;                        // 自动调零修正（传感器零点漂移电压，0.1mV），v2新增，占用v1保留字节
+    calib_point_t curve[CALIB_CURVE_MAX_POINTS]; // 多点曲线，x从小到大排序
+} calib_pressure_t;
+
+/*!
+ * @brief 温度传感器标定（PT1000）
+ */
+typedef struct {
+    float offset;                             // 校准偏移量(°C)
+    float min_temp;                           // 输出下限(°C)
+    float fallback_temp;                      // 电阻超出分度表范围时的输出(°C)
+    uint8_t point_count;                      // 电压-电阻标定点数量（2~CALIB_PT1000_MAX_POINTS）
+    uint8_t reserved[3];
+    pt1000_calib_point_t points[CALIB_PT1000_MAX_POINTS]; // 标定点，电压从小到大排序
+} calib_temperature_t;
+
+/*!
+ * @brief 旁通阀压力闭环增益调度表（v3新增）
+ * temp_points为0时不启用（使用压力闭环默认增益）；pressure_points为1时仅按油温一维插值
+ */
+typedef struct {
+    uint8_t temp_points;                      // 油温断点数（0或1~CALIB_SCHED_TEMP_POINTS）
+    uint8_t pressure_points;                  // 压力断点数（1~CALIB_SCHED_PRESSURE_POINTS）
+    uint8_t reserved[6];
+    float temp_axis[CALIB_SCHED_TEMP_POINTS];         // 油温断点(°C)，严格递增
+    float pressure_axis[CALIB_SCHED_PRESSURE_POINTS]; // 压力设定值断点(MPa)，严格递增
+    platform_gain_set_t gains[CALIB_SCHED_TEMP_POINTS][CALIB_SCHED_PRESSURE_POINTS]; // kp/ki/kd/前馈开度(%)
+} calib_gain_schedule_t;
+
+/*!
+ * @brief 标定镜像头
+ */
+typedef struct {
+    uint32_t magic;                           // CALIB_STORE_MAGIC
+    uint16_t version;                         // CALIB_STORE_VERSION
+    uint16_t length;                          // 镜像总长度(字节)
+    uint32_t sequence;                        // 写入序号，A/B页中序号大者为当前镜像
+    uint32_t crc32;                           // 除crc32字段外整个镜像的CRC32
+} calib_image_header_t;
+
+/*!
+ * @brief 标定镜像（DFlash中的存储格式，长度为8字节整数倍）
+ */
+typedef struct {
+    calib_image_header_t header;
+    calib_pressure_t pressure[CALIB_PRESSURE_COUNT];
+    calib_temperature_t temperature[CALIB_TEMP_COUNT];
+    calib_gain_schedule_t gain_schedule;      // v3新增
+} calib_image_t;
+
+/* ==========================================  Functions  =========================================== */
+
+/* ==================== 初始化接口 ==================== */
+
+/*!
+ * @brief 初始化标定存储：读取DFlash中有效镜像（无则使用出厂标定）并编译查找表
+ */
+void CalibStore_Init(void);
+
+/*!
+ * @brief 标定存储后台任务：处理CAN命令、执行延时保存
+ * @param allow_flash_write 是否允许擦写DFlash（系统运行中擦写会阻塞主循环，应在停机时进行）
+ */
+void CalibStore_Task(bool allow_flash_write);
+
+/* ==================== 采样转换接口 ==================== */
+
+/*!
+ * @brief ADC原始值转换为压力（查表）
+ * @param channel 压力通道
+ * @param adc_raw ADC原始值 (0-4095)
+ * @return 压力 (MPa)
+ */
+float CalibStore_ConvertPressure(calib_pressure_channel_id_t channel, uint16_t adc_raw);
+
+/*!
+ * @brief 获取压力标定修订号（标定上传、恢复出厂、自动调零修正等使压力转换变化时递增）
+ * @return 修订号，依赖压力标定换算的模块比较该值判断是否需要重新换算
+ */
+uint32_t CalibStore_GetPressureRevision(void);
+
+/*!
+ * @brief ADC原始值转换为温度（查表，含校准偏移量）
+ * @param channel 温度通道
+ * @param adc_raw ADC原始值 (0-4095)
+ * @return 温度 (°C)
+ */
+float CalibStore_ConvertTemperature(calib_temp_channel_id_t channel, uint16_t adc_raw);
+
+/* ==================== 标定参数接口 ==================== */
+
+/*!
+ * @brief 获取温度校准偏移量
+ * @param channel 温度通道
+ * @return 校准偏移量 (°C)
+ */
+float CalibStore_GetTemperatureOffset(calib_temp_channel_id_t channel);
+
+/*!
+ * @brief 设置温度校准偏移量（立即生效，延时写入DFlash）
+ * @param channel 温度通道
+ * @param offset 校准偏移量 (°C)
+ */
+void CalibStore_SetTemperatureOffset(calib_temp_channel_id_t channel, float offset);
+
+/*!
+ * @brief 获取压力通道标称零点电压（标定输出0MPa对应的电压，不含自动调零修正）
+ * @param channel 压力通道
+ * @return 零点电压 (V)
+ */
+float CalibStore_GetPressureZeroVoltage(calib_pressure_channel_id_t channel);
+
+/*!
+ * @brief 获取压力通道自动调零修正量
+ * @param channel 压力通道
+ * @return 修正量 (V)
+ */
+float CalibStore_GetPressureZeroTrim(calib_pressure_channel_id_t channel);
+
+/*!
+ * @brief 设置压力通道自动调零修正量（立即重新编译该通道，延时写入DFlash）
+ * @param channel 压力通道
+ * @param trim_v 修正量 (V)
+ */
+void CalibStore_SetPressureZeroTrim(calib_pressure_channel_id_t channel, float trim_v);
+
+/*!
+ * @brief 获取当前标定镜像
+ * @return 标定镜像指针
+ */
+const calib_image_t* CalibStore_GetImage(void);
+
+/*!
+ * @brief 应用新的标定镜像（校验后编译查找表）
+ * @param image 标定镜像
+ * @return 校验结果
+ */
+calib_status_t CalibStore_Apply(const calib_image_t *image);
+
+/*!
+ * @brief 恢复出厂标定
+ */
+void CalibStore_RestoreDefaults(void);
+
+/*!
+ * @brief 将当前标定写入DFlash（A/B页交替写入）
+ * @return true: 成功, false: 失败
+ */
+bool CalibStore_Save(void);
+
+/*!
+ * @brief 是否有尚未写入DFlash的修改
+ * @return true: 有待保存修改
+ */
+bool CalibStore_IsSavePending(void);
+
+/*!
+ * @brief 查询增益调度表（双线性插值，缓存区间索引；非中断上下文调用）
+ * @param oil_temp 滤波后油温 (°C)
+ * @param pressure 工作压力 (MPa)
+ * @param gains 输出参数
+ * @return true: 调度表已启用, false: 未启用（gains不修改）
+ */
+bool CalibStore_LookupGains(float oil_temp, float pressure, platform_gain_set_t *gains);
+
+/*!
+ * @brief 写入增益调度表的一个节点（自整定结果），延时保存到DFlash
+ * 调度表未启用时以(oil_temp, pressure)为唯一断点建立1×1表，此时索引须为0
+ * @param temp_index 油温断点序号
+ * @param pressure_index 压力断点序号
+ * @param gains 节点参数
+ * @param oil_temp 当前油温 (°C)，仅建表时使用
+ * @param pressure 当前压力设定值 (MPa)，仅建表时使用
+ * @return CALIB_STATUS_OK, CALIB_STATUS_BAD_LENGTH(索引越界), CALIB_STATUS_BAD_CONTENT(参数非法)
+ */
+calib_status_t CalibStore_SetGainScheduleEntry(uint8_t temp_index, uint8_t pressure_index,
+                                              const platform_gain_set_t *gains, float oil_temp, float pressure);
+
+/* ==================== CAN参数服务接口 ==================== */
+
+/*!
+ * @brief 处理CAN参数设置帧（在CAN接收回调中调用）
+ * @param data 数据
+ * @param length 数据长度
+ * @return true: 已处理（属于标定命令）, false: 非标定命令
+ */
+bool CalibStore_HandleCanFrame(const uint8_t *data, uint8_t length);
+
+/* ==================== 工具接口 ==================== */
+
+/*!
+ * @brief 计算CRC32（IEEE 802.3，多项式0xEDB88320）
+ * @param crc 初始值（首次调用传0）
+ * @param data 数据
+ * @param length 数据长度
+ * @return CRC32
+ */
+uint32_t CalibStore_Crc32(uint32_t crc, const uint8_t *data, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CALIB_STORE_H */
@@ -67,6 +67,10 @@ typedef struct can_msg_info_s can_msg_info_t;
 #define CAN_MSG_SENSOR_FAST_ID      0x18FF1001U  /* 快速传感器数据 */
 #define CAN_MSG_SENSOR_SLOW_ID      0x18FF1002U  /* 慢速传感器数据 */
 #define CAN_MSG_SYSTEM_DIAG_ID      0x18FF1003U  /* 系统诊断数据 */
+#define CAN_MSG_PARAM_ACK_ID        0x18FF1004U  /* 参数设置应答 */
+#define CAN_MSG_CAPTURE_DATA_ID     0x18FF1005U  /* 压力录波数据 */
+#define CAN_MSG_SPECTRUM_ID         0x18FF1006U  /* 油压脉动频谱摘要 */
+#define CAN_MSG_VALVE_CYCLE_ID      0x18FF1007U  /* 换向周期统计摘要 */
 #define CAN_MSG_ACTUATOR_CMD_ID     0x18FF2001U  /* 执行器控制命令 */
 #define CAN_MSG_PARAM_SET_ID        0x18FF2002U  /* 参数设置命令 */
 #define CAN_MSG_PC_CONTROL_CMD_ID   0x18FF2003U  /* PC端控制算法结果命令 */
@@ -48,6 +48,17 @@ typedef enum {
     PLATFORM_STATUS_INVALID_PARAM = 3
 } platform_status_t;
 
+/* ==================== 平台无关滑动平均参数 ==================== */
+#define PLATFORM_MA_MAX_WINDOW             64U         // 滑动平均最大窗口（2的幂）
+#define PLATFORM_MA_RESUM_PERIOD           1024U       // 累加和重算周期（更新次数），限制浮点累积误差
+
+/* ==================== 平台无关定周期PID参数 ==================== */
+#define PLATFORM_PID_GAIN_FRAC_BITS        16U         // 定点PID增益小数位数（Q15.16）
+#define PLATFORM_PID_FILTER_FRAC_BITS      15U         // 定点PID微分滤波系数小数位数（Q15）
+
+/* ==================== 平台无关增益调度参数 ==================== */
+#define PLATFORM_SCHED_MAX_POINTS          8U          // 调度表每个轴的最大断点数
+
 /* ==================== 系统基础配置参数 ==================== */
 #define SYSTEM_CLOCK_FREQ_HZ               120000000    // 系统时钟频率 120MHz (已使用)
 #define SYSTEM_PRESSURE_TOLERANCE_MPA       1.0f        // 系统压力容差 (已使用)
@@ -105,6 +116,16 @@ typedef enum {
 #define BYPASS_VALVE_MIN_DUTY               0.0f        // 旁通阀最小开度(%) (已使用)
 #define BYPASS_VALVE_ADJUSTMENT_STEP        0.5f        // 旁通阀调节步长(%) (已使用)
 #define BYPASS_VALVE_FIXED_DUTY             0.0f        // 旁通阀固定开度值（检测到油压时记录） (已使用)
+#define BYPASS_PWM_MAX_COUNT                10000U      // 旁通阀PWM0计数周期(MOD)
+#define BYPASS_PWM_PRESCALER                1U          // 旁通阀PWM0时钟分频寄存器值（分频系数CLKPSC+1）
+#define BYPASS_PWM_MIN_FREQ_HZ              1000U       // 旁通阀PWM载波下限(Hz)，周期计数不超过16位MOD
+#define BYPASS_PWM_MAX_FREQ_HZ              20000U      // 旁通阀PWM载波上限(Hz)，开度分辨率仍优于0.001%
+#define BYPASS_DITHER_MAX_AMPLITUDE         5.0f        // 旁通阀低频颤振幅值上限(%)
+#define BYPASS_DITHER_MIN_FREQ_HZ           20U         // 旁通阀低频颤振频率下限(Hz)
+#define BYPASS_DITHER_MAX_FREQ_HZ           500U        // 旁通阀低频颤振频率上限(Hz)
+#define BYPASS_DITHER_DEFAULT_FREQ_HZ       100U        // 旁通阀低频颤振默认频率(Hz)
+#define BYPASS_RAMP_DEFAULT_RATE            100.0f      // 旁通阀开度默认斜率限制(%/s)，0为不限制
+#define BYPASS_RAMP_DEFAULT_ACCEL           0.0f        // 旁通阀开度默认加速度限制(%/s²)，0为不做S曲线
 
 
 /* ==================== 风冷器参数 ==================== */
@@ -175,6 +196,79 @@ typedef enum {
 #define SENSOR_VALUE_MIN_VALID             -200.0f     // 传感器最小值（放宽范围，允许传感器未连接） (已使用)
 #define SENSOR_VALUE_MAX_VALID             300.0f      // 传感器最大值（放宽范围，允许传感器未连接） (已使用)
 
+/* ==================== 原始信号合理性检测参数 ==================== */
+#define SENSOR_PLAUSIBILITY_ENABLE         1           // 原始ADC码值合理性检测使能 1:启用, 0:禁用
+#define SENSOR_PLAUS_PRESSURE_CODE_LOW     590U        // 压力码值下限 0.72V（<3.6mA，断线）
+#define SENSOR_PLAUS_PRESSURE_CODE_HIGH    3440U       // 压力码值上限 4.2V（>21mA，短路/超量程）
+#define SENSOR_PLAUS_TEMP_CODE_LOW         82U         // 温度码值下限 0.1V（PT1000短路/放大器失效）
+#define SENSOR_PLAUS_TEMP_CODE_HIGH        3685U       // 温度码值上限 4.5V（PT1000断线，放大器饱和）
+#define SENSOR_PLAUS_STUCK_WINDOW_MS       10000U      // 卡滞检测窗口(ms)：窗口内码值极差不超过容差判卡滞
+#define SENSOR_PLAUS_PRESSURE_STUCK_TOLERANCE 4U       // 压力卡滞判定容差（码值max-min）
+#define SENSOR_PLAUS_TEMP_STUCK_TOLERANCE  2U          // 温度卡滞判定容差（稳态温度/硬件平均时码值可长时间不变）
+#define SENSOR_PLAUS_STUCK_INVALIDATES     0           // 卡滞使通道无效 1:是, 0:仅诊断（Sensor_GetPlausibilityFaults可见）
+#define SENSOR_PLAUS_PRESSURE_SLEW_PER_MS  66U         // 压力最大变化率(码值/ms)，约1000MPa/s
+#define SENSOR_PLAUS_TEMP_SLEW_PER_MS      1U          // 温度最大变化率(码值/ms)，约40°C/s
+#define SENSOR_PLAUS_SLEW_NOISE_CODES      32U         // 跳变检测噪声余量(码值)
+#define SENSOR_PLAUS_DEBOUNCE_SET_MS       50U         // 连续异常持续该时间后置故障
+#define SENSOR_PLAUS_DEBOUNCE_CLEAR_MS     500U        // 连续正常持续该时间后清除故障
+#define SENSOR_PLAUS_DEFAULT_PERIOD_US     10000U      // 默认采样周期(us)，与10ms采集任务一致
+
+/* ==================== 压力自动调零参数 ==================== */
+#define SENSOR_AUTOZERO_OIL_ENABLE         1           // 油压自动调零使能 1:启用, 0:禁用
+#define SENSOR_AUTOZERO_LNG_ENABLE         0           // LNG压力自动调零使能（停机后管路仍有储罐压力，默认禁用）
+#define SENSOR_AUTOZERO_SETTLE_MS          3000U       // 停机且阀门关闭后等待压力泄放的时间(ms)
+#define SENSOR_AUTOZERO_WINDOW_SAMPLES     256U        // 零点平均窗口采样数（10ms采样约2.56s）
+#define SENSOR_AUTOZERO_STABLE_CODES       16U         // 窗口内码值波动上限，超出视为压力未稳定
+#define SENSOR_AUTOZERO_MAX_TRIM_V         0.040f      // 允许学习的最大零点偏差(V)，油压约0.5MPa
+#define SENSOR_AUTOZERO_DEADBAND_V         0.002f      // 与当前修正量差值小于该值时不更新，减少DFlash擦写
+#define SENSOR_AUTOZERO_MAX_STEP_V         0.012f      // 相邻两次学习结果的最大变化(V)，超出判漂移过快
+#define SENSOR_AUTOZERO_MAX_DRIFT_V_PER_H  0.004f      // 运行期内零点漂移速率上限(V/h)
+#define SENSOR_AUTOZERO_DRIFT_MIN_MS       600000U     // 计算漂移速率的最短间隔(ms)
+
+/* ==================== 自适应采集速率参数 ==================== */
+#define SENSOR_RATE_HIGH_PERIOD_MS         5U          // 活动状态采集/上报周期(ms)
+#define SENSOR_RATE_NORMAL_PERIOD_MS       10U         // 系统使能且信号平稳时的周期(ms)，PC端控制周期
+#define SENSOR_RATE_IDLE_PERIOD_MS         50U         // 系统未使能且信号平稳时的周期(ms)
+#define SENSOR_RATE_MIN_PERIOD_MS          2U          // 允许配置的最短周期(ms)
+#define SENSOR_RATE_MAX_PERIOD_MS          100U        // 允许配置的最长周期(ms)
+#define SENSOR_RATE_ENTER_MPA_PER_S        20.0f       // 压力变化率超过该值进入活动状态(MPa/s)
+#define SENSOR_RATE_EXIT_MPA_PER_S         8.0f        // 压力变化率低于该值才视为平稳(MPa/s)，与进入阈值构成回差
+#define SENSOR_RATE_HOLD_MS                500U        // 平稳持续该时间后周期加倍一次，逐级降到目标周期
+
+/* ==================== 压力高速采集参数 ==================== */
+#define SENSOR_STREAM_TIMER_INSTANCE       0U          // 高速采集使用的定时器实例
+#define SENSOR_STREAM_TIMER_CHANNEL        0U          // 高速采集使用的定时器通道（周期中断启动ADC1注入组转换）
+#define SENSOR_STREAM_MIN_PERIOD_US        20U         // 最小采样周期(us)，即50kHz（油压+LNG压力两次注入转换约2us）
+
+/* ==================== 换向阀定时换向参数 ==================== */
+#define DIRECTIONAL_VALVE_TIMER_INSTANCE   SENSOR_STREAM_TIMER_INSTANCE // 换向定时器实例（与高速采集共用定时器模块）
+#define DIRECTIONAL_VALVE_TIMER_CHANNEL    1U          // 换向定时器通道（每相结束中断翻转PB4）
+#define DIRECTIONAL_VALVE_MAX_FREQ_HZ      100U        // 最高换向频率(Hz)
+#define DIRECTIONAL_VALVE_DEFAULT_DUTY     50U         // 默认通电占比(%)
+#define DIRECTIONAL_VALVE_MIN_DUTY         5U          // 最小通电占比(%)
+#define DIRECTIONAL_VALVE_MAX_DUTY         95U         // 最大通电占比(%)
+
+/* ==================== 液压对象模型仿真 ==================== */
+#ifndef HP_PLANT_SIM
+#define HP_PLANT_SIM                       0           // 1: ADC码值由液压对象模型(plant_model)按阀门输出生成，台架无液压时调试
+#endif
+#define HP_PLANT_SIM_MAX_CATCHUP_MS        20U         // 采集任务推进模型的单次最长时长(ms)，约200个积分步；超出部分丢弃（仿真慢于实时）
+
+/* ==================== 旁通阀线圈电流采样 ==================== */
+#ifndef HP_VALVE_CURRENT_ENABLE
+#define HP_VALVE_CURRENT_ENABLE            0           // 1: 启用PA0分流采样与电流闭环；须先按原理图填写valve_current.h中的通道、分流电阻、放大倍数与线圈参数
+#endif
+
+/* ==================== 油压硬件超压联锁 ==================== */
+#ifndef HP_OVERPRESSURE_GUARD_ENABLE
+#define HP_OVERPRESSURE_GUARD_ENABLE       0           // 1: 启用ACMP0→PWM0故障输入硬件联锁；须先按原理图确认OVP_ACMP_INPUT_CHANNEL，输入错接或悬空会误强制旁通阀全开
+#endif
+
+/* ==================== 热点函数性能基准 ==================== */
+#ifndef HP_PERF_BENCH
+#define HP_PERF_BENCH                      0           // 1: 任务注册后、调度器启动前运行一次热点函数基准(perf_bench)并经调试串口输出
+#endif
+
 /* ==================== CAN通信参数 ==================== */
 #define CAN_MSG_BUFFER_COUNT               10U         // CAN消息缓冲区数量 (已使用)
 #define CAN_FILTER_COUNT                   16U         // CAN过滤器数量 (已使用)
@@ -216,6 +310,155 @@ typedef struct {
     platform_float32_t last_time;       // 上次时间戳
 } platform_pid_controller_t;
 
+/*!
+ * @brief 平台无关定周期PID配置（Init时换算为每周期系数）
+ */
+typedef struct {
+    platform_float32_t kp;              // 比例系数
+    platform_float32_t ki;              // 积分系数 (1/s)
+    platform_float32_t kd;              // 微分系数 (s)
+    platform_float32_t dt;              // 控制周期 (s)，由调度周期给定
+    platform_float32_t derivative_cutoff_hz; // 微分低通截止频率，<=0不滤波
+    platform_float32_t tracking_gain;   // 反算抗饱和增益 (1/s)，<=0时取ki/kp
+    platform_float32_t output_min;      // 输出下限
+    platform_float32_t output_max;      // 输出上限
+} platform_pid_config_t;
+
+/*!
+ * @brief 平台无关定周期PID（浮点）：测量值微分+低通、反算抗饱和、前馈、无扰切换
+ */
+typedef struct {
+    platform_float32_t kp;              // 比例系数
+    platform_float32_t ki_dt;           // ki*dt
+    platform_float32_t kd_dt;           // kd/dt
+    platform_float32_t kt_dt;           // 反算增益*dt（限制在0~1）
+    platform_float32_t d_beta;          // 微分低通系数
+    platform_float32_t output_min;      // 输出下限
+    platform_float32_t output_max;      // 输出上限
+    platform_float32_t integral;        // 积分项（输出单位）
+    platform_float32_t derivative;      // 滤波后微分项（输出单位）
+    platform_float32_t last_measurement; // 上次测量值
+    platform_float32_t last_error;      // 上次误差（重新整定时补偿比例项跳变）
+    platform_bool_t initialized;        // 已有上次测量值
+} platform_pidf_t;
+
+/*!
+ * @brief 平台无关定周期PID（定点）：输入输出为满量程归一化Q15，积分/微分状态Q31
+ */
+typedef struct {
+    platform_int32_t kp;                // 比例系数 Q15.16
+    platform_int32_t ki_dt;             // ki*dt Q15.16
+    platform_int32_t kd_dt;             // kd/dt Q15.16
+    platform_int32_t kt_dt;             // 反算增益*dt Q15.16
+    platform_int32_t d_beta;            // 微分低通系数 Q15
+    platform_int32_t integral;          // 积分项 Q31
+    platform_int32_t derivative;        // 滤波后微分项 Q31
+    platform_int16_t output_min;        // 输出下限 Q15
+    platform_int16_t output_max;        // 输出上限 Q15
+    platform_int16_t last_measurement;  // 上次测量值 Q15
+    platform_bool_t initialized;        // 已有上次测量值
+} platform_pidq_t;
+
+/*!
+ * @brief 调度表一组控制参数
+ */
+typedef struct {
+    platform_float32_t kp;              // 比例系数
+    platform_float32_t ki;              // 积分系数 (1/s)
+    platform_float32_t kd;              // 微分系数 (s)
+    platform_float32_t feedforward;     // 前馈输出
+} platform_gain_set_t;
+
+/*!
+ * @brief 继电器自整定的整定规则
+ */
+typedef enum {
+    PLATFORM_TUNE_RULE_TYREUS_LUYBEN_PI = 0,   // Tyreus-Luyben PI：kp=Ku/3.2, Ti=2.2Tu（超调小，默认）
+    PLATFORM_TUNE_RULE_ZN_PI,                  // Ziegler-Nichols PI：kp=0.45Ku, Ti=Tu/1.2
+    PLATFORM_TUNE_RULE_ZN_PID                  // Ziegler-Nichols PID：kp=0.6Ku, Ti=Tu/2, Td=Tu/8
+} platform_tune_rule_t;
+
+/*!
+ * @brief 继电器自整定状态
+ */
+typedef enum {
+    PLATFORM_TUNE_IDLE = 0,
+    PLATFORM_TUNE_RUNNING,                     // 继电器振荡中
+    PLATFORM_TUNE_DONE,                        // 已得到Ku/Tu与整定参数
+    PLATFORM_TUNE_FAILED                       // 越界、超时、振荡幅值不足或被中止
+} platform_tune_state_t;
+
+/*!
+ * @brief 继电器自整定配置（正作用：输出增大测量值增大）
+ */
+typedef struct {
+    platform_float32_t setpoint;        // 振荡中心
+    platform_float32_t bias;            // 继电器中心输出
+    platform_float32_t amplitude;       // 继电器幅值d，输出为bias±d
+    platform_float32_t hysteresis;      // 切换滞环ε（抑制噪声误切换）
+    platform_float32_t max_deviation;   // 测量值偏离设定值超过该值即失败
+    platform_float32_t dt;              // 采样周期 (s)
+    platform_uint32_t timeout_samples;  // 超时采样数
+    platform_uint8_t settle_cycles;     // 丢弃的起振周期数
+    platform_uint8_t measure_cycles;    // 参与平均的周期数
+    platform_tune_rule_t rule;          // 整定规则
+} platform_relay_tune_config_t;
+
+/*!
+ * @brief 继电器自整定（Astrom-Hagglund），每采样调用一次，固定运算量
+ */
+typedef struct {
+    platform_relay_tune_config_t config;
+    platform_tune_state_t state;
+    platform_int8_t relay;              // 当前继电器方向 +1/-1
+    platform_uint8_t cycles;            // 已完成的完整周期数
+    platform_uint32_t samples;          // 已执行采样数
+    platform_uint32_t last_rise;        // 上次向上切换的采样序号，0表示尚未切换
+    platform_float32_t peak_max;        // 本周期测量最大值
+    platform_float32_t peak_min;        // 本周期测量最小值
+    platform_float32_t period_sum;      // 参与平均的周期和（采样数）
+    platform_float32_t amplitude_sum;   // 参与平均的半峰峰值和
+    platform_float32_t output_sum;      // 参与平均周期内的输出和（用于估计前馈）
+    platform_uint32_t output_count;
+    platform_float32_t ku;              // 临界增益
+    platform_float32_t tu;              // 临界周期 (s)
+    platform_gain_set_t gains;          // 整定结果（feedforward为振荡期间平均输出）
+} platform_relay_tune_t;
+
+/*!
+ * @brief 调度表轴（断点严格递增，预计算区间倒数，缓存上次所在区间）
+ */
+typedef struct {
+    platform_float32_t points[PLATFORM_SCHED_MAX_POINTS];    // 断点
+    platform_float32_t inv_span[PLATFORM_SCHED_MAX_POINTS];  // 1/(points[i+1]-points[i])
+    platform_uint8_t count;             // 断点数（1表示该轴不参与插值）
+    platform_uint8_t segment;           // 缓存的区间序号，输入缓慢变化时查找为O(1)
+} platform_sched_axis_t;
+
+/*!
+ * @brief 一维/二维增益调度表：x轴×y轴，双线性插值
+ */
+typedef struct {
+    platform_sched_axis_t axis_x;       // x轴（如油温）
+    platform_sched_axis_t axis_y;       // y轴（如工作压力），count为1时退化为一维
+    const platform_gain_set_t* table;   // 参数表，table[ix * stride + iy]
+    platform_uint8_t stride;            // 行跨度（>= axis_y.count）
+} platform_gain_schedule_t;
+
+/*!
+ * @brief 平台无关滑动平均滤波器（增量累加和，O(1)更新）
+ */
+typedef struct {
+    platform_float32_t buffer[PLATFORM_MA_MAX_WINDOW]; // 环形缓冲区
+    platform_float32_t sum;             // 窗口内样本累加和
+    platform_float32_t inv_window;      // 1/窗口大小
+    platform_uint16_t resum_countdown;  // 距下次重算累加和的更新次数
+    platform_uint8_t index;             // 下一个写入位置
+    platform_uint8_t count;             // 已填充样本数（<=窗口大小）
+    platform_uint8_t window;            // 窗口大小（2的幂）
+    platform_uint8_t mask;              // 索引掩码 window-1
+} platform_moving_average_t;
+
 /*!
  * @brief 平台无关传感器数据结构体
  */
@@ -418,6 +661,126 @@ typedef struct {
     uint32_t last_valid_time;   // 最后有效时间
 } sensor_validity_status_t;
 
+/*!
+ * @brief 原始信号合理性故障位
+ */
+typedef enum {
+    SENSOR_PLAUS_OK = 0x00,             // 正常
+    SENSOR_PLAUS_OPEN = 0x01,           // 低于码值下限（断线）
+    SENSOR_PLAUS_SHORT = 0x02,          // 高于码值上限（短路/超量程）
+    SENSOR_PLAUS_STUCK = 0x04,          // 卡滞（窗口内变化不超过容差，默认仅诊断）
+    SENSOR_PLAUS_SLEW = 0x08            // 变化率超限（跳变）
+} sensor_plausibility_fault_t;
+
+/*!
+ * @brief 原始信号合理性检测配置（时间参数以ms为单位，按采样周期换算为采样数）
+ */
+typedef struct {
+    uint16_t code_low;                  // 码值下限
+    uint16_t code_high;                 // 码值上限
+    uint16_t slew_codes_per_ms;         // 最大变化率(码值/ms)，0禁用
+    uint16_t slew_noise_codes;          // 变化率检测噪声余量(码值)
+    uint16_t stuck_tolerance;           // 卡滞判定容差(码值)
+    uint32_t stuck_window_ms;           // 卡滞检测窗口(ms)，0禁用
+    bool stuck_invalidates;             // 卡滞参与有效性判定（false时仅诊断）
+    uint32_t debounce_set_ms;           // 置故障去抖时间(ms)
+    uint32_t debounce_clear_ms;         // 清故障去抖时间(ms)
+    bool enabled;                       // 检测使能
+} sensor_plausibility_config_t;
+
+/*!
+ * @brief 原始信号合理性检测状态（逐采样更新，仅整数运算）
+ */
+typedef struct {
+    // 按采样周期换算后的参数
+    uint16_t slew_limit;                // 相邻采样最大差值(码值)
+    uint16_t stuck_window;              // 卡滞窗口(采样数)
+    uint16_t debounce_set;              // 置故障采样数
+    uint16_t debounce_clear;            // 清故障采样数
+    // 运行状态
+    uint16_t last_code;                 // 上次码值
+    uint16_t window_min;                // 当前窗口最小码值
+    uint16_t window_max;                // 当前窗口最大码值
+    uint16_t window_count;              // 当前窗口采样数
+    uint16_t bad_count;                 // 连续异常采样数
+    uint16_t good_count;                // 连续正常采样数
+    uint8_t violation;                  // 本次采样的原始异常位
+    uint8_t faults;                     // 去抖后的故障位
+    bool stuck;                         // 上一窗口判定卡滞
+    bool has_last;                      // last_code有效
+    bool valid;                         // 通道数据有效
+    uint32_t fault_events;              // 故障置位次数
+} sensor_plausibility_state_t;
+
+/*!
+ * @brief 压力自动调零状态标志
+ */
+typedef enum {
+    SENSOR_AUTOZERO_FLAG_NONE = 0x00,
+    SENSOR_AUTOZERO_FLAG_LEARNED = 0x01,        // 本次上电已完成零点学习
+    SENSOR_AUTOZERO_FLAG_OUT_OF_RANGE = 0x02,   // 学习结果超出允许范围，未应用
+    SENSOR_AUTOZERO_FLAG_DRIFT = 0x04           // 零点漂移过快（保持至重新上电）
+} sensor_autozero_flag_t;
+
+/*!
+ * @brief 压力自动调零通道状态
+ */
+typedef struct {
+    bool enabled;                       // 通道参与自动调零
+    uint8_t flags;                      // sensor_autozero_flag_t位组合
+    uint16_t window_count;              // 当前窗口采样数
+    uint16_t window_min;                // 当前窗口码值最小值
+    uint16_t window_max;                // 当前窗口码值最大值
+    uint32_t window_sum;                // 当前窗口码值累加
+    float measured_v;                   // 最近一次窗口测得的零点偏差(V)
+    float last_learned_v;               // 上次学习结果(V)
+    float drift_rate_v_per_h;           // 最近一次计算的漂移速率(V/h)
+    uint32_t last_learn_time;           // 上次学习时刻(ms)
+    uint32_t learn_count;               // 学习次数
+} sensor_autozero_state_t;
+
+/*!
+ * @brief 自适应采集速率配置
+ */
+typedef struct {
+    uint16_t high_period_ms;            // 活动状态周期(ms)
+    uint16_t normal_period_ms;          // 系统使能时的平稳周期(ms)
+    uint16_t idle_period_ms;            // 系统未使能时的平稳周期(ms)
+    uint16_t hold_ms;                   // 降速步进间隔(ms)
+    float enter_rate_mpa_s;             // 进入活动状态的压力变化率(MPa/s)
+    float exit_rate_mpa_s;              // 退出活动状态的压力变化率(MPa/s)
+} sensor_rate_config_t;
+
+/*!
+ * @brief 自适应采集速率状态
+ */
+typedef struct {
+    uint16_t period_ms;                 // 当前采集/上报周期(ms)
+    bool active;                        // 活动状态（变化率超限/换向阀动作/换向频率非0）
+    float pressure_rate_mpa_s;          // 最近一次油压/LNG压力变化率绝对值的较大者(MPa/s)
+    float last_oil_pressure;            // 上次油压(MPa)
+    float last_lng_pressure;            // 上次LNG压力(MPa)
+    uint32_t last_sample_time;          // 上次采样时刻(ms)
+    uint32_t last_change_time;          // 上次活动或降速时刻(ms)
+    uint32_t switch_count;              // 周期切换次数
+    bool has_last;                      // last_*有效
+} sensor_rate_state_t;
+
+/*!
+ * @brief 压力高速采集回调（在定时器中断中逐采样调用，须短小且不可阻塞）
+ * @param oil_pressure_raw 油压ADC原始值 (0-4095)
+ * @param lng_pressure_raw LNG压力ADC原始值 (0-4095)
+ */
+typedef void (*sensor_stream_callback_t)(uint16_t oil_pressure_raw, uint16_t lng_pressure_raw);
+
+/*!
+ * @brief 压力高速采集旁路监听回调（定时器中断中逐采样调用，不占用采集流，采集流由谁启动都会收到）
+ * @param oil_pressure_raw 油压ADC原始值 (0-4095)
+ * @param period_us 当前采样周期 (us)
+ * @param restarted 采集流（重新）启动后的首个采样，与上一采样之间可能有间隔
+ */
+typedef void (*sensor_stream_observer_t)(uint16_t oil_pressure_raw, uint32_t period_us, bool restarted);
+
 /* ==================== 阀门相关结构体 ==================== */
 /*!
  * @brief 阀门响应状态结构体
@@ -606,7 +969,174 @@ platform_float32_t PlatformPID_Calculate(platform_pid_controller_t* pid, platfor
 void PlatformPID_Reset(platform_pid_controller_t* pid);
 
 /*!
- * @brief 平台无关滤波算法
+ * @brief 初始化定周期PID（浮点）
+ * @param pid PID控制器指针
+ * @param config 配置（dt>0，output_min<output_max）
+ * @return PLATFORM_STATUS_OK 或 PLATFORM_STATUS_INVALID_PARAM
+ */
+platform_status_t PlatformPIDF_Init(platform_pidf_t* pid, const platform_pid_config_t* config);
+
+/*!
+ * @brief 定周期PID计算一步（浮点，固定运算量）
+ * @param pid PID控制器指针
+ * @param setpoint 设定值
+ * @param measurement 测量值
+ * @param feedforward 前馈量（直接叠加到输出）
+ * @return 限幅后输出
+ */
+platform_float32_t PlatformPIDF_Update(platform_pidf_t* pid, platform_float32_t setpoint,
+                                       platform_float32_t measurement, platform_float32_t feedforward);
+
+/*!
+ * @brief 无扰切换：按当前执行器输出反推积分项（手动→自动或切换控制器前调用）
+ * @param pid PID控制器指针
+ * @param setpoint 设定值
+ * @param measurement 测量值
+ * @param feedforward 前馈量
+ * @param output 当前执行器输出
+ */
+void PlatformPIDF_Bumpless(platform_pidf_t* pid, platform_float32_t setpoint, platform_float32_t measurement,
+                           platform_float32_t feedforward, platform_float32_t output);
+
+/*!
+ * @brief 清除定周期PID状态（浮点）
+ * @param pid PID控制器指针
+ */
+void PlatformPIDF_Reset(platform_pidf_t* pid);
+
+/*!
+ * @brief 运行中重新整定（增益/限值变化），保留积分与微分状态并补偿比例项，输出不跳变
+ * @param pid PID控制器指针
+ * @param config 新配置
+ * @return PLATFORM_STATUS_OK 或 PLATFORM_STATUS_INVALID_PARAM（保持原参数）
+ */
+platform_status_t PlatformPIDF_Retune(platform_pidf_t* pid, const platform_pid_config_t* config);
+
+/*!
+ * @brief 初始化定周期PID（定点），config中增益按输入/输出满量程归一化
+ * @param pid PID控制器指针
+ * @param config 配置（output_min/max在-1~1之间）
+ * @return PLATFORM_STATUS_OK 或 PLATFORM_STATUS_INVALID_PARAM
+ */
+platform_status_t PlatformPIDQ_Init(platform_pidq_t* pid, const platform_pid_config_t* config);
+
+/*!
+ * @brief 定周期PID计算一步（定点，Q15输入输出）
+ * @param pid PID控制器指针
+ * @param setpoint 设定值 Q15
+ * @param measurement 测量值 Q15
+ * @param feedforward 前馈量 Q15
+ * @return 限幅后输出 Q15
+ */
+platform_int16_t PlatformPIDQ_Update(platform_pidq_t* pid, platform_int16_t setpoint,
+                                     platform_int16_t measurement, platform_int16_t feedforward);
+
+/*!
+ * @brief 无扰切换（定点）
+ * @param pid PID控制器指针
+ * @param setpoint 设定值 Q15
+ * @param measurement 测量值 Q15
+ * @param feedforward 前馈量 Q15
+ * @param output 当前执行器输出 Q15
+ */
+void PlatformPIDQ_Bumpless(platform_pidq_t* pid, platform_int16_t setpoint, platform_int16_t measurement,
+                           platform_int16_t feedforward, platform_int16_t output);
+
+/*!
+ * @brief 清除定周期PID状态（定点）
+ * @param pid PID控制器指针
+ */
+void PlatformPIDQ_Reset(platform_pidq_t* pid);
+
+/*!
+ * @brief 启动继电器自整定
+ * @param tune 自整定指针
+ * @param config 配置（amplitude>hysteresis>=0，dt>0，measure_cycles>0）
+ * @return PLATFORM_STATUS_OK 或 PLATFORM_STATUS_INVALID_PARAM
+ */
+platform_status_t PlatformRelayTune_Start(platform_relay_tune_t* tune, const platform_relay_tune_config_t* config);
+
+/*!
+ * @brief 自整定一步：按测量值切换继电器，完整周期结束时累计周期与幅值
+ * @param tune 自整定指针
+ * @param measurement 测量值
+ * @return 本周期输出（未运行时为bias）
+ */
+platform_float32_t PlatformRelayTune_Update(platform_relay_tune_t* tune, platform_float32_t measurement);
+
+/*!
+ * @brief 中止自整定（状态置为失败）
+ * @param tune 自整定指针
+ */
+void PlatformRelayTune_Abort(platform_relay_tune_t* tune);
+
+/*!
+ * @brief 初始化调度表轴
+ * @param axis 轴指针
+ * @param points 断点（严格递增）
+ * @param count 断点数 (1~PLATFORM_SCHED_MAX_POINTS)
+ * @return PLATFORM_STATUS_OK 或 PLATFORM_STATUS_INVALID_PARAM
+ */
+platform_status_t PlatformSchedule_AxisInit(platform_sched_axis_t* axis, const platform_float32_t* points, platform_uint8_t count);
+
+/*!
+ * @brief 定位输入所在区间（从缓存区间向相邻区间移动），超出两端时钳位
+ * @param axis 轴指针
+ * @param value 输入值
+ * @return 区间内插值比例 (0~1)，区间序号见axis->segment
+ */
+platform_float32_t PlatformSchedule_AxisLocate(platform_sched_axis_t* axis, platform_float32_t value);
+
+/*!
+ * @brief 初始化增益调度表
+ * @param sched 调度表指针
+ * @param x_points x轴断点
+ * @param x_count x轴断点数
+ * @param y_points y轴断点（y_count为1时可为单点）
+ * @param y_count y轴断点数
+ * @param table 参数表，table[ix * stride + iy]，须在调度表使用期间保持有效
+ * @param stride 行跨度
+ * @return PLATFORM_STATUS_OK 或 PLATFORM_STATUS_INVALID_PARAM
+ */
+platform_status_t PlatformSchedule_Init(platform_gain_schedule_t* sched,
+                                        const platform_float32_t* x_points, platform_uint8_t x_count,
+                                        const platform_float32_t* y_points, platform_uint8_t y_count,
+                                        const platform_gain_set_t* table, platform_uint8_t stride);
+
+/*!
+ * @brief 查询增益调度表（双线性插值，超出范围按边界值）
+ * @param sched 调度表指针
+ * @param x x轴输入
+ * @param y y轴输入
+ * @param gains 输出参数
+ */
+void PlatformSchedule_Lookup(platform_gain_schedule_t* sched, platform_float32_t x, platform_float32_t y,
+                             platform_gain_set_t* gains);
+
+/*!
+ * @brief 初始化滑动平均滤波器
+ * @param ma 滤波器指针
+ * @param window 窗口大小，向下取整为2的幂并限制在1~PLATFORM_MA_MAX_WINDOW
+ */
+void PlatformFilter_MovingAverageInit(platform_moving_average_t* ma, platform_uint8_t window);
+
+/*!
+ * @brief 滑动平均滤波器更新（O(1)，与窗口大小无关）
+ * @param ma 滤波器指针
+ * @param new_value 新值
+ * @return 滤波后值（窗口未填满时为已有样本均值）
+ */
+platform_float32_t PlatformFilter_MovingAverageUpdate(platform_moving_average_t* ma, platform_float32_t new_value);
+
+/*!
+ * @brief 获取滑动平均滤波器当前输出
+ * @param ma 滤波器指针
+ * @return 滤波后值，无样本时为0
+ */
+platform_float32_t PlatformFilter_MovingAverageGet(const platform_moving_average_t* ma);
+
+/*!
+ * @brief 平台无关滤波算法（兼容接口，每次重算整个窗口，新代码使用PlatformFilter_MovingAverageUpdate）
  * @param buffer 滤波缓冲区
  * @param index 当前索引指针
  * @param window_size 窗口大小
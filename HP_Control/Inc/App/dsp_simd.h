@@ -0,0 +1,129 @@
+/*!
+ * @file dsp_simd.h
+ * @brief Cortex-M4 DSP/SIMD指令封装 - 打包16位（半字）整数运算
+ *
+ * 说明：
+ * - 打包格式：32位字中低半字为第0个元素（复数为实部），高半字为第1个元素（复数为虚部）
+ * - 目标为Cortex-M4（ARMCC定义__TARGET_FEATURE_DSPMUL，armclang/GCC定义__ARM_FEATURE_DSP）时
+ *   直接使用CMSIS内建指令，每条单周期；否则使用语义相同的C实现，便于在无DSP扩展的平台上编译
+ */
+
+#ifndef DSP_SIMD_H
+#define DSP_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+
+#if defined(__TARGET_FEATURE_DSPMUL) || (defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+#include "ac7840x.h"
+#define DSP_SIMD_HW                       1           // 使用硬件SIMD指令
+#else
+#define DSP_SIMD_HW                       0
+#endif
+
+/* ============================================  Define  ============================================ */
+
+#define DSP_LO16(x)                       ((int32_t)(int16_t)((x) & 0xFFFFU))
+#define DSP_HI16(x)                       ((int32_t)(int16_t)((uint32_t)(x) >> 16))
+
+/* ==========================================  Functions  =========================================== */
+
+/*!
+ * @brief 打包两个16位数：lo为低半字，hi为高半字
+ */
+static inline uint32_t DSP_Pack16(int16_t lo, int16_t hi)
+{
+    return (uint32_t)(uint16_t)lo | ((uint32_t)(uint16_t)hi << 16);
+}
+
+#if DSP_SIMD_HW
+
+/* lo(x)*lo(y) + hi(x)*hi(y) */
+static inline int32_t DSP_Smuad(uint32_t x, uint32_t y) { return (int32_t)__SMUAD(x, y); }
+/* acc + lo(x)*lo(y) + hi(x)*hi(y) */
+static inline int32_t DSP_Smlad(uint32_t x, uint32_t y, int32_t acc) { return (int32_t)__SMLAD(x, y, (uint32_t)acc); }
+/* lo(x)*lo(y) - hi(x)*hi(y) */
+static inline int32_t DSP_Smusd(uint32_t x, uint32_t y) { return (int32_t)__SMUSD(x, y); }
+/* lo(x)*hi(y) - hi(x)*lo(y) */
+static inline int32_t DSP_Smusdx(uint32_t x, uint32_t y) { return (int32_t)__SMUSDX(x, y); }
+/* 逐半字加（回绕） */
+static inline uint32_t DSP_Sadd16(uint32_t x, uint32_t y) { return __SADD16(x, y); }
+/* 逐半字减（回绕） */
+static inline uint32_t DSP_Ssub16(uint32_t x, uint32_t y) { return __SSUB16(x, y); }
+/* 逐半字 (x + y) >> 1 */
+static inline uint32_t DSP_Shadd16(uint32_t x, uint32_t y) { return __SHADD16(x, y); }
+/* 逐半字 (x - y) >> 1 */
+static inline uint32_t DSP_Shsub16(uint32_t x, uint32_t y) { return __SHSUB16(x, y); }
+/* 逐半字饱和加 */
+static inline uint32_t DSP_Qadd16(uint32_t x, uint32_t y) { return __QADD16(x, y); }
+/* 逐半字饱和减 */
+static inline uint32_t DSP_Qsub16(uint32_t x, uint32_t y) { return __QSUB16(x, y); }
+
+#else
+
+static inline int32_t DSP_Sat16(int32_t v)
+{
+    return (v > 32767) ? 32767 : ((v < -32768) ? -32768 : v);
+}
+
+static inline int32_t DSP_Smuad(uint32_t x, uint32_t y)
+{
+    return (int32_t)((uint32_t)(DSP_LO16(x) * DSP_LO16(y)) + (uint32_t)(DSP_HI16(x) * DSP_HI16(y)));
+}
+
+static inline int32_t DSP_Smlad(uint32_t x, uint32_t y, int32_t acc)
+{
+    return (int32_t)((uint32_t)acc + (uint32_t)DSP_Smuad(x, y));
+}
+
+static inline int32_t DSP_Smusd(uint32_t x, uint32_t y)
+{
+    return DSP_LO16(x) * DSP_LO16(y) - DSP_HI16(x) * DSP_HI16(y);
+}
+
+static inline int32_t DSP_Smusdx(uint32_t x, uint32_t y)
+{
+    return DSP_LO16(x) * DSP_HI16(y) - DSP_HI16(x) * DSP_LO16(y);
+}
+
+static inline uint32_t DSP_Sadd16(uint32_t x, uint32_t y)
+{
+    return DSP_Pack16((int16_t)(DSP_LO16(x) + DSP_LO16(y)), (int16_t)(DSP_HI16(x) + DSP_HI16(y)));
+}
+
+static inline uint32_t DSP_Ssub16(uint32_t x, uint32_t y)
+{
+    return DSP_Pack16((int16_t)(DSP_LO16(x) - DSP_LO16(y)), (int16_t)(DSP_HI16(x) - DSP_HI16(y)));
+}
+
+static inline uint32_t DSP_Shadd16(uint32_t x, uint32_t y)
+{
+    return DSP_Pack16((int16_t)((DSP_LO16(x) + DSP_LO16(y)) >> 1), (int16_t)((DSP_HI16(x) + DSP_HI16(y)) >> 1));
+}
+
+static inline uint32_t DSP_Shsub16(uint32_t x, uint32_t y)
+{
+    return DSP_Pack16((int16_t)((DSP_LO16(x) - DSP_LO16(y)) >> 1), (int16_t)((DSP_HI16(x) - DSP_HI16(y)) >> 1));
+}
+
+static inline uint32_t DSP_Qadd16(uint32_t x, uint32_t y)
+{
+    return DSP_Pack16((int16_t)DSP_Sat16(DSP_LO16(x) + DSP_LO16(y)), (int16_t)DSP_Sat16(DSP_HI16(x) + DSP_HI16(y)));
+}
+
+static inline uint32_t DSP_Qsub16(uint32_t x, uint32_t y)
+{
+    return DSP_Pack16((int16_t)DSP_Sat16(DSP_LO16(x) - DSP_LO16(y)), (int16_t)DSP_Sat16(DSP_HI16(x) - DSP_HI16(y)));
+}
+
+#endif /* DSP_SIMD_HW */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_SIMD_H */
@@ -65,6 +65,12 @@ bool FaultDiagnosis_CheckValveResponse(void);
  */
 valve_response_t FaultDiagnosis_GetValveResponse(void);
 
+/*!
+ * @brief 记录一个换向周期（换向周期统计模块每完成一个周期调用）
+ * @param responded 周期内油压是否响应
+ */
+void FaultDiagnosis_RecordValveCycle(bool responded);
+
 /*!
  * @brief 阀门故障诊断
  */
@@ -128,6 +128,14 @@ void OptimizedTaskScheduler_Stop(void);
  */
 void OptimizedTaskScheduler_Update(void);
 
+/*!
+ * @brief 执行一轮任务分发：按优先级运行到期任务
+ * @param loop_time 本轮时间戳(ms)
+ * @param next_task_time 输出距最近一个未到期任务的时间(ms)，无则为UINT32_MAX；可为NULL
+ * @return true: 本轮执行了任务
+ */
+bool OptimizedTaskScheduler_Dispatch(uint32_t loop_time, uint32_t *next_task_time);
+
 /*!
  * @brief 执行任务调度器主循环
  */
@@ -169,6 +177,14 @@ bool OptimizedTaskScheduler_SetTaskEnabled(int32_t task_id, bool enabled);
  */
 bool OptimizedTaskScheduler_SetTaskSuspended(int32_t task_id, bool suspended);
 
+/*!
+ * @brief 修改任务周期（下一次调度起生效）
+ * @param task_id 任务ID
+ * @param period_ms 新的任务周期(ms)
+ * @return true: 成功, false: 失败
+ */
+bool OptimizedTaskScheduler_SetTaskPeriod(int32_t task_id, uint32_t period_ms);
+
 /*!
  * @brief 检查调度器是否正在运行
  * @return true: 正在运行, false: 已停止
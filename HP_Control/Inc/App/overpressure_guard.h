@@ -0,0 +1,106 @@
+/*!
+ * @file overpressure_guard.h
+ * @brief 油压硬件超压联锁 - ACMP比较油压信号与DAC阈值，经CTU送入PWM0故障输入，不经CPU强制旁通阀全开
+ *
+ * 功能模块：
+ * - 比较器：ACMP0正端接油压传感器信号，负端接内部8位DAC（VDD参考），油压超过阈值时输出高电平
+ * - 故障路由：ACMP0_OUT → TRGMUX → CTU(PWM0_FAULT0选择TRGMUX) → PWM0故障输入0
+ * - 动作：PWM0故障控制（手动清除）将旁通阀通道(CH2)强制为无效电平，按现有驱动极性即线圈全通电、
+ *   旁通阀全开，与软件超压保护动作一致；比较器翻转到输出被强制只有硬件延迟（微秒级）
+ * - 软件侧：故障中断只记录并关闭自身中断；安全检查任务执行与软件超压相同的停机动作；
+ *   比较器输出回落并保持 OVP_RECOVER_HOLD_MS 后由本模块清除故障标志，PWM恢复软件指令输出
+ * - 阈值按工程单位(MPa)设置，按当前油压标定反算DAC码值（DAC分辨率约VDD/256）；标定上传、
+ *   恢复出厂或自动调零修正后由任务按新标定重新换算，动作阈值始终对应设定的MPa值
+ * - 默认不启用（HP_OVERPRESSURE_GUARD_ENABLE为0）：比较器输入引脚按原理图确认后再打开
+ * - 换向阀为GPIO驱动，不在硬件联锁范围内，由安全检查任务关闭
+ *
+ * CAN协议（参数设置帧 CAN_MSG_PARAM_SET_ID，byte0为操作码）：
+ * - 0x55 OVERPRESSURE_GUARD: byte1-2 动作阈值(0.01MPa，0为仅查询) - 立即生效，掉电不保存
+ * 应答帧 CAN_MSG_PARAM_ACK_ID：byte0 操作码, byte1 结果, byte2 状态(OVP_STATUS_xxx),
+ *   byte3 DAC码值, byte4-5 实际动作阈值(0.01MPa), byte6-7 累计动作次数
+ */
+
+#ifndef OVERPRESSURE_GUARD_H
+#define OVERPRESSURE_GUARD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+#include "common_types.h"
+
+/* ============================================  Define  ============================================ */
+
+/* ==================== 比较器硬件 ==================== */
+#define OVP_ACMP_INSTANCE                 0U          // ACMP0
+#define OVP_ACMP_INPUT_CHANNEL            2U          // 油压信号PD2并接的ACMP0外部通道（按硬件原理图修改，确认后打开HP_OVERPRESSURE_GUARD_ENABLE）
+#define OVP_DAC_REFERENCE_V               5.0f        // DAC参考电压VDD(V)，与传感器供电一致
+#define OVP_DAC_STEPS                     256.0f      // DAC输出 = VDD × 码值 / 256
+
+/* ==================== 阈值与恢复 ==================== */
+#define OVP_DEFAULT_THRESHOLD_MPA         38.0f       // 上电默认动作阈值(MPa)，油压传感器满量程40MPa以内
+#define OVP_MIN_THRESHOLD_MPA             5.0f        // 允许设置的最低阈值(MPa)，防止误设导致无法建压
+#define OVP_RECOVER_HOLD_MS               500U        // 比较器回落后保持时间(ms)，之后清除故障恢复PWM输出
+
+/* ==================== CAN操作码 ==================== */
+#define OVP_CMD_OVERPRESSURE_GUARD        0x55U       // 设置/查询硬件超压联锁
+
+/* ==================== 状态位 ==================== */
+#define OVP_STATUS_READY                  0x01U       // 联锁已配置（未启用或仿真模式下为0）
+#define OVP_STATUS_TRIPPED                0x02U       // 已动作，PWM输出被故障控制锁定
+#define OVP_STATUS_COMPARATOR_HIGH        0x04U       // 比较器当前输出高（油压高于阈值）
+
+/* ==========================================  Functions  =========================================== */
+
+/*!
+ * @brief 初始化比较器与故障路由（需在PWM0与传感器模块初始化之后调用）
+ */
+void OverpressureGuard_Init(void);
+
+/*!
+ * @brief 按工程单位设置动作阈值（换算为DAC码值，立即生效）
+ * @param threshold_mpa 动作阈值(MPa)
+ * @return 阈值低于OVP_MIN_THRESHOLD_MPA或超出当前标定可测范围时返回false，阈值不变
+ */
+bool OverpressureGuard_SetThreshold(float threshold_mpa);
+
+/*!
+ * @brief 获取实际动作阈值（DAC量化后按标定换算）
+ * @return 阈值(MPa)
+ */
+float OverpressureGuard_GetThreshold(void);
+
+/*!
+ * @brief 硬件联锁是否处于动作状态（故障中断置位，恢复后清除）
+ */
+bool OverpressureGuard_IsTripped(void);
+
+/*!
+ * @brief 获取状态位（OVP_STATUS_xxx）
+ */
+uint8_t OverpressureGuard_GetStatus(void);
+
+/*!
+ * @brief 获取上电以来的动作次数
+ */
+uint16_t OverpressureGuard_GetTripCount(void);
+
+/*!
+ * @brief CAN参数设置帧入口（CAN接收中断中调用，只做拷贝）
+ * @return 操作码属于本模块时返回true
+ */
+bool OverpressureGuard_HandleCanFrame(const uint8_t *data, uint8_t length);
+
+/*!
+ * @brief 周期任务（10ms）：记录动作，比较器回落后恢复PWM输出，压力标定变化后重新换算阈值，处理CAN命令
+ */
+void OverpressureGuard_Task(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OVERPRESSURE_GUARD_H */
@@ -0,0 +1,46 @@
+/*!
+ * @file perf_bench.h
+ * @brief 热点函数性能基准 - 每1~10ms执行的转换、滤波、DBC打包、PID和任务分发的单次开销
+ *
+ * 功能模块：
+ * - 每项基准循环PERF_BENCH_ITERATIONS次，重复PERF_BENCH_REPEATS轮取最小值，抑制中断干扰
+ * - 结果扣除空循环开销，目标板上单位为CPU周期（DWT CYCCNT），PC端为纳秒（CLOCK_MONOTONIC）
+ * - 输出为固定格式文本，不同固件版本的结果可直接diff，发现性能回退
+ *
+ * 输出格式（每行一项，名称与顺序固定）：
+ *   PERF begin v1 unit=<cyc|ns> iter=<N> repeat=<R>
+ *   PERF <名称> <单次开销，保留1位小数>
+ *   PERF end
+ * 任务分发在调度器启动前测量（所有任务均未到期，只统计扫描开销），条件不满足时输出 skip
+ */
+
+#ifndef PERF_BENCH_H
+#define PERF_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+#include "common_types.h"
+
+/* ============================================  Define  ============================================ */
+
+#define PERF_BENCH_ITERATIONS             1000U       // 每轮循环次数
+#define PERF_BENCH_REPEATS                5U          // 重复轮数（取最小值）
+
+/* ==========================================  Functions  =========================================== */
+
+/*!
+ * @brief 运行全部基准并经调试串口(printf)输出
+ * 需在任务调度器启动前调用；运行后复位统一滤波器状态
+ */
+void PerfBench_Run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERF_BENCH_H */
@@ -0,0 +1,115 @@
+/*!
+ * @file plant_model.h
+ * @brief 液压对象模型 - 泵、旁通阀、溢流阀、换向阀负载、蓄能器与油温/LNG的集总参数模型
+ *
+ * 功能模块：
+ * - 只依赖common_types.h与math.h，不调用任何驱动，可在PC端编译运行（与平台算法库相同）
+ * - 高压腔油压：dP/dt = (Q泵 - Q旁通 - Q溢流 - Q负载 - Q泄漏) / (V/β + 蓄能器容腔)
+ * - 旁通阀：PWM开度经死区映射为阀芯开度，一阶阀芯动态，孔口流量 Q = k·x·√P
+ * - 蓄能器：等温气体，油压高于预充压力后提供容腔 V0·p0/P²
+ * - 油温：节流损失P·Q全部转为热量，风冷器与环境散热；LNG压力按增压比一阶跟随油压
+ * - 内部按PLANT_MODEL_MAX_STEP_S细分步长，调用方按任意周期推进
+ *
+ * 用途：
+ * - 台架无液压系统时由传感器模块（HP_PLANT_SIM=1）以模型输出代替ADC采样，驱动
+ *   传感器→滤波→安全检查→闭环→阀门的完整链路
+ * - PC端以模型推进时间可远快于实时，用于控制与保护行为的回归和算法性能评估
+ */
+
+#ifndef PLANT_MODEL_H
+#define PLANT_MODEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include "common_types.h"
+
+/* ============================================  Define  ============================================ */
+
+#define PLANT_MODEL_MAX_STEP_S            0.0001f     // 内部积分最大步长(s)
+#define PLANT_MODEL_ATM_MPA               0.1f        // 大气压(MPa)，蓄能器气体按绝对压力计算
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 模型参数
+ */
+typedef struct {
+    platform_float32_t pump_flow_lpm;         // 泵额定流量(L/min)
+    platform_float32_t pump_leak_lpm_mpa;     // 泵及系统内泄漏(L/min/MPa)
+    platform_float32_t bypass_k;              // 旁通阀全开流量系数(L/min/√MPa)
+    platform_float32_t bypass_dead_duty;      // 旁通阀开度死区(%)
+    platform_float32_t bypass_full_duty;      // 旁通阀全开对应开度(%)
+    platform_float32_t bypass_tau_s;          // 阀芯时间常数(s)
+    platform_float32_t relief_crack_mpa;      // 溢流阀开启压力(MPa)
+    platform_float32_t relief_gain_lpm_mpa;   // 溢流阀流量增益(L/min/MPa)
+    platform_float32_t load_k;                // 换向阀打开时负载流量系数(L/min/√MPa)
+    platform_float32_t volume_l;              // 高压腔油液容积(L)
+    platform_float32_t bulk_modulus_mpa;      // 油液体积弹性模量(MPa)
+    platform_float32_t acc_precharge_mpa;     // 蓄能器预充压力(MPa，表压)，0为无蓄能器
+    platform_float32_t acc_volume_l;          // 蓄能器容积(L)
+    platform_float32_t oil_heat_capacity_j_k; // 油液热容(J/K)
+    platform_float32_t cooler_w_k;            // 风冷器换热系数(W/K)
+    platform_float32_t ambient_w_k;           // 环境散热系数(W/K)
+    platform_float32_t ambient_c;             // 环境温度(°C)
+    platform_float32_t lng_ratio;             // LNG压力/油压增压比
+    platform_float32_t lng_tau_s;             // LNG压力跟随时间常数(s)
+    platform_float32_t lng_temp_c;            // LNG温度(°C)
+} plant_model_params_t;
+
+/*!
+ * @brief 模型输入（执行器状态）
+ */
+typedef struct {
+    platform_float32_t pump_speed;            // 泵转速比例(0~1)
+    platform_float32_t bypass_duty;           // 旁通阀PWM开度(%)
+    bool directional_valve;                   // 换向阀通电
+    bool cooler;                              // 风冷器运行
+} plant_model_inputs_t;
+
+/*!
+ * @brief 模型状态
+ */
+typedef struct {
+    plant_model_params_t params;
+    platform_float32_t time_s;                // 模型时间(s)
+    platform_float32_t oil_pressure_mpa;      // 高压腔油压(MPa)
+    platform_float32_t bypass_opening;        // 阀芯开度(0~1)
+    platform_float32_t oil_temp_c;            // 油温(°C)
+    platform_float32_t lng_pressure_mpa;      // LNG压力(MPa)
+    platform_float32_t flow_bypass_lpm;       // 旁通流量(L/min)
+    platform_float32_t flow_relief_lpm;       // 溢流流量(L/min)
+    platform_float32_t flow_load_lpm;         // 负载流量(L/min)
+} plant_model_t;
+
+/* ==========================================  Functions  =========================================== */
+
+/*!
+ * @brief 获取默认参数（20L/min泵，旁通阀50%开度全开时约3MPa，溢流阀18MPa）
+ * @param params 输出参数
+ */
+void PlantModel_DefaultParams(plant_model_params_t* params);
+
+/*!
+ * @brief 初始化模型（油压为0，油温与环境温度相同）
+ * @param model 模型指针
+ * @param params 参数
+ * @return PLATFORM_STATUS_OK 或 PLATFORM_STATUS_INVALID_PARAM
+ */
+platform_status_t PlantModel_Init(plant_model_t* model, const plant_model_params_t* params);
+
+/*!
+ * @brief 推进模型
+ * @param model 模型指针
+ * @param inputs 本段时间内保持不变的执行器状态
+ * @param dt 推进时间(s)
+ */
+void PlantModel_Step(plant_model_t* model, const plant_model_inputs_t* inputs, platform_float32_t dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLANT_MODEL_H */
@@ -0,0 +1,177 @@
+/*!
+ * @file pressure_capture.h
+ * @brief 压力波形捕获模块 - 换向/阈值触发的高速压力录波与CAN分段下载
+ *
+ * 功能模块：
+ * - 布防后以高速采集流（定时器触发ADC1注入组，默认20kHz）连续写入环形缓冲区
+ * - 触发源：换向阀(PB4)通/断沿、油压/LNG压力原始码值上升/下降越过阈值、上位机强制触发
+ * - 触发后记录触发前/后窗口，采满后自动停止采集；未布防时定时器关闭，稳态无开销
+ * - 录波数据为原始ADC码值，由上位机按标定换算，经CAN分段下载
+ *
+ * CAN协议（参数设置帧 CAN_MSG_PARAM_SET_ID，byte0为操作码，多字节数据均为小端）：
+ * - 0x20 ARM     : byte1 触发源掩码, byte2-3 阈值码值, byte4-5 触发前采样数, byte6-7 采样周期(us)
+ *                  （触发前采样数/周期为0时使用默认值）
+ * - 0x21 TRIGGER : 无                 - 强制触发（布防状态下有效）
+ * - 0x22 ABORT   : 无                 - 停止采集并清除录波
+ * - 0x23 STATUS  : 无                 - 查询状态（采满时也会主动发送一次）
+ * - 0x24 READ    : byte1-2 起始采样序号, byte3-4 采样数(0表示到末尾) - 开始分段下载
+ * 应答帧 CAN_MSG_PARAM_ACK_ID：byte0 操作码, byte1 结果, byte2 状态, byte3 触发源,
+ *   byte4-5 触发点序号(READ为起始序号), byte6-7 采样周期us(READ为采样数)
+ * 数据帧 CAN_MSG_CAPTURE_DATA_ID：byte0-1 首个采样序号, byte2-7 两个采样点，
+ *   每点依次为油压、LNG压力12位码值，按小端位序紧凑排列
+ */
+
+#ifndef PRESSURE_CAPTURE_H
+#define PRESSURE_CAPTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+#include "common_types.h"
+
+/* ============================================  Define  ============================================ */
+
+/* ==================== 录波参数 ==================== */
+#define PCAP_BUFFER_SAMPLES               2048U       // 录波长度（采样点，2的幂），每点4字节共8KB
+#define PCAP_DEFAULT_PRE_SAMPLES          512U        // 默认触发前采样数
+#define PCAP_DEFAULT_PERIOD_US            50U         // 默认采样周期(us)，20kHz，录波时长约102ms
+#define PCAP_SAMPLES_PER_FRAME            2U          // 每个数据帧携带的采样点数
+#define PCAP_FRAMES_PER_TASK              8U          // 每次任务调用最多发送的数据帧数，限制总线占用
+
+/* ==================== CAN操作码 ==================== */
+#define PCAP_CMD_ARM                      0x20U       // 布防
+#define PCAP_CMD_TRIGGER                  0x21U       // 强制触发
+#define PCAP_CMD_ABORT                    0x22U       // 停止并清除
+#define PCAP_CMD_STATUS                   0x23U       // 查询状态
+#define PCAP_CMD_READ                     0x24U       // 分段下载
+
+/* ==================== 触发源掩码 ==================== */
+#define PCAP_TRIG_VALVE_ON                0x01U       // 换向阀 断→通
+#define PCAP_TRIG_VALVE_OFF               0x02U       // 换向阀 通→断
+#define PCAP_TRIG_OIL_RISE                0x04U       // 油压上升越过阈值
+#define PCAP_TRIG_OIL_FALL                0x08U       // 油压下降越过阈值
+#define PCAP_TRIG_LNG_RISE                0x10U       // LNG压力上升越过阈值
+#define PCAP_TRIG_LNG_FALL                0x20U       // LNG压力下降越过阈值
+#define PCAP_TRIG_DEFAULT                 (PCAP_TRIG_VALVE_ON | PCAP_TRIG_VALVE_OFF)
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 录波状态
+ */
+typedef enum {
+    PCAP_STATE_IDLE = 0,                      // 空闲（采集关闭）
+    PCAP_STATE_ARMED,                         // 已布防，等待触发
+    PCAP_STATE_TRIGGERED,                     // 已触发，记录触发后窗口
+    PCAP_STATE_DONE                           // 录波完成，可下载
+} pressure_capture_state_t;
+
+/*!
+ * @brief 实际触发源
+ */
+typedef enum {
+    PCAP_SOURCE_NONE = 0,
+    PCAP_SOURCE_VALVE,                        // 换向阀动作
+    PCAP_SOURCE_OIL_THRESHOLD,                // 油压越限
+    PCAP_SOURCE_LNG_THRESHOLD,                // LNG压力越限
+    PCAP_SOURCE_FORCED                        // 上位机强制
+} pressure_capture_source_t;
+
+/*!
+ * @brief 应答结果
+ */
+typedef enum {
+    PCAP_RESULT_OK = 0,
+    PCAP_RESULT_BAD_PARAM,                    // 参数错误
+    PCAP_RESULT_BUSY,                         // 采集流被占用
+    PCAP_RESULT_NO_DATA                       // 无可下载的录波
+} pressure_capture_result_t;
+
+/*!
+ * @brief 布防配置
+ */
+typedef struct {
+    uint8_t trigger_mask;                     // 触发源掩码 PCAP_TRIG_*
+    uint16_t threshold_code;                  // 压力阈值（ADC码值）
+    uint16_t pre_samples;                     // 触发前采样数（< PCAP_BUFFER_SAMPLES）
+    uint16_t period_us;                       // 采样周期(us)
+} pressure_capture_config_t;
+
+/*!
+ * @brief 录波信息
+ */
+typedef struct {
+    pressure_capture_state_t state;
+    pressure_capture_source_t source;         // 实际触发源
+    uint16_t trigger_index;                   // 触发点在录波中的序号（即实际触发前采样数）
+    uint16_t period_us;                       // 采样周期(us)
+    uint32_t trigger_time;                    // 触发时刻(ms)
+} pressure_capture_info_t;
+
+/* ==========================================  Functions  =========================================== */
+
+/*!
+ * @brief 初始化录波模块
+ */
+void PressureCapture_Init(void);
+
+/*!
+ * @brief 布防：清空缓冲区并启动高速采集
+ * @param config 布防配置
+ * @return 结果
+ */
+pressure_capture_result_t PressureCapture_Arm(const pressure_capture_config_t *config);
+
+/*!
+ * @brief 强制触发（布防状态下有效，在下一个采样点生效）
+ */
+void PressureCapture_Trigger(void);
+
+/*!
+ * @brief 停止采集并清除录波
+ */
+void PressureCapture_Abort(void);
+
+/*!
+ * @brief 换向阀状态变化通知（由阀门控制模块调用）
+ * @param valve_on 变化后的阀门状态
+ */
+void PressureCapture_NotifyValveEdge(bool valve_on);
+
+/*!
+ * @brief 获取录波信息
+ * @param info 输出信息
+ */
+void PressureCapture_GetInfo(pressure_capture_info_t *info);
+
+/*!
+ * @brief 读取录波采样点（录波完成后有效）
+ * @param index 采样序号 (0 ~ PCAP_BUFFER_SAMPLES-1)
+ * @param oil_raw 油压码值
+ * @param lng_raw LNG压力码值
+ * @return true: 成功, false: 无录波或序号越界
+ */
+bool PressureCapture_GetSample(uint16_t index, uint16_t *oil_raw, uint16_t *lng_raw);
+
+/*!
+ * @brief 处理CAN参数设置帧（在CAN接收回调中调用）
+ * @param data 数据
+ * @param length 数据长度
+ * @return true: 已处理（属于录波命令）, false: 非录波命令
+ */
+bool PressureCapture_HandleCanFrame(const uint8_t *data, uint8_t length);
+
+/*!
+ * @brief 录波后台任务：执行CAN命令、发送完成通知与分段数据
+ */
+void PressureCapture_Task(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRESSURE_CAPTURE_H */
@@ -0,0 +1,181 @@
+/*!
+ * @file pressure_control.h
+ * @brief 旁通阀压力闭环模块 - MCU本地1kHz油压闭环，上位机负责监督
+ *
+ * 功能模块：
+ * - 上位机经gcu_control下发控制模式、压力设定值和开度限值，闭环在MCU本地完成
+ * - 占用压力高速采集流（1ms周期），在采样中断中换算油压、计算PID并直接写PWM0_CH2
+ * - 控制延迟由"遥测+上位机计算+命令下发"的数十毫秒降至一个采样周期
+ * - 上位机停止下发闭环模式、系统禁用、命令超时或安全保护动作时立即退出闭环
+ *
+ * gcu_control复用字段（控制模式PCTRL_MODE_PRESSURE时）：
+ * - ctrl_reserved bit0-7  : 控制模式（0 开环占空比, 1 本地压力闭环）
+ * - ctrl_reserved bit8-21 : 油压设定值（0.01MPa）
+ * - ctrl_reserved bit22-29: 最小开度（%）
+ * - ctrl_bypass_valve_duty: 最大开度（开环模式下为开度指令）
+ *
+ * 旁通阀开度增大时油压下降，控制器按反作用方式计算（油压高于设定值时开大）
+ * 切入闭环时按当前开度无扰切换；开度饱和时按反算抗饱和回退积分，退出饱和不超调
+ * 标定镜像中启用增益调度表时，kp/ki/kd和前馈开度按油温×压力设定值插值，运行中无扰整定
+ * 采集流为单一占用者，闭环运行期间压力录波布防返回BUSY，频谱分析暂停
+ *
+ * 继电器自整定（闭环运行中由上位机启动，采样中断以继电器输出代替PID，在当前设定值附近振荡）：
+ * - 测得临界增益Ku、临界周期Tu后按整定规则计算kp/ki/kd，振荡期间平均开度作为前馈
+ * - 油压偏离设定值超出允许范围、超时、退出闭环或任何安全保护动作时立即中止
+ * - 结束后从当前开度无扰切回PID（仍使用原参数）；上位机确认结果后用STORE写入增益调度表节点，
+ *   由调度查表生效并随标定镜像保存到DFlash
+ *
+ * CAN协议（参数设置帧 CAN_MSG_PARAM_SET_ID，byte0为操作码）：
+ * - 0x40 TUNE_START : byte1 整定规则, byte2 继电器中心开度(%，0xFF为当前开度), byte3 继电器幅值(0.1%),
+ *                     byte4 滞环(0.01MPa), byte5 允许偏差(0.1MPa，0为默认), byte6 超时(s，0为默认)
+ * - 0x41 TUNE_ABORT : 无                   - 中止试验
+ * - 0x42 TUNE_STATUS: 无                   - 查询状态（试验结束时也会主动发送一次）
+ * - 0x43 TUNE_STORE : byte1 油温断点序号, byte2 压力断点序号 - 将结果写入增益调度表
+ * 应答帧 CAN_MSG_PARAM_ACK_ID：byte0 操作码, byte1 结果, byte2 试验状态, byte3 已完成振荡周期数,
+ *   byte4-5 Ku(0.01%/MPa), byte6-7 Tu(ms)
+ */
+
+#ifndef PRESSURE_CONTROL_H
+#define PRESSURE_CONTROL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+#include "common_types.h"
+
+/* ============================================  Define  ============================================ */
+
+/* ==================== 控制模式 ==================== */
+#define PCTRL_MODE_OPEN_LOOP              0U          // 上位机直接给定开度
+#define PCTRL_MODE_PRESSURE               1U          // 本地油压闭环
+
+/* ==================== gcu_control字段解析 ==================== */
+#define PCTRL_CMD_MODE_MASK               0xFFU
+#define PCTRL_CMD_SETPOINT_SHIFT          8U
+#define PCTRL_CMD_SETPOINT_MASK           0x3FFFU
+#define PCTRL_CMD_SETPOINT_SCALE          0.01f       // 设定值分辨率(MPa)
+#define PCTRL_CMD_MIN_DUTY_SHIFT          22U
+#define PCTRL_CMD_MIN_DUTY_MASK           0xFFU
+
+/* ==================== 闭环参数 ==================== */
+#define PCTRL_PERIOD_US                   1000U       // 闭环采样周期(us)，1kHz
+#define PCTRL_DEFAULT_KP                  2.0f        // 比例系数(%/MPa)
+#define PCTRL_DEFAULT_KI                  10.0f       // 积分系数(%/(MPa·s))
+#define PCTRL_DEFAULT_KD                  0.0f        // 微分系数(%·s/MPa)
+#define PCTRL_DERIVATIVE_CUTOFF_HZ        50.0f       // 微分低通截止频率(Hz)，抑制泵脉动
+#define PCTRL_SCHEDULE_PERIOD_MS          100U        // 增益调度查表周期(ms)
+
+/* ==================== 继电器自整定 ==================== */
+#define PCTRL_TUNE_SETTLE_CYCLES          2U          // 丢弃的起振周期数
+#define PCTRL_TUNE_MEASURE_CYCLES         4U          // 参与平均的振荡周期数
+#define PCTRL_TUNE_DEFAULT_DEVIATION      2.0f        // 默认允许偏差(MPa)
+#define PCTRL_TUNE_DEFAULT_TIMEOUT_S      30U         // 默认超时(s)
+#define PCTRL_TUNE_BIAS_CURRENT           0xFFU       // 继电器中心取当前开度
+
+/* ==================== CAN操作码 ==================== */
+#define PCTRL_CMD_TUNE_START              0x40U       // 启动自整定
+#define PCTRL_CMD_TUNE_ABORT              0x41U       // 中止自整定
+#define PCTRL_CMD_TUNE_STATUS             0x42U       // 查询自整定状态
+#define PCTRL_CMD_TUNE_STORE              0x43U       // 整定结果写入增益调度表
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 闭环状态
+ */
+typedef enum {
+    PCTRL_STATE_IDLE = 0,                     // 未请求闭环
+    PCTRL_STATE_WAIT_STREAM,                  // 已请求，等待采集流空闲
+    PCTRL_STATE_RUNNING                       // 闭环运行中
+} pressure_control_state_t;
+
+/*!
+ * @brief 自整定命令执行结果
+ */
+typedef enum {
+    PCTRL_RESULT_OK = 0,
+    PCTRL_RESULT_BAD_PARAM,                   // 参数非法（规则、开度范围、滞环等）
+    PCTRL_RESULT_NOT_RUNNING,                 // 本地闭环未运行
+    PCTRL_RESULT_BUSY,                        // 试验进行中
+    PCTRL_RESULT_NO_RESULT                    // 无有效整定结果
+} pressure_control_result_t;
+
+/*!
+ * @brief 闭环状态信息
+ */
+typedef struct {
+    pressure_control_state_t state;
+    float setpoint_mpa;                       // 设定值(MPa)
+    float pressure_mpa;                       // 最近一次采样油压(MPa)
+    float duty;                               // 最近一次输出开度(%)
+    float duty_min;                           // 开度下限(%)
+    float duty_max;                           // 开度上限(%)
+    uint32_t cycles;                          // 本次闭环已执行周期数
+    float kp;                                 // 当前比例系数
+    float ki;                                 // 当前积分系数
+    float feedforward;                        // 当前前馈开度(%)
+    platform_tune_state_t tune_state;         // 自整定状态
+} pressure_control_status_t;
+
+/* ==========================================  Functions  =========================================== */
+
+/*!
+ * @brief 初始化压力闭环
+ */
+void PressureControl_Init(void);
+
+/*!
+ * @brief 更新上位机闭环命令（可在CAN接收中断中调用）
+ * @param enable 是否请求本地闭环；false时立即退出闭环
+ * @param setpoint_mpa 油压设定值(MPa)
+ * @param duty_min 开度下限(%)
+ * @param duty_max 开度上限(%)
+ */
+void PressureControl_SetCommand(bool enable, float setpoint_mpa, float duty_min, float duty_max);
+
+/*!
+ * @brief 立即退出闭环并清除请求（安全保护调用，之后由上位机重新请求）
+ */
+void PressureControl_Stop(void);
+
+/*!
+ * @brief 处理CAN参数设置帧（在CAN接收回调中调用）
+ * @param data 数据
+ * @param length 数据长度
+ * @return true: 已处理（属于自整定命令）, false: 非自整定命令
+ */
+bool PressureControl_HandleCanFrame(const uint8_t *data, uint8_t length);
+
+/*!
+ * @brief 获取最近一次自整定结果
+ * @return 自整定结构指针（state为PLATFORM_TUNE_DONE时ku/tu/gains有效）
+ */
+const platform_relay_tune_t* PressureControl_GetTuneResult(void);
+
+/*!
+ * @brief 闭环后台任务：执行自整定命令，申请采集流并启动闭环
+ * @param system_enabled 系统是否使能（未使能时不启动）
+ */
+void PressureControl_Task(bool system_enabled);
+
+/*!
+ * @brief 闭环是否正在控制旁通阀
+ * @return true: 运行中
+ */
+bool PressureControl_IsRunning(void);
+
+/*!
+ * @brief 获取闭环状态
+ * @param status 输出状态
+ */
+void PressureControl_GetStatus(pressure_control_status_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRESSURE_CONTROL_H */
@@ -14,6 +14,15 @@
 #include <stdint.h>
 #include "common_types.h"
 
+/* ===========================================  Typedef  ============================================ */
+
+/**
+ * @brief 电压-电阻标定点（实测）
+ */
+typedef struct {
+    float voltage;    // 测得的电压值 (V)
+    float resistance; // 对应的电阻值 (Ω)
+} pt1000_calib_point_t;
 
 /**
  * @brief PT1000电阻查找表（浮点版本）从-200°C到+100°C
@@ -44,6 +53,22 @@ float pt1000_get_temp_float(float resistance);
  */
 float pt1000_voltage_to_resistance(float voltage);
 
+/**
+ * @brief 电压转PT1000电阻值（使用指定的标定点表）
+ * @param voltage      输入电压 (单位: V)
+ * @param calib_points 标定点数组，电压从小到大排序
+ * @param num_points   标定点数量（至少2个）
+ * @return float       计算出的PT1000电阻值 (单位: Ohm)
+ */
+float pt1000_voltage_to_resistance_table(float voltage, const pt1000_calib_point_t *calib_points, uint8_t num_points);
+
+/**
+ * @brief 获取出厂默认电压-电阻标定点
+ * @param count 输出标定点数量（可为NULL）
+ * @return const pt1000_calib_point_t* 标定点数组指针
+ */
+const pt1000_calib_point_t* pt1000_get_default_calib_points(uint8_t *count);
+
 /**
  * @brief 根据ADC原始值计算温度（适配放大倍数=10的电路）
  * @param adc_raw    ADC原始采样值
@@ -17,6 +17,9 @@
 #include <stdbool.h>
 #include "common_types.h"
 #include "ac7840x.h"
+#if HP_PLANT_SIM
+#include "plant_model.h"
+#endif
 
 /* ============================================  Define  ============================================ */
 
@@ -61,6 +64,65 @@ uint16_t Sensor_GetADCValue(uint8_t channel);
  */
 void Sensor_GetAllADCValues(uint16_t raw_values[ADC_CHANNEL_COUNT]);
 
+/**
+ * @brief 获取通道最近8个监测周期的平均电压（原始码值平均后换算；raw_data.voltage[]为当次瞬时值）
+ * @param channel ADC通道 (0-3)
+ * @return 平均电压(V)
+ */
+float Sensor_GetAveragedVoltage(uint8_t channel);
+
+/* ==================== 压力高速采集接口 ==================== */
+
+/**
+ * @brief 启动压力高速采集流：定时器周期中断中启动ADC1注入组（油压、LNG压力），
+ *        下一周期读取结果并调用回调；与轮询采集的规则组互不影响
+ * @param period_us 采样周期 (us)，不小于SENSOR_STREAM_MIN_PERIOD_US
+ * @param callback 逐采样回调（中断上下文）
+ * @return true: 启动成功, false: 参数错误或采集流已被占用（后台运行的采集流直接抢占）
+ */
+bool Sensor_StartPressureStream(uint32_t period_us, sensor_stream_callback_t callback);
+
+/**
+ * @brief 停止压力高速采集流（可在采集回调中调用）
+ */
+void Sensor_StopPressureStream(void);
+
+/**
+ * @brief 以后台方式启动压力高速采集流：只向旁路监听送采样，Sensor_StartPressureStream可直接抢占
+ * @param period_us 采样周期 (us)
+ * @return true: 启动成功, false: 参数错误或采集流已在运行
+ */
+bool Sensor_StartBackgroundPressureStream(uint32_t period_us);
+
+/**
+ * @brief 停止后台方式运行的采集流（采集流被占用时不影响占用者）
+ */
+void Sensor_StopBackgroundPressureStream(void);
+
+/**
+ * @brief 设置采集流旁路监听：采集流运行时（无论占用者是谁）每个采样都会调用
+ * @param observer 监听回调（中断上下文），NULL为取消
+ */
+void Sensor_SetPressureStreamObserver(sensor_stream_observer_t observer);
+
+/**
+ * @brief 压力高速采集流是否运行
+ * @return true: 运行中
+ */
+bool Sensor_IsPressureStreamRunning(void);
+
+/**
+ * @brief 获取压力高速采集流采样周期
+ * @return 采样周期 (us)，未运行时返回0
+ */
+uint32_t Sensor_GetPressureStreamPeriod(void);
+
+/**
+ * @brief 获取采集流溢出次数（定时到达时上次注入转换未完成）
+ * @return 溢出次数
+ */
+uint32_t Sensor_GetPressureStreamOverruns(void);
+
 /* ==================== 数据转换接口 ==================== */
 
 /**
@@ -173,6 +235,15 @@ float Sensor_GetOilPressure(void);
  */
 float Sensor_GetLNGPressure(void);
 
+/**
+ * @brief 获取压力Kalman估计（压力与变化率，按传感器采样周期更新）
+ * @param channel 压力标定通道（CALIB_PRESSURE_OIL / CALIB_PRESSURE_LNG）
+ * @param pressure_mpa 输出压力估计(MPa)，可为NULL
+ * @param rate_mpa_s 输出压力变化率(MPa/s)，可为NULL
+ * @return true: 成功, false: 通道无效或尚无采样
+ */
+bool Sensor_GetPressureEstimate(uint8_t channel, float *pressure_mpa, float *rate_mpa_s);
+
 // 已删除：Sensor_NeedCooling() - 控制逻辑，移至PC端
 // 已删除：Sensor_IsLNGPressureInRange() - 控制逻辑，移至PC端
 
@@ -193,6 +264,133 @@ sensor_fault_status_t Sensor_GetFaultStatus(void);
  */
 void Sensor_FaultDiagnosis(void);
 
+/* ==================== 原始信号合理性检测接口 ==================== */
+
+/**
+ * @brief 合理性检测初始化（加载默认配置，所有通道置为有效）
+ */
+void Sensor_PlausibilityInit(void);
+
+/**
+ * @brief 设置通道合理性检测配置
+ * @param channel ADC通道 (0-3)
+ * @param config 检测配置
+ */
+void Sensor_SetPlausibilityConfig(uint8_t channel, const sensor_plausibility_config_t *config);
+
+/**
+ * @brief 获取通道合理性检测配置
+ * @param channel ADC通道 (0-3)
+ * @param config 输出检测配置
+ * @return true: 成功, false: 参数错误
+ */
+bool Sensor_GetPlausibilityConfig(uint8_t channel, sensor_plausibility_config_t *config);
+
+/**
+ * @brief 设置采样周期，按周期重新换算变化率/卡滞窗口/去抖采样数
+ * @param period_us 采样周期 (us)
+ */
+void Sensor_SetPlausibilitySamplePeriod(uint32_t period_us);
+
+/**
+ * @brief 单个原始采样的合理性检测（逐采样调用，仅整数运算）
+ * @param channel ADC通道 (0-3)
+ * @param adc_raw ADC原始值 (0-4095)
+ * @return true: 通道数据有效, false: 通道故障
+ */
+bool Sensor_PlausibilityCheck(uint8_t channel, uint16_t adc_raw);
+
+/**
+ * @brief 获取通道去抖后的合理性故障位（含仅诊断的卡滞位）
+ * @param channel ADC通道 (0-3)
+ * @return sensor_plausibility_fault_t位组合
+ */
+uint8_t Sensor_GetPlausibilityFaults(uint8_t channel);
+
+/**
+ * @brief 获取通道合理性检测状态
+ * @param channel ADC通道 (0-3)
+ * @return 状态指针，通道无效时返回NULL
+ */
+const sensor_plausibility_state_t* Sensor_GetPlausibilityState(uint8_t channel);
+
+/**
+ * @brief 对一组四通道原始采样执行合理性检测并更新数据有效性
+ * @param adc_raw 四通道ADC原始值
+ */
+void Sensor_UpdateValidity(const uint16_t adc_raw[ADC_CHANNEL_COUNT]);
+
+/* ==================== 压力自动调零接口 ==================== */
+
+/**
+ * @brief 初始化压力自动调零状态（读取已保存的零点修正作为漂移基准）
+ */
+void Sensor_AutoZeroInit(void);
+
+/**
+ * @brief 设置压力通道是否参与自动调零
+ * @param channel 压力标定通道 (CALIB_PRESSURE_OIL / CALIB_PRESSURE_LNG)
+ * @param enable true: 参与
+ */
+void Sensor_SetAutoZeroEnable(uint8_t channel, bool enable);
+
+/**
+ * @brief 自动调零周期处理（每次Sensor_UpdateMonitor后调用）
+ *        停机且阀门关闭并稳定后按窗口平均原始码值学习零点偏差，结果在范围内时写入标定存储
+ * @param system_idle true: 系统未使能且阀门关闭
+ */
+void Sensor_AutoZeroUpdate(bool system_idle);
+
+/**
+ * @brief 获取压力通道自动调零状态
+ * @param channel 压力标定通道
+ * @return 状态指针，通道无效时返回NULL
+ */
+const sensor_autozero_state_t* Sensor_GetAutoZeroState(uint8_t channel);
+
+/* ==================== 自适应采集速率接口 ==================== */
+
+/**
+ * @brief 初始化自适应采集速率（默认配置，周期为SENSOR_RATE_NORMAL_PERIOD_MS）
+ */
+void Sensor_RateInit(void);
+
+/**
+ * @brief 设置自适应采集速率配置（周期限制在SENSOR_RATE_MIN/MAX_PERIOD_MS之间）
+ * @param config 配置
+ * @return true: 成功, false: 参数不合理（退出阈值大于进入阈值、活动周期长于平稳周期等）
+ */
+bool Sensor_SetRateConfig(const sensor_rate_config_t *config);
+
+/**
+ * @brief 获取自适应采集速率配置
+ * @param config 输出配置
+ */
+void Sensor_GetRateConfig(sensor_rate_config_t *config);
+
+/**
+ * @brief 自适应采集速率更新（每次Sensor_UpdateMonitor后调用）
+ *        压力变化率超限、换向阀动作或换向频率非0时立即切换到活动周期，
+ *        平稳后每hold_ms周期加倍一次，逐级降到平稳周期
+ * @param valve_active 换向阀动作中
+ * @param reversal_freq_hz 换向频率(Hz)
+ * @param system_enabled 系统使能（决定平稳周期取normal或idle）
+ * @return 新的采集/上报周期(ms)
+ */
+uint16_t Sensor_RateUpdate(bool valve_active, uint8_t reversal_freq_hz, bool system_enabled);
+
+/**
+ * @brief 获取当前采集/上报周期
+ * @return 周期(ms)
+ */
+uint16_t Sensor_GetSamplePeriodMs(void);
+
+/**
+ * @brief 获取自适应采集速率状态
+ * @return 状态指针
+ */
+const sensor_rate_state_t* Sensor_GetRateState(void);
+
 /**
  * @brief 验证传感器数值
  * @param value 传感器数值
@@ -202,4 +400,12 @@ void Sensor_FaultDiagnosis(void);
  */
 bool Sensor_ValidateValue(float value, float min_valid, float max_valid);
 
+#if HP_PLANT_SIM
+/**
+ * @brief 获取液压对象模型（仿真/PC端测试读取真值或修改参数）
+ * @return 模型指针
+ */
+plant_model_t* Sensor_GetPlantModel(void);
+#endif
+
 #endif 
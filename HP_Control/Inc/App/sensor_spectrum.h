@@ -0,0 +1,89 @@
+/*!
+ * @file sensor_spectrum.h
+ * @brief 油压脉动频谱分析模块 - 定点FFT提取泵脉动主频与幅值
+ *
+ * 功能模块：
+ * - 周期性借用压力高速采集流，以2kHz采集256点油压原始码值（约128ms窗口）
+ * - 去均值、Hann窗后做Q15基2定点FFT（蝶形/旋转因子使用Cortex-M4 SIMD指令）
+ * - 提取两个最强谱峰（抛物线插值修正频率）、脉动有效值和高频段能量占比
+ * - 每个分析周期发送一帧频谱摘要（CAN_MSG_SPECTRUM_ID），代替上传kHz级原始数据
+ *
+ * 频谱摘要帧：byte0-1 主峰频率(0.1Hz), byte2 主峰幅值(0.01MPa), byte3-4 次峰频率(0.1Hz),
+ *   byte5 次峰幅值(0.01MPa), byte6 脉动有效值(0.01MPa), byte7 高频段(>fs/4)能量占比(%)
+ */
+
+#ifndef SENSOR_SPECTRUM_H
+#define SENSOR_SPECTRUM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+#include "common_types.h"
+
+/* ============================================  Define  ============================================ */
+
+/* ==================== 频谱分析参数 ==================== */
+#define SPECTRUM_FFT_LOG2N                8U          // FFT点数的log2
+#define SPECTRUM_FFT_SIZE                 (1U << SPECTRUM_FFT_LOG2N) // FFT点数 256
+#define SPECTRUM_SAMPLE_PERIOD_US         500U        // 采样周期(us)，2kHz，可分析至1kHz
+#define SPECTRUM_INTERVAL_MS              1000U       // 分析周期(ms)
+#define SPECTRUM_INPUT_SHIFT              3U          // 去均值后码值左移位数（12位→Q15留3位余量）
+#define SPECTRUM_MIN_PEAK_BIN             2U          // 谱峰搜索起始频点（排除直流泄漏）
+#define SPECTRUM_PEAK_COUNT               2U          // 输出谱峰数量
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 谱峰
+ */
+typedef struct {
+    float frequency_hz;                       // 频率(Hz)
+    float amplitude_mpa;                      // 幅值(MPa，峰值)
+} spectrum_peak_t;
+
+/*!
+ * @brief 频谱摘要
+ */
+typedef struct {
+    spectrum_peak_t peaks[SPECTRUM_PEAK_COUNT]; // 按幅值从大到小
+    float ripple_rms_mpa;                     // 脉动有效值(MPa)
+    uint8_t high_band_percent;                // 高频段能量占比(%)，气蚀时升高
+    float mean_pressure_mpa;                  // 窗口平均压力(MPa)
+    uint32_t timestamp;                       // 分析完成时刻(ms)
+    uint32_t count;                           // 已完成分析次数
+} spectrum_summary_t;
+
+/* ==========================================  Functions  =========================================== */
+
+/*!
+ * @brief 初始化频谱分析（生成旋转因子和窗函数表）
+ */
+void SensorSpectrum_Init(void);
+
+/*!
+ * @brief 频谱分析任务：按周期启动窗口采集，采满后计算FFT并发送摘要
+ * @param enabled 是否进行分析（泵运行时才有意义）
+ */
+void SensorSpectrum_Task(bool enabled);
+
+/*!
+ * @brief 获取最近一次频谱摘要
+ * @return 摘要指针
+ */
+const spectrum_summary_t* SensorSpectrum_GetSummary(void);
+
+/*!
+ * @brief Q15定点基2 FFT（原位，每级缩放1/2，结果为DFT/N）
+ * @param data 复数数组，每个元素低半字为实部、高半字为虚部
+ */
+void SensorSpectrum_FftQ15(uint32_t data[SPECTRUM_FFT_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENSOR_SPECTRUM_H */
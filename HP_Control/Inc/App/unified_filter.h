@@ -6,6 +6,13 @@
  * - 统一管理所有传感器的滤波缓冲区
  * - 提供统一的滤波算法接口
  * - 支持多种滤波算法（移动平均、低通滤波等）
+ * - 级联二阶节(SOS)滤波引擎：直接II型转置，float32/Q31两种实现，四通道结构数组布局
+ *
+ * Biquad系数CAN协议（参数设置帧 CAN_MSG_PARAM_SET_ID，byte0为操作码，多字节数据均为小端）：
+ * - 0x30 COEFF   : byte1 通道, byte2 节序号, byte3 系数序号(0 b0,1 b1,2 b2,3 a1,4 a2), byte4-7 float系数
+ * - 0x31 COMMIT  : byte1 通道, byte2 使用节数(1~UNIFIED_FILTER_BIQUAD_SECTIONS) - 校验稳定性后切换系数并启用Biquad
+ * - 0x32 DISABLE : byte1 通道        - 该通道恢复默认滤波配置，系数恢复直通
+ * 应答帧 CAN_MSG_PARAM_ACK_ID：byte0 操作码, byte1 结果, byte2 通道, byte3 使用节数, byte4 生效系数组
  */
 
 #ifndef UNIFIED_FILTER_H
@@ -33,41 +40,207 @@ extern "C" {
 #define FILTER_TYPE_MOVING_AVERAGE    0   // 移动平均滤波
 #define FILTER_TYPE_LOW_PASS          1   // 低通滤波
 #define FILTER_TYPE_EXPONENTIAL       2   // 指数滤波
+#define FILTER_TYPE_BIQUAD            3   // 级联二阶节(SOS)滤波
 
 /* ==================== 滤波参数 ==================== */
-#define UNIFIED_FILTER_SIZE           10U         // 统一滤波窗口大小
+#define UNIFIED_FILTER_SIZE           8U          // 统一滤波窗口大小（2的幂，最大PLATFORM_MA_MAX_WINDOW）
 #define UNIFIED_FILTER_ALPHA          0.3f        // 滤波系数
+#define UNIFIED_FILTER_CUTOFF_HZ      5.0f        // 低通滤波默认截止频率(Hz)
+#define UNIFIED_FILTER_MAX_DT_MS      1000U       // 低通滤波单步最大采样间隔(ms)，超出按此计算
+#define UNIFIED_FILTER_MA_POOL_SIZE   2U          // 移动平均缓冲区池大小（同时使用移动平均的通道数上限）
+
+/* ==================== 尖峰剔除(Hampel)参数 ==================== */
+#define UNIFIED_FILTER_HAMPEL_MAX_WINDOW  9U      // 最大窗口（奇数）
+#define UNIFIED_FILTER_HAMPEL_WINDOW      5U      // 默认窗口，阶跃响应延迟(窗口-1)/2个采样
+#define UNIFIED_FILTER_HAMPEL_THRESHOLD   3.0f    // 剔除阈值（MAD估计标准差的倍数）
+#define UNIFIED_FILTER_HAMPEL_MIN_DEV     0.3f    // 最小剔除偏差（信号平稳MAD≈0时防止误剔除）
+#define UNIFIED_FILTER_MAD_SCALE          1.4826f // MAD→标准差换算系数（正态分布）
+
+/* ==================== 级联二阶节(Biquad)参数 ==================== */
+#define UNIFIED_FILTER_BIQUAD_SECTIONS    3U      // 每通道最大二阶节数（未用节为直通，不参与计算）
+#define UNIFIED_FILTER_BIQUAD_Q31         0       // 1: Q31定点引擎, 0: float32引擎（M4F有FPU，默认float）
+#define UNIFIED_FILTER_BIQUAD_Q31_SCALE   64.0f   // Q31引擎输入满量程（工程单位）
+#define UNIFIED_FILTER_BIQUAD_Q31_SHIFT   1U      // Q31系数格式Q(31-SHIFT)，系数范围(-2, 2)
+
+/* ==================== 压力Kalman估计参数 ==================== */
+// 匀速模型：状态[压力, 压力变化率]，过程噪声为白噪声加速度
+#define UNIFIED_FILTER_KALMAN_MEAS_VAR    0.0025f // 测量噪声方差(MPa^2)，约0.05MPa标准差
+#define UNIFIED_FILTER_KALMAN_ACCEL_PSD   400.0f  // 压力加速度噪声谱密度(MPa^2/s^3)，越大变化率响应越快
+#define UNIFIED_FILTER_KALMAN_INIT_RATE_VAR 100.0f // 初始变化率方差(MPa^2/s^2)
+#define UNIFIED_FILTER_KALMAN_MAX_DT_MS   500U    // 采样间隔超过此值时重新初始化(ms)
+
+/* ==================== 原始码值打包滤波参数 ==================== */
+// 12位码值两两打包为半字，8点窗口和最大32760，不溢出int16
+#define UNIFIED_FILTER_RAW_WINDOW_LOG2    3U      // 窗口大小log2
+#define UNIFIED_FILTER_RAW_WINDOW         (1U << UNIFIED_FILTER_RAW_WINDOW_LOG2)
+#define UNIFIED_FILTER_RAW_MAX_CHANNELS   8U      // 最大通道数
+#define UNIFIED_FILTER_RAW_WORDS          (UNIFIED_FILTER_RAW_MAX_CHANNELS / 2U)
+#define UNIFIED_FILTER_RAW_CODE_MASK      0x0FFFU // 12位码值
+
+/* ==================== Biquad CAN操作码 ==================== */
+#define FILTER_CMD_BIQUAD_COEFF           0x30U   // 写入一个系数到暂存区
+#define FILTER_CMD_BIQUAD_COMMIT          0x31U   // 校验并切换系数组
+#define FILTER_CMD_BIQUAD_DISABLE         0x32U   // 恢复通道默认滤波
+
+/* ==================== 各通道默认配置 ==================== */
+// 温度变化慢：指数滤波，无缓冲区；压力：短窗口移动平均
+#define UNIFIED_FILTER_TEMP_TYPE      FILTER_TYPE_EXPONENTIAL
+#define UNIFIED_FILTER_TEMP_ALPHA     TEMP_FILTER_ALPHA
+#define UNIFIED_FILTER_PRESSURE_TYPE  FILTER_TYPE_MOVING_AVERAGE
+#define UNIFIED_FILTER_PRESSURE_SIZE  UNIFIED_FILTER_SIZE
 
 /* ===========================================  Typedef  ============================================ */
 
+/*!
+ * @brief 滤波通道
+ */
+typedef enum {
+    FILTER_CHANNEL_OIL_TEMP = 0,      // 油温
+    FILTER_CHANNEL_LNG_TEMP,          // LNG温度
+    FILTER_CHANNEL_OIL_PRESSURE,      // 油压
+    FILTER_CHANNEL_LNG_PRESSURE,      // LNG压力
+    FILTER_CHANNEL_COUNT
+} filter_channel_t;
+
 /*!
  * @brief 滤波配置结构体
  */
 typedef struct {
     uint8_t filter_type;              // 滤波算法类型
-    uint8_t window_size;              // 滤波窗口大小
-    float alpha;                      // 滤波系数
+    uint8_t window_size;              // 滤波窗口大小（移动平均，须为2的幂且不超过PLATFORM_MA_MAX_WINDOW）
+    float alpha;                      // 滤波系数（指数滤波，每个采样）
+    float cutoff_hz;                  // 截止频率Hz（低通滤波，按实际采样间隔换算系数）
     bool enabled;                     // 滤波使能
 } filter_config_t;
 
+/*!
+ * @brief Biquad命令应答结果
+ */
+typedef enum {
+    BIQUAD_RESULT_OK = 0,
+    BIQUAD_RESULT_BAD_PARAM,                  // 通道/节数错误
+    BIQUAD_RESULT_INCOMPLETE,                 // 暂存区系数不完整
+    BIQUAD_RESULT_UNSTABLE                    // 极点不在单位圆内或超出定点范围
+} biquad_result_t;
+
+/*!
+ * @brief 二阶节系数（a0归一化为1）：y = b0*x + b1*x[-1] + b2*x[-2] - a1*y[-1] - a2*y[-2]
+ */
+typedef struct {
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+} biquad_coeffs_t;
+
+/*!
+ * @brief 二阶节系数组（结构数组布局 [节][通道]，内层循环按通道连续访问）
+ */
+typedef struct {
+    float b0[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+    float b1[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+    float b2[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+    float a1[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+    float a2[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+} biquad_bank_f32_t;
+
+/*!
+ * @brief 二阶节Q31系数组（Q(31-UNIFIED_FILTER_BIQUAD_Q31_SHIFT)）
+ */
+typedef struct {
+    int32_t b0[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+    int32_t b1[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+    int32_t b2[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+    int32_t a1[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+    int32_t a2[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+} biquad_bank_q31_t;
+
+/*!
+ * @brief 级联二阶节引擎：系数双缓冲，切换时只改生效索引，滤波过程中不会读到半更新的系数
+ */
+typedef struct {
+#if UNIFIED_FILTER_BIQUAD_Q31
+    biquad_bank_q31_t bank[2];
+    int32_t z1[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+    int32_t z2[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+#else
+    biquad_bank_f32_t bank[2];
+    float z1[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+    float z2[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT];
+#endif
+    biquad_coeffs_t coeffs[UNIFIED_FILTER_BIQUAD_SECTIONS][FILTER_CHANNEL_COUNT]; // 当前生效系数(float，供读回/换算)
+    uint8_t sections[FILTER_CHANNEL_COUNT];          // 各通道使用节数
+    volatile uint8_t active;                         // 生效系数组索引
+} biquad_engine_t;
+
+/*!
+ * @brief 压力Kalman估计（二维状态，定长运算，无动态分配）
+ */
+typedef struct {
+    float pressure;                   // 压力估计(MPa)
+    float rate;                       // 压力变化率估计(MPa/s)
+    float p00;                        // 协方差矩阵 [p00 p01; p01 p11]
+    float p01;
+    float p11;
+    bool initialized;                 // 已由首个样本初始化
+} pressure_kalman_t;
+
+/*!
+ * @brief 多通道原始码值滑动和（结构数组布局：每个采样各通道交错，两通道打包为一个字，SIMD一次处理两通道）
+ */
+typedef struct {
+    uint32_t history[UNIFIED_FILTER_RAW_WINDOW][UNIFIED_FILTER_RAW_WORDS]; // [采样][通道对]
+    uint32_t sum[UNIFIED_FILTER_RAW_WORDS];   // 各通道窗口和（打包）
+    uint8_t channels;                 // 通道数
+    uint8_t words;                    // 打包字数 (channels+1)/2
+    uint8_t index;                    // 下一个写入位置
+    uint8_t count;                    // 已填充样本数
+} packed_boxcar_t;
+
+/*!
+ * @brief 尖峰剔除(Hampel)配置
+ */
+typedef struct {
+    bool enabled;                     // 使能
+    uint8_t window_size;              // 窗口大小（奇数，3~UNIFIED_FILTER_HAMPEL_MAX_WINDOW）
+    float threshold;                  // 剔除阈值（MAD估计标准差的倍数）
+    float min_deviation;              // 最小剔除偏差（工程单位）
+} hampel_config_t;
+
+/*!
+ * @brief 尖峰剔除(Hampel)状态：时间序环形窗口 + 升序窗口，增删O(W)无需整窗排序
+ */
+typedef struct {
+    hampel_config_t config;
+    float history[UNIFIED_FILTER_HAMPEL_MAX_WINDOW]; // 按时间顺序的原始样本
+    float sorted[UNIFIED_FILTER_HAMPEL_MAX_WINDOW];  // 升序排列的同一组样本
+    uint8_t index;                    // 下一个写入位置
+    uint8_t count;                    // 已填充样本数
+    uint32_t rejected_count;          // 剔除样本计数
+} hampel_filter_t;
+
+/*!
+ * @brief 单通道滤波器：独立配置与状态，指数/低通滤波不占用缓冲区
+ */
+typedef struct {
+    filter_config_t config;           // 通道配置
+    hampel_filter_t spike;            // 尖峰剔除前置级
+    platform_moving_average_t* ma;    // 移动平均状态（从缓冲区池分配，其他类型为NULL）
+    float output;                     // 当前滤波输出（指数/低通滤波的状态）
+    uint32_t sample_count;            // 已滤波样本数
+} filter_channel_state_t;
+
 /*!
  * @brief 统一滤波管理器结构体
  */
 typedef struct {
-    // 滤波缓冲区 - 统一管理所有传感器数据
-    float oil_temp_buffer[UNIFIED_FILTER_SIZE];
-    float lng_temp_buffer[UNIFIED_FILTER_SIZE];
-    float oil_pressure_buffer[UNIFIED_FILTER_SIZE];
-    float lng_pressure_buffer[UNIFIED_FILTER_SIZE];
-    
-    // 缓冲区索引
-    uint8_t oil_temp_index;
-    uint8_t lng_temp_index;
-    uint8_t oil_pressure_index;
-    uint8_t lng_pressure_index;
-    
-    // 滤波配置
-    filter_config_t config;
+    // 各通道滤波器 - 统一管理所有传感器数据
+    filter_channel_state_t channels[FILTER_CHANNEL_COUNT];
+    platform_moving_average_t ma_pool[UNIFIED_FILTER_MA_POOL_SIZE];
+    biquad_engine_t biquad;
+    pressure_kalman_t kalman[2];      // 油压、LNG压力（尖峰剔除后的测量值）
+    packed_boxcar_t raw_codes;        // ADC原始码值8点平均
     
     // 统计信息
     uint32_t filter_count;
@@ -84,11 +257,64 @@ typedef struct {
 void UnifiedFilter_Init(void);
 
 /*!
- * @brief 配置滤波参数
+ * @brief 配置滤波参数（应用到所有通道；移动平均缓冲区池不足的通道保持原配置）
  * @param config 滤波配置
  */
 void UnifiedFilter_Configure(const filter_config_t* config);
 
+/*!
+ * @brief 配置单个通道的滤波参数（类型或窗口变化时重建该通道状态）
+ * @param channel 滤波通道
+ * @param config 滤波配置
+ * @return true: 成功, false: 参数无效（含移动平均窗口非2的幂或超过PLATFORM_MA_MAX_WINDOW）或移动平均缓冲区池已满
+ */
+bool UnifiedFilter_ConfigureChannel(filter_channel_t channel, const filter_config_t* config);
+
+/*!
+ * @brief 获取单个通道的滤波配置
+ * @param channel 滤波通道
+ * @param config 输出配置
+ * @return true: 成功, false: 参数无效
+ */
+bool UnifiedFilter_GetChannelConfig(filter_channel_t channel, filter_config_t* config);
+
+/*!
+ * @brief 配置单个通道的尖峰剔除前置级（窗口变化时清空窗口，剔除计数保留）
+ * @param channel 滤波通道
+ * @param config 尖峰剔除配置
+ * @return true: 成功, false: 参数无效
+ */
+bool UnifiedFilter_ConfigureSpikeFilter(filter_channel_t channel, const hampel_config_t* config);
+
+/*!
+ * @brief 获取单个通道的尖峰剔除计数
+ * @param channel 滤波通道
+ * @return 自初始化以来剔除的样本数
+ */
+uint32_t UnifiedFilter_GetSpikeRejectCount(filter_channel_t channel);
+
+/*!
+ * @brief 设置通道的级联二阶节系数（写入备用系数组后切换），不改变通道滤波类型
+ * @param channel 滤波通道
+ * @param coeffs 系数数组
+ * @param sections 节数（1~UNIFIED_FILTER_BIQUAD_SECTIONS，其余节直通）
+ * @return true: 成功, false: 参数无效或滤波器不稳定
+ */
+bool UnifiedFilter_SetBiquad(filter_channel_t channel, const biquad_coeffs_t* coeffs, uint8_t sections);
+
+/*!
+ * @brief 处理CAN参数设置帧（在CAN接收回调中调用）
+ * @param data 数据
+ * @param length 数据长度
+ * @return true: 已处理（属于Biquad命令）, false: 非Biquad命令
+ */
+bool UnifiedFilter_HandleCanFrame(const uint8_t* data, uint8_t length);
+
+/*!
+ * @brief 滤波参数服务任务：执行CAN提交的系数切换并应答
+ */
+void UnifiedFilter_Task(void);
+
 /*!
  * @brief 更新传感器数据并滤波
  * @param oil_temp 油温原始值
@@ -101,6 +327,22 @@ void UnifiedFilter_UpdateData(float oil_temp, float lng_temp,
 
 /* ==================== 滤波数据获取接口 ==================== */
 
+/*!
+ * @brief 获取指定通道滤波后数据
+ * @param channel 滤波通道
+ * @return 滤波后值，通道禁用或无效时为0
+ */
+float UnifiedFilter_GetFiltered(filter_channel_t channel);
+
+/*!
+ * @brief 获取压力Kalman估计
+ * @param channel 滤波通道（仅FILTER_CHANNEL_OIL_PRESSURE / FILTER_CHANNEL_LNG_PRESSURE）
+ * @param pressure 输出压力估计(MPa)，可为NULL
+ * @param rate 输出压力变化率估计(MPa/s)，可为NULL
+ * @return true: 成功, false: 通道无效或尚未初始化
+ */
+bool UnifiedFilter_GetPressureEstimate(filter_channel_t channel, float* pressure, float* rate);
+
 /*!
  * @brief 获取滤波后油温
  * @return 滤波后油温
@@ -134,7 +376,7 @@ void UnifiedFilter_GetAllFilteredData(unified_sensor_data_t* data);
 /* ==================== 滤波算法接口 ==================== */
 
 /*!
- * @brief 移动平均滤波
+ * @brief 移动平均滤波（兼容接口，每次重算整个窗口，新代码使用PlatformFilter_MovingAverageUpdate）
  * @param buffer 滤波缓冲区
  * @param index 当前索引
  * @param window_size 窗口大小
@@ -162,6 +404,49 @@ float UnifiedFilter_LowPass(float last_filtered, float new_value, float alpha);
  */
 float UnifiedFilter_Exponential(float last_filtered, float new_value, float alpha);
 
+/* ==================== 原始码值打包滤波接口 ==================== */
+
+/*!
+ * @brief 初始化多通道原始码值滑动和
+ * @param bc 滤波器指针
+ * @param channels 通道数（1~UNIFIED_FILTER_RAW_MAX_CHANNELS）
+ */
+void UnifiedFilter_PackedBoxcarInit(packed_boxcar_t* bc, uint8_t channels);
+
+/*!
+ * @brief 一次更新所有通道（每对通道一条减法一条加法，开销与窗口大小无关）
+ * @param bc 滤波器指针
+ * @param codes 各通道12位码值
+ */
+void UnifiedFilter_PackedBoxcarUpdate(packed_boxcar_t* bc, const uint16_t* codes);
+
+/*!
+ * @brief 获取通道窗口平均码值（Q3，即码值×8；窗口未满时按已有样本换算）
+ * @param bc 滤波器指针
+ * @param channel 通道序号
+ * @return 平均码值Q3
+ */
+uint16_t UnifiedFilter_PackedBoxcarGetQ3(const packed_boxcar_t* bc, uint8_t channel);
+
+/*!
+ * @brief 批量更新所有通道（按filter_channel_t顺序），一次完成尖峰剔除、Biquad、平滑滤波和Kalman估计
+ * @param values 各通道原始值
+ */
+void UnifiedFilter_UpdateChannels(const float values[FILTER_CHANNEL_COUNT]);
+
+/*!
+ * @brief 更新ADC原始码值的8点平均（按ADC通道序号，打包SIMD批量计算）
+ * @param codes 各ADC通道码值（ADC_CHANNEL_COUNT个）
+ */
+void UnifiedFilter_UpdateRawCodes(const uint16_t* codes);
+
+/*!
+ * @brief 获取ADC通道8点平均码值
+ * @param adc_channel ADC通道序号
+ * @return 平均码值Q3（码值×8）
+ */
+uint16_t UnifiedFilter_GetRawMeanQ3(uint8_t adc_channel);
+
 /* ==================== 滤波状态管理 ==================== */
 
 /*!
@@ -170,8 +455,8 @@ float UnifiedFilter_Exponential(float last_filtered, float new_value, float alph
 void UnifiedFilter_Reset(void);
 
 /*!
- * @brief 检查滤波是否就绪
- * @return true: 就绪, false: 未就绪
+ * @brief 检查滤波是否就绪（移动平均窗口填满；指数/低通滤波以首个样本初始化，有样本即就绪）
+ * @return true: 所有启用通道就绪, false: 未就绪
  */
 bool UnifiedFilter_IsReady(void);
 
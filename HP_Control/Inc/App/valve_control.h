@@ -8,6 +8,32 @@
  * - 系统控制逻辑已迁移到hydraulic_control模块
  * - 提供统一的阀门硬件控制接口
  * - 包含阀门状态管理和统计信息
+ *
+ * 换向阀定时换向（上位机使能且换向频率>0时）：
+ * - 定时器通道DIRECTIONAL_VALVE_TIMER_CHANNEL每相结束中断翻转PB4，相长由硬件计数，不受任务调度与CAN抖动影响
+ * - 定时器装载值在本相结束时生效：中断中预装下一相长度，换向沿间隔与指令周期一致且不累积误差
+ * - 频率/通电占比变更只在周期边界（断电相结束）生效；上位机关闭换向时走完当前周期后停在断电状态
+ * - 安全保护及静态开关（ValveControl_SetDirectionalValve）立即停止换向
+ *
+ * 旁通阀开度轨迹：
+ * - 上位机开环指令只给定目标开度，PWM0计数溢出中断逐PWM周期按斜率（可选加速度限制，
+ *   即S曲线）推进实际开度并写入通道计数值，计数值在周期边界装载，输出无毛刺
+ * - 到达目标后屏蔽溢出中断，目标变化时重新开启，静止时不占用CPU
+ * - 安全保护使用ValveControl_SetBypassValveImmediate立即到位；本地压力闭环与继电器整定
+ *   使用ValveControl_WriteBypassValveDutyImmediate，不经斜率限制（执行器须与PID输出一致）
+ * - 载波频率可调(BYPASS_PWM_MIN_FREQ_HZ~BYPASS_PWM_MAX_FREQ_HZ)，周期与通道计数的小数部分经硬件计数抖动
+ *   (PDHR/CnDHR，1/32计数)输出，高载波下开度分辨率不下降
+ * - 可选低频颤振：在溢出中断中叠加三角波，克服阀芯静摩擦；仅阀门开启时叠加，不计入实际开度
+ *
+ * CAN协议（参数设置帧 CAN_MSG_PARAM_SET_ID，byte0为操作码）：
+ * - 0x50 REVERSAL_DUTY  : byte1 通电占比(%，5~95，0为默认50%) - 下一周期生效
+ * - 0x51 REVERSAL_STATUS: 无                                  - 查询换向状态
+ * - 0x52 BYPASS_RAMP    : byte1-2 斜率(0.1%/s，0为不限制), byte3-4 加速度(%/s²，0为不做S曲线) - 立即生效
+ * - 0x53 BYPASS_PWM     : byte1-2 载波(Hz，0为默认), byte3 颤振幅值(0.1%，0为关闭), byte4-5 颤振频率(Hz) - 下一周期生效
+ * 应答帧 CAN_MSG_PARAM_ACK_ID：byte0 操作码, byte1 结果,
+ *   0x50/0x51: byte2 当前换向频率(Hz，0为静态), byte3 通电占比(%), byte4-7 已完成换向周期数
+ *   0x52     : byte2-3 斜率(0.1%/s), byte4-5 加速度(%/s²), byte6-7 当前实际开度(0.1%)
+ *   0x53     : byte2-3 实际载波(Hz), byte4 颤振幅值(0.1%), byte5-6 颤振频率(Hz)
  */
 
 #ifndef VALVE_CONTROL_H
@@ -25,8 +51,22 @@ extern "C" {
 
 /* ============================================  Define  ============================================ */
 
+/* 参数设置帧操作码 */
+#define VALVE_CMD_REVERSAL_DUTY           0x50U       // 设置换向通电占比
+#define VALVE_CMD_REVERSAL_STATUS         0x51U       // 查询换向状态
+#define VALVE_CMD_BYPASS_RAMP             0x52U       // 设置旁通阀开度斜率/加速度限制
+#define VALVE_CMD_BYPASS_PWM              0x53U       // 设置旁通阀PWM载波与低频颤振
+
 /* ===========================================  Typedef  ============================================ */
 
+/*!
+ * @brief 换向命令执行结果（应答帧byte1）
+ */
+typedef enum {
+    VALVE_RESULT_OK = 0,
+    VALVE_RESULT_BAD_PARAM                    // 参数非法（占比、载波或颤振超出范围）
+} valve_control_result_t;
+
 
 /* 阀门硬件控制数据结构 */
 typedef struct {
@@ -35,7 +75,6 @@ typedef struct {
     valve_state_t cooler_state;             // 风冷器状态
     float bypass_valve_duty;                // 旁通阀开度
     directional_valve_mode_t valve_mode;    // 换向阀控制模式
-    directional_valve_stats_t stats;        // 统计信息
     bool hardware_ready;                    // 硬件就绪状态
     uint32_t last_update_time;              // 最后更新时间
     uint32_t error_count;                   // 硬件错误计数
@@ -64,6 +103,45 @@ void ValveControl_SetDirectionalValve(bool enable);
  */
 valve_state_t ValveControl_GetDirectionalValveState(void);
 
+/*!
+ * @brief 按指定频率定时换向（可在CAN接收中断中调用，相同参数重复调用无副作用）
+ * @param freq_hz 换向频率(Hz，1~DIRECTIONAL_VALVE_MAX_FREQ_HZ)；0为走完当前周期后停止
+ * @return true: 已启动或已排入下一周期, false: 频率超出范围或定时器配置失败
+ * 运行中变更频率在周期边界生效，不产生不完整周期
+ */
+bool ValveControl_SetDirectionalOscillation(uint8_t freq_hz);
+
+/*!
+ * @brief 设置换向通电占比（下一周期生效）
+ * @param duty_percent 通电时间占周期百分比(DIRECTIONAL_VALVE_MIN_DUTY~DIRECTIONAL_VALVE_MAX_DUTY)
+ * @return true: 设置成功, false: 超出范围
+ */
+bool ValveControl_SetDirectionalDuty(uint8_t duty_percent);
+
+/*!
+ * @brief 获取当前换向频率
+ * @return 正在执行的换向频率(Hz)，静态输出或正在停止时为0
+ */
+uint8_t ValveControl_GetDirectionalFrequency(void);
+
+/*!
+ * @brief 是否正在定时换向（含等待周期结束停止）
+ */
+bool ValveControl_IsDirectionalOscillating(void);
+
+/*!
+ * @brief 处理参数设置帧中的换向命令（CAN接收中断中调用）
+ * @param data 帧数据
+ * @param length 数据长度
+ * @return true: 已识别并受理, false: 非本模块命令
+ */
+bool ValveControl_HandleCanFrame(const uint8_t *data, uint8_t length);
+
+/*!
+ * @brief 换向后台任务：执行待处理命令并发送应答（10ms参数服务任务中调用）
+ */
+void ValveControl_Task(void);
+
 /*!
  * @brief 设置换向阀控制模式
  * @param mode 控制模式
@@ -99,17 +177,80 @@ void ValveControl_ResetDirectionalValveStats(void);
 /* ==================== 旁通阀控制 ==================== */
 
 /*!
- * @brief 设置旁通阀开度
+ * @brief 设置旁通阀目标开度（按斜率限制过渡）
  * @param duty 开度百分比(0-100)
  */
 void ValveControl_SetBypassValve(float duty);
 
 /*!
- * @brief 获取旁通阀开度
+ * @brief 旁通阀立即到位（不经斜率限制，供安全保护和上电初始化使用）
+ * @param duty 开度百分比(0-100)
+ */
+void ValveControl_SetBypassValveImmediate(float duty);
+
+/*!
+ * @brief 写入旁通阀目标开度（无打印，供压力闭环在采样中断中调用）
+ * @param duty 开度百分比(0-100)，按BYPASS_VALVE_MIN_DUTY~BYPASS_VALVE_MAX_DUTY限幅
+ */
+void ValveControl_WriteBypassValveDuty(float duty);
+
+/*!
+ * @brief 旁通阀开度立即到位（无打印，不经斜率限制，供本地压力闭环和继电器整定在采样中断中调用）
+ * @param duty 开度百分比(0-100)，按BYPASS_VALVE_MIN_DUTY~BYPASS_VALVE_MAX_DUTY限幅
+ */
+void ValveControl_WriteBypassValveDutyImmediate(float duty);
+
+/*!
+ * @brief 设置旁通阀开度斜率与加速度限制
+ * @param rate 斜率(%/s)，<=0不限制
+ * @param accel 加速度(%/s²)，<=0不做S曲线
+ */
+void ValveControl_SetBypassRamp(float rate, float accel);
+
+/*!
+ * @brief 设置旁通阀PWM载波频率与低频颤振（当前开度按新周期重写）
+ * @param carrier_hz 载波频率(Hz)，0为默认(BYPASS_PWM_MAX_COUNT对应频率)
+ * @param dither_amplitude 颤振幅值(%)，0为关闭，不超过BYPASS_DITHER_MAX_AMPLITUDE
+ * @param dither_freq_hz 颤振频率(Hz)，颤振关闭时忽略
+ * @return 参数超出范围时返回false，配置不变
+ */
+bool ValveControl_SetBypassPwm(uint32_t carrier_hz, float dither_amplitude, uint16_t dither_freq_hz);
+
+/*!
+ * @brief 获取旁通阀实际PWM载波频率
+ * @return 载波频率(Hz)
+ */
+uint32_t ValveControl_GetBypassPwmFrequency(void);
+
+/*!
+ * @brief 获取旁通阀实际PWM周期
+ * @return 周期(s)
+ */
+float ValveControl_GetBypassPwmPeriod(void);
+
+/*!
+ * @brief 直接写旁通阀PWM占空比（不更新实际开度，供电流闭环在采样中断中调用）
+ * @param duty PWM占空比(%)
+ */
+void ValveControl_OutputBypassPwm(float duty);
+
+/*!
+ * @brief 开启PWM0_CH3匹配触发，触发点随PWM输出保持在通电时间中点（电流采样链初始化时调用）
+ */
+void ValveControl_EnableCurrentTrigger(void);
+
+/*!
+ * @brief 获取旁通阀实际开度（当前PWM输出）
  * @return 开度百分比
  */
 float ValveControl_GetBypassValveDuty(void);
 
+/*!
+ * @brief 获取旁通阀目标开度
+ * @return 开度百分比
+ */
+float ValveControl_GetBypassValveTarget(void);
+
 /*!
  * @brief 获取旁通阀状态
  * @return 旁通阀状态
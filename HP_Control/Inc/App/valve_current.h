@@ -0,0 +1,132 @@
+/*!
+ * @file valve_current.h
+ * @brief 旁通阀线圈电流采样与电流闭环 - PWM同步采样分流电阻，ADC中断内逐PWM周期调节占空比
+ *
+ * 功能模块：
+ * - 采样链：PWM0_CH3匹配触发(通道计数值=通电时间一半) → CTU(TRGMUX) → PDT0延时 → ADC0注入组
+ *   采样点位于通电时间中点，连续导通时即为线圈平均电流，不受PWM纹波影响
+ * - 采样链上电后常开，开环模式下也更新线圈电流，供监控与故障诊断使用
+ * - 电流闭环：开度轨迹（斜率限制、颤振）输出作为电流设定值，ADC注入组转换完成中断中按
+ *   前馈+PI计算占空比并写PWM0_CH2，油温导致的线圈电阻变化和电源电压波动由积分补偿
+ * - 开度与电流的换算：开度100%对应 VCUR_COIL_SUPPLY_V / VCUR_COIL_RESISTANCE_OHM，
+ *   标称条件下两种模式的阀芯受力一致，切换无扰
+ * - 过流或采样中断停止（采样链故障）时退出闭环，回到开环占空比并置故障标志
+ * - 默认不启用（HP_VALVE_CURRENT_ENABLE为0）：下列采样硬件与线圈参数为待按原理图确认的占位值，
+ *   未启用时不配置PA0/ADC0/PDT0/触发路由，闭环模式请求返回失败
+ *
+ * CAN协议（参数设置帧 CAN_MSG_PARAM_SET_ID，byte0为操作码）：
+ * - 0x54 BYPASS_CURRENT: byte1 模式(0开环占空比, 1电流闭环), byte2-3 kp(0.1%/A，0为默认),
+ *                        byte4-5 ki(%/(A·s)，0为默认) - 立即生效
+ * 应答帧 CAN_MSG_PARAM_ACK_ID：byte0 操作码, byte1 结果, byte2 当前模式, byte3 故障标志,
+ *   byte4-5 线圈电流(mA), byte6-7 电流设定值(mA)
+ */
+
+#ifndef VALVE_CURRENT_H
+#define VALVE_CURRENT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+#include "common_types.h"
+
+/* ============================================  Define  ============================================ */
+
+/* ==================== 采样硬件（按原理图确认后打开HP_VALVE_CURRENT_ENABLE） ==================== */
+#define VCUR_ADC_INSTANCE                 0U          // ADC0（ADC1为传感器轮询与压力采集流占用）
+#define VCUR_ADC_CHANNEL                  0U          // 分流放大器输出 PA0_ADC0_IN0（按硬件原理图修改）
+#define VCUR_PDT_INSTANCE                 0U          // PDT0：匹配触发到ADC启动的延时
+#define VCUR_PDT_DELAY_COUNTS             0U          // PDT延时(PDT时钟计数)，补偿栅极驱动与电流检测滤波延迟
+
+/* ==================== 分流电阻与线圈 ==================== */
+#define VCUR_SHUNT_OHM                    0.1f        // 分流电阻(Ω)
+#define VCUR_AMP_GAIN                     20.0f       // 电流检测放大倍数
+#define VCUR_COIL_SUPPLY_V                24.0f       // 线圈标称电源电压(V)
+#define VCUR_COIL_RESISTANCE_OHM          20.0f       // 线圈20℃标称电阻(Ω)
+#define VCUR_OVERCURRENT_A                2.0f        // 过流保护阈值(A)
+
+/* ==================== 电流闭环 ==================== */
+#define VCUR_DEFAULT_KP                   100.0f      // 比例系数(%/A)，约100Hz电流环带宽（线圈电感50mH）
+#define VCUR_DEFAULT_KI                   40000.0f    // 积分系数(%/(A·s))，零点约等于线圈R/L
+#define VCUR_INTEGRAL_LIMIT               30.0f       // 积分修正量限幅(%)
+#define VCUR_MAX_PWM_DUTY                 95.0f       // 电流闭环最大PWM占空比(%)
+
+/* ==================== CAN操作码 ==================== */
+#define VCUR_CMD_BYPASS_CURRENT           0x54U       // 设置旁通阀驱动模式与电流环参数
+
+/* ==================== 模式与故障 ==================== */
+#define VCUR_MODE_DUTY                    0U          // 开环占空比
+#define VCUR_MODE_CURRENT                 1U          // 电流闭环
+
+#define VCUR_FAULT_NONE                   0x00U
+#define VCUR_FAULT_OVERCURRENT            0x01U       // 线圈电流超过VCUR_OVERCURRENT_A
+#define VCUR_FAULT_SAMPLE_STALL           0x02U       // 采样中断停止（触发链或ADC故障）
+
+/* ==========================================  Functions  =========================================== */
+
+/*!
+ * @brief 初始化采样链（需在PWM0与阀门控制模块初始化之后调用），上电为开环模式
+ */
+void ValveCurrent_Init(void);
+
+/*!
+ * @brief 切换旁通阀驱动模式
+ * @param mode VCUR_MODE_DUTY / VCUR_MODE_CURRENT
+ * @return 采样链未就绪（未启用或仿真模式）或模式非法时返回false
+ */
+bool ValveCurrent_SetMode(uint8_t mode);
+
+/*!
+ * @brief 设置电流环参数（下一个采样中断生效）
+ * @param kp 比例系数(%/A)
+ * @param ki 积分系数(%/(A·s))
+ */
+void ValveCurrent_SetGains(float kp, float ki);
+
+/*!
+ * @brief 电流闭环是否运行
+ */
+bool ValveCurrent_IsActive(void);
+
+/*!
+ * @brief 写入开度指令，闭环时换算为电流设定值（由阀门模块在开度轨迹输出时调用，可在中断中调用）
+ * @param duty 开度百分比
+ */
+void ValveCurrent_SetDemand(float duty);
+
+/*!
+ * @brief 获取最近一次采样的线圈电流
+ * @return 电流(A)
+ */
+float ValveCurrent_GetCurrent(void);
+
+/*!
+ * @brief 获取电流设定值
+ * @return 电流(A)，开环模式下为0
+ */
+float ValveCurrent_GetSetpoint(void);
+
+/*!
+ * @brief 获取故障标志（VCUR_FAULT_xxx，切换模式时清除）
+ */
+uint8_t ValveCurrent_GetFaults(void);
+
+/*!
+ * @brief CAN参数设置帧入口（CAN接收中断中调用，只做拷贝）
+ * @return 操作码属于本模块时返回true
+ */
+bool ValveCurrent_HandleCanFrame(const uint8_t *data, uint8_t length);
+
+/*!
+ * @brief 周期任务（10ms）：处理CAN命令，检查采样链是否停止
+ */
+void ValveCurrent_Task(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VALVE_CURRENT_H */
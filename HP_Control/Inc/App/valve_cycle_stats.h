@@ -0,0 +1,114 @@
+/*!
+ * @file valve_cycle_stats.h
+ * @brief 换向周期统计 - 按换向沿切分压力高速采样，逐周期提取峰谷、达峰时间、周期、超调和响应延迟
+ *
+ * 功能模块：
+ * - 采样来源：压力高速采集流旁路监听，录波/本地闭环/频谱分析占用采集流时共用其采样；
+ *   定时换向期间采集流空闲时以 VCYC_SAMPLE_PERIOD_US 后台运行，被占用者启动时直接让出
+ * - 周期定义：通电沿到下一个通电沿；通电沿时刻的油压为起始压力，断电沿前最后一个采样为平台压力
+ * - 采样中断内每个采样只做码值比较和累加（O(1)），周期结束时写入无锁环形缓冲
+ * - 参数服务任务取出周期记录，按标定换算为MPa，更新换向阀统计（directional_valve_stats_t）、
+ *   滑动平均，并向故障诊断报告阀门响应
+ * - 采集流中断（重启、停止）或两个采样之间出现多个换向沿时丢弃当前周期
+ *
+ * 指标定义：
+ * - 达峰时间：通电沿到周期内油压最大值的时间
+ * - 响应延迟：通电沿到油压偏离起始压力超过 VCYC_RESPONSE_DELTA_MPA 的时间，周期内未偏离视为无响应
+ * - 超调：(峰值 - 平台压力) / (平台压力 - 起始压力)，压力变化不足 VCYC_RESPONSE_DELTA_MPA 时为0
+ *
+ * 换向周期摘要帧 CAN_MSG_VALVE_CYCLE_ID（有新周期时每 VCYC_REPORT_INTERVAL_MS 发送一组两帧，byte0低4位为帧号）：
+ * - 帧0（最近周期）：byte0 帧号0|周期序号低4位<<4, byte1-2 峰值(0.01MPa), byte3-4 谷值(0.01MPa),
+ *   byte5 达峰时间(ms), byte6 响应延迟(ms，0xFF无响应), byte7 超调(%)
+ * - 帧1（滑动统计）：byte0 帧号1|周期序号低4位<<4, byte1-2 最近周期(0.1ms), byte3-4 平均周期(0.1ms),
+ *   byte5 平均响应延迟(ms), byte6 平均超调(%), byte7 响应成功率(%)
+ */
+
+#ifndef VALVE_CYCLE_STATS_H
+#define VALVE_CYCLE_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===========================================  Includes  =========================================== */
+#include <stdint.h>
+#include <stdbool.h>
+#include "common_types.h"
+
+/* ============================================  Define  ============================================ */
+
+/* ==================== 统计参数 ==================== */
+#define VCYC_SAMPLE_PERIOD_US             500U        // 后台采样周期(us)，2kHz，100Hz换向时每周期20个采样
+#define VCYC_RESPONSE_DELTA_MPA           0.2f        // 判定油压开始响应的偏离量(MPa)
+#define VCYC_AVG_WEIGHT                   0.125f      // 滑动平均权重（约8个周期）
+#define VCYC_REPORT_INTERVAL_MS           100U        // 摘要帧最短发送间隔(ms)
+#define VCYC_RING_SIZE                    8U          // 周期记录缓冲（2的幂），任务周期内最多缓冲的周期数
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 单个换向周期结果
+ */
+typedef struct {
+    float peak_mpa;                           // 周期内油压峰值(MPa)
+    float valley_mpa;                         // 周期内油压谷值(MPa)
+    float start_mpa;                          // 通电沿时油压(MPa)
+    float plateau_mpa;                        // 断电沿前油压(MPa)
+    float period_ms;                          // 周期(ms)
+    float time_to_peak_ms;                    // 达峰时间(ms)
+    float response_delay_ms;                  // 响应延迟(ms)，无响应时为周期长度
+    float overshoot_percent;                  // 超调(%)
+    bool responded;                           // 周期内油压是否响应
+} valve_cycle_result_t;
+
+/*!
+ * @brief 换向周期滑动统计
+ */
+typedef struct {
+    valve_cycle_result_t last;                // 最近一个周期
+    float avg_period_ms;                      // 平均周期(ms)
+    float avg_time_to_peak_ms;                // 平均达峰时间(ms)
+    float avg_response_delay_ms;              // 平均响应延迟(ms)，只统计有响应的周期
+    float avg_overshoot_percent;              // 平均超调(%)
+    uint32_t dropped_cycles;                  // 因采集中断或缓冲溢出丢弃的周期数
+} valve_cycle_summary_t;
+
+/* ==========================================  Functions  =========================================== */
+
+/*!
+ * @brief 初始化并注册采集流旁路监听（需在传感器模块初始化之后调用）
+ */
+void ValveCycleStats_Init(void);
+
+/*!
+ * @brief 换向沿通知（换向阀输出变化时由阀门模块调用，可在中断中调用）
+ * @param valve_on 新的输出电平
+ */
+void ValveCycleStats_NotifyValveEdge(bool valve_on);
+
+/*!
+ * @brief 周期任务（10ms）：管理后台采集，处理周期记录，发送摘要帧
+ */
+void ValveCycleStats_Task(void);
+
+/*!
+ * @brief 获取换向阀统计信息
+ */
+directional_valve_stats_t ValveCycleStats_GetStats(void);
+
+/*!
+ * @brief 获取换向周期滑动统计
+ * @return 摘要指针
+ */
+const valve_cycle_summary_t* ValveCycleStats_GetSummary(void);
+
+/*!
+ * @brief 清除统计（任务上下文调用）
+ */
+void ValveCycleStats_Reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VALVE_CYCLE_STATS_H */
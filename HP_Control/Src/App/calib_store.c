@@ -0,0 +1,1026 @@
+/*!
+ * @file calib_store.c
+ *
+ * @brief 传感器标定存储模块实现 - DFlash A/B页持久化 + CAN在线标定 + 查找表编译
+ *
+ * 说明：
+ * - 标定镜像写入时交替使用A/B两页，写入失败或掉电时另一页仍为有效镜像
+ * - 上电/标定更新时把"电压→电阻→分度表二分查找"整条链路预先编译为按ADC码索引的查找表，
+ *   采样转换只需一次查表+线性插值（每个区间8个ADC码，约9.8mV）
+ * - CAN接收回调运行在中断上下文，只做数据拷贝；校验、擦写和应答在CalibStore_Task中完成
+ * - 压力查找表在采样中断中使用：新表编译到备用缓冲，完成后切换通道指针发布，中断不会读到半更新的表
+ * - 温度查找表需逐码值扫描分度表（4096次），在CalibStore_Task中分步编译到备用缓冲，完成后切换；
+ *   编译期间温度转换继续使用旧表
+ */
+
+#include "calib_store.h"
+#include "can_config.h"
+#include "flash_drv.h"
+#include "osif.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define CALIB_ADC_CODE_MAX          4095U       // 12位ADC最大码值
+#define CALIB_LUT_FRAC_MASK         ((1U << CALIB_LUT_SHIFT) - 1U)
+#define CALIB_LUT_FRAC_SCALE        (1.0f / (float)(1U << CALIB_LUT_SHIFT))
+#define CALIB_CMD_NONE              0x00U       // 无待处理命令
+#define CALIB_DATA_SEGMENT_SIZE     5U          // 每个DATA帧最多携带5字节
+#define CALIB_IMAGE_V2_LENGTH       offsetof(calib_image_t, gain_schedule) // v1/v2镜像长度（无增益调度表）
+#define CALIB_TEMP_BUILD_STEP_CODES 256U        // 温度查找表每次任务调用编译的码值数（约0.3ms）
+#define CALIB_VERIFY_CHUNK_SIZE     32U         // 写入后回读校验的分段长度（字节）
+
+/* 镜像长度必须为DFlash写入单元(8字节)整数倍且不超过一页 */
+typedef char calib_image_size_check_t[((sizeof(calib_image_t) % PFLASH_WRITE_UNIT_SIZE) == 0U &&
+                                       sizeof(calib_image_t) <= DFLASH_PAGE_SIZE) ? 1 : -1];
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 压力通道编译结果
+ */
+typedef struct {
+    float k;                                  // 线性标定：P = code * k + b
+    float b;
+    float out_min;                            // 输出下限
+    float out_max;                            // 输出上限
+    uint16_t code_min;                        // 低于该码值输出out_min
+    uint16_t code_max;                        // 高于该码值输出out_max
+    bool use_lut;                             // 多点曲线使用查找表
+    float lut[CALIB_LUT_SIZE];                // 多点曲线查找表
+} calib_pressure_compiled_t;
+
+/*!
+ * @brief 温度通道编译结果
+ */
+typedef struct {
+    uint16_t code_valid_min;                  // 电阻落在分度表范围内的最小码值
+    uint16_t code_valid_max;                  // 电阻落在分度表范围内的最大码值
+    float fallback;                           // 有效区间外的输出（不含偏移量）
+    float lut[CALIB_LUT_SIZE];                // 查找表（不含偏移量）
+} calib_temperature_compiled_t;
+
+/*!
+ * @brief 温度查找表分步编译状态
+ */
+typedef struct {
+    uint8_t channel;                          // 正在编译的通道，CALIB_TEMP_COUNT为空闲
+    uint16_t code;                            // 下一个待扫描码值
+} calib_temp_build_t;
+
+/*!
+ * @brief CAN上传状态
+ */
+typedef struct {
+    uint16_t expected_length;                 // BEGIN声明的镜像长度
+    uint16_t received_end;                    // 已收到数据的最大结束偏移
+    bool active;                              // 上传进行中
+    bool begin_ack;                           // BEGIN待应答
+} calib_upload_t;
+
+/* ==========================================  Variables  =========================================== */
+
+// 当前生效的标定镜像
+static calib_image_t g_calib_image;
+
+// CAN上传暂存区
+static calib_image_t g_calib_staging;
+static calib_upload_t g_calib_upload;
+
+// 编译后的查找表：每类多一个备用缓冲，编译到备用缓冲后切换通道指针，旧缓冲成为新的备用缓冲
+static calib_pressure_compiled_t g_pressure_bank[CALIB_PRESSURE_COUNT + 1U];
+static calib_pressure_compiled_t * volatile g_pressure_active[CALIB_PRESSURE_COUNT];
+static calib_pressure_compiled_t *g_pressure_spare;
+static calib_temperature_compiled_t g_temperature_bank[CALIB_TEMP_COUNT + 1U];
+static calib_temperature_compiled_t *g_temperature_active[CALIB_TEMP_COUNT];
+static calib_temperature_compiled_t *g_temperature_spare;
+static calib_temp_build_t g_temp_build;
+static uint32_t g_pressure_revision = 0U;     // 压力查找表每次发布递增
+
+// 编译后的增益调度表（断点倒数预计算，区间索引缓存）
+static platform_gain_schedule_t g_gain_schedule;
+static bool g_gain_schedule_enabled = false;
+
+// DFlash状态
+static flash_config_t g_flash_config;
+static uint32_t g_active_page_addr = 0U;      // 当前有效镜像所在页，0表示DFlash中无有效镜像
+static bool g_save_pending = false;
+static uint32_t g_save_request_time = 0U;
+
+// 中断→任务的待处理命令
+static volatile uint8_t g_pending_cmd = CALIB_CMD_NONE;
+static volatile uint32_t g_pending_arg = 0U;
+
+// CRC32半字节表（多项式0xEDB88320）
+static const uint32_t CALIB_CRC32_TABLE[16] = {
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/* ====================================  Functions declaration  ===================================== */
+static void CalibStore_BuildDefaults(calib_image_t *image);
+static uint32_t CalibStore_ImageCrc(const calib_image_t *image);
+static calib_status_t CalibStore_ValidateGainSchedule(const calib_gain_schedule_t *sched);
+static calib_status_t CalibStore_Validate(const calib_image_t *image);
+static void CalibStore_Upgrade(calib_image_t *image);
+static void CalibStore_CompilePressure(uint8_t ch);
+static void CalibStore_CompileGainSchedule(void);
+static void CalibStore_Compile(void);
+static bool CalibStore_BuildTemperatureStep(void);
+static bool CalibStore_ReadPage(uint32_t addr, calib_image_t *image);
+static bool CalibStore_WritePage(uint32_t addr, const calib_image_t *image);
+static void CalibStore_SendAck(uint8_t cmd, calib_status_t status, uint16_t offset, uint32_t value);
+
+/* ======================================  Functions define  ======================================== */
+
+/* ==================== 工具函数 ==================== */
+
+uint32_t CalibStore_Crc32(uint32_t crc, const uint8_t *data, uint32_t length)
+{
+    if (data == NULL) {
+        return crc;
+    }
+
+    crc = ~crc;
+    for (uint32_t i = 0; i < length; i++) {
+        crc = CALIB_CRC32_TABLE[(crc ^ data[i]) & 0x0FU] ^ (crc >> 4);
+        crc = CALIB_CRC32_TABLE[(crc ^ (data[i] >> 4)) & 0x0FU] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+/*!
+ * @brief 计算镜像CRC32（跳过header.crc32字段，按header.length覆盖旧版本较短的镜像）
+ */
+static uint32_t CalibStore_ImageCrc(const calib_image_t *image)
+{
+    const uint8_t *bytes = (const uint8_t *)image;
+    uint32_t length = image->header.length;
+    if (length < sizeof(calib_image_header_t) || length > sizeof(calib_image_t)) {
+        length = sizeof(calib_image_t);
+    }
+    uint32_t crc = CalibStore_Crc32(0U, bytes, offsetof(calib_image_header_t, crc32));
+    return CalibStore_Crc32(crc, bytes + sizeof(calib_image_header_t),
+                            length - sizeof(calib_image_header_t));
+}
+
+static bool CalibStore_IsFinite(float value)
+{
+    return (value == value) && (value < 1.0e30f) && (value > -1.0e30f);
+}
+
+/*!
+ * @brief 按ADC码查表并线性插值
+ */
+static float CalibStore_LutLookup(const float *lut, uint16_t adc_raw)
+{
+    uint16_t code = (adc_raw > CALIB_ADC_CODE_MAX) ? CALIB_ADC_CODE_MAX : adc_raw;
+    uint16_t idx = code >> CALIB_LUT_SHIFT;
+    float frac = (float)(code & CALIB_LUT_FRAC_MASK) * CALIB_LUT_FRAC_SCALE;
+    return lut[idx] + (lut[idx + 1U] - lut[idx]) * frac;
+}
+
+static float CalibStore_CodeToVoltage(uint32_t code)
+{
+    return (float)code * ADC_REFERENCE_VOLTAGE / ADC_MAX_VALUE;
+}
+
+/* ==================== 出厂标定 ==================== */
+
+/*!
+ * @brief 生成出厂标定镜像（与原固定参数一致）
+ */
+static void CalibStore_BuildDefaults(calib_image_t *image)
+{
+    memset(image, 0, sizeof(calib_image_t));
+
+    image->header.magic = CALIB_STORE_MAGIC;
+    image->header.version = CALIB_STORE_VERSION;
+    image->header.length = (uint16_t)sizeof(calib_image_t);
+
+    // 油压：4-20mA对应0.8-4V，对应0-40MPa，P = (V - 0.8) * 12.5
+    image->pressure[CALIB_PRESSURE_OIL].zero_voltage = 0.8f;
+    image->pressure[CALIB_PRESSURE_OIL].gain = 12.5f;
+    image->pressure[CALIB_PRESSURE_OIL].offset = 0.0f;
+    image->pressure[CALIB_PRESSURE_OIL].min_voltage = 0.8f;
+    image->pressure[CALIB_PRESSURE_OIL].max_voltage = 4.0f;
+    image->pressure[CALIB_PRESSURE_OIL].min_output = 0.0f;
+    image->pressure[CALIB_PRESSURE_OIL].max_output = 40.0f;
+
+    // LNG压力：4-20mA对应0.8-4V，对应0-35MPa，P = (V - 0.8) * 10.9375
+    image->pressure[CALIB_PRESSURE_LNG].zero_voltage = 0.8f;
+    image->pressure[CALIB_PRESSURE_LNG].gain = 10.9375f;
+    image->pressure[CALIB_PRESSURE_LNG].offset = 0.0f;
+    image->pressure[CALIB_PRESSURE_LNG].min_voltage = 0.8f;
+    image->pressure[CALIB_PRESSURE_LNG].max_voltage = 4.0f;
+    image->pressure[CALIB_PRESSURE_LNG].min_output = 0.0f;
+    image->pressure[CALIB_PRESSURE_LNG].max_output = 35.0f;
+
+    // 温度：PT1000实测标定点，超出分度表返回25°C，最低-40°C
+    uint8_t count = 0U;
+    const pt1000_calib_point_t *points = pt1000_get_default_calib_points(&count);
+    if (count > CALIB_PT1000_MAX_POINTS) {
+        count = CALIB_PT1000_MAX_POINTS;
+    }
+    for (uint8_t ch = 0; ch < CALIB_TEMP_COUNT; ch++) {
+        image->temperature[ch].min_temp = -40.0f;
+        image->temperature[ch].fallback_temp = 25.0f;
+        image->temperature[ch].point_count = count;
+        memcpy(image->temperature[ch].points, points, count * sizeof(pt1000_calib_point_t));
+    }
+    image->temperature[CALIB_TEMP_OIL].offset = OIL_TEMP_CALIBRATION_OFFSET;
+    image->temperature[CALIB_TEMP_LNG].offset = LNG_TEMP_CALIBRATION_OFFSET;
+
+    image->header.crc32 = CalibStore_ImageCrc(image);
+}
+
+/* ==================== 校验与编译 ==================== */
+
+/*!
+ * @brief 校验增益调度表（断点递增、增益非负）
+ */
+static calib_status_t CalibStore_ValidateGainSchedule(const calib_gain_schedule_t *sched)
+{
+    if (sched->temp_points == 0U) {
+        return CALIB_STATUS_OK;
+    }
+    if (sched->temp_points > CALIB_SCHED_TEMP_POINTS ||
+        sched->pressure_points == 0U || sched->pressure_points > CALIB_SCHED_PRESSURE_POINTS) {
+        return CALIB_STATUS_BAD_CONTENT;
+    }
+
+    for (uint8_t i = 0; i < sched->temp_points; i++) {
+        if (!CalibStore_IsFinite(sched->temp_axis[i]) ||
+            (i > 0U && sched->temp_axis[i] <= sched->temp_axis[i - 1U])) {
+            return CALIB_STATUS_BAD_CONTENT;
+        }
+    }
+    for (uint8_t j = 0; j < sched->pressure_points; j++) {
+        if (!CalibStore_IsFinite(sched->pressure_axis[j]) ||
+            (j > 0U && sched->pressure_axis[j] <= sched->pressure_axis[j - 1U])) {
+            return CALIB_STATUS_BAD_CONTENT;
+        }
+    }
+    for (uint8_t i = 0; i < sched->temp_points; i++) {
+        for (uint8_t j = 0; j < sched->pressure_points; j++) {
+            const platform_gain_set_t *g = &sched->gains[i][j];
+            if (!CalibStore_IsFinite(g->kp) || !CalibStore_IsFinite(g->ki) ||
+                !CalibStore_IsFinite(g->kd) || !CalibStore_IsFinite(g->feedforward) ||
+                g->kp < 0.0f || g->ki < 0.0f || g->kd < 0.0f) {
+                return CALIB_STATUS_BAD_CONTENT;
+            }
+        }
+    }
+    return CALIB_STATUS_OK;
+}
+
+/*!
+ * @brief 校验标定镜像（格式、CRC和内容合理性）
+ */
+static calib_status_t CalibStore_Validate(const calib_image_t *image)
+{
+    uint32_t expected_length = (image->header.version >= 3U) ? sizeof(calib_image_t) : CALIB_IMAGE_V2_LENGTH;
+
+    if (image->header.magic != CALIB_STORE_MAGIC ||
+        image->header.version < CALIB_STORE_VERSION_MIN ||
+        image->header.version > CALIB_STORE_VERSION ||
+        image->header.length != expected_length) {
+        return CALIB_STATUS_BAD_CONTENT;
+    }
+
+    if (image->header.crc32 != CalibStore_ImageCrc(image)) {
+        return CALIB_STATUS_BAD_CRC;
+    }
+
+    for (uint8_t ch = 0; ch < CALIB_PRESSURE_COUNT; ch++) {
+        const calib_pressure_t *p = &image->pressure[ch];
+
+        if (!CalibStore_IsFinite(p->zero_voltage) || !CalibStore_IsFinite(p->gain) ||
+            !CalibStore_IsFinite(p->offset) || !CalibStore_IsFinite(p->min_voltage) ||
+            !CalibStore_IsFinite(p->max_voltage) || !CalibStore_IsFinite(p->min_output) ||
+            !CalibStore_IsFinite(p->max_output)) {
+            return CALIB_STATUS_BAD_CONTENT;
+        }
+        if (p->min_voltage >= p->max_voltage || p->min_output >= p->max_output) {
+            return CALIB_STATUS_BAD_CONTENT;
+        }
+        if (p->curve_points == 1U || p->curve_points > CALIB_CURVE_MAX_POINTS) {
+            return CALIB_STATUS_BAD_CONTENT;
+        }
+        for (uint8_t i = 0; i < p->curve_points; i++) {
+            if (!CalibStore_IsFinite(p->curve[i].x) || !CalibStore_IsFinite(p->curve[i].y)) {
+                return CALIB_STATUS_BAD_CONTENT;
+            }
+            if (i > 0U && p->curve[i].x <= p->curve[i - 1U].x) {
+                return CALIB_STATUS_BAD_CONTENT;
+            }
+        }
+    }
+
+    for (uint8_t ch = 0; ch < CALIB_TEMP_COUNT; ch++) {
+        const calib_temperature_t *t = &image->temperature[ch];
+
+        if (!CalibStore_IsFinite(t->offset) || !CalibStore_IsFinite(t->min_temp) ||
+            !CalibStore_IsFinite(t->fallback_temp)) {
+            return CALIB_STATUS_BAD_CONTENT;
+        }
+        if (t->point_count < 2U || t->point_count > CALIB_PT1000_MAX_POINTS) {
+            return CALIB_STATUS_BAD_CONTENT;
+        }
+        for (uint8_t i = 0; i < t->point_count; i++) {
+            if (!CalibStore_IsFinite(t->points[i].voltage) || !(t->points[i].resistance > 0.0f) ||
+                !CalibStore_IsFinite(t->points[i].resistance)) {
+                return CALIB_STATUS_BAD_CONTENT;
+            }
+            if (i > 0U && t->points[i].voltage <= t->points[i - 1U].voltage) {
+                return CALIB_STATUS_BAD_CONTENT;
+            }
+        }
+    }
+
+    if (image->header.version >= 3U) {
+        return CalibStore_ValidateGainSchedule(&image->gain_schedule);
+    }
+    return CALIB_STATUS_OK;
+}
+
+/*!
+ * @brief 将已校验的旧版本镜像升级为当前版本
+ * v1 -> v2：压力通道保留字节改为自动调零修正量，v1中该处无意义，清零
+ * v2 -> v3：镜像末尾追加增益调度表，旧镜像读入时该区域为页内其他数据，清零（不启用）
+ */
+static void CalibStore_Upgrade(calib_image_t *image)
+{
+    if (image->header.version >= CALIB_STORE_VERSION) {
+        return;
+    }
+    if (image->header.version < 2U) {
+        for (uint8_t ch = 0; ch < CALIB_PRESSURE_COUNT; ch++) {
+            image->pressure[ch].reserved = 0U;
+            image->pressure[ch].zero_trim = 0;
+        }
+    }
+    memset(&image->gain_schedule, 0, sizeof(image->gain_schedule));
+    image->header.version = CALIB_STORE_VERSION;
+    image->header.length = (uint16_t)sizeof(calib_image_t);
+    image->header.crc32 = CalibStore_ImageCrc(image);
+}
+
+/*!
+ * @brief 多点曲线分段线性插值（两端按首末段斜率外推）
+ */
+static float CalibStore_CurveEvaluate(const calib_pressure_t *p, float voltage)
+{
+    uint8_t seg = 0U;
+    while (seg + 2U < p->curve_points && voltage > p->curve[seg + 1U].x) {
+        seg++;
+    }
+    const calib_point_t *a = &p->curve[seg];
+    const calib_point_t *b = &p->curve[seg + 1U];
+    return a->y + (b->y - a->y) * (voltage - a->x) / (b->x - a->x);
+}
+
+static uint16_t CalibStore_VoltageToCode(float voltage, bool round_up)
+{
+    float code = voltage * ADC_MAX_VALUE / ADC_REFERENCE_VOLTAGE;
+    if (code <= 0.0f) {
+        return 0U;
+    }
+    if (code >= (float)CALIB_ADC_CODE_MAX) {
+        return CALIB_ADC_CODE_MAX;
+    }
+    uint16_t whole = (uint16_t)code;
+    if (round_up && (float)whole < code) {
+        whole++;
+    }
+    return whole;
+}
+
+/*!
+ * @brief 编译单个压力通道（自动调零修正并入线性系数/查找表，转换时无额外开销）
+ */
+static void CalibStore_CompilePressure(uint8_t ch)
+{
+    const float volt_per_code = ADC_REFERENCE_VOLTAGE / ADC_MAX_VALUE;
+    const calib_pressure_t *p = &g_calib_image.pressure[ch];
+    calib_pressure_compiled_t *c = g_pressure_spare;
+    float trim_v = (float)p->zero_trim * CALIB_ZERO_TRIM_LSB_V;
+
+    c->out_min = p->min_output;
+    c->out_max = p->max_output;
+    // 低于min_voltage的码值视为断线，高于max_voltage的码值视为满量程（按实际电压判断，不含调零修正）
+    c->code_min = CalibStore_VoltageToCode(p->min_voltage, true);
+    c->code_max = (p->max_voltage >= ADC_REFERENCE_VOLTAGE) ? CALIB_ADC_CODE_MAX
+                : CalibStore_VoltageToCode(p->max_voltage, false);
+    c->use_lut = (p->curve_points >= 2U);
+    c->k = p->gain * volt_per_code;
+    c->b = p->offset - (p->zero_voltage + trim_v) * p->gain;
+
+    if (c->use_lut) {
+        for (uint32_t i = 0; i < CALIB_LUT_SIZE; i++) {
+            uint32_t code = i << CALIB_LUT_SHIFT;
+            float value = CalibStore_CurveEvaluate(p, CalibStore_CodeToVoltage(code) - trim_v) + p->offset;
+            if (value < c->out_min) value = c->out_min;
+            if (value > c->out_max) value = c->out_max;
+            c->lut[i] = value;
+        }
+    }
+
+    // 编译结果写完后再切换指针（单字写入，采样中断只会看到完整的旧表或新表）
+    __DMB();
+    g_pressure_spare = g_pressure_active[ch];
+    g_pressure_active[ch] = c;
+    g_pressure_revision++;
+}
+
+/*!
+ * @brief 编译增益调度表：参数直接引用镜像，只预计算断点区间倒数
+ */
+static void CalibStore_CompileGainSchedule(void)
+{
+    const calib_gain_schedule_t *sched = &g_calib_image.gain_schedule;
+    g_gain_schedule_enabled = (sched->temp_points > 0U) &&
+                              (PlatformSchedule_Init(&g_gain_schedule,
+                                                     sched->temp_axis, sched->temp_points,
+                                                     sched->pressure_axis, sched->pressure_points,
+                                                     &sched->gains[0][0], CALIB_SCHED_PRESSURE_POINTS) == PLATFORM_STATUS_OK);
+}
+
+/*!
+ * @brief 温度查找表节点：节点电阻限制在分度表范围内，保证有效区间边缘的插值连续
+ */
+static float CalibStore_TemperatureNode(const calib_temperature_t *t, float resistance,
+                                        float r_lut_min, float r_lut_max)
+{
+    if (resistance < r_lut_min) resistance = r_lut_min;
+    if (resistance > r_lut_max) resistance = r_lut_max;
+
+    float temperature = pt1000_get_temp_float(resistance);
+    return (temperature < t->min_temp) ? t->min_temp : temperature;
+}
+
+/*!
+ * @brief 分步编译温度查找表：每次扫描CALIB_TEMP_BUILD_STEP_CODES个码值，通道完成后切换指针
+ * @return 仍有未完成的通道时返回true
+ */
+static bool CalibStore_BuildTemperatureStep(void)
+{
+    if (g_temp_build.channel >= CALIB_TEMP_COUNT) {
+        return false;
+    }
+
+    const float *pt1000_lut = pt1000_get_lut_float();
+    const float r_lut_min = pt1000_lut[0];
+    const float r_lut_max = pt1000_lut[LUT_TABLE_SIZE - 1];
+    const calib_temperature_t *t = &g_calib_image.temperature[g_temp_build.channel];
+    calib_temperature_compiled_t *c = g_temperature_spare;
+    uint32_t code = g_temp_build.code;
+    uint32_t end = code + CALIB_TEMP_BUILD_STEP_CODES;
+
+    if (end > CALIB_ADC_CODE_MAX + 1U) {
+        end = CALIB_ADC_CODE_MAX + 1U;
+    }
+    if (code == 0U) {
+        c->code_valid_min = CALIB_ADC_CODE_MAX + 1U;
+        c->code_valid_max = 0U;
+        c->fallback = (t->fallback_temp < t->min_temp) ? t->min_temp : t->fallback_temp;
+    }
+
+    for (; code < end; code++) {
+        float resistance = pt1000_voltage_to_resistance_table(CalibStore_CodeToVoltage(code),
+                                                              t->points, t->point_count);
+
+        // 电阻超出分度表的码值区间输出fallback，按码值精确划分，避免查表插值跨越该跳变
+        if (resistance >= r_lut_min && resistance <= r_lut_max) {
+            if (code < c->code_valid_min) c->code_valid_min = (uint16_t)code;
+            c->code_valid_max = (uint16_t)code;
+        }
+        if ((code & CALIB_LUT_FRAC_MASK) == 0U) {
+            c->lut[code >> CALIB_LUT_SHIFT] = CalibStore_TemperatureNode(t, resistance, r_lut_min, r_lut_max);
+        }
+    }
+
+    if (end <= CALIB_ADC_CODE_MAX) {
+        g_temp_build.code = (uint16_t)end;
+        return true;
+    }
+
+    // 末端节点（码值4096）
+    float resistance = pt1000_voltage_to_resistance_table(CalibStore_CodeToVoltage(CALIB_ADC_CODE_MAX + 1U),
+                                                          t->points, t->point_count);
+    c->lut[CALIB_LUT_SIZE - 1U] = CalibStore_TemperatureNode(t, resistance, r_lut_min, r_lut_max);
+
+    g_temperature_spare = g_temperature_active[g_temp_build.channel];
+    g_temperature_active[g_temp_build.channel] = c;
+    g_temp_build.channel++;
+    g_temp_build.code = 0U;
+    return g_temp_build.channel < CALIB_TEMP_COUNT;
+}
+
+/*!
+ * @brief 将当前标定镜像编译为查找表（压力立即生效，温度在CalibStore_Task中分步完成）
+ */
+static void CalibStore_Compile(void)
+{
+    for (uint8_t ch = 0; ch < CALIB_PRESSURE_COUNT; ch++) {
+        CalibStore_CompilePressure(ch);
+    }
+
+    CalibStore_CompileGainSchedule();
+
+    // 编译进行中时从头开始，备用缓冲中的半成品直接覆盖
+    g_temp_build.channel = 0U;
+    g_temp_build.code = 0U;
+}
+
+/* ==================== DFlash读写 ==================== */
+
+static bool CalibStore_ReadPage(uint32_t addr, calib_image_t *image)
+{
+    if (FLASH_DRV_Read(&g_flash_config, addr, (uint8_t *)image, sizeof(calib_image_t)) != STATUS_SUCCESS) {
+        return false;
+    }
+    if (CalibStore_Validate(image) != CALIB_STATUS_OK) {
+        return false;
+    }
+    CalibStore_Upgrade(image);
+    return true;
+}
+
+static bool CalibStore_WritePage(uint32_t addr, const calib_image_t *image)
+{
+    status_t ret = FLASH_DRV_UnlockCtrl();
+
+    if (ret == STATUS_SUCCESS) {
+        ret = FLASH_DRV_EraseSector(&g_flash_config, addr, DFLASH_PAGE_SIZE);
+    }
+    if (ret == STATUS_SUCCESS) {
+        ret = FLASH_DRV_Program(&g_flash_config, addr, sizeof(calib_image_t), (const uint8_t *)image);
+    }
+    FLASH_DRV_LockCtrl();
+
+    // 经驱动分段回读确认（不直接按地址访问DFlash，PC端替身同样适用）
+    uint8_t readback[CALIB_VERIFY_CHUNK_SIZE];
+    for (uint32_t pos = 0U; ret == STATUS_SUCCESS && pos < sizeof(calib_image_t); pos += sizeof(readback)) {
+        uint32_t size = sizeof(calib_image_t) - pos;
+        if (size > sizeof(readback)) {
+            size = sizeof(readback);
+        }
+        ret = FLASH_DRV_Read(&g_flash_config, addr + pos, readback, size);
+        if (ret == STATUS_SUCCESS && memcmp(readback, (const uint8_t *)image + pos, size) != 0) {
+            ret = STATUS_ERROR;
+        }
+    }
+    return ret == STATUS_SUCCESS;
+}
+
+/* ==================== 初始化接口 ==================== */
+
+void CalibStore_Init(void)
+{
+    flash_user_config_t flash_user_config;
+    FLASH_DRV_GetDefaultConfig(&flash_user_config);
+    FLASH_DRV_Init(&flash_user_config, &g_flash_config);
+
+    memset(&g_calib_upload, 0, sizeof(g_calib_upload));
+    g_pending_cmd = CALIB_CMD_NONE;
+    g_save_pending = false;
+    g_active_page_addr = 0U;
+
+    for (uint8_t ch = 0; ch < CALIB_PRESSURE_COUNT; ch++) {
+        g_pressure_active[ch] = &g_pressure_bank[ch];
+    }
+    g_pressure_spare = &g_pressure_bank[CALIB_PRESSURE_COUNT];
+    for (uint8_t ch = 0; ch < CALIB_TEMP_COUNT; ch++) {
+        g_temperature_active[ch] = &g_temperature_bank[ch];
+    }
+    g_temperature_spare = &g_temperature_bank[CALIB_TEMP_COUNT];
+
+    // A/B页中取序号较新的有效镜像（暂存区用作B页读取缓冲）
+    bool valid_a = CalibStore_ReadPage(CALIB_STORE_PAGE_A_ADDR, &g_calib_image);
+    bool valid_b = CalibStore_ReadPage(CALIB_STORE_PAGE_B_ADDR, &g_calib_staging);
+
+    if (valid_b && (!valid_a || (int32_t)(g_calib_staging.header.sequence - g_calib_image.header.sequence) > 0)) {
+        memcpy(&g_calib_image, &g_calib_staging, sizeof(calib_image_t));
+        g_active_page_addr = CALIB_STORE_PAGE_B_ADDR;
+    } else if (valid_a) {
+        g_active_page_addr = CALIB_STORE_PAGE_A_ADDR;
+    } else {
+        CalibStore_BuildDefaults(&g_calib_image);
+    }
+
+    // 上电时任务尚未运行，温度查找表一次编译完成
+    CalibStore_Compile();
+    while (CalibStore_BuildTemperatureStep()) {
+    }
+
+    if (g_active_page_addr != 0U) {
+        printf("[CALIB] Loaded calibration #%lu from DFlash page %c\r\n",
+               (unsigned long)g_calib_image.header.sequence,
+               (g_active_page_addr == CALIB_STORE_PAGE_A_ADDR) ? 'A' : 'B');
+    } else {
+        printf("[CALIB] No valid calibration in DFlash, using factory defaults\r\n");
+    }
+}
+
+/* ==================== 采样转换接口 ==================== */
+
+float CalibStore_ConvertPressure(calib_pressure_channel_id_t channel, uint16_t adc_raw)
+{
+    if (channel >= CALIB_PRESSURE_COUNT) {
+        return 0.0f;
+    }
+
+    const calib_pressure_compiled_t *c = g_pressure_active[channel];
+
+    if (adc_raw < c->code_min) {
+        return c->out_min;
+    }
+    if (adc_raw > c->code_max) {
+        return c->out_max;
+    }
+    if (c->use_lut) {
+        return CalibStore_LutLookup(c->lut, adc_raw);
+    }
+
+    float pressure = (float)adc_raw * c->k + c->b;
+    if (pressure < c->out_min) pressure = c->out_min;
+    if (pressure > c->out_max) pressure = c->out_max;
+    return pressure;
+}
+
+uint32_t CalibStore_GetPressureRevision(void)
+{
+    return g_pressure_revision;
+}
+
+float CalibStore_ConvertTemperature(calib_temp_channel_id_t channel, uint16_t adc_raw)
+{
+    if (channel >= CALIB_TEMP_COUNT) {
+        return 0.0f;
+    }
+    const calib_temperature_compiled_t *c = g_temperature_active[channel];
+    float offset = g_calib_image.temperature[channel].offset;
+
+    if (adc_raw < c->code_valid_min || adc_raw > c->code_valid_max) {
+        return c->fallback + offset;
+    }
+    return CalibStore_LutLookup(c->lut, adc_raw) + offset;
+}
+
+/* ==================== 标定参数接口 ==================== */
+
+float CalibStore_GetTemperatureOffset(calib_temp_channel_id_t channel)
+{
+    if (channel >= CALIB_TEMP_COUNT) {
+        return 0.0f;
+    }
+    return g_calib_image.temperature[channel].offset;
+}
+
+void CalibStore_SetTemperatureOffset(calib_temp_channel_id_t channel, float offset)
+{
+    if (channel >= CALIB_TEMP_COUNT || !CalibStore_IsFinite(offset)) {
+        return;
+    }
+    if (g_calib_image.temperature[channel].offset == offset) {
+        return;
+    }
+
+    // 偏移量在转换时实时叠加，无需重新编译查找表
+    g_calib_image.temperature[channel].offset = offset;
+    g_calib_image.header.crc32 = CalibStore_ImageCrc(&g_calib_image);
+    g_save_pending = true;
+    g_save_request_time = OSIF_GetMilliseconds();
+}
+
+float CalibStore_GetPressureZeroVoltage(calib_pressure_channel_id_t channel)
+{
+    if (channel >= CALIB_PRESSURE_COUNT) {
+        return 0.0f;
+    }
+    const calib_pressure_t *p = &g_calib_image.pressure[channel];
+
+    if (p->curve_points < 2U) {
+        return (p->gain != 0.0f) ? (p->zero_voltage - p->offset / p->gain) : p->zero_voltage;
+    }
+
+    // 多点曲线：找到 curve.y + offset 过零的区间并反插值
+    for (uint8_t i = 0; i + 1U < p->curve_points; i++) {
+        float y0 = p->curve[i].y + p->offset;
+        float y1 = p->curve[i + 1U].y + p->offset;
+        if ((y0 <= 0.0f && y1 >= 0.0f) || (y0 >= 0.0f && y1 <= 0.0f)) {
+            if (y1 == y0) {
+                return p->curve[i].x;
+            }
+            return p->curve[i].x + (p->curve[i + 1U].x - p->curve[i].x) * (0.0f - y0) / (y1 - y0);
+        }
+    }
+    return p->zero_voltage;
+}
+
+float CalibStore_GetPressureZeroTrim(calib_pressure_channel_id_t channel)
+{
+    if (channel >= CALIB_PRESSURE_COUNT) {
+        return 0.0f;
+    }
+    return (float)g_calib_image.pressure[channel].zero_trim * CALIB_ZERO_TRIM_LSB_V;
+}
+
+void CalibStore_SetPressureZeroTrim(calib_pressure_channel_id_t channel, float trim_v)
+{
+    if (channel >= CALIB_PRESSURE_COUNT || !CalibStore_IsFinite(trim_v)) {
+        return;
+    }
+
+    float lsb = trim_v / CALIB_ZERO_TRIM_LSB_V;
+    if (lsb > 32767.0f) lsb = 32767.0f;
+    if (lsb < -32768.0f) lsb = -32768.0f;
+    int16_t trim = (int16_t)((lsb >= 0.0f) ? (lsb + 0.5f) : (lsb - 0.5f));
+    if (g_calib_image.pressure[channel].zero_trim == trim) {
+        return;
+    }
+
+    g_calib_image.pressure[channel].zero_trim = trim;
+    g_calib_image.header.crc32 = CalibStore_ImageCrc(&g_calib_image);
+    CalibStore_CompilePressure((uint8_t)channel);
+    g_save_pending = true;
+    g_save_request_time = OSIF_GetMilliseconds();
+}
+
+const calib_image_t* CalibStore_GetImage(void)
+{
+    return &g_calib_image;
+}
+
+calib_status_t CalibStore_Apply(const calib_image_t *image)
+{
+    if (image == NULL) {
+        return CALIB_STATUS_BAD_CONTENT;
+    }
+
+    calib_status_t status = CalibStore_Validate(image);
+    if (status != CALIB_STATUS_OK) {
+        return status;
+    }
+
+    // 序号由存储管理，保留当前值
+    uint32_t sequence = g_calib_image.header.sequence;
+    memcpy(&g_calib_image, image, sizeof(calib_image_t));
+    CalibStore_Upgrade(&g_calib_image);
+    g_calib_image.header.sequence = sequence;
+    g_calib_image.header.crc32 = CalibStore_ImageCrc(&g_calib_image);
+
+    CalibStore_Compile();
+    g_save_pending = true;
+    g_save_request_time = OSIF_GetMilliseconds();
+    return CALIB_STATUS_OK;
+}
+
+void CalibStore_RestoreDefaults(void)
+{
+    uint32_t sequence = g_calib_image.header.sequence;
+    CalibStore_BuildDefaults(&g_calib_image);
+    g_calib_image.header.sequence = sequence;
+    g_calib_image.header.crc32 = CalibStore_ImageCrc(&g_calib_image);
+
+    CalibStore_Compile();
+    g_save_pending = true;
+    g_save_request_time = OSIF_GetMilliseconds();
+}
+
+bool CalibStore_Save(void)
+{
+    // 写入非当前页，成功后再切换，保证任意时刻至少一页有效
+    uint32_t target = (g_active_page_addr == CALIB_STORE_PAGE_A_ADDR) ? CALIB_STORE_PAGE_B_ADDR
+                                                                      : CALIB_STORE_PAGE_A_ADDR;
+
+    g_calib_image.header.sequence++;
+    g_calib_image.header.crc32 = CalibStore_ImageCrc(&g_calib_image);
+
+    if (!CalibStore_WritePage(target, &g_calib_image)) {
+        g_calib_image.header.sequence--;
+        g_calib_image.header.crc32 = CalibStore_ImageCrc(&g_calib_image);
+        printf("[CALIB] ERROR: DFlash write failed at 0x%08lX\r\n", (unsigned long)target);
+        return false;
+    }
+
+    g_active_page_addr = target;
+    g_save_pending = false;
+    printf("[CALIB] Calibration #%lu saved to DFlash page %c\r\n",
+           (unsigned long)g_calib_image.header.sequence,
+           (target == CALIB_STORE_PAGE_A_ADDR) ? 'A' : 'B');
+    return true;
+}
+
+bool CalibStore_IsSavePending(void)
+{
+    return g_save_pending;
+}
+
+bool CalibStore_LookupGains(float oil_temp, float pressure, platform_gain_set_t *gains)
+{
+    if (!g_gain_schedule_enabled || gains == NULL) {
+        return false;
+    }
+    PlatformSchedule_Lookup(&g_gain_schedule, oil_temp, pressure, gains);
+    return true;
+}
+
+calib_status_t CalibStore_SetGainScheduleEntry(uint8_t temp_index, uint8_t pressure_index,
+                                              const platform_gain_set_t *gains, float oil_temp, float pressure)
+{
+    calib_gain_schedule_t *sched = &g_calib_image.gain_schedule;
+
+    if (gains == NULL || !CalibStore_IsFinite(gains->kp) || !CalibStore_IsFinite(gains->ki) ||
+        !CalibStore_IsFinite(gains->kd) || !CalibStore_IsFinite(gains->feedforward) ||
+        gains->kp < 0.0f || gains->ki < 0.0f || gains->kd < 0.0f) {
+        return CALIB_STATUS_BAD_CONTENT;
+    }
+
+    if (sched->temp_points == 0U) {
+        // 调度表未启用：以当前工况为唯一断点建立1×1表（全工况使用该组参数）
+        if (temp_index != 0U || pressure_index != 0U ||
+            !CalibStore_IsFinite(oil_temp) || !CalibStore_IsFinite(pressure)) {
+            return CALIB_STATUS_BAD_LENGTH;
+        }
+        memset(sched, 0, sizeof(calib_gain_schedule_t));
+        sched->temp_points = 1U;
+        sched->pressure_points = 1U;
+        sched->temp_axis[0] = oil_temp;
+        sched->pressure_axis[0] = pressure;
+    } else if (temp_index >= sched->temp_points || pressure_index >= sched->pressure_points) {
+        return CALIB_STATUS_BAD_LENGTH;
+    }
+
+    sched->gains[temp_index][pressure_index] = *gains;
+    g_calib_image.header.crc32 = CalibStore_ImageCrc(&g_calib_image);
+    CalibStore_CompileGainSchedule();
+    g_save_pending = true;
+    g_save_request_time = OSIF_GetMilliseconds();
+    return CALIB_STATUS_OK;
+}
+
+/* ==================== CAN参数服务 ==================== */
+
+static void CalibStore_SendAck(uint8_t cmd, calib_status_t status, uint16_t offset, uint32_t value)
+{
+    uint8_t data[8];
+
+    data[0] = cmd;
+    data[1] = (uint8_t)status;
+    data[2] = (uint8_t)(offset & 0xFFU);
+    data[3] = (uint8_t)(offset >> 8);
+    data[4] = (uint8_t)(value & 0xFFU);
+    data[5] = (uint8_t)((value >> 8) & 0xFFU);
+    data[6] = (uint8_t)((value >> 16) & 0xFFU);
+    data[7] = (uint8_t)((value >> 24) & 0xFFU);
+
+    CAN_Config_SendMessage(CAN_MSG_PARAM_ACK_ID, data, 8, true);
+}
+
+bool CalibStore_HandleCanFrame(const uint8_t *data, uint8_t length)
+{
+    if (data == NULL || length < 1U) {
+        return false;
+    }
+
+    uint8_t cmd = data[0];
+
+    switch (cmd) {
+        case CALIB_CMD_BEGIN:
+            // 暂存区正在校验时不接受新上传
+            if (g_pending_cmd == CALIB_CMD_COMMIT || length < 3U) {
+                return true;
+            }
+            memset(&g_calib_staging, 0, sizeof(g_calib_staging));
+            g_calib_upload.expected_length = (uint16_t)(data[1] | ((uint16_t)data[2] << 8));
+            g_calib_upload.received_end = 0U;
+            g_calib_upload.active = true;
+            g_calib_upload.begin_ack = true;
+            return true;
+
+        case CALIB_CMD_DATA: {
+            if (!g_calib_upload.active || g_pending_cmd == CALIB_CMD_COMMIT || length < 4U) {
+                return true;
+            }
+            uint16_t offset = (uint16_t)(data[1] | ((uint16_t)data[2] << 8));
+            uint8_t count = length - 3U;
+            if (count > CALIB_DATA_SEGMENT_SIZE) {
+                count = CALIB_DATA_SEGMENT_SIZE;
+            }
+            if ((uint32_t)offset + count > sizeof(g_calib_staging)) {
+                return true;
+            }
+            memcpy((uint8_t *)&g_calib_staging + offset, &data[3], count);
+            if (offset + count > g_calib_upload.received_end) {
+                g_calib_upload.received_end = offset + count;
+            }
+            return true;
+        }
+
+        case CALIB_CMD_COMMIT:
+        case CALIB_CMD_DEFAULT:
+        case CALIB_CMD_SAVE:
+        case CALIB_CMD_READ:
+            // 校验/擦写/应答放到任务中执行，上一条未处理完时丢弃（上位机超时重发）
+            if (g_pending_cmd == CALIB_CMD_NONE) {
+                uint32_t arg = 0U;
+                for (uint8_t i = 1U; i < length && i <= 4U; i++) {
+                    arg |= (uint32_t)data[i] << (8U * (i - 1U));
+                }
+                g_pending_arg = arg;
+                g_pending_cmd = cmd;
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void CalibStore_Task(bool allow_flash_write)
+{
+    (void)CalibStore_BuildTemperatureStep();
+
+    if (g_calib_upload.begin_ack) {
+        g_calib_upload.begin_ack = false;
+        CalibStore_SendAck(CALIB_CMD_BEGIN,
+                           (g_calib_upload.expected_length == sizeof(calib_image_t)) ? CALIB_STATUS_OK
+                                                                                     : CALIB_STATUS_BAD_LENGTH,
+                           (uint16_t)sizeof(calib_image_t), CALIB_STORE_VERSION);
+    }
+
+    uint8_t cmd = g_pending_cmd;
+    uint32_t arg = g_pending_arg;
+    calib_status_t status = CALIB_STATUS_OK;
+    bool persist_now = false;
+
+    switch (cmd) {
+        case CALIB_CMD_COMMIT:
+            if (!g_calib_upload.active ||
+                g_calib_upload.expected_length != sizeof(calib_image_t) ||
+                g_calib_upload.received_end != sizeof(calib_image_t)) {
+                status = CALIB_STATUS_BAD_LENGTH;
+            } else if (g_calib_staging.header.crc32 != arg) {
+                status = CALIB_STATUS_BAD_CRC;
+            } else {
+                status = CalibStore_Apply(&g_calib_staging);
+            }
+            g_calib_upload.active = false;
+            persist_now = (status == CALIB_STATUS_OK);
+            break;
+
+        case CALIB_CMD_DEFAULT:
+            CalibStore_RestoreDefaults();
+            if ((arg & 0xFFU) != 0U) {
+                persist_now = true;
+            } else {
+                // 仅恢复到RAM，不写入DFlash
+                g_save_pending = false;
+            }
+            break;
+
+        case CALIB_CMD_SAVE:
+            g_save_pending = true;
+            persist_now = true;
+            break;
+
+        case CALIB_CMD_READ: {
+            uint16_t offset = (uint16_t)(arg & 0xFFFFU);
+            uint32_t value = 0U;
+            if ((uint32_t)offset + sizeof(value) > sizeof(calib_image_t)) {
+                status = CALIB_STATUS_BAD_LENGTH;
+            } else {
+                memcpy(&value, (const uint8_t *)&g_calib_image + offset, sizeof(value));
+            }
+            CalibStore_SendAck(cmd, status, offset, value);
+            g_pending_cmd = CALIB_CMD_NONE;
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    // 系统停机时才擦写DFlash，避免阻塞控制任务；偏移量修改延时合并后保存
+    if (g_save_pending && allow_flash_write &&
+        (persist_now || (OSIF_GetMilliseconds() - g_save_request_time) >= CALIB_STORE_SAVE_DELAY_MS)) {
+        if (!CalibStore_Save()) {
+            g_save_request_time = OSIF_GetMilliseconds();
+            if (persist_now) {
+                status = CALIB_STATUS_FLASH_ERROR;
+            }
+        }
+    }
+
+    if (cmd != CALIB_CMD_NONE) {
+        if (status == CALIB_STATUS_OK && g_save_pending) {
+            status = CALIB_STATUS_SAVE_PENDING;
+        }
+        CalibStore_SendAck(cmd, status, (uint16_t)sizeof(calib_image_t), g_calib_image.header.crc32);
+        g_pending_cmd = CALIB_CMD_NONE;
+    }
+}
@@ -122,7 +122,7 @@ static void CAN_EventCallback(uint8_t instance, uint32_t event, uint32_t koer)
             // 简化接收消息显示（每10次显示一次）
             if (s_canAppConfig.rxCount % 10 == 0) {
                 printf("[CAN RX] Count: %lu, ID: 0x%08X (%s)\r\n", 
-                       s_canAppConfig.rxCount, msg.ID, (msg.IDE) ? "Ext" : "Std");
+                       (unsigned long)s_canAppConfig.rxCount, msg.ID, (msg.IDE) ? "Ext" : "Std");
             }
             
             /* 已删除：旧的CAN透传处理代码 - 平台无关化后使用新的回调机制 */
@@ -148,7 +148,7 @@ static void CAN_EventCallback(uint8_t instance, uint32_t event, uint32_t koer)
         
         // 简化发送完成信息（每50次显示一次）
         if (s_canAppConfig.txCount % 50 == 0) {
-            printf("[CAN TX COMPLETE] Count: %lu\r\n", s_canAppConfig.txCount);
+            printf("[CAN TX COMPLETE] Count: %lu\r\n", (unsigned long)s_canAppConfig.txCount);
         }
         
         /* Call transmit handler if installed */
@@ -170,7 +170,7 @@ static void CAN_EventCallback(uint8_t instance, uint32_t event, uint32_t koer)
         static uint32_t error_report_count = 0;
         if (++error_report_count % 1000 == 0) {
             printf("[CAN ERROR] Count: %lu, Event: 0x%08X\r\n", 
-                   s_canAppConfig.errorCount, event);
+                   (unsigned long)s_canAppConfig.errorCount, event);
         }
         
         /* Only mark error as active if this error type hasn't been marked before */
@@ -357,14 +357,14 @@ bool CAN_Config_SendMessage(uint32_t id, const uint8_t *data, uint8_t length, bo
         send_error_count++;
         // 只在错误过多时显示
         if (send_error_count % 50 == 0) {
-            printf("[CAN ERROR] Status: 0x%08X, Errors: %lu\r\n", status, send_error_count);
+            printf("[CAN ERROR] Status: 0x%08X, Errors: %lu\r\n", status, (unsigned long)send_error_count);
         }
     }
     
     // 每100次发送显示一次统计
     if (++send_count % 100 == 0) {
         printf("[CAN STATS] Total: %lu, Errors: %lu, Success: %.1f%%\r\n", 
-               send_count, send_error_count,
+               (unsigned long)send_count, (unsigned long)send_error_count,
                send_count > 0 ? (100.0f * (send_count - send_error_count) / send_count) : 0.0f);
     }
     
@@ -15,6 +15,7 @@
 static fault_diagnosis_t g_fault_diagnosis;
 static sensor_health_t g_sensor_health;
 static valve_response_t g_valve_response;
+static uint32_t g_valve_last_cycle_time = 0;     // 最近一个换向周期完成时刻(ms)
 
 // 故障诊断状态
 // 这些变量将在后续实现中使用
@@ -43,6 +44,7 @@ void FaultDiagnosis_Init(void) {
     g_valve_response.valve_response_time = 0;
     g_valve_response.cycle_count = 0;
     g_valve_response.valve_stuck = false;
+    g_valve_last_cycle_time = 0;
     
     g_last_diagnosis_time = OSIF_GetMilliseconds();
     
@@ -104,8 +106,10 @@ void FaultDiagnosis_SensorFaultDiagnosis(void) {
 bool FaultDiagnosis_CheckValveResponse(void) {
     uint32_t current_time = OSIF_GetMilliseconds();
     
-    // 检查阀门响应时间
-    if (current_time - g_valve_response.valve_response_time > FAULT_DETECTION_TIMEOUT_MS) {
+    // 检查阀门响应时间：仍在换向，但油压已超过超时时间没有随换向变化
+    bool cycling = (g_valve_response.cycle_count > 0) &&
+                   (current_time - g_valve_last_cycle_time <= FAULT_DETECTION_TIMEOUT_MS);
+    if (cycling && g_valve_last_cycle_time - g_valve_response.valve_response_time > FAULT_DETECTION_TIMEOUT_MS) {
         g_valve_response.valve_stuck = true;
         return false;
     }
@@ -122,6 +126,20 @@ valve_response_t FaultDiagnosis_GetValveResponse(void) {
     return g_valve_response;
 }
 
+void FaultDiagnosis_RecordValveCycle(bool responded) {
+    uint32_t current_time = OSIF_GetMilliseconds();
+    
+    g_valve_response.cycle_count++;
+    g_valve_last_cycle_time = current_time;
+    if (g_valve_response.cycle_count == 1) {
+        g_valve_response.valve_response_time = current_time;  // 从第一个周期开始计超时
+    }
+    if (responded) {
+        g_valve_response.valve_response_time = current_time;  // 最近一次确认油压响应的时刻
+        g_valve_response.valve_stuck = false;
+    }
+}
+
 void FaultDiagnosis_ValveFaultDiagnosis(void) {
     // 检查阀门响应状态
     if (!FaultDiagnosis_CheckValveResponse()) {
@@ -15,11 +15,20 @@
 #include "pwm_common.h"
 #include "pwm_output.h"
 #include "sensor.h"
+#include "calib_store.h"
+#include "pressure_capture.h"
+#include "sensor_spectrum.h"
+#include "pressure_control.h"
+#include "unified_filter.h"
 #include "valve_control.h"
+#include "valve_current.h"
+#include "overpressure_guard.h"
+#include "valve_cycle_stats.h"
 #include "fault_diagnosis.h"
 #include "can_config.h"
 #include "gcu_control_dbc.h"
 #include "optimized_task_scheduler.h"
+#include "perf_bench.h"
 #include "debugout_ac7840x.h"
 #include "osif.h"
 #include <stdio.h>
@@ -36,6 +45,10 @@
 // PC命令超时保护
 #define PC_CMD_TIMEOUT_MS  1000  // 1秒超时
 
+// 超压保护
+#define OVERPRESSURE_LIMIT_MPA      45.0f   // 油压超压阈值(MPa)
+#define OVERPRESSURE_PREDICT_S      0.15f   // 预测时域(s)：安全检查周期 + 阀门动作时间
+
 /* ==========================================  Variables  =========================================== */
 // 全局变量
 bool g_systemEnabled = false;
@@ -46,9 +59,13 @@ static uint32_t g_can_rx_message_count = 0;  // CAN接收消息计数
 static uint8_t g_reversal_valve_freq = 0;  // 换向阀频率（Hz）
 static uint8_t g_control_mode = 0;         // 控制模式
 
+// 传感器采集/上报任务ID（周期由自适应采集速率调整）
+static int32_t g_sensor_task_id = -1;
+
 /* ====================================  Functions declaration  ===================================== */
 static void SystemHardwareInit(void);
-static void SystemInit(void);
+static void SystemAppInit(void);
+void SystemStartup(void);
 bool IsStartupSwitchActive(void);
 
 // 任务声明
@@ -58,6 +75,7 @@ void Task_1000ms_CANStatusMonitor(void);
 void Task_2000ms_SensorDataMonitor(void);
 void Task_100ms_RealTimeCANMonitor(void);
 void Task_1ms_CANMessageProcess(void);
+void Task_10ms_ParamService(void);
 
 // CAN接收回调
 void CAN_RxCallback(uint32_t msg_id, const uint8_t* data, uint8_t length);
@@ -71,7 +89,7 @@ uint8_t GetControlMode(void);
 /*!
  * @brief 统一系统初始化函数
  */
-static void SystemInit(void)
+static void SystemAppInit(void)
 {
     // 硬件初始化
     SystemHardwareInit();
@@ -79,7 +97,13 @@ static void SystemInit(void)
     // 核心模块初始化
     Sensor_Init();            // 传感器模块初始化
     ValveControl_Init();      // 阀门控制初始化
+    ValveCurrent_Init();      // 旁通阀线圈电流采样链（PWM0匹配触发ADC0），上电为开环模式
+    OverpressureGuard_Init(); // 油压硬件超压联锁（ACMP0→PWM0故障输入，需在传感器标定加载后）
     FaultDiagnosis_Init();    // 故障诊断初始化
+    PressureCapture_Init();   // 压力录波初始化（布防前不占用定时器）
+    SensorSpectrum_Init();    // 油压脉动频谱分析初始化
+    ValveCycleStats_Init();   // 换向周期统计（旁路监听压力采集流）
+    PressureControl_Init();   // 旁通阀本地压力闭环初始化（上位机请求后启动）
     
     // CAN通信模块初始化 - 添加调试信息
     printf("[INIT] Initializing CAN module...\r\n");
@@ -103,7 +127,7 @@ static void SystemInit(void)
     ValveControl_SetDirectionalValve(false);
     
     // 上电默认关闭旁通阀
-    ValveControl_SetBypassValve(0.0f);
+    ValveControl_SetBypassValveImmediate(0.0f);
     
     // 系统初始化完成确认
     printf("[INIT] System initialization completed\r\n");
@@ -111,15 +135,9 @@ static void SystemInit(void)
 }
 
 /*!
-* @brief 主函数 - 平台无关化版本
-* 
-* 功能说明：
-* - 只负责传感器数据采集和通过CAN发送给PC
-* - 接收PC的CAN控制命令并执行
-* - 保留基础硬件安全保护
-* - 所有控制算法在PC端运行
-*/
-int main(void)
+ * @brief 系统启动：初始化、注册任务并启动调度器（PC端仿真直接调用后自行驱动任务分发）
+ */
+void SystemStartup(void)
 {
     // 立即初始化串口进行测试
     CKGEN_DRV_Enable(CLK_UART1, true);
@@ -129,7 +147,7 @@ int main(void)
     
     // 立即测试串口输出
     
-    SystemInit();  // 统一初始化
+    SystemAppInit();  // 统一初始化
     
     // 系统上电状态确认打印
     printf("\r\n================= GCU System Startup =================\r\n");
@@ -139,7 +157,7 @@ int main(void)
     printf("DEBUG: UART1@115200, TX=PC9 RX=PC8\r\n");
     printf("IO: DirValve PB4, Bypass PWM0_CH2@PC2, Cooler PE8, StartSw PC17\r\n");
     printf("System Status: INITIALIZED\r\n");
-    printf("Sensor Data: Sending to PC every 10ms\r\n");
+    printf("Sensor Data: Sending to PC every 5-50ms (adaptive, period in reserve_debug1)\r\n");
     printf("Safety Check: Running every 50ms\r\n");
     printf("CAN Monitor: Status check every 1000ms\r\n");
     printf("Sensor Monitor: Data display every 2000ms\r\n");
@@ -150,8 +168,8 @@ int main(void)
     CAN_Config_RegisterRxCallback(CAN_RxCallback);
     
     /* 配置任务调度器 - 只保留必要任务 */
-    // 任务1: 10ms - 发送传感器数据给PC
-    OptimizedTaskScheduler_AddTask(Task_10ms_SendSensorData, 10, TASK_PRIORITY_HIGH);
+    // 任务1: 10ms - 发送传感器数据给PC（周期随信号活动在5~50ms间自适应调整）
+    g_sensor_task_id = OptimizedTaskScheduler_AddTask(Task_10ms_SendSensorData, SENSOR_RATE_NORMAL_PERIOD_MS, TASK_PRIORITY_HIGH);
     
     // 任务2: 50ms - 安全保护检查
     OptimizedTaskScheduler_AddTask(Task_50ms_SafetyCheck, 50, TASK_PRIORITY_CRITICAL);
@@ -168,6 +186,14 @@ int main(void)
     // 任务6: 1ms - CAN消息处理（关键任务！）
     OptimizedTaskScheduler_AddTask(Task_1ms_CANMessageProcess, 1, TASK_PRIORITY_CRITICAL);
     
+    // 任务7: 10ms - 参数服务（标定上传/保存）
+    OptimizedTaskScheduler_AddTask(Task_10ms_ParamService, 10, TASK_PRIORITY_LOW);
+
+#if HP_PERF_BENCH
+    /* 热点函数性能基准（调度器启动前，任务均未执行） */
+    PerfBench_Run();
+#endif
+
     /* 启动任务调度器 */
     OptimizedTaskScheduler_Start();
     
@@ -177,13 +203,14 @@ int main(void)
     
     // 启动后立即显示一次状态
     printf("\r\n=== Initial System Status ===\r\n");
-    printf("System is running with 6 tasks:\r\n");
-    printf("- Task 1: Sensor data (10ms)\r\n");
+    printf("System is running with 7 tasks:\r\n");
+    printf("- Task 1: Sensor data (5-50ms adaptive)\r\n");
     printf("- Task 2: Safety check (50ms)\r\n");
     printf("- Task 3: CAN monitor (1000ms)\r\n");
     printf("- Task 4: Sensor monitor (2000ms)\r\n");
     printf("- Task 5: Real-time CAN monitor (100ms)\r\n");
     printf("- Task 6: CAN message process (1ms) - CRITICAL!\r\n");
+    printf("- Task 7: Parameter service (10ms)\r\n");
     printf("First status reports will appear in 5-6 seconds...\r\n");
     printf("================================\r\n");
     
@@ -222,6 +249,20 @@ int main(void)
     
     /* 主循环 */
     printf("[SYSTEM] Entering main loop...\r\n");
+}
+
+/*!
+* @brief 主函数 - 平台无关化版本
+* 
+* 功能说明：
+* - 只负责传感器数据采集和通过CAN发送给PC
+* - 接收PC的CAN控制命令并执行
+* - 保留基础硬件安全保护
+* - 所有控制算法在PC端运行
+*/
+int main(void)
+{
+    SystemStartup();
     
     // CAN错误检测和恢复计数器
     static uint32_t can_error_count = 0;
@@ -245,7 +286,7 @@ int main(void)
             if (error_count > 1000) {
                 can_error_count++;
                 printf("[CAN ERROR] High error count detected: %lu, attempting reset #%lu\r\n", 
-                       error_count, can_error_count);
+                       (unsigned long)error_count, (unsigned long)can_error_count);
                 
                 if (CAN_Config_ResetController()) {
                     printf("[CAN RECOVERY] Controller reset successful\r\n");
@@ -262,8 +303,36 @@ int main(void)
 }
 
 /* ========================================================================
- * 任务1：发送传感器数据（10ms周期）
+ * 任务1：发送传感器数据（默认10ms周期，自适应5~50ms）
  * ======================================================================== */
+/*!
+ * @brief 发送压力Kalman估计：byte0-1 油压(0.01MPa), byte2-3 油压变化率(0.1MPa/s, 有符号),
+ *        byte4-5 LNG压力(0.01MPa), byte6-7 LNG压力变化率(0.1MPa/s, 有符号)，均为小端
+ */
+static void SendPressureEstimate(void)
+{
+    static const uint8_t channels[2] = {CALIB_PRESSURE_OIL, CALIB_PRESSURE_LNG};
+    uint8_t data[8] = {0};
+    
+    for (uint8_t i = 0; i < 2U; i++) {
+        float pressure = 0.0f;
+        float rate = 0.0f;
+        if (!Sensor_GetPressureEstimate(channels[i], &pressure, &rate)) {
+            return;
+        }
+        float p_scaled = pressure * 100.0f + 0.5f;
+        float r_scaled = rate * 10.0f;
+        uint16_t p_raw = (p_scaled <= 0.0f) ? 0U : ((p_scaled >= 65535.0f) ? 0xFFFFU : (uint16_t)p_scaled);
+        int16_t r_raw = (r_scaled >= 32767.0f) ? 32767 : ((r_scaled <= -32768.0f) ? -32768 : (int16_t)r_scaled);
+        data[i * 4U] = (uint8_t)(p_raw & 0xFFU);
+        data[i * 4U + 1U] = (uint8_t)(p_raw >> 8);
+        data[i * 4U + 2U] = (uint8_t)((uint16_t)r_raw & 0xFFU);
+        data[i * 4U + 3U] = (uint8_t)((uint16_t)r_raw >> 8);
+    }
+    
+    CAN_Config_SendMessage(CAN_MSG_SENSOR_FAST_ID, data, 8, true);
+}
+
 void Task_10ms_SendSensorData(void)
 {
     gcu_debug1_t msg;
@@ -272,6 +341,16 @@ void Task_10ms_SendSensorData(void)
     /* 1. 更新传感器数据 */
     Sensor_UpdateMonitor();
     
+    /* 1.1 停机且阀门关闭时学习压力零点 */
+    Sensor_AutoZeroUpdate(!g_systemEnabled &&
+                          ValveControl_GetDirectionalValveState() == VALVE_STATE_OFF &&
+                          ValveControl_GetBypassValveDuty() <= 0.0f);
+    
+    /* 1.2 根据压力变化率和换向阀活动调整采集/上报周期 */
+    uint16_t sample_period_ms = Sensor_RateUpdate(ValveControl_GetDirectionalValveState() == VALVE_STATE_ON,
+                                                  g_reversal_valve_freq, g_systemEnabled);
+    OptimizedTaskScheduler_SetTaskPeriod(g_sensor_task_id, sample_period_ms);
+    
     /* 2. 填充CAN消息（使用encode函数转换物理值→原始值） */
     msg.oil_temperature = gcu_debug1_oil_temperature_encode(Sensor_GetOilTemperature());
     msg.LNG_temperature = gcu_debug1_LNG_temperature_encode(Sensor_GetLNGTemperature());
@@ -279,8 +358,11 @@ void Task_10ms_SendSensorData(void)
     msg.LNG_pressure = gcu_debug1_LNG_pressure_encode(Sensor_GetLNGPressure());
     msg.bypass_ratio = gcu_debug1_bypass_ratio_encode(ValveControl_GetBypassValveDuty());
     msg.reversal_valve_st = (ValveControl_GetDirectionalValveState() == VALVE_STATE_ON) ? 1 : 0;
-    msg.reversal_valve_hz = 0;  // 根据实际硬件填充
-    msg.reserve_debug1 = 0;
+    msg.reversal_valve_hz = gcu_debug1_reversal_valve_hz_encode(ValveControl_GetDirectionalFrequency());
+    msg.reserve_debug1 = (uint8_t)sample_period_ms;  // 当前采集周期(ms)，供PC端按实际速率重采样
+    
+    /* 2.1 压力Kalman估计与变化率（快速传感器数据帧） */
+    SendPressureEstimate();
     
     /* 3. 打包并发送 */
     if (gcu_debug1_pack(can_data, &msg, sizeof(can_data)) > 0) {
@@ -289,7 +371,7 @@ void Task_10ms_SendSensorData(void)
         
         // 简化发送信息显示（每1000次显示一次）
         if (++send_count % 1000 == 0) {
-            printf("[CAN TX] Count: #%lu\r\n", send_count);
+            printf("[CAN TX] Count: #%lu\r\n", (unsigned long)send_count);
         }
         
         bool send_result = CAN_Config_SendMessage(CAN_MSG_GCU_DEBUG1_ID, can_data, 8, true);
@@ -298,7 +380,7 @@ void Task_10ms_SendSensorData(void)
         if (!send_result) {
             send_fail_count++;
             if (send_fail_count % 100 == 0) {
-                printf("[CAN TX FAIL] Count: #%lu, Failures: %lu\r\n", send_count, send_fail_count);
+                printf("[CAN TX FAIL] Count: #%lu, Failures: %lu\r\n", (unsigned long)send_count, (unsigned long)send_fail_count);
             }
         }
     }
@@ -311,9 +393,23 @@ void Task_50ms_SafetyCheck(void)
 {
     uint32_t current_time = OSIF_GetMilliseconds();
     
-    /* 1. 超压保护（>45MPa） */
-    if (Sensor_GetOilPressure() > 45.0f) {
-        ValveControl_SetBypassValve(100.0f);  // 全开旁通阀
+    /* 执行顺序：超压泄压优先于所有关闭动作。超压（含预测超压、硬件联锁动作、油压码值高于合理性上限）
+     * 期间第3~5层不再写旁通阀0%，避免同一周期内后写的关闭指令覆盖全开指令 */
+    
+    /* 1. 超压保护（>45MPa）：当前值超限，或按Kalman估计的上升速率外推到预测时域后超限 */
+    float oil_estimate = 0.0f;
+    float oil_rate = 0.0f;
+    bool predicted_overpressure = Sensor_GetPressureEstimate(CALIB_PRESSURE_OIL, &oil_estimate, &oil_rate) &&
+                                  oil_rate > 0.0f &&
+                                  (oil_estimate + oil_rate * OVERPRESSURE_PREDICT_S) > OVERPRESSURE_LIMIT_MPA;
+    // 油压码值高于上限（SHORT）与真实超压无法区分（约42.5MPa即超出码值上限），按超压处理
+    bool oil_pressure_short = (Sensor_GetPlausibilityFaults(ADC_CHANNEL_OIL_PRESSURE) & SENSOR_PLAUS_SHORT) != 0U;
+    bool overpressure = (Sensor_GetOilPressure() > OVERPRESSURE_LIMIT_MPA) || predicted_overpressure ||
+                        OverpressureGuard_IsTripped() ||  // 硬件联锁已动作时同步软件状态，联锁释放后保持旁通阀全开
+                        oil_pressure_short;
+    if (overpressure) {
+        PressureControl_Stop();
+        ValveControl_SetBypassValveImmediate(100.0f);  // 全开旁通阀
         ValveControl_SetDirectionalValve(false);
     }
     
@@ -324,14 +420,20 @@ void Task_50ms_SafetyCheck(void)
     
     /* 3. 传感器故障保护 */
     if (!Sensor_CheckDataValidity()) {
-        ValveControl_SetBypassValve(0.0f);
+        PressureControl_Stop();
+        if (!overpressure) {
+            ValveControl_SetBypassValveImmediate(0.0f);
+        }
         ValveControl_SetDirectionalValve(false);
         ValveControl_SetCooler(false);
     }
     
     /* 4. PC命令超时保护（1秒无命令） */
     if (last_pc_cmd_time > 0 && (current_time - last_pc_cmd_time) > PC_CMD_TIMEOUT_MS) {
-        ValveControl_SetBypassValve(0.0f);
+        PressureControl_Stop();
+        if (!overpressure) {
+            ValveControl_SetBypassValveImmediate(0.0f);
+        }
         ValveControl_SetDirectionalValve(false);
         ValveControl_SetCooler(false);
         last_pc_cmd_time = 0;  // 重置以避免重复打印
@@ -339,7 +441,10 @@ void Task_50ms_SafetyCheck(void)
     
     /* 5. 硬件故障检查 */
     if (!ValveControl_CheckHardwareStatus()) {
-        ValveControl_SetBypassValve(0.0f);
+        PressureControl_Stop();
+        if (!overpressure) {
+            ValveControl_SetBypassValveImmediate(0.0f);
+        }
         ValveControl_SetDirectionalValve(false);
     }
 }
@@ -360,6 +465,19 @@ void CAN_RxCallback(uint32_t msg_id, const uint8_t* data, uint8_t length)
         printf("[CAN RX] Control message received: ID=0x%08X, Len=%d\r\n", msg_id, length);
     }
     
+    // 参数设置命令（标定上传等），中断中只做拷贝，由参数服务任务处理
+    if (msg_id == CAN_MSG_PARAM_SET_ID) {
+        if (!CalibStore_HandleCanFrame(data, length) &&
+            !PressureCapture_HandleCanFrame(data, length) &&
+            !PressureControl_HandleCanFrame(data, length) &&
+            !ValveControl_HandleCanFrame(data, length) &&
+            !ValveCurrent_HandleCanFrame(data, length) &&
+            !OverpressureGuard_HandleCanFrame(data, length)) {
+            UnifiedFilter_HandleCanFrame(data, length);
+        }
+        return;
+    }
+    
     // 临时修复：处理接收到的控制消息ID
     if ((msg_id == CAN_MSG_GCU_CONTROL_ID || msg_id == 0x18080100) && length == 8) {
         gcu_control_t ctrl_msg;
@@ -376,13 +494,27 @@ void CAN_RxCallback(uint32_t msg_id, const uint8_t* data, uint8_t length)
             
             /* 执行控制命令 - 处理所有6个控制信号 */
             
-            // 1. 换向阀使能控制
+            // 1. 换向阀使能控制：使能且频率>0时由定时器按指令频率换向，否则静态输出
             bool reversal_enable = (ctrl_msg.ctrl_reversal_valve_enable == 1);
-            ValveControl_SetDirectionalValve(reversal_enable);
+            if (reversal_enable && ctrl_msg.ctrl_reversal_valve_freq > 0U) {
+                ValveControl_SetDirectionalOscillation(ctrl_msg.ctrl_reversal_valve_freq);
+            } else if (!reversal_enable && ValveControl_IsDirectionalOscillating()) {
+                ValveControl_SetDirectionalOscillation(0U);  // 走完当前周期后停在断电状态
+            } else {
+                ValveControl_SetDirectionalValve(reversal_enable);
+            }
             
-            // 2. 旁通阀占空比控制（使用decode转换原始值→物理值）
+            // 2. 旁通阀：开环时为占空比指令；本地压力闭环时为开度上限，设定值/下限取自ctrl_reserved
             double bypass_duty = gcu_control_ctrl_bypass_valve_duty_decode(ctrl_msg.ctrl_bypass_valve_duty);
-            ValveControl_SetBypassValve((float)bypass_duty);
+            if ((ctrl_msg.ctrl_reserved & PCTRL_CMD_MODE_MASK) == PCTRL_MODE_PRESSURE) {
+                uint32_t setpoint_raw = (ctrl_msg.ctrl_reserved >> PCTRL_CMD_SETPOINT_SHIFT) & PCTRL_CMD_SETPOINT_MASK;
+                uint32_t min_duty_raw = (ctrl_msg.ctrl_reserved >> PCTRL_CMD_MIN_DUTY_SHIFT) & PCTRL_CMD_MIN_DUTY_MASK;
+                PressureControl_SetCommand(true, (float)setpoint_raw * PCTRL_CMD_SETPOINT_SCALE,
+                                           (float)min_duty_raw, (float)bypass_duty);
+            } else {
+                PressureControl_SetCommand(false, 0.0f, 0.0f, 0.0f);
+                ValveControl_SetBypassValve((float)bypass_duty);
+            }
             
             // 3. 换向阀频率控制
             g_reversal_valve_freq = ctrl_msg.ctrl_reversal_valve_freq;
@@ -394,7 +526,8 @@ void CAN_RxCallback(uint32_t msg_id, const uint8_t* data, uint8_t length)
             // 5. 系统使能控制
             if (ctrl_msg.ctrl_system_enable == 0) {
                 // 系统禁用，安全关闭所有执行器
-                ValveControl_SetBypassValve(0.0f);
+                PressureControl_Stop();
+                ValveControl_SetBypassValveImmediate(0.0f);
                 ValveControl_SetDirectionalValve(false);
                 ValveControl_SetCooler(false);
                 g_systemEnabled = false;
@@ -445,15 +578,16 @@ static void SystemHardwareInit(void)
     pwm_config.countMode = PWM_UP_COUNT;
     pwm_config.levelMode = PWM_LOW_TRUE;
     pwm_config.clkSource = PWM_CLK_SOURCE_SYSTEM;
-    pwm_config.clkPsc = 1U;
+    pwm_config.clkPsc = BYPASS_PWM_PRESCALER;
     pwm_config.initValue = 0U;
-    pwm_config.maxValue = 10000U;  // PWM周期值
+    pwm_config.maxValue = BYPASS_PWM_MAX_COUNT;  // PWM周期值
     pwm_config.oddPolarity = PWM_OUTPUT_POLARITY_ACTIVE_HIGH;
     pwm_config.evenPolarity = PWM_OUTPUT_POLARITY_ACTIVE_HIGH;
     pwm_config.oddInitLevel = PWM_LOW_LEVEL;
     pwm_config.evenInitLevel = PWM_LOW_LEVEL;
     pwm_config.initChOutputEn = (1U << PWM_CH_2);  // 使能通道2输出
     pwm_config.deadtimePsc = PWM_DEADTIME_DIVID_1;
+    pwm_config.overflowInterrupEn = true;  // 计数溢出中断：旁通阀开度轨迹逐周期推进（回调由阀门模块安装）
     
     // 初始化PWM0模块
     PWM_DRV_SimplyInit(0, &pwm_config);
@@ -606,29 +740,29 @@ void Task_1000ms_CANStatusMonitor(void)
     
     // 每10次监控（10秒）显示状态
     if (++monitor_count % 10 == 0) {
-        printf("[CAN] RX:%lu TX:%lu Err:%lu (10s)\r\n", rx_delta, tx_delta, error_delta);
+        printf("[CAN] RX:%lu TX:%lu Err:%lu (10s)\r\n", (unsigned long)rx_delta, (unsigned long)tx_delta, (unsigned long)error_delta);
     }
     
     // 每50次监控（50秒）打印一次详细状态
     if (monitor_count % 50 == 0) {
         printf("\r\n=== CAN Communication Status ===\r\n");
         printf("Total RX: %lu, TX: %lu, Errors: %lu\r\n", 
-               current_rx_count, current_tx_count, current_error_count);
+               (unsigned long)current_rx_count, (unsigned long)current_tx_count, (unsigned long)current_error_count);
         printf("Rate (10s): RX=%lu, TX=%lu, Errors=%lu\r\n", 
-               rx_delta, tx_delta, error_delta);
+               (unsigned long)rx_delta, (unsigned long)tx_delta, (unsigned long)error_delta);
         printf("===============================\r\n");
     }
     
     // 错误检测和报警
     if (error_delta > 0) {
-        printf("[CAN] Warning: %lu errors detected in last 1s\r\n", error_delta);
+        printf("[CAN] Warning: %lu errors detected in last 1s\r\n", (unsigned long)error_delta);
     }
     
     // 通信超时检测
     static uint32_t no_rx_count = 0;
     if (rx_delta == 0 && current_rx_count > 0) {
         if (++no_rx_count >= 5) {  // 5秒无接收
-            printf("[CAN] Warning: No RX messages for %lu seconds\r\n", no_rx_count);
+            printf("[CAN] Warning: No RX messages for %lu seconds\r\n", (unsigned long)no_rx_count);
         }
     } else {
         no_rx_count = 0;  // 重置计数器
@@ -720,7 +854,7 @@ void Task_100ms_RealTimeCANMonitor(void)
     // 每100次监控（10秒）显示实时CAN活动
     if (++monitor_count % 100 == 0) {
         printf("[CAN] RX: %lu, TX: %lu, Rate: %lu/%lu msg/s\r\n", 
-               current_rx_count, current_tx_count, rx_delta, tx_delta);
+               (unsigned long)current_rx_count, (unsigned long)current_tx_count, (unsigned long)rx_delta, (unsigned long)tx_delta);
     }
 }
 
@@ -737,4 +871,37 @@ void Task_1ms_CANMessageProcess(void)
     CAN_Config_Task();
 }
 
+/* ========================================================================
+ * 任务7：参数服务（10ms周期）
+ * ======================================================================== */
+void Task_10ms_ParamService(void)
+{
+    // 处理标定上传/读回/保存命令；DFlash擦写会阻塞主循环，仅在系统未使能时进行
+    CalibStore_Task(!g_systemEnabled);
+    
+    // 压力录波命令、完成通知和分段下载
+    PressureCapture_Task();
+    
+    // Biquad滤波系数切换与应答
+    UnifiedFilter_Task();
+    
+    // 换向通电占比、旁通阀开度斜率设置与状态查询
+    ValveControl_Task();
+    
+    // 旁通阀驱动模式（开环占空比/电流闭环）切换与采样链检查
+    ValveCurrent_Task();
+    
+    // 硬件超压联锁：动作记录、比较器回落后释放PWM故障锁定、阈值设置
+    OverpressureGuard_Task();
+    
+    // 本地压力闭环：优先于频谱分析申请采集流
+    PressureControl_Task(g_systemEnabled);
+    
+    // 油压脉动频谱：系统运行时周期性借用采集流，录波布防/本地闭环期间自动跳过
+    SensorSpectrum_Task(g_systemEnabled);
+    
+    // 换向周期统计：定时换向期间采集流空闲时后台采样，被占用时共用采样
+    ValveCycleStats_Task();
+}
+
 /* =============================================  EOF  ============================================== */
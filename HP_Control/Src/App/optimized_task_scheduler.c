@@ -97,66 +97,76 @@ void OptimizedTaskScheduler_Update(void) {
     }
 }
 
-void OptimizedTaskScheduler_MainLoop(void) {
+bool OptimizedTaskScheduler_Dispatch(uint32_t loop_time, uint32_t *next_task_time) {
+    bool any_task_executed = false;
+    uint32_t next_time = UINT32_MAX;
     
-    // 主调度循环 - 标准版优化 v2.0
-    while (g_scheduler_running) {
-        // ✅ 优化1：每轮循环只获取一次时间戳（缓存优化）
-        uint32_t loop_time = OSIF_GetMilliseconds();
-        bool any_task_executed = false;
-        uint32_t next_task_time = UINT32_MAX;
-        
-        // 按优先级顺序执行任务
-        for (int priority = TASK_PRIORITY_CRITICAL; priority <= TASK_PRIORITY_LOW; priority++) {
-            for (int i = 0; i < MAX_TASKS; i++) {
-                optimized_task_t *task = &g_tasks[i];
+    // 按优先级顺序执行任务
+    for (int priority = TASK_PRIORITY_CRITICAL; priority <= TASK_PRIORITY_LOW; priority++) {
+        for (int i = 0; i < MAX_TASKS; i++) {
+            optimized_task_t *task = &g_tasks[i];
+            
+            // 快速跳过无效任务
+            if (task->task_function == NULL) continue;
+            if (!task->enabled) continue;
+            if (task->state == TASK_STATE_SUSPENDED) continue;
+            if (task->priority != priority) continue;
+            
+            // ✅ 优化2：使用缓存的时间戳计算
+            uint32_t time_since_last_run = loop_time - task->last_run_time;
+            
+            // 检查是否到了执行时间
+            if (time_since_last_run >= task->period_ms) {
+                // 执行任务
+                task->state = TASK_STATE_RUNNING;
+                
+                #if ENABLE_TASK_PROFILING
+                // 性能分析模式：记录执行时间
+                uint32_t task_start = OSIF_GetMilliseconds();
+                #endif
                 
-                // 快速跳过无效任务
-                if (task->task_function == NULL) continue;
-                if (!task->enabled) continue;
-                if (task->state == TASK_STATE_SUSPENDED) continue;
-                if (task->priority != priority) continue;
+                task->task_function();
                 
-                // ✅ 优化2：使用缓存的时间戳计算
-                uint32_t time_since_last_run = loop_time - task->last_run_time;
+                #if ENABLE_TASK_PROFILING
+                uint32_t task_end = OSIF_GetMilliseconds();
+                task->actual_execution_time = task_end - task_start;
                 
-                // 检查是否到了执行时间
-                if (time_since_last_run >= task->period_ms) {
-                    // 执行任务
-                    task->state = TASK_STATE_RUNNING;
-                    
-                    #if ENABLE_TASK_PROFILING
-                    // 性能分析模式：记录执行时间
-                    uint32_t task_start = OSIF_GetMilliseconds();
-                    #endif
-                    
-                    task->task_function();
-                    
-                    #if ENABLE_TASK_PROFILING
-                    uint32_t task_end = OSIF_GetMilliseconds();
-                    task->actual_execution_time = task_end - task_start;
-                    
-                    // 检查执行时间是否超限
-                    if (task->actual_execution_time > task->max_execution_time) {
-                        // 任务执行时间超限（无打印）
-                    }
-                    #endif
-                    
-                    // ✅ 使用缓存的时间戳更新
-                    task->last_run_time = loop_time;
-                    task->run_count++;
-                    task->state = TASK_STATE_READY;
-                    
-                    any_task_executed = true;
-                } else {
-                    // ✅ 优化3：计算下一次执行时间（智能休眠）
-                    uint32_t time_until_next_run = task->period_ms - time_since_last_run;
-                    if (time_until_next_run < next_task_time) {
-                        next_task_time = time_until_next_run;
-                    }
+                // 检查执行时间是否超限
+                if (task->actual_execution_time > task->max_execution_time) {
+                    // 任务执行时间超限（无打印）
+                }
+                #endif
+                
+                // ✅ 使用缓存的时间戳更新
+                task->last_run_time = loop_time;
+                task->run_count++;
+                task->state = TASK_STATE_READY;
+                
+                any_task_executed = true;
+            } else {
+                // ✅ 优化3：计算下一次执行时间（智能休眠）
+                uint32_t time_until_next_run = task->period_ms - time_since_last_run;
+                if (time_until_next_run < next_time) {
+                    next_time = time_until_next_run;
                 }
             }
         }
+    }
+    
+    if (next_task_time != NULL) {
+        *next_task_time = next_time;
+    }
+    return any_task_executed;
+}
+
+void OptimizedTaskScheduler_MainLoop(void) {
+    
+    // 主调度循环 - 标准版优化 v2.0
+    while (g_scheduler_running) {
+        // ✅ 优化1：每轮循环只获取一次时间戳（缓存优化）
+        uint32_t loop_time = OSIF_GetMilliseconds();
+        uint32_t next_task_time = UINT32_MAX;
+        bool any_task_executed = OptimizedTaskScheduler_Dispatch(loop_time, &next_task_time);
         
         // ✅ 优化4：智能休眠机制
         if (!any_task_executed) {
@@ -234,6 +244,18 @@ bool OptimizedTaskScheduler_SetTaskSuspended(int32_t task_id, bool suspended) {
     return false;
 }
 
+bool OptimizedTaskScheduler_SetTaskPeriod(int32_t task_id, uint32_t period_ms) {
+    if (task_id < 0 || task_id >= MAX_TASKS || period_ms == 0) return false;
+    
+    if (g_tasks[task_id].task_function != NULL) {
+        g_tasks[task_id].period_ms = period_ms;
+        g_tasks[task_id].max_execution_time = period_ms / 2;
+        return true;
+    }
+    
+    return false;
+}
+
 const optimized_task_t* OptimizedTaskScheduler_GetTaskStatus(int32_t task_id) {
     if (task_id < 0 || task_id >= MAX_TASKS) return NULL;
     
@@ -0,0 +1,364 @@
+/*!
+ * @file overpressure_guard.c
+ *
+ * @brief 油压硬件超压联锁实现
+ *
+ * 说明：
+ * - 动作路径全部为硬件：ACMP0输出 → TRGMUX → CTU → PWM0故障输入0 → CH2/CH3通道对输出强制为无效电平
+ * - PWM0按PWM_LOW_TRUE、ACTIVE_HIGH配置，无效电平为低，经反相驱动即线圈全通电（旁通阀全开）
+ * - 故障控制为手动清除模式：比较器回落后输出仍保持锁定，直到本模块确认油压稳定后清除故障标志
+ * - 故障标志未清除前故障中断会持续挂起，因此中断内先关闭自身中断，恢复时再打开
+ */
+
+#include "overpressure_guard.h"
+#include "sensor.h"
+#include "calib_store.h"
+#include "acmp_drv.h"
+#include "ctu_drv.h"
+#include "pwm_common.h"
+#include "pwm_input.h"
+#include "can_config.h"
+#include "osif.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define OVP_PWM_INSTANCE                  0U
+#define OVP_PWM_FAULT_IRQ                 PWM0_FAULT_IRQn
+#define OVP_PWM_FAULT_CHANNEL             PWM_FAULT_CH_0
+#define OVP_PWM_FAULT_PAIR                ((uint8_t)PWM_CH_2 >> 1)   // 旁通阀通道所在通道对
+#define OVP_PWM_FAULT_FILTER              15U         // 故障输入滤波计数（PS_8下约1us），滤除开关噪声
+#define OVP_CTU_INSTANCE                  0U
+#define OVP_CTU_FAULT_SOURCE_TRGMUX       1U          // PWM故障输入来自TRGMUX（0为外部引脚）
+#define OVP_DAC_CODE_MAX                  255U
+#define OVP_CMD_NONE                      0x00U
+
+/* ==========================================  Variables  =========================================== */
+
+static bool g_ovp_ready = false;
+static uint8_t g_ovp_dac_code = 0U;
+static float g_ovp_threshold = 0.0f;              // DAC量化后的实际动作阈值(MPa)
+static float g_ovp_setpoint = OVP_DEFAULT_THRESHOLD_MPA; // 设定的动作阈值(MPa)，标定变化后按此值重新换算
+static uint32_t g_ovp_calib_revision = 0U;        // 换算DAC码值时的压力标定修订号
+
+static volatile bool g_ovp_tripped = false;       // 故障中断置位，恢复后清除
+static volatile uint16_t g_ovp_trip_count = 0U;
+static volatile uint32_t g_ovp_trip_time = 0U;
+static bool g_ovp_trip_logged = false;
+static bool g_ovp_low_pending = false;            // 比较器已回落，等待保持时间
+static uint32_t g_ovp_low_since = 0U;
+
+/* CAN命令（接收中断拷贝，参数服务任务处理） */
+static volatile uint8_t g_ovp_pending_cmd = OVP_CMD_NONE;
+static uint8_t g_ovp_pending_data[CAN_MSG_DATA_MAX_SIZE];
+
+/* ==========================================  Functions  =========================================== */
+
+/* DAC码值 → 传感器电压 → 按当前标定换算的实际动作阈值 */
+static float OverpressureGuard_DacToThreshold(uint8_t dac_code)
+{
+    float actual_v = (float)dac_code * (OVP_DAC_REFERENCE_V / OVP_DAC_STEPS);
+    float actual_code = actual_v * (ADC_MAX_VALUE / ADC_REFERENCE_VOLTAGE) + 0.5f;
+    if (actual_code > ADC_MAX_VALUE) {
+        actual_code = ADC_MAX_VALUE;
+    }
+    return Sensor_ADCToOilPressure((uint16_t)actual_code);
+}
+
+/* ADC码值 → 传感器电压 → DAC码值（向上取整，保证实际阈值不低于设定值） */
+static bool OverpressureGuard_ThresholdToDac(float threshold_mpa, uint8_t *dac_code, float *actual_mpa)
+{
+    uint16_t lo = 0U;
+    uint16_t hi = (uint16_t)ADC_MAX_VALUE;
+
+    if (Sensor_ADCToOilPressure(hi) < threshold_mpa) {
+        return false;
+    }
+    // 标定单调递增：二分找到第一个不低于阈值的码值
+    while (lo < hi) {
+        uint16_t mid = (uint16_t)((lo + hi) >> 1);
+        if (Sensor_ADCToOilPressure(mid) >= threshold_mpa) {
+            hi = mid;
+        } else {
+            lo = (uint16_t)(mid + 1U);
+        }
+    }
+
+    float voltage = (float)lo * (ADC_REFERENCE_VOLTAGE / ADC_MAX_VALUE);
+    float steps = voltage * (OVP_DAC_STEPS / OVP_DAC_REFERENCE_V);
+    uint32_t code = (uint32_t)steps;
+    if ((float)code < steps) {
+        code++;
+    }
+    if (code > OVP_DAC_CODE_MAX) {
+        return false;
+    }
+    if (code == 0U) {
+        code = 1U;
+    }
+
+    *dac_code = (uint8_t)code;
+    *actual_mpa = OverpressureGuard_DacToThreshold((uint8_t)code);
+    return true;
+}
+
+static bool OverpressureGuard_WriteDac(uint8_t dac_code)
+{
+    acmp_dac_t dac_config;
+    dac_config.voltageReferenceSource = ACMP_DAC_VDD;
+    dac_config.voltage = dac_code;
+    dac_config.state = true;
+    return ACMP_DRV_ConfigDAC(OVP_ACMP_INSTANCE, &dac_config) == STATUS_SUCCESS;
+}
+
+static bool OverpressureGuard_ComparatorHigh(void)
+{
+    uint8_t output = 0U;
+    (void)ACMP_DRV_GetOutputData(OVP_ACMP_INSTANCE, &output);
+    return output != 0U;
+}
+
+#if !HP_PLANT_SIM && HP_OVERPRESSURE_GUARD_ENABLE
+/*!
+ * @brief PWM0故障中断：输出已由硬件锁定，这里只记录并关闭中断（标志由任务在恢复时清除）
+ */
+static void OverpressureGuard_FaultCallback(uint8_t instance, uint32_t status, void *userData)
+{
+    (void)instance;
+    (void)status;
+    (void)userData;
+
+    NVIC_DisableIRQ(OVP_PWM_FAULT_IRQ);
+    g_ovp_trip_time = OSIF_GetMilliseconds();
+    g_ovp_trip_count++;
+    g_ovp_tripped = true;
+}
+#endif
+
+void OverpressureGuard_Init(void)
+{
+#if HP_PLANT_SIM || !HP_OVERPRESSURE_GUARD_ENABLE
+    // 仿真模式下油压为模型值，真实引脚电压与之无关；比较器输入引脚未确认时不配置，避免误动作
+    g_ovp_ready = false;
+    printf("[OVP] Hardware interlock disabled\r\n");
+#else
+    uint8_t dac_code = 0U;
+    float actual = 0.0f;
+    if (!OverpressureGuard_ThresholdToDac(OVP_DEFAULT_THRESHOLD_MPA, &dac_code, &actual)) {
+        printf("[OVP] ERROR: default threshold %.1f MPa out of sensor range\r\n", OVP_DEFAULT_THRESHOLD_MPA);
+        return;
+    }
+
+    // ACMP0：正端油压信号，负端DAC，油压高于阈值输出高；不使用比较器中断
+    acmp_module_t acmp_config;
+    ACMP_DRV_GetDefaultConfig(&acmp_config);
+    acmp_config.mux.positiveInputMux = (acmp_ch_number_t)OVP_ACMP_INPUT_CHANNEL;
+    acmp_config.mux.negativeInputMux = ACMP_DAC_OUTPUT;
+    acmp_config.dac.voltageReferenceSource = ACMP_DAC_VDD;
+    acmp_config.dac.voltage = dac_code;
+    acmp_config.dac.state = true;
+    acmp_config.comparator.interruptEn = false;
+    acmp_config.comparator.hysteresisMode = ACMP_HYS_BOTH_EDGE;
+    acmp_config.comparator.hysteresisLevel = ACMP_LEVEL_HYS_20MV;
+    acmp_config.comparator.callback = NULL;
+    ACMP_DRV_Init(OVP_ACMP_INSTANCE, &acmp_config);
+
+    // CTU触发路由：ACMP0_OUT → PWM0_FAULT0
+    CTU_DRV_Init(OVP_CTU_INSTANCE);
+    if (TRGMUX_DRV_SetTrigSourceForTargetModule(OVP_CTU_INSTANCE, TRGMUX_TRIG_SOURCE_ACMP0_OUT,
+                                                TRGMUX_TARGET_MODULE_PWM0_FAULT0) != STATUS_SUCCESS) {
+        printf("[OVP] ERROR: trigger routing locked\r\n");
+        return;
+    }
+    CTU_DRV_SetPWMFaultTriggerSource(OVP_CTU_INSTANCE, OVP_CTU_FAULT_SOURCE_TRGMUX, CTU_CFG_PWM0_FAULT0);
+
+    // PWM0故障控制：故障输入0高有效，只作用于旁通阀通道对，手动清除
+    pwm_fault_config_t fault_config;
+    memset(&fault_config, 0, sizeof(fault_config));
+    fault_config.mode = PWM_FAULT_CTRL_MANUAL_ALL;
+    fault_config.channelConfig[OVP_PWM_FAULT_CHANNEL].faultInputEn = true;
+    fault_config.channelConfig[OVP_PWM_FAULT_CHANNEL].faultFilterEn = true;
+    fault_config.channelConfig[OVP_PWM_FAULT_CHANNEL].faultPolarity = PWM_INPUT_POLARITY_ACTIVE_HIGH;
+    fault_config.filterValue = OVP_PWM_FAULT_FILTER;
+    fault_config.filterPsc = PWM_CHANNEL_INPUT_FILTER_PS_8;
+    fault_config.faultCtrlOutputEn[OVP_PWM_FAULT_PAIR] = true;
+    fault_config.interruptEn = true;
+    fault_config.HizEnable = false;
+    fault_config.faultCallback = OverpressureGuard_FaultCallback;
+    PWM_DRV_InitFaultControl(OVP_PWM_INSTANCE, &fault_config);
+    NVIC_DisableIRQ(OVP_PWM_FAULT_IRQ);
+
+    // 清除配置过程中可能锁存的故障后再打开中断；上电即超压则保持锁定，由中断和任务按正常流程处理
+    if (!OverpressureGuard_ComparatorHigh()) {
+        PWM_DRV_ClearFaultChannelFlag(OVP_PWM_INSTANCE, OVP_PWM_FAULT_CHANNEL);
+        PWM_DRV_ClearFaultFlag(OVP_PWM_INSTANCE);
+    }
+    NVIC_ClearPendingIRQ(OVP_PWM_FAULT_IRQ);
+    NVIC_EnableIRQ(OVP_PWM_FAULT_IRQ);
+
+    g_ovp_dac_code = dac_code;
+    g_ovp_threshold = actual;
+    g_ovp_setpoint = OVP_DEFAULT_THRESHOLD_MPA;
+    g_ovp_calib_revision = CalibStore_GetPressureRevision();
+    g_ovp_ready = true;
+    printf("[OVP] Hardware interlock armed: %.2f MPa (DAC %u)\r\n", actual, dac_code);
+#endif
+}
+
+bool OverpressureGuard_SetThreshold(float threshold_mpa)
+{
+    uint8_t dac_code = 0U;
+    float actual = 0.0f;
+
+    if (!g_ovp_ready || !(threshold_mpa >= OVP_MIN_THRESHOLD_MPA) ||
+        !OverpressureGuard_ThresholdToDac(threshold_mpa, &dac_code, &actual)) {
+        return false;
+    }
+
+    if (!OverpressureGuard_WriteDac(dac_code)) {
+        return false;
+    }
+    g_ovp_dac_code = dac_code;
+    g_ovp_threshold = actual;
+    g_ovp_setpoint = threshold_mpa;
+    g_ovp_calib_revision = CalibStore_GetPressureRevision();
+    return true;
+}
+
+float OverpressureGuard_GetThreshold(void)
+{
+    return g_ovp_threshold;
+}
+
+bool OverpressureGuard_IsTripped(void)
+{
+    return g_ovp_tripped;
+}
+
+uint8_t OverpressureGuard_GetStatus(void)
+{
+    uint8_t status = 0U;
+
+    if (g_ovp_ready) {
+        status |= OVP_STATUS_READY;
+        if (OverpressureGuard_ComparatorHigh()) {
+            status |= OVP_STATUS_COMPARATOR_HIGH;
+        }
+    }
+    if (g_ovp_tripped) {
+        status |= OVP_STATUS_TRIPPED;
+    }
+    return status;
+}
+
+uint16_t OverpressureGuard_GetTripCount(void)
+{
+    return g_ovp_trip_count;
+}
+
+/* 比较器回落并保持后清除故障标志，PWM从下一个周期起恢复软件指令输出 */
+static void OverpressureGuard_Recover(void)
+{
+    uint32_t now = OSIF_GetMilliseconds();
+
+    if (OverpressureGuard_ComparatorHigh()) {
+        g_ovp_low_pending = false;
+        return;
+    }
+    if (!g_ovp_low_pending) {
+        g_ovp_low_pending = true;
+        g_ovp_low_since = now;
+        return;
+    }
+    if ((now - g_ovp_low_since) < OVP_RECOVER_HOLD_MS) {
+        return;
+    }
+
+    PWM_DRV_ClearFaultChannelFlag(OVP_PWM_INSTANCE, OVP_PWM_FAULT_CHANNEL);
+    PWM_DRV_ClearFaultFlag(OVP_PWM_INSTANCE);
+    g_ovp_low_pending = false;
+    g_ovp_trip_logged = false;
+    g_ovp_tripped = false;
+    NVIC_ClearPendingIRQ(OVP_PWM_FAULT_IRQ);
+    NVIC_EnableIRQ(OVP_PWM_FAULT_IRQ);
+    printf("[OVP] Interlock released after %lu ms\r\n", (unsigned long)(now - g_ovp_trip_time));
+}
+
+/* 压力标定变化后按新标定重新换算DAC码值；设定值超出新标定量程时保持原码值，按新标定报告实际阈值 */
+static void OverpressureGuard_Rearm(void)
+{
+    uint8_t dac_code = 0U;
+    float actual = 0.0f;
+
+    g_ovp_calib_revision = CalibStore_GetPressureRevision();
+    if (OverpressureGuard_ThresholdToDac(g_ovp_setpoint, &dac_code, &actual) &&
+        OverpressureGuard_WriteDac(dac_code)) {
+        g_ovp_dac_code = dac_code;
+        g_ovp_threshold = actual;
+        printf("[OVP] Calibration changed, threshold re-armed: %.2f MPa (DAC %u)\r\n", actual, dac_code);
+        return;
+    }
+    g_ovp_threshold = OverpressureGuard_DacToThreshold(g_ovp_dac_code);
+    printf("[OVP] WARNING: %.2f MPa out of new calibration range, DAC %u kept (%.2f MPa)\r\n",
+           g_ovp_setpoint, g_ovp_dac_code, g_ovp_threshold);
+}
+
+/* ==================== CAN命令 ==================== */
+
+bool OverpressureGuard_HandleCanFrame(const uint8_t *data, uint8_t length)
+{
+    if (data == NULL || length < 1U || data[0] != OVP_CMD_OVERPRESSURE_GUARD) {
+        return false;
+    }
+    // 上一条未处理完时丢弃（上位机超时重发）
+    if (g_ovp_pending_cmd == OVP_CMD_NONE) {
+        memset(g_ovp_pending_data, 0, sizeof(g_ovp_pending_data));
+        memcpy(g_ovp_pending_data, data, (length > CAN_MSG_DATA_MAX_SIZE) ? CAN_MSG_DATA_MAX_SIZE : length);
+        g_ovp_pending_cmd = data[0];
+    }
+    return true;
+}
+
+static void OverpressureGuard_ProcessCommand(void)
+{
+    bool ok = g_ovp_ready;
+    uint16_t threshold = (uint16_t)(g_ovp_pending_data[1] | ((uint16_t)g_ovp_pending_data[2] << 8));
+    if (threshold != 0U) {
+        ok = OverpressureGuard_SetThreshold((float)threshold * 0.01f);
+    }
+
+    uint8_t ack[8];
+    uint16_t actual = (uint16_t)(g_ovp_threshold * 100.0f + 0.5f);
+    uint16_t count = g_ovp_trip_count;
+    ack[0] = OVP_CMD_OVERPRESSURE_GUARD;
+    ack[1] = ok ? 0U : 1U;
+    ack[2] = OverpressureGuard_GetStatus();
+    ack[3] = g_ovp_dac_code;
+    ack[4] = (uint8_t)(actual & 0xFFU);
+    ack[5] = (uint8_t)(actual >> 8);
+    ack[6] = (uint8_t)(count & 0xFFU);
+    ack[7] = (uint8_t)(count >> 8);
+    CAN_Config_SendMessage(CAN_MSG_PARAM_ACK_ID, ack, 8, true);
+}
+
+void OverpressureGuard_Task(void)
+{
+    if (g_ovp_tripped) {
+        if (!g_ovp_trip_logged) {
+            g_ovp_trip_logged = true;
+            printf("[OVP] TRIP #%u: oil %.2f MPa, threshold %.2f MPa, bypass forced open\r\n",
+                   (unsigned int)g_ovp_trip_count, Sensor_GetOilPressure(), g_ovp_threshold);
+        }
+        OverpressureGuard_Recover();
+    }
+
+    if (g_ovp_ready && CalibStore_GetPressureRevision() != g_ovp_calib_revision) {
+        OverpressureGuard_Rearm();
+    }
+
+    if (g_ovp_pending_cmd != OVP_CMD_NONE) {
+        OverpressureGuard_ProcessCommand();
+        g_ovp_pending_cmd = OVP_CMD_NONE;
+    }
+}
@@ -0,0 +1,261 @@
+/*!
+ * @file perf_bench.c
+ *
+ * @brief 热点函数性能基准实现
+ *
+ * 说明：
+ * - Cortex-M4目标使用DWT周期计数器（CoreDebug DEMCR.TRCENA使能），其余平台使用CLOCK_MONOTONIC
+ * - PC端运行程序为Host/Bench/bench_perf.c（make -C Host perf）
+ * - 输入随循环序号变化，结果写入volatile变量，避免被编译器常量折叠或消除
+ */
+
+#include "perf_bench.h"
+#include "sensor.h"
+#include "pt1000.h"
+#include "unified_filter.h"
+#include "gcu_control_dbc.h"
+#include "optimized_task_scheduler.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#if (defined(__CC_ARM) || defined(__ARMCC_VERSION) || defined(__ICCARM__) || defined(__arm__)) && !defined(__linux__)
+#define PERF_BENCH_CYCLES                 1           // 目标板：DWT周期计数（ARM Linux主机无权访问DWT）
+#else
+#define PERF_BENCH_CYCLES                 0           // PC端：单调时钟纳秒
+#endif
+
+#if PERF_BENCH_CYCLES
+#define PERF_DEMCR                        (*(volatile uint32_t *)0xE000EDFCU)
+#define PERF_DEMCR_TRCENA                 (1UL << 24)
+#define PERF_DWT_CTRL                     (*(volatile uint32_t *)0xE0001000U)
+#define PERF_DWT_CTRL_CYCCNTENA           (1UL << 0)
+#define PERF_DWT_CYCCNT                   (*(volatile uint32_t *)0xE0001004U)
+#define PERF_UNIT                         "cyc"
+typedef uint32_t perf_tick_t;
+#else
+#include <time.h>
+#define PERF_UNIT                         "ns"
+typedef uint64_t perf_tick_t;
+#endif
+
+/* ===========================================  Typedef  ============================================ */
+
+typedef void (*perf_bench_fn_t)(uint32_t iterations);
+
+typedef struct {
+    const char *name;
+    perf_bench_fn_t fn;
+} perf_bench_item_t;
+
+/* ==========================================  Variables  =========================================== */
+
+static volatile float g_perf_sink = 0.0f;
+static volatile int32_t g_perf_sink_i = 0;
+static uint32_t g_perf_sched_time = 0U;       // 任务分发基准使用的时间戳（所有任务均未到期）
+
+/* ==========================================  Functions  =========================================== */
+
+static void PerfBench_TimerInit(void)
+{
+#if PERF_BENCH_CYCLES
+    PERF_DEMCR |= PERF_DEMCR_TRCENA;
+    PERF_DWT_CYCCNT = 0U;
+    PERF_DWT_CTRL |= PERF_DWT_CTRL_CYCCNTENA;
+#endif
+}
+
+static perf_tick_t PerfBench_Now(void)
+{
+#if PERF_BENCH_CYCLES
+    return PERF_DWT_CYCCNT;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (perf_tick_t)ts.tv_sec * 1000000000ULL + (perf_tick_t)ts.tv_nsec;
+#endif
+}
+
+/* ==================== 基准项 ==================== */
+
+static void PerfBench_Empty(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++) {
+        g_perf_sink_i = (int32_t)i;
+    }
+}
+
+static void PerfBench_SensorOilTemp(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++) {
+        g_perf_sink = Sensor_ADCToOilTemperature((uint16_t)(1000U + (i & 1023U)));
+    }
+}
+
+static void PerfBench_Pt1000(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++) {
+        g_perf_sink = pt1000_get_temp_float(900.0f + (float)(i & 511U));
+    }
+}
+
+static void PerfBench_FilterUpdate(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++) {
+        float d = (float)(i & 15U) * 0.01f;
+        UnifiedFilter_UpdateData(40.0f + d, -20.0f + d, 8.0f + d, 12.0f + d);
+        g_perf_sink = UnifiedFilter_GetFilteredOilTemperature() + UnifiedFilter_GetFilteredLNGTemperature() +
+                      UnifiedFilter_GetFilteredOilPressure() + UnifiedFilter_GetFilteredLNGPressure();
+    }
+}
+
+static void PerfBench_Debug1Pack(uint32_t iterations)
+{
+    gcu_debug1_t msg;
+    uint8_t data[8];
+
+    memset(&msg, 0, sizeof(msg));
+    for (uint32_t i = 0; i < iterations; i++) {
+        float d = (float)(i & 15U) * 0.1f;
+        msg.oil_temperature = gcu_debug1_oil_temperature_encode(40.0f + d);
+        msg.LNG_temperature = gcu_debug1_LNG_temperature_encode(-20.0f + d);
+        msg.oil_pressure = gcu_debug1_oil_pressure_encode(8.0f + d);
+        msg.LNG_pressure = gcu_debug1_LNG_pressure_encode(12.0f + d);
+        msg.bypass_ratio = gcu_debug1_bypass_ratio_encode(20.0f + d);
+        g_perf_sink_i = gcu_debug1_pack(data, &msg, sizeof(data));
+    }
+}
+
+static void PerfBench_ControlUnpack(uint32_t iterations)
+{
+    gcu_control_t msg;
+    uint8_t data[8];
+
+    memset(&msg, 0, sizeof(msg));
+    msg.ctrl_system_enable = 1U;
+    msg.ctrl_reversal_valve_enable = 1U;
+    msg.ctrl_reversal_valve_freq = 2U;
+    msg.ctrl_bypass_valve_duty = 250U;
+    msg.ctrl_reserved = 0x00032001UL;
+    (void)gcu_control_pack(data, &msg, sizeof(data));
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        data[1] = (uint8_t)i;
+        if (gcu_control_unpack(&msg, data, sizeof(data)) == 0) {
+            g_perf_sink = (float)(gcu_control_ctrl_bypass_valve_duty_decode(msg.ctrl_bypass_valve_duty) +
+                                  gcu_control_ctrl_reversal_valve_freq_decode(msg.ctrl_reversal_valve_freq));
+        }
+    }
+}
+
+static void PerfBench_PidCalculate(uint32_t iterations)
+{
+    platform_pid_controller_t pid;
+
+    PlatformPID_Init(&pid, 2.0f, 10.0f, 0.01f);
+    pid.setpoint = 8.0f;
+    for (uint32_t i = 0; i < iterations; i++) {
+        g_perf_sink = PlatformPID_Calculate(&pid, 7.9f + (float)(i & 15U) * 0.01f, i * 10U);
+    }
+}
+
+static void PerfBench_PidfUpdate(uint32_t iterations)
+{
+    platform_pid_config_t config = {2.0f, 10.0f, 0.01f, 0.001f, 50.0f, 0.0f, 0.0f, BYPASS_VALVE_MAX_DUTY};
+    platform_pidf_t pid;
+
+    (void)PlatformPIDF_Init(&pid, &config);
+    for (uint32_t i = 0; i < iterations; i++) {
+        g_perf_sink = PlatformPIDF_Update(&pid, -8.0f, -7.9f - (float)(i & 15U) * 0.01f, 0.0f);
+    }
+}
+
+static void PerfBench_SchedDispatch(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++) {
+        g_perf_sink_i = OptimizedTaskScheduler_Dispatch(g_perf_sched_time, NULL) ? 1 : 0;
+    }
+}
+
+/*!
+ * @brief 取已注册任务的最大上次运行时间，确认该时刻所有任务均未到期（分发时不会执行任务）
+ */
+static bool PerfBench_PrepareSchedDispatch(void)
+{
+    bool found = false;
+
+    for (int32_t id = 0; id < MAX_TASKS_DEFAULT; id++) {
+        const optimized_task_t *task = OptimizedTaskScheduler_GetTaskStatus(id);
+        if (task != NULL && (!found || (int32_t)(task->last_run_time - g_perf_sched_time) > 0)) {
+            g_perf_sched_time = task->last_run_time;
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    for (int32_t id = 0; id < MAX_TASKS_DEFAULT; id++) {
+        const optimized_task_t *task = OptimizedTaskScheduler_GetTaskStatus(id);
+        if (task != NULL && task->enabled && task->state != TASK_STATE_SUSPENDED &&
+            (g_perf_sched_time - task->last_run_time) >= task->period_ms) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const perf_bench_item_t g_perf_items[] = {
+    {"sensor_oil_temp",     PerfBench_SensorOilTemp},
+    {"pt1000_temp",         PerfBench_Pt1000},
+    {"filter_update",       PerfBench_FilterUpdate},
+    {"dbc_debug1_pack",     PerfBench_Debug1Pack},
+    {"dbc_control_unpack",  PerfBench_ControlUnpack},
+    {"pid_calculate",       PerfBench_PidCalculate},
+    {"pidf_update",         PerfBench_PidfUpdate},
+    {"sched_dispatch",      PerfBench_SchedDispatch},
+};
+
+/* 重复运行取最小耗时 */
+static perf_tick_t PerfBench_Measure(perf_bench_fn_t fn)
+{
+    perf_tick_t best = 0;
+
+    for (uint32_t r = 0; r < PERF_BENCH_REPEATS; r++) {
+        perf_tick_t start = PerfBench_Now();
+        fn(PERF_BENCH_ITERATIONS);
+        perf_tick_t elapsed = (perf_tick_t)(PerfBench_Now() - start);
+        if (r == 0U || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+void PerfBench_Run(void)
+{
+    PerfBench_TimerInit();
+
+    // 任务分发基准依赖调度器当前状态，最先确认
+    bool sched_ok = PerfBench_PrepareSchedDispatch();
+    perf_tick_t overhead = PerfBench_Measure(PerfBench_Empty);
+
+    printf("PERF begin v1 unit=%s iter=%lu repeat=%lu\r\n", PERF_UNIT,
+           (unsigned long)PERF_BENCH_ITERATIONS, (unsigned long)PERF_BENCH_REPEATS);
+    printf("PERF %-20s %.1f\r\n", "loop_overhead", (double)overhead / (double)PERF_BENCH_ITERATIONS);
+
+    for (uint32_t i = 0; i < sizeof(g_perf_items) / sizeof(g_perf_items[0]); i++) {
+        const perf_bench_item_t *item = &g_perf_items[i];
+        if (item->fn == PerfBench_SchedDispatch && !sched_ok) {
+            printf("PERF %-20s skip\r\n", item->name);
+            continue;
+        }
+        perf_tick_t elapsed = PerfBench_Measure(item->fn);
+        perf_tick_t net = (elapsed > overhead) ? (perf_tick_t)(elapsed - overhead) : 0;
+        printf("PERF %-20s %.1f\r\n", item->name, (double)net / (double)PERF_BENCH_ITERATIONS);
+    }
+    printf("PERF end\r\n");
+
+    // 基准输入污染了滤波器状态
+    UnifiedFilter_Reset();
+}
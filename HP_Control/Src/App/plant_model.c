@@ -0,0 +1,127 @@
+/*!
+ * @file plant_model.c
+ *
+ * @brief 液压对象模型实现 - 显式欧拉积分，步长受油液刚度限制
+ *
+ * 说明：
+ * - 单位：压力MPa，流量L/min（内部换算为L/s），容积L；MPa·L/s即kW
+ * - 阀口流量对油压开方，低压时刚度很大，内部步长固定不超过PLANT_MODEL_MAX_STEP_S
+ */
+
+#include "plant_model.h"
+#include <math.h>
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define PLANT_LPM_TO_LPS                  (1.0f / 60.0f)
+
+/* ==========================================  Functions  =========================================== */
+
+void PlantModel_DefaultParams(plant_model_params_t* params)
+{
+    if (params == NULL) {
+        return;
+    }
+
+    params->pump_flow_lpm = 20.0f;
+    params->pump_leak_lpm_mpa = 0.05f;
+    params->bypass_k = 11.5f;
+    params->bypass_dead_duty = 5.0f;
+    params->bypass_full_duty = BYPASS_VALVE_MAX_DUTY;
+    params->bypass_tau_s = 0.008f;
+    params->relief_crack_mpa = 18.0f;
+    params->relief_gain_lpm_mpa = 20.0f;
+    params->load_k = 4.0f;
+    params->volume_l = 2.0f;
+    params->bulk_modulus_mpa = 1400.0f;
+    params->acc_precharge_mpa = 0.0f;
+    params->acc_volume_l = 0.0f;
+    params->oil_heat_capacity_j_k = 64000.0f;   // 约40L液压油
+    params->cooler_w_k = 300.0f;
+    params->ambient_w_k = 20.0f;
+    params->ambient_c = 25.0f;
+    params->lng_ratio = 1.5f;
+    params->lng_tau_s = 0.5f;
+    params->lng_temp_c = -20.0f;
+}
+
+platform_status_t PlantModel_Init(plant_model_t* model, const plant_model_params_t* params)
+{
+    if (model == NULL || params == NULL || !(params->volume_l > 0.0f) || !(params->bulk_modulus_mpa > 0.0f) ||
+        !(params->bypass_full_duty > params->bypass_dead_duty) || !(params->bypass_tau_s > 0.0f) ||
+        !(params->lng_tau_s > 0.0f) || !(params->oil_heat_capacity_j_k > 0.0f)) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+
+    memset(model, 0, sizeof(plant_model_t));
+    model->params = *params;
+    model->oil_temp_c = params->ambient_c;
+    return PLATFORM_STATUS_OK;
+}
+
+/* 单步积分（h不超过PLANT_MODEL_MAX_STEP_S） */
+static void PlantModel_Integrate(plant_model_t* model, const plant_model_inputs_t* inputs, platform_float32_t h)
+{
+    const plant_model_params_t* p = &model->params;
+    platform_float32_t pressure = model->oil_pressure_mpa;
+    platform_float32_t sqrt_p = sqrtf(pressure);
+
+    // 阀芯开度：死区以下关闭，bypass_full_duty及以上全开
+    platform_float32_t target = (inputs->bypass_duty - p->bypass_dead_duty) / (p->bypass_full_duty - p->bypass_dead_duty);
+    if (target < 0.0f) target = 0.0f;
+    if (target > 1.0f) target = 1.0f;
+    model->bypass_opening += (target - model->bypass_opening) * (h / p->bypass_tau_s);
+
+    platform_float32_t speed = inputs->pump_speed;
+    if (speed < 0.0f) speed = 0.0f;
+    if (speed > 1.0f) speed = 1.0f;
+
+    platform_float32_t q_pump = p->pump_flow_lpm * speed;
+    platform_float32_t q_leak = p->pump_leak_lpm_mpa * pressure;
+    platform_float32_t q_bypass = p->bypass_k * model->bypass_opening * sqrt_p;
+    platform_float32_t q_relief = (pressure > p->relief_crack_mpa) ? (pressure - p->relief_crack_mpa) * p->relief_gain_lpm_mpa : 0.0f;
+    platform_float32_t q_load = inputs->directional_valve ? p->load_k * sqrt_p : 0.0f;
+
+    // 容腔：油液压缩 + 蓄能器（预充压力以上，等温气体）
+    platform_float32_t capacitance = p->volume_l / p->bulk_modulus_mpa;
+    if (p->acc_volume_l > 0.0f && pressure > p->acc_precharge_mpa) {
+        platform_float32_t p0 = p->acc_precharge_mpa + PLANT_MODEL_ATM_MPA;
+        platform_float32_t pa = pressure + PLANT_MODEL_ATM_MPA;
+        capacitance += p->acc_volume_l * p0 / (pa * pa);
+    }
+
+    platform_float32_t q_net = (q_pump - q_leak - q_bypass - q_relief - q_load) * PLANT_LPM_TO_LPS;
+    pressure += q_net / capacitance * h;
+    if (pressure < 0.0f) {
+        pressure = 0.0f;
+    }
+
+    // 油温：节流损失(kW) - 散热
+    platform_float32_t heat_w = model->oil_pressure_mpa * (q_leak + q_bypass + q_relief + q_load) * PLANT_LPM_TO_LPS * 1000.0f;
+    platform_float32_t cooling_w_k = p->ambient_w_k + (inputs->cooler ? p->cooler_w_k : 0.0f);
+    heat_w -= cooling_w_k * (model->oil_temp_c - p->ambient_c);
+    model->oil_temp_c += heat_w / p->oil_heat_capacity_j_k * h;
+
+    model->lng_pressure_mpa += (p->lng_ratio * model->oil_pressure_mpa - model->lng_pressure_mpa) * (h / p->lng_tau_s);
+
+    model->oil_pressure_mpa = pressure;
+    model->flow_bypass_lpm = q_bypass;
+    model->flow_relief_lpm = q_relief;
+    model->flow_load_lpm = q_load;
+}
+
+void PlantModel_Step(plant_model_t* model, const plant_model_inputs_t* inputs, platform_float32_t dt)
+{
+    if (model == NULL || inputs == NULL || !(dt > 0.0f)) {
+        return;
+    }
+
+    platform_uint32_t steps = (platform_uint32_t)(dt / PLANT_MODEL_MAX_STEP_S) + 1U;
+    platform_float32_t h = dt / (platform_float32_t)steps;
+
+    for (platform_uint32_t i = 0U; i < steps; i++) {
+        PlantModel_Integrate(model, inputs, h);
+    }
+    model->time_s += dt;
+}
@@ -0,0 +1,387 @@
+/*!
+ * @file pressure_capture.c
+ *
+ * @brief 压力波形捕获模块实现 - 环形缓冲录波 + 触发检测 + CAN分段下载
+ *
+ * 说明：
+ * - 采样回调运行在定时器中断中，只做写缓冲和整数比较；触发后倒计数，采满即停止采集流
+ * - 换向阀动作在主循环中通知，中断在下一个采样点锁存触发位置，触发点与采样严格对齐
+ * - CAN接收回调运行在中断上下文，只记录命令；布防、应答和数据发送在PressureCapture_Task中完成
+ */
+
+#include "pressure_capture.h"
+#include "sensor.h"
+#include "can_config.h"
+#include "osif.h"
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define PCAP_INDEX_MASK             (PCAP_BUFFER_SAMPLES - 1U)
+#define PCAP_CMD_NONE               0x00U       // 无待处理命令
+#define PCAP_CODE_MASK              0x0FFFU     // 12位码值
+
+typedef char pcap_buffer_size_check_t[((PCAP_BUFFER_SAMPLES & PCAP_INDEX_MASK) == 0U &&
+                                       PCAP_BUFFER_SAMPLES <= 0x10000U) ? 1 : -1];
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 分段下载状态
+ */
+typedef struct {
+    uint16_t next;                            // 下一个待发送采样序号
+    uint16_t end;                             // 结束序号（不含）
+    bool active;
+} pcap_download_t;
+
+/* ==========================================  Variables  =========================================== */
+
+// 录波缓冲区：[0]油压 [1]LNG压力
+static uint16_t g_pcap_buffer[PCAP_BUFFER_SAMPLES][2];
+
+static pressure_capture_config_t g_pcap_config;
+static volatile pressure_capture_state_t g_pcap_state = PCAP_STATE_IDLE;
+static volatile uint8_t g_pcap_pending_source = PCAP_SOURCE_NONE; // 主循环/CAN请求的触发，由中断锁存
+static pressure_capture_source_t g_pcap_source = PCAP_SOURCE_NONE;
+static uint32_t g_pcap_write = 0U;            // 已写入采样总数
+static uint32_t g_pcap_start = 0U;            // 录波首个采样的写入序号
+static uint16_t g_pcap_trigger_index = 0U;    // 触发点在录波中的序号
+static uint16_t g_pcap_post_remaining = 0U;   // 触发后尚需记录的采样数
+static uint16_t g_pcap_period_us = 0U;
+static uint32_t g_pcap_trigger_time = 0U;
+static uint16_t g_pcap_last_oil = 0U;
+static uint16_t g_pcap_last_lng = 0U;
+static volatile bool g_pcap_done_event = false; // 采满通知待发送
+
+static pcap_download_t g_pcap_download;
+
+// CAN命令（中断中写入，任务中处理）
+static volatile uint8_t g_pcap_pending_cmd = PCAP_CMD_NONE;
+static uint8_t g_pcap_pending_data[CAN_MSG_DATA_MAX_SIZE];
+
+/* ==========================================  Functions  =========================================== */
+
+static uint16_t PressureCapture_ReadU16(const uint8_t *data)
+{
+    return (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+}
+
+static bool PressureCapture_ThresholdCrossed(uint16_t last, uint16_t now, uint16_t threshold,
+                                             uint8_t rise_mask, uint8_t fall_mask)
+{
+    uint8_t mask = g_pcap_config.trigger_mask;
+
+    if ((mask & rise_mask) != 0U && last < threshold && now >= threshold) {
+        return true;
+    }
+    if ((mask & fall_mask) != 0U && last >= threshold && now < threshold) {
+        return true;
+    }
+    return false;
+}
+
+/* 逐采样回调（定时器中断上下文） */
+static void PressureCapture_OnSample(uint16_t oil_raw, uint16_t lng_raw)
+{
+    uint32_t index = g_pcap_write;
+
+    g_pcap_buffer[index & PCAP_INDEX_MASK][0] = oil_raw;
+    g_pcap_buffer[index & PCAP_INDEX_MASK][1] = lng_raw;
+    g_pcap_write = index + 1U;
+
+    if (g_pcap_state == PCAP_STATE_ARMED) {
+        pressure_capture_source_t source = (pressure_capture_source_t)g_pcap_pending_source;
+
+        if (source == PCAP_SOURCE_NONE && index > 0U) {
+            if (PressureCapture_ThresholdCrossed(g_pcap_last_oil, oil_raw, g_pcap_config.threshold_code,
+                                                 PCAP_TRIG_OIL_RISE, PCAP_TRIG_OIL_FALL)) {
+                source = PCAP_SOURCE_OIL_THRESHOLD;
+            } else if (PressureCapture_ThresholdCrossed(g_pcap_last_lng, lng_raw, g_pcap_config.threshold_code,
+                                                        PCAP_TRIG_LNG_RISE, PCAP_TRIG_LNG_FALL)) {
+                source = PCAP_SOURCE_LNG_THRESHOLD;
+            }
+        }
+
+        if (source != PCAP_SOURCE_NONE) {
+            // 触发前窗口不足时（布防后很快触发）以实际已采样数为准，触发后窗口相应加长
+            uint16_t pre = (index < g_pcap_config.pre_samples) ? (uint16_t)index : g_pcap_config.pre_samples;
+            g_pcap_start = index - pre;
+            g_pcap_trigger_index = pre;
+            g_pcap_post_remaining = (uint16_t)(PCAP_BUFFER_SAMPLES - pre - 1U);
+            g_pcap_source = source;
+            g_pcap_trigger_time = OSIF_GetMilliseconds();
+            g_pcap_state = PCAP_STATE_TRIGGERED;
+        }
+    } else if (g_pcap_state == PCAP_STATE_TRIGGERED) {
+        if (g_pcap_post_remaining > 0U) {
+            g_pcap_post_remaining--;
+        }
+    }
+
+    if (g_pcap_state == PCAP_STATE_TRIGGERED && g_pcap_post_remaining == 0U) {
+        Sensor_StopPressureStream();
+        g_pcap_state = PCAP_STATE_DONE;
+        g_pcap_done_event = true;
+    }
+
+    g_pcap_last_oil = oil_raw;
+    g_pcap_last_lng = lng_raw;
+}
+
+void PressureCapture_Init(void)
+{
+    memset(g_pcap_buffer, 0, sizeof(g_pcap_buffer));
+    memset(&g_pcap_download, 0, sizeof(g_pcap_download));
+    g_pcap_config.trigger_mask = PCAP_TRIG_DEFAULT;
+    g_pcap_config.threshold_code = 0U;
+    g_pcap_config.pre_samples = PCAP_DEFAULT_PRE_SAMPLES;
+    g_pcap_config.period_us = PCAP_DEFAULT_PERIOD_US;
+    g_pcap_state = PCAP_STATE_IDLE;
+    g_pcap_source = PCAP_SOURCE_NONE;
+    g_pcap_pending_source = PCAP_SOURCE_NONE;
+    g_pcap_pending_cmd = PCAP_CMD_NONE;
+    g_pcap_done_event = false;
+}
+
+pressure_capture_result_t PressureCapture_Arm(const pressure_capture_config_t *config)
+{
+    if (config == NULL || config->trigger_mask == 0U ||
+        config->pre_samples >= PCAP_BUFFER_SAMPLES ||
+        config->period_us < SENSOR_STREAM_MIN_PERIOD_US ||
+        config->threshold_code > PCAP_CODE_MASK) {
+        return PCAP_RESULT_BAD_PARAM;
+    }
+
+    // 重新布防先停止本模块的采集，采集流被其他功能占用时拒绝
+    if (g_pcap_state == PCAP_STATE_ARMED || g_pcap_state == PCAP_STATE_TRIGGERED) {
+        Sensor_StopPressureStream();
+    }
+    g_pcap_state = PCAP_STATE_IDLE;
+    g_pcap_download.active = false;
+
+    g_pcap_config = *config;
+    g_pcap_write = 0U;
+    g_pcap_start = 0U;
+    g_pcap_trigger_index = 0U;
+    g_pcap_post_remaining = 0U;
+    g_pcap_source = PCAP_SOURCE_NONE;
+    g_pcap_pending_source = PCAP_SOURCE_NONE;
+    g_pcap_done_event = false;
+    g_pcap_period_us = config->period_us;
+    g_pcap_state = PCAP_STATE_ARMED;
+
+    if (!Sensor_StartPressureStream(config->period_us, PressureCapture_OnSample)) {
+        g_pcap_state = PCAP_STATE_IDLE;
+        return PCAP_RESULT_BUSY;
+    }
+    return PCAP_RESULT_OK;
+}
+
+void PressureCapture_Trigger(void)
+{
+    if (g_pcap_state == PCAP_STATE_ARMED) {
+        g_pcap_pending_source = PCAP_SOURCE_FORCED;
+    }
+}
+
+void PressureCapture_Abort(void)
+{
+    if (g_pcap_state == PCAP_STATE_ARMED || g_pcap_state == PCAP_STATE_TRIGGERED) {
+        Sensor_StopPressureStream();
+    }
+    g_pcap_state = PCAP_STATE_IDLE;
+    g_pcap_source = PCAP_SOURCE_NONE;
+    g_pcap_download.active = false;
+    g_pcap_done_event = false;
+}
+
+void PressureCapture_NotifyValveEdge(bool valve_on)
+{
+    if (g_pcap_state != PCAP_STATE_ARMED) {
+        return;
+    }
+    if ((g_pcap_config.trigger_mask & (valve_on ? PCAP_TRIG_VALVE_ON : PCAP_TRIG_VALVE_OFF)) != 0U) {
+        g_pcap_pending_source = PCAP_SOURCE_VALVE;
+    }
+}
+
+void PressureCapture_GetInfo(pressure_capture_info_t *info)
+{
+    if (info == NULL) {
+        return;
+    }
+    info->state = g_pcap_state;
+    info->source = g_pcap_source;
+    info->trigger_index = g_pcap_trigger_index;
+    info->period_us = g_pcap_period_us;
+    info->trigger_time = g_pcap_trigger_time;
+}
+
+bool PressureCapture_GetSample(uint16_t index, uint16_t *oil_raw, uint16_t *lng_raw)
+{
+    if (g_pcap_state != PCAP_STATE_DONE || index >= PCAP_BUFFER_SAMPLES ||
+        oil_raw == NULL || lng_raw == NULL) {
+        return false;
+    }
+    uint32_t slot = (g_pcap_start + index) & PCAP_INDEX_MASK;
+    *oil_raw = g_pcap_buffer[slot][0];
+    *lng_raw = g_pcap_buffer[slot][1];
+    return true;
+}
+
+/* ==================== CAN服务 ==================== */
+
+static void PressureCapture_SendAck(uint8_t cmd, pressure_capture_result_t result, uint16_t word0, uint16_t word1)
+{
+    uint8_t data[8];
+
+    data[0] = cmd;
+    data[1] = (uint8_t)result;
+    data[2] = (uint8_t)g_pcap_state;
+    data[3] = (uint8_t)g_pcap_source;
+    data[4] = (uint8_t)(word0 & 0xFFU);
+    data[5] = (uint8_t)(word0 >> 8);
+    data[6] = (uint8_t)(word1 & 0xFFU);
+    data[7] = (uint8_t)(word1 >> 8);
+
+    CAN_Config_SendMessage(CAN_MSG_PARAM_ACK_ID, data, 8, true);
+}
+
+static void PressureCapture_SendStatus(uint8_t cmd, pressure_capture_result_t result)
+{
+    PressureCapture_SendAck(cmd, result, g_pcap_trigger_index, g_pcap_period_us);
+}
+
+/* 两个采样点（4个12位码值）紧凑打包为6字节 */
+static bool PressureCapture_SendDataFrame(uint16_t index)
+{
+    uint8_t data[8];
+    uint16_t code[4] = {0U, 0U, 0U, 0U};
+
+    for (uint16_t i = 0U; i < PCAP_SAMPLES_PER_FRAME && (uint32_t)index + i < PCAP_BUFFER_SAMPLES; i++) {
+        uint32_t slot = (g_pcap_start + index + i) & PCAP_INDEX_MASK;
+        code[i * 2U] = g_pcap_buffer[slot][0] & PCAP_CODE_MASK;
+        code[i * 2U + 1U] = g_pcap_buffer[slot][1] & PCAP_CODE_MASK;
+    }
+
+    data[0] = (uint8_t)(index & 0xFFU);
+    data[1] = (uint8_t)(index >> 8);
+    data[2] = (uint8_t)(code[0] & 0xFFU);
+    data[3] = (uint8_t)((code[0] >> 8) | ((code[1] & 0x0FU) << 4));
+    data[4] = (uint8_t)(code[1] >> 4);
+    data[5] = (uint8_t)(code[2] & 0xFFU);
+    data[6] = (uint8_t)((code[2] >> 8) | ((code[3] & 0x0FU) << 4));
+    data[7] = (uint8_t)(code[3] >> 4);
+
+    return CAN_Config_SendMessage(CAN_MSG_CAPTURE_DATA_ID, data, 8, true);
+}
+
+bool PressureCapture_HandleCanFrame(const uint8_t *data, uint8_t length)
+{
+    if (data == NULL || length < 1U) {
+        return false;
+    }
+
+    uint8_t cmd = data[0];
+
+    switch (cmd) {
+        case PCAP_CMD_TRIGGER:
+            // 强制触发只置标志，由采样中断锁存
+            PressureCapture_Trigger();
+            return true;
+
+        case PCAP_CMD_ARM:
+        case PCAP_CMD_ABORT:
+        case PCAP_CMD_STATUS:
+        case PCAP_CMD_READ:
+            // 上一条未处理完时丢弃（上位机超时重发）
+            if (g_pcap_pending_cmd == PCAP_CMD_NONE) {
+                memset(g_pcap_pending_data, 0, sizeof(g_pcap_pending_data));
+                memcpy(g_pcap_pending_data, data, (length > CAN_MSG_DATA_MAX_SIZE) ? CAN_MSG_DATA_MAX_SIZE : length);
+                g_pcap_pending_cmd = cmd;
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void PressureCapture_Task(void)
+{
+    uint8_t cmd = g_pcap_pending_cmd;
+
+    switch (cmd) {
+        case PCAP_CMD_ARM: {
+            pressure_capture_config_t config;
+            config.trigger_mask = g_pcap_pending_data[1];
+            config.threshold_code = PressureCapture_ReadU16(&g_pcap_pending_data[2]);
+            config.pre_samples = PressureCapture_ReadU16(&g_pcap_pending_data[4]);
+            config.period_us = PressureCapture_ReadU16(&g_pcap_pending_data[6]);
+            if (config.pre_samples == 0U) {
+                config.pre_samples = PCAP_DEFAULT_PRE_SAMPLES;
+            }
+            if (config.period_us == 0U) {
+                config.period_us = PCAP_DEFAULT_PERIOD_US;
+            }
+            PressureCapture_SendStatus(cmd, PressureCapture_Arm(&config));
+            break;
+        }
+
+        case PCAP_CMD_ABORT:
+            PressureCapture_Abort();
+            PressureCapture_SendStatus(cmd, PCAP_RESULT_OK);
+            break;
+
+        case PCAP_CMD_STATUS:
+            PressureCapture_SendStatus(cmd, PCAP_RESULT_OK);
+            break;
+
+        case PCAP_CMD_READ: {
+            uint16_t start = PressureCapture_ReadU16(&g_pcap_pending_data[1]);
+            uint16_t count = PressureCapture_ReadU16(&g_pcap_pending_data[3]);
+            if (g_pcap_state != PCAP_STATE_DONE) {
+                PressureCapture_SendAck(cmd, PCAP_RESULT_NO_DATA, start, count);
+                break;
+            }
+            if (start >= PCAP_BUFFER_SAMPLES) {
+                PressureCapture_SendAck(cmd, PCAP_RESULT_BAD_PARAM, start, count);
+                break;
+            }
+            if (count == 0U || (uint32_t)start + count > PCAP_BUFFER_SAMPLES) {
+                count = (uint16_t)(PCAP_BUFFER_SAMPLES - start);
+            }
+            g_pcap_download.next = start;
+            g_pcap_download.end = (uint16_t)(start + count);
+            g_pcap_download.active = true;
+            PressureCapture_SendAck(cmd, PCAP_RESULT_OK, start, count);
+            break;
+        }
+
+        default:
+            break;
+    }
+    if (cmd != PCAP_CMD_NONE) {
+        g_pcap_pending_cmd = PCAP_CMD_NONE;
+    }
+
+    // 采满主动通知上位机
+    if (g_pcap_done_event) {
+        g_pcap_done_event = false;
+        PressureCapture_SendStatus(PCAP_CMD_STATUS, PCAP_RESULT_OK);
+    }
+
+    // 分段下载，发送邮箱满时下次任务继续
+    if (g_pcap_download.active) {
+        for (uint8_t i = 0U; i < PCAP_FRAMES_PER_TASK && g_pcap_download.next < g_pcap_download.end; i++) {
+            if (!PressureCapture_SendDataFrame(g_pcap_download.next)) {
+                break;
+            }
+            g_pcap_download.next += PCAP_SAMPLES_PER_FRAME;
+        }
+        if (g_pcap_download.next >= g_pcap_download.end) {
+            g_pcap_download.active = false;
+        }
+    }
+}
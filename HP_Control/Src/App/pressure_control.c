@@ -0,0 +1,445 @@
+/*!
+ * @file pressure_control.c
+ *
+ * @brief 旁通阀压力闭环实现 - 采集流中断中完成 采样→换算→PID→PWM
+ *
+ * 说明：
+ * - 闭环周期固定为采集流周期，使用定周期PID（测量值微分+低通、反算抗饱和），不受系统节拍抖动影响
+ * - 上位机命令在CAN接收中断中写入，闭环中断每周期读取，设定值和限值修改在下一周期生效
+ * - 退出闭环只停止采集流并清除请求，旁通阀保持最后开度，由调用方（上位机命令/安全保护）接管
+ * - 增益调度在任务中按油温/设定值查表，新参数交给采样中断在周期开始时整定，避免与PID计算交错
+ * - 自整定试验在任务中配置，置位g_pctrl_tuning后由采样中断独占执行；试验期间暂停增益调度
+ * - 自整定命令（含中止）在CAN接收中断中只登记，由任务执行；中止时先清除g_pctrl_tuning再改试验状态
+ */
+
+#include "pressure_control.h"
+#include "sensor.h"
+#include "calib_store.h"
+#include "valve_control.h"
+#include "can_config.h"
+#include "osif.h"
+#include <string.h>
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 上位机闭环命令
+ */
+typedef struct {
+    float setpoint_mpa;
+    float duty_min;
+    float duty_max;
+} pctrl_command_t;
+
+/* ============================================  Define  ============================================ */
+
+#define PCTRL_CMD_NONE                    0x00U       // 无待处理命令
+
+/* ==========================================  Variables  =========================================== */
+
+static volatile pressure_control_state_t g_pctrl_state = PCTRL_STATE_IDLE;
+static volatile bool g_pctrl_requested = false;
+static volatile pctrl_command_t g_pctrl_cmd;
+
+static platform_pidf_t g_pctrl_pid;
+static platform_pid_config_t g_pctrl_config;  // 当前整定参数（默认增益或调度结果）
+static volatile bool g_pctrl_transfer = false; // 下一采样按当前开度无扰切入
+static volatile float g_pctrl_feedforward = 0.0f; // 前馈开度(%)
+
+// 增益调度：任务写入，采样中断取走
+static platform_pid_config_t g_pctrl_retune_config;
+static float g_pctrl_retune_feedforward = 0.0f;
+static volatile bool g_pctrl_retune_pending = false;
+static uint32_t g_pctrl_schedule_time = 0U;
+static volatile float g_pctrl_pressure = 0.0f;
+static volatile float g_pctrl_duty = 0.0f;
+static volatile uint32_t g_pctrl_cycles = 0U;
+
+// 继电器自整定：任务中启动，采样中断执行
+static platform_relay_tune_t g_pctrl_tune;
+static volatile bool g_pctrl_tuning = false;
+static volatile bool g_pctrl_tune_event = false; // 试验结束通知待发送
+static float g_pctrl_tune_setpoint = 0.0f;    // 试验时的压力设定值(MPa)，写入调度表时使用
+
+// CAN命令（中断中写入，任务中处理）
+static volatile uint8_t g_pctrl_pending_cmd = PCTRL_CMD_NONE;
+static uint8_t g_pctrl_pending_data[CAN_MSG_DATA_MAX_SIZE];
+
+/* ==========================================  Functions  =========================================== */
+
+/* 逐采样回调（定时器中断上下文） */
+static void PressureControl_OnSample(uint16_t oil_raw, uint16_t lng_raw)
+{
+    (void)lng_raw;
+
+    if (g_pctrl_state != PCTRL_STATE_RUNNING) {
+        return;
+    }
+
+    float pressure = CalibStore_ConvertPressure(CALIB_PRESSURE_OIL, oil_raw);
+    float duty;
+
+    if (g_pctrl_tuning) {
+        // 继电器试验同样按取负后的正作用量计算：油压偏高时继电器置高（开大）
+        duty = PlatformRelayTune_Update(&g_pctrl_tune, -pressure);
+        if (g_pctrl_tune.state == PLATFORM_TUNE_RUNNING) {
+            if (duty < g_pctrl_cmd.duty_min) duty = g_pctrl_cmd.duty_min;
+            if (duty > g_pctrl_cmd.duty_max) duty = g_pctrl_cmd.duty_max;
+            ValveControl_WriteBypassValveDutyImmediate(duty);
+            g_pctrl_pressure = pressure;
+            g_pctrl_duty = duty;
+            g_pctrl_cycles++;
+            return;
+        }
+        // 试验结束（完成或越界/超时失败）：本周期起从当前开度无扰切回PID
+        g_pctrl_tuning = false;
+        g_pctrl_tune_event = true;
+        g_pctrl_transfer = true;
+    }
+
+    if (g_pctrl_retune_pending) {
+        (void)PlatformPIDF_Retune(&g_pctrl_pid, &g_pctrl_retune_config);
+        // 前馈变化并入积分项，切换调度节点时输出连续
+        g_pctrl_pid.integral += g_pctrl_feedforward - g_pctrl_retune_feedforward;
+        g_pctrl_feedforward = g_pctrl_retune_feedforward;
+        g_pctrl_retune_pending = false;
+    }
+
+    // 反作用：设定值与测量值取负，误差为 油压-设定值，油压偏高时开度增大
+    g_pctrl_pid.output_min = g_pctrl_cmd.duty_min;
+    g_pctrl_pid.output_max = g_pctrl_cmd.duty_max;
+    if (g_pctrl_transfer) {
+        PlatformPIDF_Bumpless(&g_pctrl_pid, -g_pctrl_cmd.setpoint_mpa, -pressure, g_pctrl_feedforward,
+                              ValveControl_GetBypassValveDuty());
+        g_pctrl_transfer = false;
+    }
+    duty = PlatformPIDF_Update(&g_pctrl_pid, -g_pctrl_cmd.setpoint_mpa, -pressure, g_pctrl_feedforward);
+
+    ValveControl_WriteBypassValveDutyImmediate(duty);
+    g_pctrl_pressure = pressure;
+    g_pctrl_duty = duty;
+    g_pctrl_cycles++;
+}
+
+void PressureControl_Init(void)
+{
+    g_pctrl_config.kp = PCTRL_DEFAULT_KP;
+    g_pctrl_config.ki = PCTRL_DEFAULT_KI;
+    g_pctrl_config.kd = PCTRL_DEFAULT_KD;
+    g_pctrl_config.dt = (float)PCTRL_PERIOD_US * 1.0e-6f;
+    g_pctrl_config.derivative_cutoff_hz = PCTRL_DERIVATIVE_CUTOFF_HZ;
+    g_pctrl_config.tracking_gain = 0.0f;
+    g_pctrl_config.output_min = BYPASS_VALVE_MIN_DUTY;
+    g_pctrl_config.output_max = BYPASS_VALVE_MAX_DUTY;
+    (void)PlatformPIDF_Init(&g_pctrl_pid, &g_pctrl_config);
+    g_pctrl_feedforward = 0.0f;
+    g_pctrl_retune_feedforward = 0.0f;
+    g_pctrl_retune_pending = false;
+    g_pctrl_cmd.setpoint_mpa = 0.0f;
+    g_pctrl_cmd.duty_min = BYPASS_VALVE_MIN_DUTY;
+    g_pctrl_cmd.duty_max = BYPASS_VALVE_MAX_DUTY;
+    g_pctrl_requested = false;
+    g_pctrl_state = PCTRL_STATE_IDLE;
+    g_pctrl_tuning = false;
+    g_pctrl_tune_event = false;
+    g_pctrl_pending_cmd = PCTRL_CMD_NONE;
+    memset(&g_pctrl_tune, 0, sizeof(g_pctrl_tune));
+}
+
+void PressureControl_SetCommand(bool enable, float setpoint_mpa, float duty_min, float duty_max)
+{
+    if (!enable) {
+        PressureControl_Stop();
+        return;
+    }
+
+    if (duty_min < BYPASS_VALVE_MIN_DUTY) duty_min = BYPASS_VALVE_MIN_DUTY;
+    if (duty_max > BYPASS_VALVE_MAX_DUTY) duty_max = BYPASS_VALVE_MAX_DUTY;
+    if (duty_max < duty_min) duty_max = duty_min;
+
+    g_pctrl_cmd.setpoint_mpa = setpoint_mpa;
+    g_pctrl_cmd.duty_min = duty_min;
+    g_pctrl_cmd.duty_max = duty_max;
+    g_pctrl_requested = true;
+    if (g_pctrl_state == PCTRL_STATE_IDLE) {
+        g_pctrl_state = PCTRL_STATE_WAIT_STREAM;
+    }
+}
+
+void PressureControl_Stop(void)
+{
+    pressure_control_state_t state = g_pctrl_state;
+
+    // 先切换状态，采样中断中不再写PWM
+    g_pctrl_requested = false;
+    g_pctrl_state = PCTRL_STATE_IDLE;
+    if (state == PCTRL_STATE_RUNNING) {
+        Sensor_StopPressureStream();
+    }
+
+    // 退出闭环（含安全保护）同时中止自整定
+    if (g_pctrl_tuning) {
+        g_pctrl_tuning = false;
+        PlatformRelayTune_Abort(&g_pctrl_tune);
+        g_pctrl_tune_event = true;
+    }
+}
+
+/*!
+ * @brief 按滤波后油温和压力设定值查询增益调度表，参数变化时请求整定
+ */
+static void PressureControl_UpdateSchedule(void)
+{
+    platform_gain_set_t gains;
+    uint32_t now = OSIF_GetMilliseconds();
+
+    if ((now - g_pctrl_schedule_time) < PCTRL_SCHEDULE_PERIOD_MS || g_pctrl_retune_pending || g_pctrl_tuning) {
+        return;
+    }
+    g_pctrl_schedule_time = now;
+
+    if (!CalibStore_LookupGains(Sensor_GetOilTemperature(), g_pctrl_cmd.setpoint_mpa, &gains)) {
+        return;
+    }
+    if (gains.kp == g_pctrl_config.kp && gains.ki == g_pctrl_config.ki &&
+        gains.kd == g_pctrl_config.kd && gains.feedforward == g_pctrl_retune_feedforward) {
+        return;
+    }
+
+    g_pctrl_config.kp = gains.kp;
+    g_pctrl_config.ki = gains.ki;
+    g_pctrl_config.kd = gains.kd;
+    g_pctrl_retune_feedforward = gains.feedforward;
+    if (g_pctrl_state == PCTRL_STATE_RUNNING) {
+        g_pctrl_retune_config = g_pctrl_config;
+        g_pctrl_retune_pending = true;
+    } else {
+        (void)PlatformPIDF_Retune(&g_pctrl_pid, &g_pctrl_config);
+        g_pctrl_feedforward = gains.feedforward;
+    }
+}
+
+/* ==================== 自整定CAN服务 ==================== */
+
+static uint16_t PressureControl_ToU16(float value)
+{
+    if (!(value > 0.0f)) {
+        return 0U;
+    }
+    return (value >= 65535.0f) ? 0xFFFFU : (uint16_t)(value + 0.5f);
+}
+
+static void PressureControl_SendAck(uint8_t cmd, pressure_control_result_t result)
+{
+    uint8_t data[8];
+    uint16_t ku = 0U;
+    uint16_t tu = 0U;
+
+    if (g_pctrl_tune.state == PLATFORM_TUNE_DONE) {
+        ku = PressureControl_ToU16(g_pctrl_tune.ku * 100.0f);
+        tu = PressureControl_ToU16(g_pctrl_tune.tu * 1000.0f);
+    }
+
+    data[0] = cmd;
+    data[1] = (uint8_t)result;
+    data[2] = (uint8_t)g_pctrl_tune.state;
+    data[3] = g_pctrl_tune.cycles;
+    data[4] = (uint8_t)(ku & 0xFFU);
+    data[5] = (uint8_t)(ku >> 8);
+    data[6] = (uint8_t)(tu & 0xFFU);
+    data[7] = (uint8_t)(tu >> 8);
+
+    CAN_Config_SendMessage(CAN_MSG_PARAM_ACK_ID, data, 8, true);
+}
+
+/*!
+ * @brief 按命令参数配置并启动继电器试验（闭环运行中才允许）
+ */
+static pressure_control_result_t PressureControl_StartTune(const uint8_t *data)
+{
+    platform_relay_tune_config_t config;
+
+    if (g_pctrl_state != PCTRL_STATE_RUNNING || g_pctrl_transfer) {
+        return PCTRL_RESULT_NOT_RUNNING;
+    }
+    if (g_pctrl_tuning) {
+        return PCTRL_RESULT_BUSY;
+    }
+    if (data[1] > (uint8_t)PLATFORM_TUNE_RULE_ZN_PID) {
+        return PCTRL_RESULT_BAD_PARAM;
+    }
+
+    // 继电器上下限须在上位机给定的开度范围内，否则振荡幅值被限幅，Ku偏大
+    config.bias = (data[2] == PCTRL_TUNE_BIAS_CURRENT) ? g_pctrl_duty : (float)data[2];
+    config.amplitude = (float)data[3] * 0.1f;
+    if (config.bias - config.amplitude < g_pctrl_cmd.duty_min ||
+        config.bias + config.amplitude > g_pctrl_cmd.duty_max) {
+        return PCTRL_RESULT_BAD_PARAM;
+    }
+
+    g_pctrl_tune_setpoint = g_pctrl_cmd.setpoint_mpa;
+    config.setpoint = -g_pctrl_tune_setpoint;
+    config.hysteresis = (float)data[4] * 0.01f;
+    config.max_deviation = (data[5] != 0U) ? (float)data[5] * 0.1f : PCTRL_TUNE_DEFAULT_DEVIATION;
+    config.dt = (float)PCTRL_PERIOD_US * 1.0e-6f;
+    config.timeout_samples = ((data[6] != 0U) ? (uint32_t)data[6] : PCTRL_TUNE_DEFAULT_TIMEOUT_S) *
+                             (1000000U / PCTRL_PERIOD_US);
+    config.settle_cycles = PCTRL_TUNE_SETTLE_CYCLES;
+    config.measure_cycles = PCTRL_TUNE_MEASURE_CYCLES;
+    config.rule = (platform_tune_rule_t)data[1];
+
+    // g_pctrl_tuning置位前采样中断不访问g_pctrl_tune
+    if (PlatformRelayTune_Start(&g_pctrl_tune, &config) != PLATFORM_STATUS_OK) {
+        return PCTRL_RESULT_BAD_PARAM;
+    }
+    g_pctrl_tuning = true;
+    return PCTRL_RESULT_OK;
+}
+
+/*!
+ * @brief 将整定结果写入增益调度表节点
+ */
+static pressure_control_result_t PressureControl_StoreTune(const uint8_t *data)
+{
+    if (g_pctrl_tuning) {
+        return PCTRL_RESULT_BUSY;
+    }
+    if (g_pctrl_tune.state != PLATFORM_TUNE_DONE) {
+        return PCTRL_RESULT_NO_RESULT;
+    }
+    if (CalibStore_SetGainScheduleEntry(data[1], data[2], &g_pctrl_tune.gains,
+                                        Sensor_GetOilTemperature(), g_pctrl_tune_setpoint) != CALIB_STATUS_OK) {
+        return PCTRL_RESULT_BAD_PARAM;
+    }
+    return PCTRL_RESULT_OK;
+}
+
+bool PressureControl_HandleCanFrame(const uint8_t *data, uint8_t length)
+{
+    if (data == NULL || length < 1U) {
+        return false;
+    }
+
+    uint8_t cmd = data[0];
+
+    switch (cmd) {
+        case PCTRL_CMD_TUNE_ABORT:
+        case PCTRL_CMD_TUNE_START:
+        case PCTRL_CMD_TUNE_STATUS:
+        case PCTRL_CMD_TUNE_STORE:
+            // 上一条未处理完时丢弃（上位机超时重发）
+            if (g_pctrl_pending_cmd == PCTRL_CMD_NONE) {
+                memset(g_pctrl_pending_data, 0, sizeof(g_pctrl_pending_data));
+                memcpy(g_pctrl_pending_data, data, (length > CAN_MSG_DATA_MAX_SIZE) ? CAN_MSG_DATA_MAX_SIZE : length);
+                g_pctrl_pending_cmd = cmd;
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/*!
+ * @brief 执行待处理的自整定命令，发送试验结束通知
+ */
+static void PressureControl_ServiceCan(void)
+{
+    uint8_t cmd = g_pctrl_pending_cmd;
+    pressure_control_result_t result = PCTRL_RESULT_OK;
+
+    switch (cmd) {
+        case PCTRL_CMD_TUNE_START:
+            result = PressureControl_StartTune(g_pctrl_pending_data);
+            break;
+        case PCTRL_CMD_TUNE_STORE:
+            result = PressureControl_StoreTune(g_pctrl_pending_data);
+            break;
+        case PCTRL_CMD_TUNE_ABORT:
+            // 先请求无扰切换再清除试验标志：此后采样中断走PID分支，不再访问g_pctrl_tune
+            if (g_pctrl_tuning) {
+                g_pctrl_transfer = true;
+                g_pctrl_tuning = false;
+                PlatformRelayTune_Abort(&g_pctrl_tune);
+            }
+            break;
+        default:
+            break;
+    }
+    if (cmd != PCTRL_CMD_NONE) {
+        PressureControl_SendAck(cmd, result);
+        g_pctrl_pending_cmd = PCTRL_CMD_NONE;
+    }
+
+    if (g_pctrl_tune_event) {
+        g_pctrl_tune_event = false;
+        PressureControl_SendAck(PCTRL_CMD_TUNE_STATUS,
+                                (g_pctrl_tune.state == PLATFORM_TUNE_DONE) ? PCTRL_RESULT_OK : PCTRL_RESULT_NO_RESULT);
+    }
+}
+
+/* ==================== 后台任务 ==================== */
+
+void PressureControl_Task(bool system_enabled)
+{
+    PressureControl_ServiceCan();
+
+    if (!system_enabled) {
+        if (g_pctrl_state != PCTRL_STATE_IDLE) {
+            PressureControl_Stop();
+        }
+        return;
+    }
+
+    if (g_pctrl_state == PCTRL_STATE_IDLE) {
+        return;
+    }
+    PressureControl_UpdateSchedule();
+
+    if (g_pctrl_state != PCTRL_STATE_WAIT_STREAM || !g_pctrl_requested) {
+        return;
+    }
+
+    // 首个采样按当前开度反推积分项，进入闭环时开度不跳变
+    PlatformPIDF_Reset(&g_pctrl_pid);
+    g_pctrl_transfer = true;
+    g_pctrl_cycles = 0U;
+
+    // 采集流被录波/频谱分析占用时保持等待，下个任务周期重试
+    g_pctrl_state = PCTRL_STATE_RUNNING;
+    if (!Sensor_StartPressureStream(PCTRL_PERIOD_US, PressureControl_OnSample)) {
+        g_pctrl_state = PCTRL_STATE_WAIT_STREAM;
+    } else if (!g_pctrl_requested) {
+        // 启动过程中上位机已撤销闭环（状态已由PressureControl_Stop置为空闲）
+        g_pctrl_state = PCTRL_STATE_IDLE;
+        Sensor_StopPressureStream();
+    }
+}
+
+bool PressureControl_IsRunning(void)
+{
+    return g_pctrl_state == PCTRL_STATE_RUNNING;
+}
+
+void PressureControl_GetStatus(pressure_control_status_t *status)
+{
+    if (status == NULL) {
+        return;
+    }
+    status->state = g_pctrl_state;
+    status->setpoint_mpa = g_pctrl_cmd.setpoint_mpa;
+    status->pressure_mpa = g_pctrl_pressure;
+    status->duty = g_pctrl_duty;
+    status->duty_min = g_pctrl_cmd.duty_min;
+    status->duty_max = g_pctrl_cmd.duty_max;
+    status->cycles = g_pctrl_cycles;
+    status->kp = g_pctrl_config.kp;
+    status->ki = g_pctrl_config.ki;
+    status->feedforward = g_pctrl_feedforward;
+    status->tune_state = g_pctrl_tune.state;
+}
+
+const platform_relay_tune_t* PressureControl_GetTuneResult(void)
+{
+    return &g_pctrl_tune;
+}
@@ -8,6 +8,7 @@
  */
 
 #include "pt1000.h"
+#include <stddef.h>
 
 /* ==========================================  Variables  =========================================== */
 
@@ -143,38 +144,48 @@ float pt1000_get_temp_float(float resistance) {
 }
 
 /**
- * @brief 电压转PT1000电阻值（基于实测标定数据）
- * 使用14个实测标定点进行分段线性插值
- * 与bldc项目保持一致的实现
+ * @brief 出厂默认电压-电阻标定点（基于电阻箱实测，14个标定点，电压从小到大排序）- -40°C到90°C量程
+ * 作为标定存储区(calib_store)的默认值，实际运行使用DFlash中按单板标定的数据
  */
-float pt1000_voltage_to_resistance(float voltage)
-{
-    // 实测电压-电阻标定数据表（基于电阻箱实测，14个标定点）
-    typedef struct {
-        float voltage;    // 测得的电压值 (V)
-        float resistance; // 对应的电阻值 (Ω)
-        float temperature; // 对应的温度值 (°C) - 仅用于注释
-    } voltage_resistance_point_t;
+static const pt1000_calib_point_t PT1000_DEFAULT_CALIB_POINTS[] = {
+    {0.224f,  845.0f},  // -40°C 基于实测平均值
+    {0.552f,  884.5f},  // -30°C 基于实测平均值
+    {0.887f,  923.5f},  // -20°C 基于实测平均值
+    {1.210f,  963.0f},  // -10°C 基于实测平均值
+    {1.523f,  1002.0f}, //   0°C 基于实测平均值
+    {1.838f,  1040.5f}, //  10°C 基于实测平均值
+    {2.159f,  1080.0f}, //  20°C 基于实测平均值
+    {2.372f,  1113.0f}, //  30°C 基于实测平均值
+    {2.455f,  1145.0f}, //  40°C 基于实测平均值
+    {2.547f,  1186.0f}, //  50°C 基于实测平均值
+    {2.657f,  1229.0f}, //  60°C 基于实测平均值
+    {2.752f,  1263.0f}, //  70°C 基于实测平均值
+    {2.867f,  1303.0f}, //  80°C 基于实测平均值
+    {2.977f,  1341.0f}, //  90°C 基于实测平均值
+};
 
-    // 基于电阻箱实测的标定点（电压从小到大排序）- -40°C到90°C量程
-    const voltage_resistance_point_t calib_points[] = {
-        {0.224f,  845.0f,  -40.0f}, // 基于实测平均值
-        {0.552f,  884.5f,  -30.0f}, // 基于实测平均值
-        {0.887f,  923.5f,  -20.0f}, // 基于实测平均值
-        {1.210f,  963.0f,  -10.0f}, // 基于实测平均值
-        {1.523f,  1002.0f,   0.0f}, // 基于实测平均值
-        {1.838f,  1040.5f,  10.0f}, // 基于实测平均值
-        {2.159f,  1080.0f,  20.0f}, // 基于实测平均值
-        {2.372f,  1113.0f,  30.0f}, // 基于实测平均值
-        {2.455f,  1145.0f,  40.0f}, // 基于实测平均值
-        {2.547f,  1186.0f,  50.0f}, // 基于实测平均值
-        {2.657f,  1229.0f,  60.0f}, // 基于实测平均值
-        {2.752f,  1263.0f,  70.0f}, // 基于实测平均值
-        {2.867f,  1303.0f,  80.0f}, // 基于实测平均值
-        {2.977f,  1341.0f,  90.0f}, // 基于实测平均值
-    };
+/**
+ * @brief 获取出厂默认电压-电阻标定点
+ * @param count 输出标定点数量
+ * @return 标定点数组指针
+ */
+const pt1000_calib_point_t* pt1000_get_default_calib_points(uint8_t *count)
+{
+    if (count != NULL) {
+        *count = (uint8_t)(sizeof(PT1000_DEFAULT_CALIB_POINTS) / sizeof(PT1000_DEFAULT_CALIB_POINTS[0]));
+    }
+    return PT1000_DEFAULT_CALIB_POINTS;
+}
 
-    const int num_points = sizeof(calib_points) / sizeof(calib_points[0]);
+/**
+ * @brief 电压转PT1000电阻值（指定标定点表）
+ * 分段线性插值，两端按首末段斜率外推并限制在700~2000Ω
+ */
+float pt1000_voltage_to_resistance_table(float voltage, const pt1000_calib_point_t *calib_points, uint8_t num_points)
+{
+    if (calib_points == NULL || num_points < 2U) {
+        return PT1000_RESISTANCE_0C_OHM;
+    }
 
     // 边界处理 - 低于最低标定点
     if (voltage <= calib_points[0].voltage) {
@@ -183,7 +194,7 @@ float pt1000_voltage_to_resistance(float voltage)
                      (calib_points[1].voltage - calib_points[0].voltage);
         float resistance = calib_points[0].resistance + slope * (voltage - calib_points[0].voltage);
         // 确保电阻值在合理范围内，对应温度约为-60°C
-        return (resistance < 700.0f) ? 700.0f : resistance;
+        return (resistance < PT1000_RESISTANCE_MIN_OHM) ? PT1000_RESISTANCE_MIN_OHM : resistance;
     }
     
     // 边界处理 - 高于最高标定点  
@@ -192,11 +203,11 @@ float pt1000_voltage_to_resistance(float voltage)
         float slope = (calib_points[num_points-1].resistance - calib_points[num_points-2].resistance) /
                      (calib_points[num_points-1].voltage - calib_points[num_points-2].voltage);
         float resistance = calib_points[num_points-1].resistance + slope * (voltage - calib_points[num_points-1].voltage);
-        return (resistance > 2000.0f) ? 2000.0f : resistance; // 最大电阻限制
+        return (resistance > PT1000_RESISTANCE_MAX_OHM) ? PT1000_RESISTANCE_MAX_OHM : resistance; // 最大电阻限制
     }
     
     // 在标定范围内，找到对应的区间进行线性插值
-    for (int i = 0; i < num_points - 1; i++) {
+    for (uint8_t i = 0; i < num_points - 1U; i++) {
         if (voltage >= calib_points[i].voltage && voltage <= calib_points[i+1].voltage) {
             // 线性插值计算电阻值
             float slope = (calib_points[i+1].resistance - calib_points[i].resistance) /
@@ -206,7 +217,18 @@ float pt1000_voltage_to_resistance(float voltage)
     }
     
     // 理论上不应该到达这里，返回默认值
-    return 1000.0f; // 0°C对应的标准电阻值
+    return PT1000_RESISTANCE_0C_OHM; // 0°C对应的标准电阻值
+}
+
+/**
+ * @brief 电压转PT1000电阻值（基于出厂默认标定数据）
+ * 使用14个实测标定点进行分段线性插值
+ * 与bldc项目保持一致的实现
+ */
+float pt1000_voltage_to_resistance(float voltage)
+{
+    return pt1000_voltage_to_resistance_table(voltage, PT1000_DEFAULT_CALIB_POINTS,
+        (uint8_t)(sizeof(PT1000_DEFAULT_CALIB_POINTS) / sizeof(PT1000_DEFAULT_CALIB_POINTS[0])));
 }
 
 /**
@@ -9,12 +9,19 @@
 
 #include "sensor.h"
 #include "pt1000.h"
+#include "calib_store.h"
 #include "adc_drv.h"
 #include "gpio_drv.h"
 #include "ckgen_drv.h"
+#include "timer_drv.h"
 #include "osif.h"
 #include "unified_filter.h"
+#if HP_PLANT_SIM
+#include "plant_model.h"
+#include "valve_control.h"
+#endif
 #include <string.h>
+#include <stdio.h>
 
 /* ==========================================  Variables  =========================================== */
 
@@ -27,9 +34,39 @@ static adc_chan_config_t adcChanConfig;
 // 传感器监控数据
 static sensor_monitor_t g_sensor_monitor;
 
-// 温度校准偏移量
-static float g_oil_temp_calibration_offset = OIL_TEMP_CALIBRATION_OFFSET;
-static float g_lng_temp_calibration_offset = LNG_TEMP_CALIBRATION_OFFSET;
+// 原始信号合理性检测（按ADC通道号索引）
+static sensor_plausibility_config_t g_plaus_config[ADC_CHANNEL_COUNT];
+static sensor_plausibility_state_t g_plaus_state[ADC_CHANNEL_COUNT];
+static uint32_t g_plaus_period_us = SENSOR_PLAUS_DEFAULT_PERIOD_US;
+
+// 压力自动调零（按压力标定通道索引）
+static sensor_autozero_state_t g_autozero_state[CALIB_PRESSURE_COUNT];
+static bool g_autozero_idle = false;
+static uint32_t g_autozero_idle_since = 0U;
+
+// 自适应采集速率
+static sensor_rate_config_t g_rate_config;
+static sensor_rate_state_t g_rate_state;
+
+// 压力高速采集流（定时器中断启动ADC1注入组，未启动时无任何开销）
+static sensor_stream_callback_t g_stream_callback = NULL; // 占用者回调，后台运行时为NULL
+static sensor_stream_observer_t g_stream_observer = NULL;  // 旁路监听（不占用采集流）
+static volatile bool g_stream_running = false;
+static bool g_stream_restarted = false;         // 下一个送出的采样是启动后的首个采样
+static bool g_stream_primed = false;            // 已启动过一次注入转换，可读取结果
+static bool g_stream_timer_ready = false;
+static uint32_t g_stream_period_us = 0U;
+static volatile uint32_t g_stream_overruns = 0U; // 定时到达时上次转换未完成的次数
+
+#if HP_PLANT_SIM
+// 液压对象模型：采集流运行时由采样中断推进，否则由监控任务按流逝时间推进
+static plant_model_t g_plant;
+static uint32_t g_plant_time_ms = 0U;
+static uint16_t g_plant_code_min[ADC_CHANNEL_COUNT]; // 换算单调区间（两端为限幅/回退平台）
+static uint16_t g_plant_code_max[ADC_CHANNEL_COUNT];
+static bool g_plant_rising[ADC_CHANNEL_COUNT];
+#define SENSOR_STREAM_IRQ                 ((IRQn_Type)((uint32_t)TIMER_CHANNEL0_IRQn + SENSOR_STREAM_TIMER_CHANNEL))
+#endif
 
 // 滤波缓冲区
 static float g_filter_buffer[ADC_CHANNEL_COUNT][MONITOR_FILTER_SIZE];
@@ -37,11 +74,110 @@ static uint8_t g_filter_index[ADC_CHANNEL_COUNT] = {0};
 
 /* ==========================================  Functions  =========================================== */
 
+#if HP_PLANT_SIM
+/* ==================== 液压对象模型仿真 ==================== */
+
+static float Sensor_PlantConvert(uint8_t channel, uint16_t code)
+{
+    switch (channel) {
+        case ADC_CHANNEL_OIL_TEMP:     return Sensor_ADCToOilTemperature(code);
+        case ADC_CHANNEL_LNG_TEMP:     return Sensor_ADCToLNGTemperature(code);
+        case ADC_CHANNEL_OIL_PRESSURE: return Sensor_ADCToOilPressure(code);
+        default:                       return Sensor_ADCToLNGPressure(code);
+    }
+}
+
+/* 找出各通道换算的单调区间，之后按二分反求码值（使用上电时的标定，标定更新后需复位） */
+static void Sensor_PlantInit(void)
+{
+    plant_model_params_t params;
+    PlantModel_DefaultParams(&params);
+    (void)PlantModel_Init(&g_plant, &params);
+    g_plant_time_ms = OSIF_GetMilliseconds();
+
+    for (uint8_t ch = 0; ch < ADC_CHANNEL_COUNT; ch++) {
+        uint16_t lo = 0U;
+        uint16_t hi = (uint16_t)ADC_MAX_VALUE;
+        float v_lo = Sensor_PlantConvert(ch, lo);
+        float v_hi = Sensor_PlantConvert(ch, hi);
+        while (lo < hi && Sensor_PlantConvert(ch, (uint16_t)(lo + 1U)) == v_lo) lo++;
+        while (hi > lo && Sensor_PlantConvert(ch, (uint16_t)(hi - 1U)) == v_hi) hi--;
+        g_plant_code_min[ch] = lo;
+        g_plant_code_max[ch] = hi;
+        g_plant_rising[ch] = (v_hi >= v_lo);
+    }
+}
+
+/* 物理量→码值：单调区间内二分 */
+static uint16_t Sensor_PlantToCode(uint8_t channel, float value)
+{
+    uint16_t lo = g_plant_code_min[channel];
+    uint16_t hi = g_plant_code_max[channel];
+    bool rising = g_plant_rising[channel];
+
+    while (lo < hi) {
+        uint16_t mid = (uint16_t)((lo + hi) >> 1);
+        if ((Sensor_PlantConvert(channel, mid) < value) == rising) {
+            lo = (uint16_t)(mid + 1U);
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* 泵由发动机驱动，视为持续运行；阀门状态取阀门模块当前输出 */
+static void Sensor_PlantStep(float dt)
+{
+    plant_model_inputs_t inputs;
+    inputs.pump_speed = 1.0f;
+    inputs.bypass_duty = ValveControl_GetBypassValveDuty();
+    inputs.directional_valve = (ValveControl_GetDirectionalValveState() == VALVE_STATE_ON);
+    inputs.cooler = (ValveControl_GetCoolerState() == VALVE_STATE_ON);
+    PlantModel_Step(&g_plant, &inputs, dt);
+}
+
+plant_model_t* Sensor_GetPlantModel(void)
+{
+    return &g_plant;
+}
+
+static void Sensor_PlantSample(uint16_t raw_values[ADC_CHANNEL_COUNT])
+{
+    uint32_t now = OSIF_GetMilliseconds();
+    uint32_t elapsed = now - g_plant_time_ms;
+
+    // 采集流运行时由采样中断推进模型；判断与推进期间屏蔽采集流中断，两者不会同时推进模型
+    // 结束后恢复进入前的使能状态，未使能时不打开
+    if (elapsed > HP_PLANT_SIM_MAX_CATCHUP_MS) {
+        elapsed = HP_PLANT_SIM_MAX_CATCHUP_MS;
+    }
+    bool irq_enabled = (NVIC_GetEnableIRQ(SENSOR_STREAM_IRQ) != 0U);
+    NVIC_DisableIRQ(SENSOR_STREAM_IRQ);
+    if (!g_stream_running && elapsed > 0U) {
+        Sensor_PlantStep((float)elapsed * 0.001f);
+    }
+    if (irq_enabled) {
+        NVIC_EnableIRQ(SENSOR_STREAM_IRQ);
+    }
+    g_plant_time_ms = now;
+
+    raw_values[ADC_CHANNEL_OIL_TEMP] = Sensor_PlantToCode(ADC_CHANNEL_OIL_TEMP, g_plant.oil_temp_c);
+    raw_values[ADC_CHANNEL_LNG_TEMP] = Sensor_PlantToCode(ADC_CHANNEL_LNG_TEMP, g_plant.params.lng_temp_c);
+    raw_values[ADC_CHANNEL_OIL_PRESSURE] = Sensor_PlantToCode(ADC_CHANNEL_OIL_PRESSURE, g_plant.oil_pressure_mpa);
+    raw_values[ADC_CHANNEL_LNG_PRESSURE] = Sensor_PlantToCode(ADC_CHANNEL_LNG_PRESSURE, g_plant.lng_pressure_mpa);
+}
+#endif
+
 // 基础ADC功能
 void Sensor_Init(void) {
+    CalibStore_Init();     // 加载单板标定并编译查找表
     Sensor_InitADC();
     Sensor_InitMonitor();
     UnifiedFilter_Init();  // 初始化统一滤波管理器
+#if HP_PLANT_SIM
+    Sensor_PlantInit();
+#endif
 }
 
 void Sensor_InitADC(void) {
@@ -116,14 +252,14 @@ void Sensor_InitADC(void) {
     adcConfig.injectTrigger = ADC_TRIGGER_INTERNAL;
     adcConfig.dmaEnable = false;
     adcConfig.voltageRef = ADC_VOLTAGEREF_VREF;
-    adcConfig.scanModeEn = false;  // 单通道模式
+    adcConfig.scanModeEn = true;   // 注入组扫描两个压力通道；规则组序列长度为1，仍为单通道轮询
     adcConfig.continuousModeEn = false;
     adcConfig.regularDiscontinuousModeEn = false;
     adcConfig.injectDiscontinuousModeEn = false;
     adcConfig.injectAutoModeEn = false;
     adcConfig.intervalModeEn = false;
     adcConfig.regularSequenceLength = 1;
-    adcConfig.injectSequenceLength = 0;
+    adcConfig.injectSequenceLength = 2;  // ISEQ_0油压、ISEQ_1 LNG压力，供高速采集流使用
     adcConfig.callback = NULL;
     adcConfig.parameter = NULL;
     adcConfig.powerEn = true;
@@ -181,9 +317,173 @@ uint16_t Sensor_GetADCValue(uint8_t channel) {
 }
 
 void Sensor_GetAllADCValues(uint16_t raw_values[ADC_CHANNEL_COUNT]) {
+#if HP_PLANT_SIM
+    Sensor_PlantSample(raw_values);
+#else
     for (uint8_t i = 0; i < ADC_CHANNEL_COUNT; i++) {
         raw_values[i] = Sensor_GetADCValue(i);
     }
+#endif
+}
+
+float Sensor_GetAveragedVoltage(uint8_t channel) {
+    if (channel >= ADC_CHANNEL_COUNT) {
+        return 0.0f;
+    }
+    // 平均码值为Q3（码值×8）
+    return Sensor_ConvertAdcToVoltage(UnifiedFilter_GetRawMeanQ3(channel)) * 0.125f;
+}
+
+// 压力高速采集流
+static void Sensor_StreamDeliver(uint16_t oil_raw, uint16_t lng_raw)
+{
+    uint32_t period_us = g_stream_period_us;   // 占用者回调中可能停止采集流
+    bool restarted = g_stream_restarted;
+
+    g_stream_restarted = false;
+    if (g_stream_callback != NULL) {
+        g_stream_callback(oil_raw, lng_raw);
+    }
+    if (g_stream_observer != NULL) {
+        g_stream_observer(oil_raw, period_us, restarted);
+    }
+}
+
+static void Sensor_StreamTimerCallback(void *device, uint32_t wpara, uint32_t lpara)
+{
+    (void)device;
+    (void)wpara;
+    (void)lpara;
+
+#if HP_PLANT_SIM
+    // 仿真：定时器周期推进模型，码值由模型输出反求
+    Sensor_PlantStep((float)g_stream_period_us * 1.0e-6f);
+    Sensor_StreamDeliver(Sensor_PlantToCode(ADC_CHANNEL_OIL_PRESSURE, g_plant.oil_pressure_mpa),
+                         Sensor_PlantToCode(ADC_CHANNEL_LNG_PRESSURE, g_plant.lng_pressure_mpa));
+#else
+    // 读取上一周期启动的注入组转换结果（采样周期远大于转换时间，正常时已完成）
+    if (g_stream_primed) {
+        if (ADC_DRV_GetConvCompleteFlag(1U, ADC_ISEQ_1)) {
+            uint16_t oil_raw = 0U;
+            uint16_t lng_raw = 0U;
+            ADC_DRV_GetSeqResult(1U, ADC_ISEQ_0, &oil_raw);
+            ADC_DRV_GetSeqResult(1U, ADC_ISEQ_1, &lng_raw);
+            ADC_DRV_ClearConvCompleteFlag(1U, ADC_ISEQ_0);
+            ADC_DRV_ClearConvCompleteFlag(1U, ADC_ISEQ_1);
+            Sensor_StreamDeliver(oil_raw, lng_raw);
+        } else {
+            g_stream_overruns++;
+        }
+    }
+
+    // 回调中可能已停止采集
+    if (g_stream_running) {
+        ADC_DRV_SoftwareStartInjectConvert(1U);
+        g_stream_primed = true;
+    }
+#endif
+}
+
+static bool Sensor_StreamStart(uint32_t period_us, sensor_stream_callback_t callback)
+{
+    // 注入组通道：ISEQ_0油压、ISEQ_1 LNG压力，采样时间与规则组一致
+    adc_chan_config_t chan_config;
+    ADC_DRV_InitChanStruct(&chan_config);
+    chan_config.spt = ADC_SPT_CLK_23;
+    chan_config.interruptEn = false;
+    chan_config.channel = (adc_inputchannel_t)ADC_CHANNEL_OIL_PRESSURE;
+    ADC_DRV_ConfigChan(1U, ADC_ISEQ_0, &chan_config);
+    chan_config.channel = (adc_inputchannel_t)ADC_CHANNEL_LNG_PRESSURE;
+    ADC_DRV_ConfigChan(1U, ADC_ISEQ_1, &chan_config);
+    ADC_DRV_ClearConvCompleteFlag(1U, ADC_ISEQ_0);
+    ADC_DRV_ClearConvCompleteFlag(1U, ADC_ISEQ_1);
+
+    if (!g_stream_timer_ready) {
+        TIMER_DRV_Init(SENSOR_STREAM_TIMER_INSTANCE, false);
+        g_stream_timer_ready = true;
+    }
+
+    timer_user_channel_config_t timer_config;
+    memset(&timer_config, 0, sizeof(timer_config));
+    TIMER_DRV_GetDefaultChanConfig(&timer_config);
+    timer_config.timerMode = TIMER_PERIODIC_COUNTER;
+    timer_config.periodUnits = TIMER_PERIOD_UNITS_MICROSECONDS;
+    timer_config.period = period_us;
+    timer_config.triggerSource = TIMER_TRIGGER_SOURCE_INTERNAL;
+    timer_config.chainChannel = false;
+    timer_config.isInterruptEnabled = true;
+    timer_config.callback = Sensor_StreamTimerCallback;
+
+    g_stream_callback = callback;
+    g_stream_primed = false;
+    g_stream_overruns = 0U;
+    if (TIMER_DRV_InitChannel(SENSOR_STREAM_TIMER_INSTANCE, SENSOR_STREAM_TIMER_CHANNEL, &timer_config) != STATUS_SUCCESS) {
+        g_stream_callback = NULL;
+        return false;
+    }
+
+    g_stream_period_us = period_us;
+    g_stream_restarted = true;
+    g_stream_running = true;
+    TIMER_DRV_StartChannels(SENSOR_STREAM_TIMER_INSTANCE, 1UL << SENSOR_STREAM_TIMER_CHANNEL);
+    return true;
+}
+
+bool Sensor_StartPressureStream(uint32_t period_us, sensor_stream_callback_t callback)
+{
+    if (callback == NULL || period_us < SENSOR_STREAM_MIN_PERIOD_US ||
+        (g_stream_running && g_stream_callback != NULL)) {
+        return false;
+    }
+    // 后台运行（只有旁路监听）时直接让出
+    Sensor_StopPressureStream();
+    return Sensor_StreamStart(period_us, callback);
+}
+
+bool Sensor_StartBackgroundPressureStream(uint32_t period_us)
+{
+    if (period_us < SENSOR_STREAM_MIN_PERIOD_US || g_stream_running) {
+        return false;
+    }
+    return Sensor_StreamStart(period_us, NULL);
+}
+
+void Sensor_StopBackgroundPressureStream(void)
+{
+    if (g_stream_running && g_stream_callback == NULL) {
+        Sensor_StopPressureStream();
+    }
+}
+
+void Sensor_SetPressureStreamObserver(sensor_stream_observer_t observer)
+{
+    g_stream_observer = observer;
+}
+
+void Sensor_StopPressureStream(void)
+{
+    if (!g_stream_running) {
+        return;
+    }
+    // 可在采集回调（定时器中断）中调用
+    TIMER_DRV_StopChannels(SENSOR_STREAM_TIMER_INSTANCE, 1UL << SENSOR_STREAM_TIMER_CHANNEL);
+    g_stream_running = false;
+    g_stream_primed = false;
+}
+
+bool Sensor_IsPressureStreamRunning(void)
+{
+    return g_stream_running;
+}
+
+uint32_t Sensor_GetPressureStreamPeriod(void)
+{
+    return g_stream_running ? g_stream_period_us : 0U;
+}
+
+uint32_t Sensor_GetPressureStreamOverruns(void)
+{
+    return g_stream_overruns;
 }
 
 // 数据转换功能
@@ -212,107 +512,14 @@ float Sensor_ConvertVoltageToPressure(float voltage)
     return pressure;
 }
 
-/**
- * @brief 电压转换为油压（4-20mA对应0.8-4V，对应0-40MPa）
- * @param voltage 电压值 (V)
- * @return 油压 (MPa)
- */
-static float Voltage_To_Oil_Pressure(float voltage)
-{
-    // 4-20mA电流信号转换为压力
-    // 4mA对应0.8V，20mA对应4V
-    // 4mA对应0MPa，20mA对应40MPa
-    // 线性关系：P = (V - 0.8) * 40.0 / (4.0 - 0.8) = (V - 0.8) * 12.5
-    
-    // 检查电压是否在合理范围内
-    if (voltage < 0.0f) {
-        return 0.0f; // 电压过低，返回0MPa
-    }
-    
-    if (voltage < 0.8f) {
-        // 电压低于0.8V，可能是传感器未连接或故障
-        return 0.0f;
-    }
-    
-    if (voltage > 4.0f) {
-        // 电压超过4V，可能是传感器故障或短路
-        return 40.0f; // 返回最大压力值
-    }
-    
-    float pressure = (voltage - 0.8f) * 12.5f;
-    
-    if (pressure < 0.0f) pressure = 0.0f;
-    if (pressure > 40.0f) pressure = 40.0f;
-    
-    return pressure;
-}
-
-/**
- * @brief 电压转换为LNG压力（4-20mA对应0.8-4V，对应0-35MPa）
- * @param voltage 电压值 (V)
- * @return LNG压力 (MPa)
- */
-static float Voltage_To_LNG_Pressure(float voltage)
-{
-    // 4-20mA电流信号转换为压力
-    // 4mA对应0.8V，20mA对应4V
-    // 4mA对应0MPa，20mA对应35MPa
-    // 线性关系：P = (V - 0.8) * 35.0 / (4.0 - 0.8) = (V - 0.8) * 10.9375
-    
-    // 检查电压是否在合理范围内
-    if (voltage < 0.0f) {
-        return 0.0f; // 电压过低，返回0MPa
-    }
-    
-    if (voltage < 0.8f) {
-        // 电压低于0.8V，可能是传感器未连接或故障
-        return 0.0f;
-    }
-    
-    if (voltage > 4.0f) {
-        // 电压超过4V，可能是传感器故障或短路
-        return 35.0f; // 返回最大压力值
-    }
-    
-    float pressure = (voltage - 0.8f) * 10.9375f;
-    
-    if (pressure < 0.0f) pressure = 0.0f;
-    if (pressure > 35.0f) pressure = 35.0f;
-    
-    return pressure;
-}
+/* 压力/温度换算由标定存储模块的查找表完成，标定参数见calib_store.c（出厂默认值与原固定公式一致） */
 
 float Sensor_ADCToOilPressure(uint16_t adc_raw) {
-    float voltage = Sensor_ConvertAdcToVoltage(adc_raw);
-    return Voltage_To_Oil_Pressure(voltage);
+    return CalibStore_ConvertPressure(CALIB_PRESSURE_OIL, adc_raw);
 }
 
 float Sensor_ADCToLNGPressure(uint16_t adc_raw) {
-    float voltage = Sensor_ConvertAdcToVoltage(adc_raw);
-    return Voltage_To_LNG_Pressure(voltage);
-}
-
-/**
- * @brief 通用温度转换函数（使用PT1000标定）
- * @param voltage 电压值 (V)
- * @return 温度 (°C)
- */
-static float Voltage_To_Temperature_Common(float voltage)
-{
-    // 使用PT1000标定算法计算温度
-    float temperature = pt1000_voltage_to_temp_float(voltage);
-    
-    // 如果标定失败，返回默认值
-    if (temperature == PT1000_RESISTANCE_OUT_OF_RANGE_F) {
-        return 25.0f; // 默认25°C
-    }
-    
-    // 限制最低温度为-40°C
-    if (temperature < -40.0f) {
-        temperature = -40.0f;
-    }
-    
-    return temperature;
+    return CalibStore_ConvertPressure(CALIB_PRESSURE_LNG, adc_raw);
 }
 
 /**
@@ -321,9 +528,7 @@ static float Voltage_To_Temperature_Common(float voltage)
  * @return 油温 (°C)
  */
 float Sensor_ADCToOilTemperature(uint16_t adc_raw) {
-    float voltage = Sensor_ConvertAdcToVoltage(adc_raw);
-    float temperature = Voltage_To_Temperature_Common(voltage);
-    return temperature + g_oil_temp_calibration_offset;
+    return CalibStore_ConvertTemperature(CALIB_TEMP_OIL, adc_raw);
 }
 
 /**
@@ -332,35 +537,34 @@ float Sensor_ADCToOilTemperature(uint16_t adc_raw) {
  * @return LNG温度 (°C)
  */
 float Sensor_ADCToLNGTemperature(uint16_t adc_raw) {
-    float voltage = Sensor_ConvertAdcToVoltage(adc_raw);
-    float temperature = Voltage_To_Temperature_Common(voltage);
-    return temperature + g_lng_temp_calibration_offset;
+    return CalibStore_ConvertTemperature(CALIB_TEMP_LNG, adc_raw);
 }
 
 // 温度校准功能
 float Sensor_GetOilTempCalibrationOffset(void) {
-    return g_oil_temp_calibration_offset;
+    return CalibStore_GetTemperatureOffset(CALIB_TEMP_OIL);
 }
 
 float Sensor_GetLNGTempCalibrationOffset(void) {
-    return g_lng_temp_calibration_offset;
+    return CalibStore_GetTemperatureOffset(CALIB_TEMP_LNG);
 }
 
+// 偏移量写入标定存储，立即生效并延时保存到DFlash
 void Sensor_SetOilTempCalibrationOffset(float offset) {
-    g_oil_temp_calibration_offset = offset;
+    CalibStore_SetTemperatureOffset(CALIB_TEMP_OIL, offset);
 }
 
 void Sensor_SetLNGTempCalibrationOffset(float offset) {
-    g_lng_temp_calibration_offset = offset;
+    CalibStore_SetTemperatureOffset(CALIB_TEMP_LNG, offset);
 }
 
 bool Sensor_ValidateTemperatureCalibration(uint8_t sensor_type) {
     // 验证温度校准精度
     if (sensor_type == 0) { // 油温传感器
-        float offset = g_oil_temp_calibration_offset;
+        float offset = Sensor_GetOilTempCalibrationOffset();
         return (offset >= -10.0f && offset <= 10.0f);
     } else if (sensor_type == 1) { // LNG温度传感器
-        float offset = g_lng_temp_calibration_offset;
+        float offset = Sensor_GetLNGTempCalibrationOffset();
         return (offset >= -10.0f && offset <= 10.0f);
     }
     return false;
@@ -380,6 +584,10 @@ void Sensor_InitMonitor(void) {
     g_sensor_monitor.validity.oil_pressure_valid = true;
     g_sensor_monitor.validity.lng_pressure_valid = true;
     g_sensor_monitor.validity.last_valid_time = 0;
+    
+    Sensor_PlausibilityInit();
+    Sensor_AutoZeroInit();
+    Sensor_RateInit();
 }
 
 void Sensor_UpdateMonitor(void) {
@@ -393,12 +601,18 @@ void Sensor_UpdateMonitor(void) {
     g_sensor_monitor.raw_data.adc_raw[ADC_CHANNEL_OIL_PRESSURE] = adc_raw_values[ADC_CHANNEL_OIL_PRESSURE];
     g_sensor_monitor.raw_data.adc_raw[ADC_CHANNEL_LNG_PRESSURE] = adc_raw_values[ADC_CHANNEL_LNG_PRESSURE];
     
+    // 原始码值合理性检测（断线/短路/卡滞/跳变）
+    Sensor_UpdateValidity(adc_raw_values);
+    
     // 转换为电压值
     g_sensor_monitor.raw_data.voltage[ADC_CHANNEL_OIL_TEMP] = Sensor_ConvertAdcToVoltage(adc_raw_values[ADC_CHANNEL_OIL_TEMP]);
     g_sensor_monitor.raw_data.voltage[ADC_CHANNEL_LNG_TEMP] = Sensor_ConvertAdcToVoltage(adc_raw_values[ADC_CHANNEL_LNG_TEMP]);
     g_sensor_monitor.raw_data.voltage[ADC_CHANNEL_OIL_PRESSURE] = Sensor_ConvertAdcToVoltage(adc_raw_values[ADC_CHANNEL_OIL_PRESSURE]);
     g_sensor_monitor.raw_data.voltage[ADC_CHANNEL_LNG_PRESSURE] = Sensor_ConvertAdcToVoltage(adc_raw_values[ADC_CHANNEL_LNG_PRESSURE]);
     
+    // 原始码值8点平均（四通道打包批量计算），经Sensor_GetAveragedVoltage读取
+    UnifiedFilter_UpdateRawCodes(adc_raw_values);
+    
     // 转换为物理量
     g_sensor_monitor.raw_data.oil_temp_celsius = Sensor_ADCToOilTemperature(adc_raw_values[ADC_CHANNEL_OIL_TEMP]);
     g_sensor_monitor.raw_data.lng_temp_celsius = Sensor_ADCToLNGTemperature(adc_raw_values[ADC_CHANNEL_LNG_TEMP]);
@@ -449,6 +663,16 @@ float Sensor_GetLNGPressure(void) {
     return g_sensor_monitor.filtered_data.lng_pressure_mpa;
 }
 
+bool Sensor_GetPressureEstimate(uint8_t channel, float *pressure_mpa, float *rate_mpa_s) {
+    if (channel == CALIB_PRESSURE_OIL) {
+        return UnifiedFilter_GetPressureEstimate(FILTER_CHANNEL_OIL_PRESSURE, pressure_mpa, rate_mpa_s);
+    }
+    if (channel == CALIB_PRESSURE_LNG) {
+        return UnifiedFilter_GetPressureEstimate(FILTER_CHANNEL_LNG_PRESSURE, pressure_mpa, rate_mpa_s);
+    }
+    return false;
+}
+
 // 已删除：Sensor_NeedCooling() - 控制逻辑，移至PC端
 // 已删除：Sensor_IsLNGPressureInRange() - 控制逻辑，移至PC端
 
@@ -466,6 +690,20 @@ sensor_fault_status_t Sensor_GetFaultStatus(void) {
 void Sensor_FaultDiagnosis(void) {
     g_sensor_monitor.fault_status = SENSOR_FAULT_NONE;
     
+    // 原始信号合理性故障
+    if (!g_plaus_state[ADC_CHANNEL_OIL_TEMP].valid) {
+        g_sensor_monitor.fault_status |= SENSOR_FAULT_OIL_TEMP;
+    }
+    if (!g_plaus_state[ADC_CHANNEL_LNG_TEMP].valid) {
+        g_sensor_monitor.fault_status |= SENSOR_FAULT_LNG_TEMP;
+    }
+    if (!g_plaus_state[ADC_CHANNEL_OIL_PRESSURE].valid) {
+        g_sensor_monitor.fault_status |= SENSOR_FAULT_OIL_PRESSURE;
+    }
+    if (!g_plaus_state[ADC_CHANNEL_LNG_PRESSURE].valid) {
+        g_sensor_monitor.fault_status |= SENSOR_FAULT_LNG_PRESSURE;
+    }
+    
     // 检查油温传感器故障
     if (!Sensor_ValidateValue(g_sensor_monitor.filtered_data.oil_temp_celsius, 
                              SENSOR_VALUE_MIN_VALID, SENSOR_VALUE_MAX_VALID)) {
@@ -494,3 +732,446 @@ void Sensor_FaultDiagnosis(void) {
 bool Sensor_ValidateValue(float value, float min_valid, float max_valid) {
     return (value >= min_valid) && (value <= max_valid);
 }
+
+/* ==================== 原始信号合理性检测 ==================== */
+
+/**
+ * @brief 毫秒时间换算为采样数（至少1个采样，上限65535）
+ */
+static uint16_t Sensor_PlausibilityMsToSamples(uint32_t time_ms)
+{
+    uint32_t samples = (time_ms * 1000U + g_plaus_period_us - 1U) / g_plaus_period_us;
+    if (samples == 0U) samples = 1U;
+    if (samples > 0xFFFFU) samples = 0xFFFFU;
+    return (uint16_t)samples;
+}
+
+/**
+ * @brief 按当前采样周期换算通道检测参数
+ */
+static void Sensor_PlausibilityDerive(uint8_t channel)
+{
+    const sensor_plausibility_config_t *cfg = &g_plaus_config[channel];
+    sensor_plausibility_state_t *st = &g_plaus_state[channel];
+    
+    uint32_t slew = 0U;
+    if (cfg->slew_codes_per_ms > 0U) {
+        slew = (uint32_t)cfg->slew_codes_per_ms * g_plaus_period_us / 1000U + cfg->slew_noise_codes;
+        if (slew > 0xFFFFU) slew = 0xFFFFU;
+    }
+    st->slew_limit = (uint16_t)slew;
+    st->stuck_window = (cfg->stuck_window_ms > 0U) ? Sensor_PlausibilityMsToSamples(cfg->stuck_window_ms) : 0U;
+    st->debounce_set = Sensor_PlausibilityMsToSamples(cfg->debounce_set_ms);
+    st->debounce_clear = Sensor_PlausibilityMsToSamples(cfg->debounce_clear_ms);
+}
+
+/**
+ * @brief 复位通道检测状态（数据视为有效，等待采样确认）
+ */
+static void Sensor_PlausibilityResetState(uint8_t channel)
+{
+    sensor_plausibility_state_t *st = &g_plaus_state[channel];
+    uint32_t events = st->fault_events;
+    
+    memset(st, 0, sizeof(sensor_plausibility_state_t));
+    st->window_min = 0xFFFFU;
+    st->valid = true;
+    st->fault_events = events;
+    Sensor_PlausibilityDerive(channel);
+}
+
+void Sensor_PlausibilityInit(void) {
+    for (uint8_t ch = 0; ch < ADC_CHANNEL_COUNT; ch++) {
+        sensor_plausibility_config_t *cfg = &g_plaus_config[ch];
+        bool is_pressure = (ch == ADC_CHANNEL_OIL_PRESSURE) || (ch == ADC_CHANNEL_LNG_PRESSURE);
+        
+        cfg->code_low = is_pressure ? SENSOR_PLAUS_PRESSURE_CODE_LOW : SENSOR_PLAUS_TEMP_CODE_LOW;
+        cfg->code_high = is_pressure ? SENSOR_PLAUS_PRESSURE_CODE_HIGH : SENSOR_PLAUS_TEMP_CODE_HIGH;
+        cfg->slew_codes_per_ms = is_pressure ? SENSOR_PLAUS_PRESSURE_SLEW_PER_MS : SENSOR_PLAUS_TEMP_SLEW_PER_MS;
+        cfg->slew_noise_codes = SENSOR_PLAUS_SLEW_NOISE_CODES;
+        cfg->stuck_tolerance = is_pressure ? SENSOR_PLAUS_PRESSURE_STUCK_TOLERANCE : SENSOR_PLAUS_TEMP_STUCK_TOLERANCE;
+        cfg->stuck_window_ms = SENSOR_PLAUS_STUCK_WINDOW_MS;
+        cfg->stuck_invalidates = (SENSOR_PLAUS_STUCK_INVALIDATES != 0);
+        cfg->debounce_set_ms = SENSOR_PLAUS_DEBOUNCE_SET_MS;
+        cfg->debounce_clear_ms = SENSOR_PLAUS_DEBOUNCE_CLEAR_MS;
+        cfg->enabled = (SENSOR_PLAUSIBILITY_ENABLE != 0);
+        
+        g_plaus_state[ch].fault_events = 0U;
+        Sensor_PlausibilityResetState(ch);
+    }
+}
+
+void Sensor_SetPlausibilityConfig(uint8_t channel, const sensor_plausibility_config_t *config) {
+    if (channel >= ADC_CHANNEL_COUNT || config == NULL) {
+        return;
+    }
+    g_plaus_config[channel] = *config;
+    Sensor_PlausibilityResetState(channel);
+}
+
+bool Sensor_GetPlausibilityConfig(uint8_t channel, sensor_plausibility_config_t *config) {
+    if (channel >= ADC_CHANNEL_COUNT || config == NULL) {
+        return false;
+    }
+    *config = g_plaus_config[channel];
+    return true;
+}
+
+void Sensor_SetPlausibilitySamplePeriod(uint32_t period_us) {
+    if (period_us == 0U || period_us == g_plaus_period_us) {
+        return;
+    }
+    g_plaus_period_us = period_us;
+    for (uint8_t ch = 0; ch < ADC_CHANNEL_COUNT; ch++) {
+        Sensor_PlausibilityDerive(ch);
+    }
+}
+
+bool Sensor_PlausibilityCheck(uint8_t channel, uint16_t adc_raw) {
+    if (channel >= ADC_CHANNEL_COUNT) {
+        return false;
+    }
+    
+    const sensor_plausibility_config_t *cfg = &g_plaus_config[channel];
+    sensor_plausibility_state_t *st = &g_plaus_state[channel];
+    
+    if (!cfg->enabled) {
+        st->valid = true;
+        return true;
+    }
+    
+    uint8_t violation = SENSOR_PLAUS_OK;
+    
+    // 1. 电压带检测：断线/短路
+    if (adc_raw < cfg->code_low) {
+        violation |= SENSOR_PLAUS_OPEN;
+    } else if (adc_raw > cfg->code_high) {
+        violation |= SENSOR_PLAUS_SHORT;
+    }
+    
+    // 2. 变化率检测：相邻采样差值
+    if (st->slew_limit > 0U && st->has_last) {
+        uint16_t delta = (adc_raw > st->last_code) ? (adc_raw - st->last_code) : (st->last_code - adc_raw);
+        if (delta > st->slew_limit) {
+            violation |= SENSOR_PLAUS_SLEW;
+        }
+    }
+    st->last_code = adc_raw;
+    st->has_last = true;
+    
+    // 3. 卡滞检测：窗口内码值极差，窗口结束时更新判定；默认只作诊断，不参与有效性去抖
+    if (st->stuck_window > 0U) {
+        if (adc_raw < st->window_min) st->window_min = adc_raw;
+        if (adc_raw > st->window_max) st->window_max = adc_raw;
+        if (++st->window_count >= st->stuck_window) {
+            st->stuck = ((uint16_t)(st->window_max - st->window_min) <= cfg->stuck_tolerance);
+            st->window_count = 0U;
+            st->window_min = 0xFFFFU;
+            st->window_max = 0U;
+        }
+        if (st->stuck && cfg->stuck_invalidates) {
+            violation |= SENSOR_PLAUS_STUCK;
+        }
+    }
+    
+    st->violation = violation;
+    
+    // 4. 去抖：连续异常置故障，连续正常清故障
+    if (violation != SENSOR_PLAUS_OK) {
+        st->good_count = 0U;
+        if (st->bad_count < 0xFFFFU) st->bad_count++;
+        if (st->bad_count >= st->debounce_set) {
+            if (st->valid) {
+                st->fault_events++;
+            }
+            st->valid = false;
+            st->faults |= violation;
+        }
+    } else {
+        st->bad_count = 0U;
+        if (st->good_count < 0xFFFFU) st->good_count++;
+        if (!st->valid && st->good_count >= st->debounce_clear) {
+            st->valid = true;
+            st->faults = SENSOR_PLAUS_OK;
+        }
+    }
+    
+    return st->valid;
+}
+
+uint8_t Sensor_GetPlausibilityFaults(uint8_t channel) {
+    if (channel >= ADC_CHANNEL_COUNT) {
+        return SENSOR_PLAUS_OK;
+    }
+    const sensor_plausibility_state_t *st = &g_plaus_state[channel];
+    return (uint8_t)(st->faults | (st->stuck ? SENSOR_PLAUS_STUCK : SENSOR_PLAUS_OK));
+}
+
+const sensor_plausibility_state_t* Sensor_GetPlausibilityState(uint8_t channel) {
+    if (channel >= ADC_CHANNEL_COUNT) {
+        return NULL;
+    }
+    return &g_plaus_state[channel];
+}
+
+void Sensor_UpdateValidity(const uint16_t adc_raw[ADC_CHANNEL_COUNT]) {
+    g_sensor_monitor.validity.oil_temp_valid = Sensor_PlausibilityCheck(ADC_CHANNEL_OIL_TEMP, adc_raw[ADC_CHANNEL_OIL_TEMP]);
+    g_sensor_monitor.validity.lng_temp_valid = Sensor_PlausibilityCheck(ADC_CHANNEL_LNG_TEMP, adc_raw[ADC_CHANNEL_LNG_TEMP]);
+    g_sensor_monitor.validity.oil_pressure_valid = Sensor_PlausibilityCheck(ADC_CHANNEL_OIL_PRESSURE, adc_raw[ADC_CHANNEL_OIL_PRESSURE]);
+    g_sensor_monitor.validity.lng_pressure_valid = Sensor_PlausibilityCheck(ADC_CHANNEL_LNG_PRESSURE, adc_raw[ADC_CHANNEL_LNG_PRESSURE]);
+    
+    if (Sensor_CheckDataValidity()) {
+        g_sensor_monitor.validity.last_valid_time = OSIF_GetMilliseconds();
+    }
+}
+
+// 压力自动调零与零点漂移监测
+static void Sensor_AutoZeroResetWindow(sensor_autozero_state_t *st)
+{
+    st->window_count = 0U;
+    st->window_sum = 0U;
+    st->window_min = 0xFFFFU;
+    st->window_max = 0U;
+}
+
+static float Sensor_AbsFloat(float value)
+{
+    return (value < 0.0f) ? -value : value;
+}
+
+void Sensor_AutoZeroInit(void) {
+    memset(g_autozero_state, 0, sizeof(g_autozero_state));
+    g_autozero_state[CALIB_PRESSURE_OIL].enabled = (SENSOR_AUTOZERO_OIL_ENABLE != 0);
+    g_autozero_state[CALIB_PRESSURE_LNG].enabled = (SENSOR_AUTOZERO_LNG_ENABLE != 0);
+
+    for (uint8_t ch = 0; ch < CALIB_PRESSURE_COUNT; ch++) {
+        Sensor_AutoZeroResetWindow(&g_autozero_state[ch]);
+        // 上电后首次学习与DFlash中保存的结果比较，可发现停机期间的零点跳变
+        g_autozero_state[ch].last_learned_v = CalibStore_GetPressureZeroTrim((calib_pressure_channel_id_t)ch);
+    }
+    g_autozero_idle = false;
+    g_autozero_idle_since = 0U;
+}
+
+void Sensor_SetAutoZeroEnable(uint8_t channel, bool enable) {
+    if (channel >= CALIB_PRESSURE_COUNT) {
+        return;
+    }
+    g_autozero_state[channel].enabled = enable;
+    Sensor_AutoZeroResetWindow(&g_autozero_state[channel]);
+}
+
+void Sensor_AutoZeroUpdate(bool system_idle) {
+    static const uint8_t adc_channel[CALIB_PRESSURE_COUNT] = {ADC_CHANNEL_OIL_PRESSURE, ADC_CHANNEL_LNG_PRESSURE};
+    uint32_t now = OSIF_GetMilliseconds();
+
+    if (!system_idle) {
+        if (g_autozero_idle) {
+            g_autozero_idle = false;
+            for (uint8_t ch = 0; ch < CALIB_PRESSURE_COUNT; ch++) {
+                Sensor_AutoZeroResetWindow(&g_autozero_state[ch]);
+            }
+        }
+        return;
+    }
+    if (!g_autozero_idle) {
+        g_autozero_idle = true;
+        g_autozero_idle_since = now;
+    }
+    // 等待管路压力泄放
+    if ((now - g_autozero_idle_since) < SENSOR_AUTOZERO_SETTLE_MS) {
+        return;
+    }
+
+    for (uint8_t ch = 0; ch < CALIB_PRESSURE_COUNT; ch++) {
+        sensor_autozero_state_t *st = &g_autozero_state[ch];
+        uint8_t adc_ch = adc_channel[ch];
+
+        if (!st->enabled) {
+            continue;
+        }
+        // 原始信号不可信时不学习
+        if (!g_plaus_state[adc_ch].valid) {
+            Sensor_AutoZeroResetWindow(st);
+            continue;
+        }
+
+        uint16_t code = g_sensor_monitor.raw_data.adc_raw[adc_ch];
+        st->window_sum += code;
+        if (code < st->window_min) st->window_min = code;
+        if (code > st->window_max) st->window_max = code;
+        if (++st->window_count < SENSOR_AUTOZERO_WINDOW_SAMPLES) {
+            continue;
+        }
+
+        // 窗口内波动过大说明压力仍在变化，丢弃重新采集
+        if ((uint16_t)(st->window_max - st->window_min) > SENSOR_AUTOZERO_STABLE_CODES) {
+            Sensor_AutoZeroResetWindow(st);
+            continue;
+        }
+
+        float mean_voltage = Sensor_ConvertAdcToVoltage((uint16_t)(st->window_sum / st->window_count));
+        float measured = mean_voltage - CalibStore_GetPressureZeroVoltage((calib_pressure_channel_id_t)ch);
+        st->measured_v = measured;
+        Sensor_AutoZeroResetWindow(st);
+
+        if (Sensor_AbsFloat(measured) > SENSOR_AUTOZERO_MAX_TRIM_V) {
+            if ((st->flags & SENSOR_AUTOZERO_FLAG_OUT_OF_RANGE) == 0U) {
+                printf("[SENSOR] Pressure ch%u zero offset %.4fV out of range, not applied\r\n", ch, measured);
+            }
+            st->flags |= SENSOR_AUTOZERO_FLAG_OUT_OF_RANGE;
+            continue;
+        }
+        st->flags &= (uint8_t)~SENSOR_AUTOZERO_FLAG_OUT_OF_RANGE;
+
+        // 漂移监测：相邻两次学习的跳变量，以及运行期内足够长间隔上的漂移速率
+        // （出厂标定修正量为0，视为无历史基准，首次学习不判跳变）
+        bool has_baseline = ((st->flags & SENSOR_AUTOZERO_FLAG_LEARNED) != 0U) || (st->last_learned_v != 0.0f);
+        float step = Sensor_AbsFloat(measured - st->last_learned_v);
+        bool drift = has_baseline && (step > SENSOR_AUTOZERO_MAX_STEP_V);
+        if ((st->flags & SENSOR_AUTOZERO_FLAG_LEARNED) != 0U &&
+            (now - st->last_learn_time) >= SENSOR_AUTOZERO_DRIFT_MIN_MS) {
+            st->drift_rate_v_per_h = step * 3600000.0f / (float)(now - st->last_learn_time);
+            drift = drift || (st->drift_rate_v_per_h > SENSOR_AUTOZERO_MAX_DRIFT_V_PER_H);
+        }
+        if (drift && (st->flags & SENSOR_AUTOZERO_FLAG_DRIFT) == 0U) {
+            printf("[SENSOR] Pressure ch%u zero drifting too fast: %.4fV -> %.4fV\r\n",
+                   ch, st->last_learned_v, measured);
+            st->flags |= SENSOR_AUTOZERO_FLAG_DRIFT;
+        }
+
+        // 只有在速率计算间隔到达或首次学习时更新基准，避免短间隔内速率被稀释
+        if ((st->flags & SENSOR_AUTOZERO_FLAG_LEARNED) == 0U ||
+            (now - st->last_learn_time) >= SENSOR_AUTOZERO_DRIFT_MIN_MS) {
+            st->last_learned_v = measured;
+            st->last_learn_time = now;
+        }
+        st->flags |= SENSOR_AUTOZERO_FLAG_LEARNED;
+        st->learn_count++;
+
+        // 修正量变化超过死区才重新编译并延时写入DFlash
+        if (Sensor_AbsFloat(measured - CalibStore_GetPressureZeroTrim((calib_pressure_channel_id_t)ch)) >= SENSOR_AUTOZERO_DEADBAND_V) {
+            CalibStore_SetPressureZeroTrim((calib_pressure_channel_id_t)ch, measured);
+        }
+    }
+}
+
+const sensor_autozero_state_t* Sensor_GetAutoZeroState(uint8_t channel) {
+    if (channel >= CALIB_PRESSURE_COUNT) {
+        return NULL;
+    }
+    return &g_autozero_state[channel];
+}
+
+// 自适应采集速率
+static uint16_t Sensor_RateClampPeriod(uint16_t period_ms)
+{
+    if (period_ms < SENSOR_RATE_MIN_PERIOD_MS) return SENSOR_RATE_MIN_PERIOD_MS;
+    if (period_ms > SENSOR_RATE_MAX_PERIOD_MS) return SENSOR_RATE_MAX_PERIOD_MS;
+    return period_ms;
+}
+
+static void Sensor_RateApply(uint16_t period_ms)
+{
+    if (period_ms == g_rate_state.period_ms) {
+        return;
+    }
+    g_rate_state.period_ms = period_ms;
+    g_rate_state.switch_count++;
+    // 合理性检测的变化率/卡滞/去抖参数按新周期换算
+    Sensor_SetPlausibilitySamplePeriod((uint32_t)period_ms * 1000U);
+}
+
+void Sensor_RateInit(void) {
+    g_rate_config.high_period_ms = SENSOR_RATE_HIGH_PERIOD_MS;
+    g_rate_config.normal_period_ms = SENSOR_RATE_NORMAL_PERIOD_MS;
+    g_rate_config.idle_period_ms = SENSOR_RATE_IDLE_PERIOD_MS;
+    g_rate_config.hold_ms = SENSOR_RATE_HOLD_MS;
+    g_rate_config.enter_rate_mpa_s = SENSOR_RATE_ENTER_MPA_PER_S;
+    g_rate_config.exit_rate_mpa_s = SENSOR_RATE_EXIT_MPA_PER_S;
+
+    memset(&g_rate_state, 0, sizeof(g_rate_state));
+    g_rate_state.period_ms = SENSOR_RATE_NORMAL_PERIOD_MS;
+    Sensor_SetPlausibilitySamplePeriod((uint32_t)g_rate_state.period_ms * 1000U);
+}
+
+bool Sensor_SetRateConfig(const sensor_rate_config_t *config) {
+    if (config == NULL) {
+        return false;
+    }
+    if (!(config->enter_rate_mpa_s > 0.0f) || !(config->exit_rate_mpa_s > 0.0f) ||
+        config->exit_rate_mpa_s > config->enter_rate_mpa_s) {
+        return false;
+    }
+
+    sensor_rate_config_t cfg = *config;
+    cfg.high_period_ms = Sensor_RateClampPeriod(cfg.high_period_ms);
+    cfg.normal_period_ms = Sensor_RateClampPeriod(cfg.normal_period_ms);
+    cfg.idle_period_ms = Sensor_RateClampPeriod(cfg.idle_period_ms);
+    if (cfg.high_period_ms > cfg.normal_period_ms || cfg.high_period_ms > cfg.idle_period_ms) {
+        return false;
+    }
+    g_rate_config = cfg;
+    return true;
+}
+
+void Sensor_GetRateConfig(sensor_rate_config_t *config) {
+    if (config != NULL) {
+        *config = g_rate_config;
+    }
+}
+
+uint16_t Sensor_RateUpdate(bool valve_active, uint8_t reversal_freq_hz, bool system_enabled) {
+    sensor_rate_state_t *st = &g_rate_state;
+    uint32_t now = OSIF_GetMilliseconds();
+    float oil = g_sensor_monitor.filtered_data.oil_pressure_mpa;
+    float lng = g_sensor_monitor.filtered_data.lng_pressure_mpa;
+
+    // 压力变化率（滤波后数据，取两路较大者）
+    if (st->has_last && now != st->last_sample_time) {
+        float dt_s = (float)(now - st->last_sample_time) * 0.001f;
+        float d_oil = oil - st->last_oil_pressure;
+        float d_lng = lng - st->last_lng_pressure;
+        if (d_oil < 0.0f) d_oil = -d_oil;
+        if (d_lng < 0.0f) d_lng = -d_lng;
+        st->pressure_rate_mpa_s = ((d_oil > d_lng) ? d_oil : d_lng) / dt_s;
+    }
+    st->last_oil_pressure = oil;
+    st->last_lng_pressure = lng;
+    st->last_sample_time = now;
+    st->has_last = true;
+
+    // 活动状态判定：进入用高阈值，保持用低阈值（回差）
+    float threshold = st->active ? g_rate_config.exit_rate_mpa_s : g_rate_config.enter_rate_mpa_s;
+    bool activity = valve_active || (reversal_freq_hz > 0U) || (st->pressure_rate_mpa_s > threshold);
+    uint16_t floor_period = system_enabled ? g_rate_config.normal_period_ms : g_rate_config.idle_period_ms;
+
+    if (activity) {
+        // 升速立即生效
+        st->active = true;
+        st->last_change_time = now;
+        Sensor_RateApply(g_rate_config.high_period_ms);
+    } else {
+        st->active = false;
+        if (st->period_ms > floor_period) {
+            // 系统使能后目标周期变短，立即升速
+            Sensor_RateApply(floor_period);
+            st->last_change_time = now;
+        } else if (st->period_ms < floor_period && (now - st->last_change_time) >= g_rate_config.hold_ms) {
+            // 降速限速：每个保持时间周期最多加倍一次
+            uint32_t next = (uint32_t)st->period_ms * 2U;
+            Sensor_RateApply((next > floor_period) ? floor_period : (uint16_t)next);
+            st->last_change_time = now;
+        }
+    }
+
+    return st->period_ms;
+}
+
+uint16_t Sensor_GetSamplePeriodMs(void) {
+    return g_rate_state.period_ms;
+}
+
+const sensor_rate_state_t* Sensor_GetRateState(void) {
+    return &g_rate_state;
+}
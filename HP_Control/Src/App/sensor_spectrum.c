@@ -0,0 +1,282 @@
+/*!
+ * @file sensor_spectrum.c
+ *
+ * @brief 油压脉动频谱分析模块实现 - 窗口采集 + Q15定点FFT + 谱峰提取
+ *
+ * 说明：
+ * - 采样回调运行在定时器中断中，只写入原始码值，采满后停止采集流；FFT和谱峰提取在任务中完成
+ * - FFT每级蝶形输出缩放1/2（SHADD16/SHSUB16），8级共缩放1/256，整个过程无溢出；
+ *   旋转因子乘法为一条SMUAD（实部）加一条SMUSDX（虚部）
+ * - 幅值换算：Hann窗相干增益0.5，单边谱幅值 A = 4|X[k]|（X为DFT/N）
+ * - 采集流被压力录波占用时本周期跳过
+ */
+
+#include "sensor_spectrum.h"
+#include "sensor.h"
+#include "calib_store.h"
+#include "can_config.h"
+#include "dsp_simd.h"
+#include "osif.h"
+#include <math.h>
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define SPECTRUM_HALF_SIZE          (SPECTRUM_FFT_SIZE / 2U)
+#define SPECTRUM_Q15_ONE            32767.0f
+#define SPECTRUM_PI                 3.14159265358979f
+#define SPECTRUM_HANN_POWER_GAIN    0.375f      // Hann窗功率增益 mean(w^2)
+#define SPECTRUM_TIMEOUT_MS         ((SPECTRUM_FFT_SIZE * SPECTRUM_SAMPLE_PERIOD_US) / 1000U * 4U)
+
+/* ==========================================  Variables  =========================================== */
+
+// 旋转因子 W[k] = cos(2πk/N) + j*sin(2πk/N)（低半字cos，高半字sin，实际乘以共轭）
+static uint32_t g_spec_twiddle[SPECTRUM_HALF_SIZE];
+// Hann窗(Q15)
+static int16_t g_spec_window[SPECTRUM_FFT_SIZE];
+// 原始码值窗口（中断写入）与FFT工作区
+static uint16_t g_spec_samples[SPECTRUM_FFT_SIZE];
+static uint32_t g_spec_fft[SPECTRUM_FFT_SIZE];
+
+static volatile uint16_t g_spec_count = 0U;
+static volatile bool g_spec_ready = false;      // 窗口采满，待分析
+static bool g_spec_collecting = false;          // 本模块占用采集流
+static uint32_t g_spec_start_time = 0U;
+static uint32_t g_spec_last_start = 0U;
+
+static spectrum_summary_t g_spec_summary;
+
+/* ==========================================  Functions  =========================================== */
+
+static uint16_t SensorSpectrum_BitReverse(uint16_t index)
+{
+    uint16_t reversed = 0U;
+    for (uint8_t i = 0U; i < SPECTRUM_FFT_LOG2N; i++) {
+        reversed = (uint16_t)((reversed << 1) | (index & 1U));
+        index >>= 1;
+    }
+    return reversed;
+}
+
+void SensorSpectrum_FftQ15(uint32_t data[SPECTRUM_FFT_SIZE])
+{
+    // 位反序重排
+    for (uint16_t i = 0U; i < SPECTRUM_FFT_SIZE; i++) {
+        uint16_t j = SensorSpectrum_BitReverse(i);
+        if (j > i) {
+            uint32_t tmp = data[i];
+            data[i] = data[j];
+            data[j] = tmp;
+        }
+    }
+
+    // 基2按时间抽取蝶形，每级缩放1/2
+    for (uint16_t half = 1U, step = SPECTRUM_HALF_SIZE; half < SPECTRUM_FFT_SIZE; half <<= 1, step >>= 1) {
+        for (uint16_t k = 0U; k < half; k++) {
+            uint32_t w = g_spec_twiddle[k * step];
+            for (uint16_t j = k; j < SPECTRUM_FFT_SIZE; j += (uint16_t)(half << 1)) {
+                uint32_t a = data[j];
+                uint32_t b = data[j + half];
+                // t = b * conj(W)：实部 b.re*c + b.im*s，虚部 c*b.im - s*b.re
+                int32_t t_re = DSP_Smuad(b, w) >> 15;
+                int32_t t_im = DSP_Smusdx(w, b) >> 15;
+                uint32_t t = DSP_Pack16((int16_t)t_re, (int16_t)t_im);
+                data[j] = DSP_Shadd16(a, t);
+                data[j + half] = DSP_Shsub16(a, t);
+            }
+        }
+    }
+}
+
+/* 逐采样回调（定时器中断上下文） */
+static void SensorSpectrum_OnSample(uint16_t oil_pressure_raw, uint16_t lng_pressure_raw)
+{
+    (void)lng_pressure_raw;
+
+    uint16_t count = g_spec_count;
+    if (count >= SPECTRUM_FFT_SIZE) {
+        return;
+    }
+    g_spec_samples[count] = oil_pressure_raw;
+    g_spec_count = ++count;
+    if (count >= SPECTRUM_FFT_SIZE) {
+        Sensor_StopPressureStream();
+        g_spec_ready = true;
+    }
+}
+
+void SensorSpectrum_Init(void)
+{
+    for (uint16_t k = 0U; k < SPECTRUM_HALF_SIZE; k++) {
+        float angle = 2.0f * SPECTRUM_PI * (float)k / (float)SPECTRUM_FFT_SIZE;
+        int16_t c = (int16_t)lrintf(cosf(angle) * SPECTRUM_Q15_ONE);
+        int16_t s = (int16_t)lrintf(sinf(angle) * SPECTRUM_Q15_ONE);
+        g_spec_twiddle[k] = DSP_Pack16(c, s);
+    }
+    for (uint16_t n = 0U; n < SPECTRUM_FFT_SIZE; n++) {
+        float w = 0.5f - 0.5f * cosf(2.0f * SPECTRUM_PI * (float)n / (float)SPECTRUM_FFT_SIZE);
+        g_spec_window[n] = (int16_t)lrintf(w * SPECTRUM_Q15_ONE);
+    }
+
+    memset(&g_spec_summary, 0, sizeof(g_spec_summary));
+    g_spec_count = 0U;
+    g_spec_ready = false;
+    g_spec_collecting = false;
+    g_spec_last_start = OSIF_GetMilliseconds();
+}
+
+/*!
+ * @brief 计算频点功率 |X[k]|^2（Q15幅值平方）
+ */
+static uint32_t SensorSpectrum_BinPower(uint16_t k)
+{
+    return (uint32_t)DSP_Smuad(g_spec_fft[k], g_spec_fft[k]);
+}
+
+static uint8_t SensorSpectrum_ToU8(float value, float scale)
+{
+    float scaled = value * scale + 0.5f;
+    if (scaled <= 0.0f) return 0U;
+    if (scaled >= 255.0f) return 255U;
+    return (uint8_t)scaled;
+}
+
+static void SensorSpectrum_SendSummary(void)
+{
+    uint8_t data[8];
+    uint32_t f1 = (uint32_t)(g_spec_summary.peaks[0].frequency_hz * 10.0f + 0.5f);
+    uint32_t f2 = (uint32_t)(g_spec_summary.peaks[1].frequency_hz * 10.0f + 0.5f);
+    if (f1 > 0xFFFFU) f1 = 0xFFFFU;
+    if (f2 > 0xFFFFU) f2 = 0xFFFFU;
+
+    data[0] = (uint8_t)(f1 & 0xFFU);
+    data[1] = (uint8_t)(f1 >> 8);
+    data[2] = SensorSpectrum_ToU8(g_spec_summary.peaks[0].amplitude_mpa, 100.0f);
+    data[3] = (uint8_t)(f2 & 0xFFU);
+    data[4] = (uint8_t)(f2 >> 8);
+    data[5] = SensorSpectrum_ToU8(g_spec_summary.peaks[1].amplitude_mpa, 100.0f);
+    data[6] = SensorSpectrum_ToU8(g_spec_summary.ripple_rms_mpa, 100.0f);
+    data[7] = g_spec_summary.high_band_percent;
+
+    CAN_Config_SendMessage(CAN_MSG_SPECTRUM_ID, data, 8, true);
+}
+
+/*!
+ * @brief 对采满的窗口做FFT并提取摘要
+ */
+static void SensorSpectrum_Analyze(void)
+{
+    const float sample_rate = 1000000.0f / (float)SPECTRUM_SAMPLE_PERIOD_US;
+    uint32_t sum = 0U;
+
+    for (uint16_t n = 0U; n < SPECTRUM_FFT_SIZE; n++) {
+        sum += g_spec_samples[n];
+    }
+    int32_t mean = (int32_t)((sum + SPECTRUM_FFT_SIZE / 2U) >> SPECTRUM_FFT_LOG2N);
+
+    // 去均值、放大、加窗，虚部为0
+    for (uint16_t n = 0U; n < SPECTRUM_FFT_SIZE; n++) {
+        int32_t x = ((int32_t)g_spec_samples[n] - mean) * (1 << SPECTRUM_INPUT_SHIFT);
+        if (x > 32767) x = 32767;
+        if (x < -32768) x = -32768;
+        x = (x * g_spec_window[n]) >> 15;
+        g_spec_fft[n] = DSP_Pack16((int16_t)x, 0);
+    }
+
+    SensorSpectrum_FftQ15(g_spec_fft);
+
+    // 能量统计与谱峰搜索（单边谱，不含直流和奈奎斯特频点）
+    uint64_t total_power = 0U;
+    uint64_t high_power = 0U;
+    uint16_t peak_bin[SPECTRUM_PEAK_COUNT] = {0U, 0U};
+    uint32_t peak_power[SPECTRUM_PEAK_COUNT] = {0U, 0U};
+
+    for (uint16_t k = 1U; k < SPECTRUM_HALF_SIZE; k++) {
+        uint32_t p = SensorSpectrum_BinPower(k);
+        total_power += p;
+        if (k >= SPECTRUM_HALF_SIZE / 2U) {
+            high_power += p;
+        }
+        if (k >= SPECTRUM_MIN_PEAK_BIN && k + 1U < SPECTRUM_HALF_SIZE &&
+            p > SensorSpectrum_BinPower(k - 1U) && p >= SensorSpectrum_BinPower(k + 1U)) {
+            if (p > peak_power[0]) {
+                peak_power[1] = peak_power[0];
+                peak_bin[1] = peak_bin[0];
+                peak_power[0] = p;
+                peak_bin[0] = k;
+            } else if (p > peak_power[1]) {
+                peak_power[1] = p;
+                peak_bin[1] = k;
+            }
+        }
+    }
+
+    // 码值→MPa：取窗口均值附近的标定斜率
+    uint16_t code_lo = (mean > 16) ? (uint16_t)(mean - 16) : 0U;
+    uint16_t code_hi = (uint16_t)(mean + 16);
+    float mpa_per_code = (CalibStore_ConvertPressure(CALIB_PRESSURE_OIL, code_hi) -
+                          CalibStore_ConvertPressure(CALIB_PRESSURE_OIL, code_lo)) / (float)(code_hi - code_lo);
+    // Q15窗口值 = 码值 << SPECTRUM_INPUT_SHIFT
+    const float code_per_unit = 1.0f / (float)(1U << SPECTRUM_INPUT_SHIFT);
+
+    for (uint8_t i = 0U; i < SPECTRUM_PEAK_COUNT; i++) {
+        uint16_t k = peak_bin[i];
+        if (k == 0U) {
+            g_spec_summary.peaks[i].frequency_hz = 0.0f;
+            g_spec_summary.peaks[i].amplitude_mpa = 0.0f;
+            continue;
+        }
+        // 抛物线插值修正频率
+        float a = sqrtf((float)SensorSpectrum_BinPower(k - 1U));
+        float b = sqrtf((float)peak_power[i]);
+        float c = sqrtf((float)SensorSpectrum_BinPower(k + 1U));
+        float denom = a - 2.0f * b + c;
+        float delta = (denom != 0.0f) ? 0.5f * (a - c) / denom : 0.0f;
+        g_spec_summary.peaks[i].frequency_hz = ((float)k + delta) * sample_rate / (float)SPECTRUM_FFT_SIZE;
+        g_spec_summary.peaks[i].amplitude_mpa = 4.0f * b * code_per_unit * mpa_per_code;
+    }
+
+    // Parseval：时域均方 = 2*单边功率和 / 窗功率增益
+    float rms_units = sqrtf(2.0f * (float)total_power / SPECTRUM_HANN_POWER_GAIN);
+    g_spec_summary.ripple_rms_mpa = rms_units * code_per_unit * mpa_per_code;
+    g_spec_summary.high_band_percent = (total_power > 0U) ? (uint8_t)((high_power * 100U) / total_power) : 0U;
+    g_spec_summary.mean_pressure_mpa = CalibStore_ConvertPressure(CALIB_PRESSURE_OIL, (uint16_t)mean);
+    g_spec_summary.timestamp = OSIF_GetMilliseconds();
+    g_spec_summary.count++;
+}
+
+void SensorSpectrum_Task(bool enabled)
+{
+    uint32_t now = OSIF_GetMilliseconds();
+
+    if (g_spec_collecting) {
+        if (g_spec_ready) {
+            g_spec_collecting = false;
+            g_spec_ready = false;
+            SensorSpectrum_Analyze();
+            SensorSpectrum_SendSummary();
+        } else if (!enabled || (now - g_spec_start_time) > SPECTRUM_TIMEOUT_MS) {
+            // 停机或采集异常，放弃本窗口
+            Sensor_StopPressureStream();
+            g_spec_collecting = false;
+        }
+        return;
+    }
+
+    if (!enabled || (now - g_spec_last_start) < SPECTRUM_INTERVAL_MS) {
+        return;
+    }
+    g_spec_last_start = now;
+
+    g_spec_count = 0U;
+    g_spec_ready = false;
+    if (Sensor_StartPressureStream(SPECTRUM_SAMPLE_PERIOD_US, SensorSpectrum_OnSample)) {
+        g_spec_collecting = true;
+        g_spec_start_time = now;
+    }
+}
+
+const spectrum_summary_t* SensorSpectrum_GetSummary(void)
+{
+    return &g_spec_summary;
+}
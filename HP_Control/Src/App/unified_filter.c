@@ -4,8 +4,11 @@
  */
 
 #include "unified_filter.h"
+#include "can_config.h"
+#include "dsp_simd.h"
 #include "osif.h"
 #include <string.h>
+#include <math.h>
 
 /* ==================== 平台抽象接口实现 ==================== */
 // 根据算法库平台无关化实施方案添加的平台时间接口实现
@@ -25,17 +28,385 @@ void Platform_DelayMs(platform_uint32_t ms) {
 
 static unified_filter_t g_unified_filter;
 
+// 各通道默认滤波配置（DISABLE命令恢复用）
+static filter_config_t g_filter_default_config[FILTER_CHANNEL_COUNT];
+
+// Biquad系数上传暂存区（CAN中断写入，任务中提交）
+static biquad_coeffs_t g_biquad_staging[UNIFIED_FILTER_BIQUAD_SECTIONS];
+static volatile uint8_t g_biquad_staging_channel = 0U;
+static volatile uint16_t g_biquad_staging_mask = 0U;    // 已收到的系数位图，bit = 节*5 + 系数序号
+static volatile uint8_t g_filter_pending_cmd = 0U;
+static volatile uint8_t g_filter_pending_channel = 0U;
+static volatile uint8_t g_filter_pending_sections = 0U;
+
 /* ==========================================  Functions  =========================================== */
 
+static platform_moving_average_t* UnifiedFilter_AllocMovingAverage(void) {
+    for (uint8_t slot = 0; slot < UNIFIED_FILTER_MA_POOL_SIZE; slot++) {
+        platform_moving_average_t* ma = &g_unified_filter.ma_pool[slot];
+        bool used = false;
+        for (uint8_t i = 0; i < FILTER_CHANNEL_COUNT; i++) {
+            if (g_unified_filter.channels[i].ma == ma) {
+                used = true;
+                break;
+            }
+        }
+        if (!used) {
+            return ma;
+        }
+    }
+    return NULL;
+}
+
+static void UnifiedFilter_ResetChannel(filter_channel_state_t* ch) {
+    ch->output = 0.0f;
+    ch->sample_count = 0;
+    
+    if (ch->ma != NULL) {
+        PlatformFilter_MovingAverageInit(ch->ma, ch->config.window_size);
+    }
+}
+
+static void UnifiedFilter_ResetSpike(hampel_filter_t* hf) {
+    hf->index = 0;
+    hf->count = 0;
+}
+
+/*!
+ * @brief 尖峰剔除：当前样本偏离窗口中值超过 max(阈值*1.4826*MAD, 最小偏差) 时以中值代替
+ * @note 原始样本始终进入窗口，真实阶跃在窗口过半后被接受
+ */
+static float UnifiedFilter_HampelUpdate(hampel_filter_t* hf, float value) {
+    uint8_t window = hf->config.window_size;
+    uint8_t pos;
+    
+    if (hf->count >= window) {
+        // 窗口已满：最旧样本的位置直接改写为新样本，再向一侧移位保持升序（一次遍历）
+        float oldest = hf->history[hf->index];
+        for (pos = 0; pos < hf->count - 1U && hf->sorted[pos] != oldest; pos++) {
+        }
+        for (; pos > 0U && hf->sorted[pos - 1U] > value; pos--) {
+            hf->sorted[pos] = hf->sorted[pos - 1U];
+        }
+        for (; pos < hf->count - 1U && hf->sorted[pos + 1U] < value; pos++) {
+            hf->sorted[pos] = hf->sorted[pos + 1U];
+        }
+        hf->sorted[pos] = value;
+    } else {
+        // 插入新样本，保持升序
+        for (pos = hf->count; pos > 0U && hf->sorted[pos - 1U] > value; pos--) {
+            hf->sorted[pos] = hf->sorted[pos - 1U];
+        }
+        hf->sorted[pos] = value;
+        hf->count++;
+    }
+    
+    hf->history[hf->index] = value;
+    if (++hf->index >= window) {
+        hf->index = 0;
+    }
+    
+    if (hf->count < window) {
+        return value;  // 窗口未满，直通
+    }
+    
+    // 中值；MAD为偏差序列的中值：中值两侧的偏差各自单调递增，归并取第window/2小
+    uint8_t mid = window / 2U;
+    float median = hf->sorted[mid];
+    int8_t left = (int8_t)mid - 1;
+    uint8_t right = mid + 1U;
+    float mad = 0.0f;
+    for (uint8_t k = 0; k < mid; k++) {
+        float dl = (left >= 0) ? median - hf->sorted[left] : -1.0f;
+        float dr = (right < window) ? hf->sorted[right] - median : -1.0f;
+        if (dr < 0.0f || (dl >= 0.0f && dl <= dr)) {
+            mad = dl;
+            left--;
+        } else {
+            mad = dr;
+            right++;
+        }
+    }
+    
+    float limit = hf->config.threshold * UNIFIED_FILTER_MAD_SCALE * mad;
+    if (limit < hf->config.min_deviation) {
+        limit = hf->config.min_deviation;
+    }
+    float deviation = value - median;
+    if (deviation > limit || deviation < -limit) {
+        hf->rejected_count++;
+        return median;
+    }
+    return value;
+}
+
+/* ==================== 级联二阶节(Biquad)引擎 ==================== */
+
+#define BIQUAD_COEFFS_PER_SECTION   5U
+#define BIQUAD_Q31_FRAC_BITS        (31U - UNIFIED_FILTER_BIQUAD_Q31_SHIFT)
+
+static void UnifiedFilter_BiquadPassthrough(biquad_coeffs_t* c) {
+    c->b0 = 1.0f;
+    c->b1 = 0.0f;
+    c->b2 = 0.0f;
+    c->a1 = 0.0f;
+    c->a2 = 0.0f;
+}
+
+/*!
+ * @brief 稳定性检查：极点在单位圆内（稳定三角形 |a2|<1, |a1|<1+a2）
+ */
+static bool UnifiedFilter_BiquadIsValid(const biquad_coeffs_t* c) {
+    if (!(c->a2 < 1.0f && c->a2 > -1.0f)) return false;
+    if (!(c->a1 < 1.0f + c->a2 && c->a1 > -(1.0f + c->a2))) return false;
+#if UNIFIED_FILTER_BIQUAD_Q31
+    {
+        const float limit = (float)(1U << UNIFIED_FILTER_BIQUAD_Q31_SHIFT);
+        const float* v = &c->b0;
+        for (uint8_t i = 0; i < BIQUAD_COEFFS_PER_SECTION; i++) {
+            if (!(v[i] < limit && v[i] > -limit)) return false;
+        }
+    }
+#endif
+    return true;
+}
+
+#if UNIFIED_FILTER_BIQUAD_Q31
+static int32_t UnifiedFilter_Sat32(int64_t v) {
+    if (v > INT32_MAX) return INT32_MAX;
+    if (v < INT32_MIN) return INT32_MIN;
+    return (int32_t)v;
+}
+
+static int32_t UnifiedFilter_FloatToQ(float v, uint8_t frac_bits) {
+    float scaled = v * (float)(1UL << frac_bits);
+    if (scaled >= 2147483647.0f) return INT32_MAX;
+    if (scaled <= -2147483648.0f) return INT32_MIN;
+    return (int32_t)scaled;
+}
+#endif
+
+/*!
+ * @brief 由生效系数表生成指定系数组
+ */
+static void UnifiedFilter_BiquadLoadBank(uint8_t bank) {
+    biquad_engine_t* eng = &g_unified_filter.biquad;
+    
+    for (uint8_t s = 0; s < UNIFIED_FILTER_BIQUAD_SECTIONS; s++) {
+        for (uint8_t c = 0; c < FILTER_CHANNEL_COUNT; c++) {
+            const biquad_coeffs_t* k = &eng->coeffs[s][c];
+#if UNIFIED_FILTER_BIQUAD_Q31
+            eng->bank[bank].b0[s][c] = UnifiedFilter_FloatToQ(k->b0, BIQUAD_Q31_FRAC_BITS);
+            eng->bank[bank].b1[s][c] = UnifiedFilter_FloatToQ(k->b1, BIQUAD_Q31_FRAC_BITS);
+            eng->bank[bank].b2[s][c] = UnifiedFilter_FloatToQ(k->b2, BIQUAD_Q31_FRAC_BITS);
+            eng->bank[bank].a1[s][c] = UnifiedFilter_FloatToQ(k->a1, BIQUAD_Q31_FRAC_BITS);
+            eng->bank[bank].a2[s][c] = UnifiedFilter_FloatToQ(k->a2, BIQUAD_Q31_FRAC_BITS);
+#else
+            eng->bank[bank].b0[s][c] = k->b0;
+            eng->bank[bank].b1[s][c] = k->b1;
+            eng->bank[bank].b2[s][c] = k->b2;
+            eng->bank[bank].a1[s][c] = k->a1;
+            eng->bank[bank].a2[s][c] = k->a2;
+#endif
+        }
+    }
+}
+
+/*!
+ * @brief 按输入value的直流稳态设置通道状态，系数切换或启用时输出不跳变
+ */
+static void UnifiedFilter_BiquadPrime(uint8_t channel, float value) {
+    biquad_engine_t* eng = &g_unified_filter.biquad;
+    float x = value;
+    
+    for (uint8_t s = 0; s < UNIFIED_FILTER_BIQUAD_SECTIONS; s++) {
+        const biquad_coeffs_t* k = &eng->coeffs[s][channel];
+        float y = x * (k->b0 + k->b1 + k->b2) / (1.0f + k->a1 + k->a2);
+        float z1 = y - k->b0 * x;
+        float z2 = k->b2 * x - k->a2 * y;
+#if UNIFIED_FILTER_BIQUAD_Q31
+        eng->z1[s][channel] = UnifiedFilter_FloatToQ(z1 / UNIFIED_FILTER_BIQUAD_Q31_SCALE, 31U);
+        eng->z2[s][channel] = UnifiedFilter_FloatToQ(z2 / UNIFIED_FILTER_BIQUAD_Q31_SCALE, 31U);
+#else
+        eng->z1[s][channel] = z1;
+        eng->z2[s][channel] = z2;
+#endif
+        x = y;
+    }
+}
+
+/*!
+ * @brief 计算一个采样（直接II型转置），只处理列出的Biquad通道及其已用节
+ * @note 未用节为直通且状态恒为0，跳过后输出逐位一致；非Biquad通道的y不被使用，切换为Biquad时由Prime重新初始化
+ */
+static void UnifiedFilter_BiquadProcess(const uint8_t* list, uint8_t n,
+                                        const float x[FILTER_CHANNEL_COUNT], float y[FILTER_CHANNEL_COUNT]) {
+    biquad_engine_t* eng = &g_unified_filter.biquad;
+    uint8_t s, i;
+#if UNIFIED_FILTER_BIQUAD_Q31
+    const biquad_bank_q31_t* k = &eng->bank[eng->active];
+    
+    for (i = 0; i < n; i++) {
+        uint8_t c = list[i];
+        int32_t v = UnifiedFilter_FloatToQ(x[c] / UNIFIED_FILTER_BIQUAD_Q31_SCALE, 31U);
+        for (s = 0; s < eng->sections[c]; s++) {
+            int32_t out = UnifiedFilter_Sat32((((int64_t)k->b0[s][c] * v) >> BIQUAD_Q31_FRAC_BITS) + eng->z1[s][c]);
+            eng->z1[s][c] = UnifiedFilter_Sat32(((((int64_t)k->b1[s][c] * v) - ((int64_t)k->a1[s][c] * out)) >> BIQUAD_Q31_FRAC_BITS) + eng->z2[s][c]);
+            eng->z2[s][c] = UnifiedFilter_Sat32((((int64_t)k->b2[s][c] * v) - ((int64_t)k->a2[s][c] * out)) >> BIQUAD_Q31_FRAC_BITS);
+            v = out;
+        }
+        y[c] = (float)v * (UNIFIED_FILTER_BIQUAD_Q31_SCALE / 2147483648.0f);
+    }
+#else
+    const biquad_bank_f32_t* k = &eng->bank[eng->active];
+    
+    for (i = 0; i < n; i++) {
+        uint8_t c = list[i];
+        float v = x[c];
+        for (s = 0; s < eng->sections[c]; s++) {
+            float out = k->b0[s][c] * v + eng->z1[s][c];
+            eng->z1[s][c] = k->b1[s][c] * v - k->a1[s][c] * out + eng->z2[s][c];
+            eng->z2[s][c] = k->b2[s][c] * v - k->a2[s][c] * out;
+            v = out;
+        }
+        y[c] = v;
+    }
+#endif
+}
+
+static void UnifiedFilter_BiquadInit(void) {
+    biquad_engine_t* eng = &g_unified_filter.biquad;
+    
+    for (uint8_t s = 0; s < UNIFIED_FILTER_BIQUAD_SECTIONS; s++) {
+        for (uint8_t c = 0; c < FILTER_CHANNEL_COUNT; c++) {
+            UnifiedFilter_BiquadPassthrough(&eng->coeffs[s][c]);
+        }
+    }
+    for (uint8_t c = 0; c < FILTER_CHANNEL_COUNT; c++) {
+        eng->sections[c] = 1U;
+    }
+    UnifiedFilter_BiquadLoadBank(0U);
+    UnifiedFilter_BiquadLoadBank(1U);
+    eng->active = 0U;
+}
+
+/* ==================== 压力Kalman估计 ==================== */
+
+static void UnifiedFilter_KalmanUpdate(pressure_kalman_t* k, float z, uint32_t dt_ms) {
+    if (!k->initialized || dt_ms == 0U || dt_ms > UNIFIED_FILTER_KALMAN_MAX_DT_MS) {
+        k->pressure = z;
+        k->rate = 0.0f;
+        k->p00 = UNIFIED_FILTER_KALMAN_MEAS_VAR;
+        k->p01 = 0.0f;
+        k->p11 = UNIFIED_FILTER_KALMAN_INIT_RATE_VAR;
+        k->initialized = true;
+        return;
+    }
+    
+    const float q = UNIFIED_FILTER_KALMAN_ACCEL_PSD;
+    float dt = (float)dt_ms * 0.001f;
+    float dt2 = dt * dt;
+    
+    // 预测：x = F x, P = F P F' + Q
+    k->pressure += k->rate * dt;
+    k->p00 += dt * (2.0f * k->p01 + dt * k->p11) + q * dt2 * dt * (1.0f / 3.0f);
+    k->p01 += dt * k->p11 + q * dt2 * 0.5f;
+    k->p11 += q * dt;
+    
+    // 更新：H = [1 0]
+    float s = k->p00 + UNIFIED_FILTER_KALMAN_MEAS_VAR;
+    float k0 = k->p00 / s;
+    float k1 = k->p01 / s;
+    float innovation = z - k->pressure;
+    k->pressure += k0 * innovation;
+    k->rate += k1 * innovation;
+    
+    k->p11 -= k1 * k->p01;
+    k->p01 -= k0 * k->p01;
+    k->p00 -= k0 * k->p00;
+}
+
+static void UnifiedFilter_UpdateChannel(filter_channel_state_t* ch, float value, float biquad_out, uint32_t dt_ms) {
+    if (!ch->config.enabled) return;
+    
+    switch (ch->config.filter_type) {
+        case FILTER_TYPE_BIQUAD:
+            ch->output = biquad_out;
+            break;
+            
+        case FILTER_TYPE_MOVING_AVERAGE:
+            ch->output = PlatformFilter_MovingAverageUpdate(ch->ma, value);
+            break;
+            
+        case FILTER_TYPE_LOW_PASS:
+            // 一阶RC低通：按实际采样间隔换算系数，采集周期自适应变化时截止频率不变
+            if (ch->sample_count == 0) {
+                ch->output = value;
+            } else {
+                if (dt_ms > UNIFIED_FILTER_MAX_DT_MS) dt_ms = UNIFIED_FILTER_MAX_DT_MS;
+                float dt = (float)dt_ms * 0.001f;
+                float rc = 1.0f / (2.0f * 3.14159265f * ch->config.cutoff_hz);
+                ch->output = UnifiedFilter_LowPass(ch->output, value, dt / (rc + dt));
+            }
+            break;
+            
+        case FILTER_TYPE_EXPONENTIAL:
+            // 以首个样本初始化，避免从0爬升
+            if (ch->sample_count == 0) {
+                ch->output = value;
+            } else {
+                ch->output = UnifiedFilter_Exponential(ch->output, value, ch->config.alpha);
+            }
+            break;
+            
+        default:
+            ch->output = value;
+            break;
+    }
+    
+    ch->sample_count++;
+}
+
 void UnifiedFilter_Init(void) {
     // 初始化滤波缓冲区
     memset(&g_unified_filter, 0, sizeof(unified_filter_t));
+    UnifiedFilter_BiquadInit();
+    UnifiedFilter_PackedBoxcarInit(&g_unified_filter.raw_codes, ADC_CHANNEL_COUNT);
     
-    // 设置默认配置
-    g_unified_filter.config.filter_type = FILTER_TYPE_MOVING_AVERAGE;
-    g_unified_filter.config.window_size = UNIFIED_FILTER_SIZE;
-    g_unified_filter.config.alpha = UNIFIED_FILTER_ALPHA;
-    g_unified_filter.config.enabled = true;
+    // 设置各通道默认配置：温度指数滤波，压力移动平均
+    filter_config_t temp_config = {
+        .filter_type = UNIFIED_FILTER_TEMP_TYPE,
+        .window_size = UNIFIED_FILTER_SIZE,
+        .alpha = UNIFIED_FILTER_TEMP_ALPHA,
+        .cutoff_hz = UNIFIED_FILTER_CUTOFF_HZ,
+        .enabled = true
+    };
+    filter_config_t pressure_config = {
+        .filter_type = UNIFIED_FILTER_PRESSURE_TYPE,
+        .window_size = UNIFIED_FILTER_PRESSURE_SIZE,
+        .alpha = UNIFIED_FILTER_ALPHA,
+        .cutoff_hz = UNIFIED_FILTER_CUTOFF_HZ,
+        .enabled = true
+    };
+    
+    (void)UnifiedFilter_ConfigureChannel(FILTER_CHANNEL_OIL_TEMP, &temp_config);
+    (void)UnifiedFilter_ConfigureChannel(FILTER_CHANNEL_LNG_TEMP, &temp_config);
+    (void)UnifiedFilter_ConfigureChannel(FILTER_CHANNEL_OIL_PRESSURE, &pressure_config);
+    (void)UnifiedFilter_ConfigureChannel(FILTER_CHANNEL_LNG_PRESSURE, &pressure_config);
+    g_filter_default_config[FILTER_CHANNEL_OIL_TEMP] = temp_config;
+    g_filter_default_config[FILTER_CHANNEL_LNG_TEMP] = temp_config;
+    g_filter_default_config[FILTER_CHANNEL_OIL_PRESSURE] = pressure_config;
+    g_filter_default_config[FILTER_CHANNEL_LNG_PRESSURE] = pressure_config;
+    
+    // 压力通道启用尖峰剔除（电磁阀/PWM开关干扰）
+    hampel_config_t spike_config = {
+        .enabled = true,
+        .window_size = UNIFIED_FILTER_HAMPEL_WINDOW,
+        .threshold = UNIFIED_FILTER_HAMPEL_THRESHOLD,
+        .min_deviation = UNIFIED_FILTER_HAMPEL_MIN_DEV
+    };
+    (void)UnifiedFilter_ConfigureSpikeFilter(FILTER_CHANNEL_OIL_PRESSURE, &spike_config);
+    (void)UnifiedFilter_ConfigureSpikeFilter(FILTER_CHANNEL_LNG_PRESSURE, &spike_config);
     
     g_unified_filter.last_update_time = Platform_GetTimeMs();
     
@@ -44,91 +415,204 @@ void UnifiedFilter_Init(void) {
 void UnifiedFilter_Configure(const filter_config_t* config) {
     if (config == NULL) return;
     
-    g_unified_filter.config = *config;
+    for (uint8_t i = 0; i < FILTER_CHANNEL_COUNT; i++) {
+        (void)UnifiedFilter_ConfigureChannel((filter_channel_t)i, config);
+    }
 }
 
-void UnifiedFilter_UpdateData(float oil_temp, float lng_temp, 
-                             float oil_pressure, float lng_pressure) {
-    if (!g_unified_filter.config.enabled) return;
+bool UnifiedFilter_ConfigureChannel(filter_channel_t channel, const filter_config_t* config) {
+    if (channel >= FILTER_CHANNEL_COUNT || config == NULL) return false;
     
-    uint32_t current_time = Platform_GetTimeMs();
-    
-    // 根据滤波类型选择算法
-    switch (g_unified_filter.config.filter_type) {
+    // 参数检查
+    switch (config->filter_type) {
         case FILTER_TYPE_MOVING_AVERAGE:
-            // 移动平均滤波
-            g_unified_filter.oil_temp_buffer[g_unified_filter.oil_temp_index] = oil_temp;
-            g_unified_filter.oil_temp_index = (g_unified_filter.oil_temp_index + 1) % g_unified_filter.config.window_size;
-            
-            g_unified_filter.lng_temp_buffer[g_unified_filter.lng_temp_index] = lng_temp;
-            g_unified_filter.lng_temp_index = (g_unified_filter.lng_temp_index + 1) % g_unified_filter.config.window_size;
-            
-            g_unified_filter.oil_pressure_buffer[g_unified_filter.oil_pressure_index] = oil_pressure;
-            g_unified_filter.oil_pressure_index = (g_unified_filter.oil_pressure_index + 1) % g_unified_filter.config.window_size;
-            
-            g_unified_filter.lng_pressure_buffer[g_unified_filter.lng_pressure_index] = lng_pressure;
-            g_unified_filter.lng_pressure_index = (g_unified_filter.lng_pressure_index + 1) % g_unified_filter.config.window_size;
+            // 窗口须为2的幂且不超过PLATFORM_MA_MAX_WINDOW（环形索引用掩码回绕），不做隐式取整
+            if (config->window_size == 0 || config->window_size > PLATFORM_MA_MAX_WINDOW ||
+                (config->window_size & (config->window_size - 1U)) != 0U) return false;
             break;
-            
         case FILTER_TYPE_LOW_PASS:
+            if (!(config->cutoff_hz > 0.0f)) return false;
+            break;
         case FILTER_TYPE_EXPONENTIAL:
-            // 低通滤波和指数滤波需要上次的滤波值，这里简化处理
-            g_unified_filter.oil_temp_buffer[g_unified_filter.oil_temp_index] = oil_temp;
-            g_unified_filter.oil_temp_index = (g_unified_filter.oil_temp_index + 1) % g_unified_filter.config.window_size;
-            
-            g_unified_filter.lng_temp_buffer[g_unified_filter.lng_temp_index] = lng_temp;
-            g_unified_filter.lng_temp_index = (g_unified_filter.lng_temp_index + 1) % g_unified_filter.config.window_size;
-            
-            g_unified_filter.oil_pressure_buffer[g_unified_filter.oil_pressure_index] = oil_pressure;
-            g_unified_filter.oil_pressure_index = (g_unified_filter.oil_pressure_index + 1) % g_unified_filter.config.window_size;
-            
-            g_unified_filter.lng_pressure_buffer[g_unified_filter.lng_pressure_index] = lng_pressure;
-            g_unified_filter.lng_pressure_index = (g_unified_filter.lng_pressure_index + 1) % g_unified_filter.config.window_size;
+            if (!(config->alpha > 0.0f && config->alpha <= 1.0f)) return false;
             break;
+        case FILTER_TYPE_BIQUAD:
+            break;
+        default:
+            return false;
     }
     
-    g_unified_filter.filter_count++;
-    g_unified_filter.last_update_time = current_time;
+    filter_channel_state_t* ch = &g_unified_filter.channels[channel];
+    bool rebuild = (ch->sample_count == 0) || (config->filter_type != ch->config.filter_type);
+    
+    if (config->filter_type == FILTER_TYPE_MOVING_AVERAGE) {
+        if (ch->ma == NULL) {
+            ch->ma = UnifiedFilter_AllocMovingAverage();
+            if (ch->ma == NULL) return false;
+            rebuild = true;
+        }
+        if (config->window_size != ch->config.window_size) {
+            rebuild = true;
+        }
+    } else {
+        ch->ma = NULL;  // 释放回缓冲区池
+    }
+    
+    ch->config = *config;
+    if (rebuild) {
+        UnifiedFilter_ResetChannel(ch);
+    }
+    return true;
 }
 
-float UnifiedFilter_GetFilteredOilTemperature(void) {
-    if (!g_unified_filter.config.enabled) return 0.0f;
+bool UnifiedFilter_GetChannelConfig(filter_channel_t channel, filter_config_t* config) {
+    if (channel >= FILTER_CHANNEL_COUNT || config == NULL) return false;
     
-    float sum = 0.0f;
-    for (int i = 0; i < g_unified_filter.config.window_size; i++) {
-        sum += g_unified_filter.oil_temp_buffer[i];
-    }
-    return sum / g_unified_filter.config.window_size;
+    *config = g_unified_filter.channels[channel].config;
+    return true;
 }
 
-float UnifiedFilter_GetFilteredLNGTemperature(void) {
-    if (!g_unified_filter.config.enabled) return 0.0f;
+bool UnifiedFilter_ConfigureSpikeFilter(filter_channel_t channel, const hampel_config_t* config) {
+    if (channel >= FILTER_CHANNEL_COUNT || config == NULL) return false;
+    if (config->enabled &&
+        (config->window_size < 3U || config->window_size > UNIFIED_FILTER_HAMPEL_MAX_WINDOW ||
+         (config->window_size & 1U) == 0U || !(config->threshold > 0.0f) || config->min_deviation < 0.0f)) {
+        return false;
+    }
     
-    float sum = 0.0f;
-    for (int i = 0; i < g_unified_filter.config.window_size; i++) {
-        sum += g_unified_filter.lng_temp_buffer[i];
+    hampel_filter_t* hf = &g_unified_filter.channels[channel].spike;
+    bool rebuild = (config->window_size != hf->config.window_size) || (config->enabled && !hf->config.enabled);
+    hf->config = *config;
+    if (rebuild) {
+        UnifiedFilter_ResetSpike(hf);
     }
-    return sum / g_unified_filter.config.window_size;
+    return true;
 }
 
-float UnifiedFilter_GetFilteredOilPressure(void) {
-    if (!g_unified_filter.config.enabled) return 0.0f;
+uint32_t UnifiedFilter_GetSpikeRejectCount(filter_channel_t channel) {
+    if (channel >= FILTER_CHANNEL_COUNT) return 0;
     
-    float sum = 0.0f;
-    for (int i = 0; i < g_unified_filter.config.window_size; i++) {
-        sum += g_unified_filter.oil_pressure_buffer[i];
+    return g_unified_filter.channels[channel].spike.rejected_count;
+}
+
+bool UnifiedFilter_SetBiquad(filter_channel_t channel, const biquad_coeffs_t* coeffs, uint8_t sections) {
+    if (channel >= FILTER_CHANNEL_COUNT || coeffs == NULL ||
+        sections == 0U || sections > UNIFIED_FILTER_BIQUAD_SECTIONS) {
+        return false;
+    }
+    for (uint8_t s = 0; s < sections; s++) {
+        if (!UnifiedFilter_BiquadIsValid(&coeffs[s])) return false;
     }
-    return sum / g_unified_filter.config.window_size;
+    
+    biquad_engine_t* eng = &g_unified_filter.biquad;
+    uint8_t next = (uint8_t)(eng->active ^ 1U);
+    
+    for (uint8_t s = 0; s < UNIFIED_FILTER_BIQUAD_SECTIONS; s++) {
+        if (s < sections) {
+            eng->coeffs[s][channel] = coeffs[s];
+        } else {
+            UnifiedFilter_BiquadPassthrough(&eng->coeffs[s][channel]);
+        }
+    }
+    eng->sections[channel] = sections;
+    
+    // 写入备用组后一次切换；该通道状态按当前输出重新初始化
+    UnifiedFilter_BiquadLoadBank(next);
+    UnifiedFilter_BiquadPrime((uint8_t)channel, g_unified_filter.channels[channel].output);
+    eng->active = next;
+    return true;
 }
 
-float UnifiedFilter_GetFilteredLNGPressure(void) {
-    if (!g_unified_filter.config.enabled) return 0.0f;
+void UnifiedFilter_UpdateData(float oil_temp, float lng_temp, 
+                             float oil_pressure, float lng_pressure) {
+    float values[FILTER_CHANNEL_COUNT];
     
-    float sum = 0.0f;
-    for (int i = 0; i < g_unified_filter.config.window_size; i++) {
-        sum += g_unified_filter.lng_pressure_buffer[i];
+    values[FILTER_CHANNEL_OIL_TEMP] = oil_temp;
+    values[FILTER_CHANNEL_LNG_TEMP] = lng_temp;
+    values[FILTER_CHANNEL_OIL_PRESSURE] = oil_pressure;
+    values[FILTER_CHANNEL_LNG_PRESSURE] = lng_pressure;
+    UnifiedFilter_UpdateChannels(values);
+}
+
+void UnifiedFilter_UpdateChannels(const float values[FILTER_CHANNEL_COUNT]) {
+    uint32_t current_time = Platform_GetTimeMs();
+    uint32_t dt_ms = current_time - g_unified_filter.last_update_time;
+    float x[FILTER_CHANNEL_COUNT];
+    float y[FILTER_CHANNEL_COUNT];
+    uint8_t biquad_list[FILTER_CHANNEL_COUNT];
+    uint8_t biquad_count = 0;
+    uint8_t i;
+    
+    memcpy(x, values, sizeof(x));
+    memcpy(y, values, sizeof(y));
+    for (i = 0; i < FILTER_CHANNEL_COUNT; i++) {
+        filter_channel_state_t* ch = &g_unified_filter.channels[i];
+        if (!ch->config.enabled) continue;
+        
+        // 尖峰剔除前置级
+        if (ch->spike.config.enabled) {
+            x[i] = UnifiedFilter_HampelUpdate(&ch->spike, x[i]);
+        }
+        // Biquad通道首个样本按直流稳态初始化
+        if (ch->config.filter_type == FILTER_TYPE_BIQUAD) {
+            if (ch->sample_count == 0) {
+                UnifiedFilter_BiquadPrime(i, x[i]);
+            }
+            biquad_list[biquad_count++] = i;
+        }
     }
-    return sum / g_unified_filter.config.window_size;
+    
+    // 只计算启用的Biquad通道（默认配置无Biquad通道，整级跳过）
+    if (biquad_count > 0U) {
+        UnifiedFilter_BiquadProcess(biquad_list, biquad_count, x, y);
+    }
+    
+    // 压力Kalman估计（与通道平滑滤波并行，输入为尖峰剔除后的测量值）
+    UnifiedFilter_KalmanUpdate(&g_unified_filter.kalman[0], x[FILTER_CHANNEL_OIL_PRESSURE], dt_ms);
+    UnifiedFilter_KalmanUpdate(&g_unified_filter.kalman[1], x[FILTER_CHANNEL_LNG_PRESSURE], dt_ms);
+    
+    for (i = 0; i < FILTER_CHANNEL_COUNT; i++) {
+        UnifiedFilter_UpdateChannel(&g_unified_filter.channels[i], x[i], y[i], dt_ms);
+    }
+    
+    g_unified_filter.filter_count++;
+    g_unified_filter.last_update_time = current_time;
+}
+
+float UnifiedFilter_GetFiltered(filter_channel_t channel) {
+    if (channel >= FILTER_CHANNEL_COUNT) return 0.0f;
+    
+    const filter_channel_state_t* ch = &g_unified_filter.channels[channel];
+    if (!ch->config.enabled) return 0.0f;
+    
+    return ch->output;
+}
+
+bool UnifiedFilter_GetPressureEstimate(filter_channel_t channel, float* pressure, float* rate) {
+    if (channel != FILTER_CHANNEL_OIL_PRESSURE && channel != FILTER_CHANNEL_LNG_PRESSURE) return false;
+    
+    const pressure_kalman_t* k = &g_unified_filter.kalman[channel - FILTER_CHANNEL_OIL_PRESSURE];
+    if (!k->initialized) return false;
+    
+    if (pressure != NULL) *pressure = k->pressure;
+    if (rate != NULL) *rate = k->rate;
+    return true;
+}
+
+float UnifiedFilter_GetFilteredOilTemperature(void) {
+    return UnifiedFilter_GetFiltered(FILTER_CHANNEL_OIL_TEMP);
+}
+
+float UnifiedFilter_GetFilteredLNGTemperature(void) {
+    return UnifiedFilter_GetFiltered(FILTER_CHANNEL_LNG_TEMP);
+}
+
+float UnifiedFilter_GetFilteredOilPressure(void) {
+    return UnifiedFilter_GetFiltered(FILTER_CHANNEL_OIL_PRESSURE);
+}
+
+float UnifiedFilter_GetFilteredLNGPressure(void) {
+    return UnifiedFilter_GetFiltered(FILTER_CHANNEL_LNG_PRESSURE);
 }
 
 void UnifiedFilter_GetAllFilteredData(unified_sensor_data_t* data) {
@@ -144,7 +628,9 @@ void UnifiedFilter_GetAllFilteredData(unified_sensor_data_t* data) {
 float UnifiedFilter_MovingAverage(float* buffer, uint8_t* index, 
                                  uint8_t window_size, float new_value) {
     buffer[*index] = new_value;
-    *index = (*index + 1) % window_size;
+    if (++(*index) >= window_size) {
+        *index = 0;
+    }
     
     float sum = 0.0f;
     for (int i = 0; i < window_size; i++) {
@@ -162,15 +648,13 @@ float UnifiedFilter_Exponential(float last_filtered, float new_value, float alph
 }
 
 void UnifiedFilter_Reset(void) {
-    memset(g_unified_filter.oil_temp_buffer, 0, sizeof(g_unified_filter.oil_temp_buffer));
-    memset(g_unified_filter.lng_temp_buffer, 0, sizeof(g_unified_filter.lng_temp_buffer));
-    memset(g_unified_filter.oil_pressure_buffer, 0, sizeof(g_unified_filter.oil_pressure_buffer));
-    memset(g_unified_filter.lng_pressure_buffer, 0, sizeof(g_unified_filter.lng_pressure_buffer));
-    
-    g_unified_filter.oil_temp_index = 0;
-    g_unified_filter.lng_temp_index = 0;
-    g_unified_filter.oil_pressure_index = 0;
-    g_unified_filter.lng_pressure_index = 0;
+    for (uint8_t i = 0; i < FILTER_CHANNEL_COUNT; i++) {
+        UnifiedFilter_ResetChannel(&g_unified_filter.channels[i]);
+        UnifiedFilter_ResetSpike(&g_unified_filter.channels[i].spike);
+    }
+    g_unified_filter.kalman[0].initialized = false;
+    g_unified_filter.kalman[1].initialized = false;
+    UnifiedFilter_PackedBoxcarInit(&g_unified_filter.raw_codes, ADC_CHANNEL_COUNT);
     
     g_unified_filter.filter_count = 0;
     g_unified_filter.last_update_time = Platform_GetTimeMs();
@@ -178,7 +662,169 @@ void UnifiedFilter_Reset(void) {
 }
 
 bool UnifiedFilter_IsReady(void) {
-    return g_unified_filter.filter_count >= g_unified_filter.config.window_size;
+    for (uint8_t i = 0; i < FILTER_CHANNEL_COUNT; i++) {
+        const filter_channel_state_t* ch = &g_unified_filter.channels[i];
+        if (!ch->config.enabled) continue;
+        
+        if (ch->ma != NULL) {
+            if (ch->ma->count < ch->ma->window) return false;
+        } else if (ch->sample_count == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* ==================== 原始码值打包滤波 ==================== */
+
+void UnifiedFilter_PackedBoxcarInit(packed_boxcar_t* bc, uint8_t channels) {
+    if (bc == NULL) return;
+    
+    if (channels == 0U) channels = 1U;
+    if (channels > UNIFIED_FILTER_RAW_MAX_CHANNELS) channels = UNIFIED_FILTER_RAW_MAX_CHANNELS;
+    
+    memset(bc, 0, sizeof(packed_boxcar_t));
+    bc->channels = channels;
+    bc->words = (uint8_t)((channels + 1U) / 2U);
+}
+
+void UnifiedFilter_PackedBoxcarUpdate(packed_boxcar_t* bc, const uint16_t* codes) {
+    if (bc == NULL || codes == NULL) return;
+    
+    uint32_t* slot = bc->history[bc->index];
+    
+    for (uint8_t w = 0; w < bc->words; w++) {
+        uint8_t ch = (uint8_t)(w * 2U);
+        uint16_t lo = codes[ch] & UNIFIED_FILTER_RAW_CODE_MASK;
+        uint16_t hi = (ch + 1U < bc->channels) ? (codes[ch + 1U] & UNIFIED_FILTER_RAW_CODE_MASK) : 0U;
+        uint32_t sample = (uint32_t)lo | ((uint32_t)hi << 16);
+        
+        // 窗口和 += 新样本 - 移出样本（两通道一条SSUB16 + 一条SADD16）
+        bc->sum[w] = DSP_Sadd16(bc->sum[w], DSP_Ssub16(sample, slot[w]));
+        slot[w] = sample;
+    }
+    
+    bc->index = (uint8_t)((bc->index + 1U) & (UNIFIED_FILTER_RAW_WINDOW - 1U));
+    if (bc->count < UNIFIED_FILTER_RAW_WINDOW) {
+        bc->count++;
+    }
+}
+
+uint16_t UnifiedFilter_PackedBoxcarGetQ3(const packed_boxcar_t* bc, uint8_t channel) {
+    if (bc == NULL || channel >= bc->channels || bc->count == 0U) return 0U;
+    
+    uint32_t word = bc->sum[channel / 2U];
+    uint32_t sum = (channel & 1U) ? (word >> 16) : (word & 0xFFFFU);
+    if (bc->count >= UNIFIED_FILTER_RAW_WINDOW) {
+        return (uint16_t)(sum << (3U - UNIFIED_FILTER_RAW_WINDOW_LOG2));
+    }
+    return (uint16_t)((sum * 8U) / bc->count);
+}
+
+void UnifiedFilter_UpdateRawCodes(const uint16_t* codes) {
+    UnifiedFilter_PackedBoxcarUpdate(&g_unified_filter.raw_codes, codes);
+}
+
+uint16_t UnifiedFilter_GetRawMeanQ3(uint8_t adc_channel) {
+    return UnifiedFilter_PackedBoxcarGetQ3(&g_unified_filter.raw_codes, adc_channel);
+}
+
+/* ==================== Biquad系数CAN接口 ==================== */
+
+static void UnifiedFilter_SendAck(uint8_t cmd, biquad_result_t result, uint8_t channel, uint8_t sections) {
+    uint8_t data[8] = {0};
+    
+    data[0] = cmd;
+    data[1] = (uint8_t)result;
+    data[2] = channel;
+    data[3] = sections;
+    data[4] = g_unified_filter.biquad.active;
+    
+    CAN_Config_SendMessage(CAN_MSG_PARAM_ACK_ID, data, 8, true);
+}
+
+bool UnifiedFilter_HandleCanFrame(const uint8_t* data, uint8_t length) {
+    if (data == NULL || length < 1U) {
+        return false;
+    }
+    
+    switch (data[0]) {
+        case FILTER_CMD_BIQUAD_COEFF: {
+            // 提交处理中不改暂存区（上位机按应答重发）
+            if (g_filter_pending_cmd == FILTER_CMD_BIQUAD_COMMIT || length < 8U) {
+                return true;
+            }
+            uint8_t channel = data[1];
+            uint8_t section = data[2];
+            uint8_t index = data[3];
+            if (channel >= FILTER_CHANNEL_COUNT || section >= UNIFIED_FILTER_BIQUAD_SECTIONS ||
+                index >= BIQUAD_COEFFS_PER_SECTION) {
+                return true;
+            }
+            // 切换通道时清空暂存区
+            if (channel != g_biquad_staging_channel) {
+                g_biquad_staging_channel = channel;
+                g_biquad_staging_mask = 0U;
+            }
+            float value;
+            memcpy(&value, &data[4], sizeof(value));
+            (&g_biquad_staging[section].b0)[index] = value;
+            g_biquad_staging_mask |= (uint16_t)(1U << (section * BIQUAD_COEFFS_PER_SECTION + index));
+            return true;
+        }
+        
+        case FILTER_CMD_BIQUAD_COMMIT:
+        case FILTER_CMD_BIQUAD_DISABLE:
+            // 切换放到任务中执行，上一条未处理完时丢弃
+            if (g_filter_pending_cmd == 0U && length >= 2U) {
+                g_filter_pending_channel = data[1];
+                g_filter_pending_sections = (length >= 3U) ? data[2] : 0U;
+                g_filter_pending_cmd = data[0];
+            }
+            return true;
+            
+        default:
+            return false;
+    }
+}
+
+void UnifiedFilter_Task(void) {
+    uint8_t cmd = g_filter_pending_cmd;
+    if (cmd == 0U) {
+        return;
+    }
+    
+    uint8_t channel = g_filter_pending_channel;
+    uint8_t sections = g_filter_pending_sections;
+    biquad_result_t result = BIQUAD_RESULT_OK;
+    
+    if (channel >= FILTER_CHANNEL_COUNT) {
+        result = BIQUAD_RESULT_BAD_PARAM;
+    } else if (cmd == FILTER_CMD_BIQUAD_COMMIT) {
+        uint16_t required = (uint16_t)((1UL << (sections * BIQUAD_COEFFS_PER_SECTION)) - 1U);
+        if (sections == 0U || sections > UNIFIED_FILTER_BIQUAD_SECTIONS) {
+            result = BIQUAD_RESULT_BAD_PARAM;
+        } else if (channel != g_biquad_staging_channel || (g_biquad_staging_mask & required) != required) {
+            result = BIQUAD_RESULT_INCOMPLETE;
+        } else if (!UnifiedFilter_SetBiquad((filter_channel_t)channel, g_biquad_staging, sections)) {
+            result = BIQUAD_RESULT_UNSTABLE;
+        } else {
+            filter_config_t config = g_unified_filter.channels[channel].config;
+            config.filter_type = FILTER_TYPE_BIQUAD;
+            config.enabled = true;
+            (void)UnifiedFilter_ConfigureChannel((filter_channel_t)channel, &config);
+            g_biquad_staging_mask = 0U;
+        }
+    } else {
+        biquad_coeffs_t passthrough;
+        UnifiedFilter_BiquadPassthrough(&passthrough);
+        (void)UnifiedFilter_ConfigureChannel((filter_channel_t)channel, &g_filter_default_config[channel]);
+        (void)UnifiedFilter_SetBiquad((filter_channel_t)channel, &passthrough, 1U);
+        sections = 1U;
+    }
+    
+    UnifiedFilter_SendAck(cmd, result, channel, sections);
+    g_filter_pending_cmd = 0U;
 }
 
 uint32_t UnifiedFilter_GetFilterCount(void) {
@@ -283,6 +929,520 @@ void PlatformPID_Reset(platform_pid_controller_t* pid) {
     pid->last_time = 0;
 }
 
+/* ==================== 定周期PID ==================== */
+/* 周期由调度给定，Init时换算每周期系数，Update只做固定次数乘加：
+ *   u = kp*e + I + D + ff,  D为测量值微分经一阶低通（设定值阶跃不产生微分冲击）
+ *   I += ki*dt*e + kt*dt*(sat(u) - u)  反算抗饱和，输出饱和时积分按超出量回退 */
+
+/*!
+ * @brief 由配置计算每周期系数（浮点/定点共用）
+ */
+static bool PlatformPID_ComputeCoeffs(const platform_pid_config_t* config, platform_float32_t* ki_dt,
+                                      platform_float32_t* kd_dt, platform_float32_t* kt_dt, platform_float32_t* d_beta) {
+    if (config == NULL || !(config->dt > 0.0f) || !(config->output_min < config->output_max)) {
+        return false;
+    }
+    
+    *ki_dt = config->ki * config->dt;
+    *kd_dt = config->kd / config->dt;
+    
+    // 跟踪时间常数默认取积分时间 Ti=kp/ki；纯积分控制时直接钳位
+    platform_float32_t kt = config->tracking_gain;
+    if (kt <= 0.0f) {
+        kt = (config->kp > 0.0f) ? (config->ki / config->kp) : (1.0f / config->dt);
+    }
+    *kt_dt = kt * config->dt;
+    if (*kt_dt > 1.0f) *kt_dt = 1.0f;
+    
+    *d_beta = 1.0f;
+    if (config->derivative_cutoff_hz > 0.0f) {
+        platform_float32_t rc = 1.0f / (2.0f * 3.14159265f * config->derivative_cutoff_hz);
+        *d_beta = config->dt / (config->dt + rc);
+    }
+    return true;
+}
+
+platform_status_t PlatformPIDF_Init(platform_pidf_t* pid, const platform_pid_config_t* config) {
+    if (pid == NULL) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+    
+    platform_float32_t ki_dt, kd_dt, kt_dt, d_beta;
+    if (!PlatformPID_ComputeCoeffs(config, &ki_dt, &kd_dt, &kt_dt, &d_beta)) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+    
+    pid->kp = config->kp;
+    pid->ki_dt = ki_dt;
+    pid->kd_dt = kd_dt;
+    pid->kt_dt = kt_dt;
+    pid->d_beta = d_beta;
+    pid->output_min = config->output_min;
+    pid->output_max = config->output_max;
+    PlatformPIDF_Reset(pid);
+    return PLATFORM_STATUS_OK;
+}
+
+platform_float32_t PlatformPIDF_Update(platform_pidf_t* pid, platform_float32_t setpoint,
+                                       platform_float32_t measurement, platform_float32_t feedforward) {
+    if (pid == NULL) {
+        return 0.0f;
+    }
+    
+    if (!pid->initialized) {
+        pid->last_measurement = measurement;
+        pid->initialized = PLATFORM_TRUE;
+    }
+    
+    platform_float32_t error = setpoint - measurement;
+    platform_float32_t d_raw = (pid->last_measurement - measurement) * pid->kd_dt;
+    pid->derivative += (d_raw - pid->derivative) * pid->d_beta;
+    pid->last_measurement = measurement;
+    
+    platform_float32_t output = pid->kp * error + pid->integral + pid->derivative + feedforward;
+    platform_float32_t limited = output;
+    if (limited > pid->output_max) {
+        limited = pid->output_max;
+    } else if (limited < pid->output_min) {
+        limited = pid->output_min;
+    }
+    
+    pid->integral += pid->ki_dt * error + pid->kt_dt * (limited - output);
+    pid->last_error = error;
+    return limited;
+}
+
+void PlatformPIDF_Bumpless(platform_pidf_t* pid, platform_float32_t setpoint, platform_float32_t measurement,
+                           platform_float32_t feedforward, platform_float32_t output) {
+    if (pid == NULL) {
+        return;
+    }
+    
+    pid->derivative = 0.0f;
+    pid->last_measurement = measurement;
+    pid->last_error = setpoint - measurement;
+    pid->initialized = PLATFORM_TRUE;
+    pid->integral = output - pid->kp * pid->last_error - feedforward;
+}
+
+void PlatformPIDF_Reset(platform_pidf_t* pid) {
+    if (pid == NULL) {
+        return;
+    }
+    
+    pid->integral = 0.0f;
+    pid->derivative = 0.0f;
+    pid->last_measurement = 0.0f;
+    pid->last_error = 0.0f;
+    pid->initialized = PLATFORM_FALSE;
+}
+
+platform_status_t PlatformPIDF_Retune(platform_pidf_t* pid, const platform_pid_config_t* config) {
+    if (pid == NULL) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+    
+    platform_float32_t ki_dt, kd_dt, kt_dt, d_beta;
+    if (!PlatformPID_ComputeCoeffs(config, &ki_dt, &kd_dt, &kt_dt, &d_beta)) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+    
+    // 比例项变化并入积分项；微分状态按新旧微分增益缩放
+    if (pid->initialized) {
+        pid->integral += (pid->kp - config->kp) * pid->last_error;
+        pid->derivative = (pid->kd_dt > 0.0f) ? pid->derivative * (kd_dt / pid->kd_dt) : 0.0f;
+    }
+    
+    pid->kp = config->kp;
+    pid->ki_dt = ki_dt;
+    pid->kd_dt = kd_dt;
+    pid->kt_dt = kt_dt;
+    pid->d_beta = d_beta;
+    pid->output_min = config->output_min;
+    pid->output_max = config->output_max;
+    return PLATFORM_STATUS_OK;
+}
+
+/* Q15 -> Q31（按增益小数位对齐），用乘法而非左移：负数左移为未定义行为 */
+static int64_t PlatformPID_Q15ToQ31(platform_int32_t value) {
+    return (int64_t)value * ((int64_t)1 << PLATFORM_PID_GAIN_FRAC_BITS);
+}
+
+static platform_int32_t PlatformPID_SatQ31(int64_t value) {
+    if (value > (int64_t)INT32_MAX) return INT32_MAX;
+    if (value < (int64_t)INT32_MIN) return INT32_MIN;
+    return (platform_int32_t)value;
+}
+
+static platform_int32_t PlatformPID_ToQ16(platform_float32_t value) {
+    platform_float32_t scaled = value * (platform_float32_t)(1UL << PLATFORM_PID_GAIN_FRAC_BITS);
+    if (scaled >= 2147483647.0f) return INT32_MAX;
+    if (scaled <= -2147483648.0f) return INT32_MIN;
+    return (platform_int32_t)(scaled + ((scaled >= 0.0f) ? 0.5f : -0.5f));
+}
+
+static platform_int16_t PlatformPID_ToQ15(platform_float32_t value) {
+    if (value >= 1.0f) return INT16_MAX;
+    if (value <= -1.0f) return INT16_MIN;
+    return (platform_int16_t)(value * 32768.0f);
+}
+
+platform_status_t PlatformPIDQ_Init(platform_pidq_t* pid, const platform_pid_config_t* config) {
+    if (pid == NULL) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+    
+    platform_float32_t ki_dt, kd_dt, kt_dt, d_beta;
+    if (!PlatformPID_ComputeCoeffs(config, &ki_dt, &kd_dt, &kt_dt, &d_beta)) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+    
+    pid->kp = PlatformPID_ToQ16(config->kp);
+    pid->ki_dt = PlatformPID_ToQ16(ki_dt);
+    pid->kd_dt = PlatformPID_ToQ16(kd_dt);
+    pid->kt_dt = PlatformPID_ToQ16(kt_dt);
+    pid->d_beta = (platform_int32_t)(d_beta * (platform_float32_t)(1UL << PLATFORM_PID_FILTER_FRAC_BITS) + 0.5f);
+    pid->output_min = PlatformPID_ToQ15(config->output_min);
+    pid->output_max = PlatformPID_ToQ15(config->output_max);
+    PlatformPIDQ_Reset(pid);
+    return PLATFORM_STATUS_OK;
+}
+
+/* Q15误差 × Q15.16增益 = Q31，中间量用64位（Cortex-M4 SMULL/SMLAL单周期） */
+platform_int16_t PlatformPIDQ_Update(platform_pidq_t* pid, platform_int16_t setpoint,
+                                     platform_int16_t measurement, platform_int16_t feedforward) {
+    if (pid == NULL) {
+        return 0;
+    }
+    
+    if (!pid->initialized) {
+        pid->last_measurement = measurement;
+        pid->initialized = PLATFORM_TRUE;
+    }
+    
+    platform_int32_t error = (platform_int32_t)setpoint - measurement;
+    platform_int32_t d_raw = PlatformPID_SatQ31((int64_t)((platform_int32_t)pid->last_measurement - measurement) * pid->kd_dt);
+    pid->derivative = PlatformPID_SatQ31((int64_t)pid->derivative +
+                                         ((((int64_t)d_raw - pid->derivative) * pid->d_beta) >> PLATFORM_PID_FILTER_FRAC_BITS));
+    pid->last_measurement = measurement;
+    
+    int64_t output = (int64_t)error * pid->kp + pid->integral + pid->derivative +
+                     PlatformPID_Q15ToQ31(feedforward);
+    int64_t limited = output;
+    int64_t output_max = PlatformPID_Q15ToQ31(pid->output_max);
+    int64_t output_min = PlatformPID_Q15ToQ31(pid->output_min);
+    if (limited > output_max) {
+        limited = output_max;
+    } else if (limited < output_min) {
+        limited = output_min;
+    }
+    
+    platform_int32_t excess = PlatformPID_SatQ31(limited - output);
+    pid->integral = PlatformPID_SatQ31((int64_t)pid->integral + (int64_t)error * pid->ki_dt +
+                                       (((int64_t)excess * pid->kt_dt) >> PLATFORM_PID_GAIN_FRAC_BITS));
+    return (platform_int16_t)(limited >> PLATFORM_PID_GAIN_FRAC_BITS);
+}
+
+void PlatformPIDQ_Bumpless(platform_pidq_t* pid, platform_int16_t setpoint, platform_int16_t measurement,
+                           platform_int16_t feedforward, platform_int16_t output) {
+    if (pid == NULL) {
+        return;
+    }
+    
+    pid->derivative = 0;
+    pid->last_measurement = measurement;
+    pid->initialized = PLATFORM_TRUE;
+    pid->integral = PlatformPID_SatQ31(PlatformPID_Q15ToQ31(output) -
+                                       (int64_t)((platform_int32_t)setpoint - measurement) * pid->kp -
+                                       PlatformPID_Q15ToQ31(feedforward));
+}
+
+void PlatformPIDQ_Reset(platform_pidq_t* pid) {
+    if (pid == NULL) {
+        return;
+    }
+    
+    pid->integral = 0;
+    pid->derivative = 0;
+    pid->last_measurement = 0;
+    pid->initialized = PLATFORM_FALSE;
+}
+
+/* ==================== 继电器自整定 ==================== */
+/* 继电器幅值d、滞环ε下测量值振荡半峰峰值a，描述函数法：Ku = 4d / (π·sqrt(a² - ε²))，Tu为振荡周期 */
+
+platform_status_t PlatformRelayTune_Start(platform_relay_tune_t* tune, const platform_relay_tune_config_t* config) {
+    if (tune == NULL || config == NULL || !(config->dt > 0.0f) || !(config->hysteresis >= 0.0f) ||
+        !(config->amplitude > 0.0f) || !(config->max_deviation > config->hysteresis) ||
+        config->measure_cycles == 0U || config->timeout_samples == 0U) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+    
+    memset(tune, 0, sizeof(platform_relay_tune_t));
+    tune->config = *config;
+    tune->relay = 1;
+    tune->peak_max = -1.0e30f;
+    tune->peak_min = 1.0e30f;
+    tune->state = PLATFORM_TUNE_RUNNING;
+    return PLATFORM_STATUS_OK;
+}
+
+static void PlatformRelayTune_Finish(platform_relay_tune_t* tune) {
+    const platform_relay_tune_config_t* c = &tune->config;
+    platform_float32_t n = (platform_float32_t)c->measure_cycles;
+    platform_float32_t a = tune->amplitude_sum / n;
+    platform_float32_t a2 = a * a - c->hysteresis * c->hysteresis;
+    
+    if (!(a2 > 0.0f) || tune->output_count == 0U) {
+        tune->state = PLATFORM_TUNE_FAILED;
+        return;
+    }
+    
+    tune->ku = 4.0f * c->amplitude / (3.14159265f * sqrtf(a2));
+    tune->tu = (tune->period_sum / n) * c->dt;
+    
+    platform_float32_t kp, ti, td;
+    switch (c->rule) {
+        case PLATFORM_TUNE_RULE_ZN_PID:
+            kp = 0.6f * tune->ku;
+            ti = 0.5f * tune->tu;
+            td = 0.125f * tune->tu;
+            break;
+        case PLATFORM_TUNE_RULE_ZN_PI:
+            kp = 0.45f * tune->ku;
+            ti = tune->tu / 1.2f;
+            td = 0.0f;
+            break;
+        case PLATFORM_TUNE_RULE_TYREUS_LUYBEN_PI:
+        default:
+            kp = tune->ku / 3.2f;
+            ti = 2.2f * tune->tu;
+            td = 0.0f;
+            break;
+    }
+    tune->gains.kp = kp;
+    tune->gains.ki = kp / ti;
+    tune->gains.kd = kp * td;
+    tune->gains.feedforward = tune->output_sum / (platform_float32_t)tune->output_count;
+    tune->state = PLATFORM_TUNE_DONE;
+}
+
+platform_float32_t PlatformRelayTune_Update(platform_relay_tune_t* tune, platform_float32_t measurement) {
+    if (tune == NULL) {
+        return 0.0f;
+    }
+    
+    const platform_relay_tune_config_t* c = &tune->config;
+    if (tune->state != PLATFORM_TUNE_RUNNING) {
+        return c->bias;
+    }
+    
+    platform_float32_t error = c->setpoint - measurement;
+    tune->samples++;
+    if (error > c->max_deviation || error < -c->max_deviation || tune->samples > c->timeout_samples) {
+        tune->state = PLATFORM_TUNE_FAILED;
+        return c->bias;
+    }
+    
+    if (measurement > tune->peak_max) tune->peak_max = measurement;
+    if (measurement < tune->peak_min) tune->peak_min = measurement;
+    
+    if (tune->relay > 0 && error < -c->hysteresis) {
+        tune->relay = -1;
+    } else if (tune->relay < 0 && error > c->hysteresis) {
+        // 向上切换：一个完整周期结束（首次切换前的半周期不计）
+        tune->relay = 1;
+        if (tune->last_rise != 0U) {
+            tune->cycles++;
+            if (tune->cycles > c->settle_cycles) {
+                tune->period_sum += (platform_float32_t)(tune->samples - tune->last_rise);
+                tune->amplitude_sum += 0.5f * (tune->peak_max - tune->peak_min);
+                if (tune->cycles >= (platform_uint8_t)(c->settle_cycles + c->measure_cycles)) {
+                    PlatformRelayTune_Finish(tune);
+                    return c->bias;
+                }
+            }
+        }
+        tune->last_rise = tune->samples;
+        tune->peak_max = measurement;
+        tune->peak_min = measurement;
+    }
+    
+    platform_float32_t output = c->bias + (platform_float32_t)tune->relay * c->amplitude;
+    if (tune->last_rise != 0U && tune->cycles >= c->settle_cycles) {
+        tune->output_sum += output;
+        tune->output_count++;
+    }
+    return output;
+}
+
+void PlatformRelayTune_Abort(platform_relay_tune_t* tune) {
+    if (tune != NULL && tune->state == PLATFORM_TUNE_RUNNING) {
+        tune->state = PLATFORM_TUNE_FAILED;
+    }
+}
+
+/* ==================== 增益调度表 ==================== */
+
+platform_status_t PlatformSchedule_AxisInit(platform_sched_axis_t* axis, const platform_float32_t* points, platform_uint8_t count) {
+    if (axis == NULL || points == NULL || count == 0U || count > PLATFORM_SCHED_MAX_POINTS) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+    
+    for (platform_uint8_t i = 0; i < count; i++) {
+        axis->points[i] = points[i];
+        axis->inv_span[i] = 0.0f;
+        if (i > 0U) {
+            platform_float32_t span = points[i] - points[i - 1U];
+            if (!(span > 0.0f)) {
+                return PLATFORM_STATUS_INVALID_PARAM;
+            }
+            axis->inv_span[i - 1U] = 1.0f / span;
+        }
+    }
+    axis->count = count;
+    axis->segment = 0U;
+    return PLATFORM_STATUS_OK;
+}
+
+platform_float32_t PlatformSchedule_AxisLocate(platform_sched_axis_t* axis, platform_float32_t value) {
+    if (axis == NULL || axis->count < 2U) {
+        return 0.0f;
+    }
+    
+    platform_uint8_t seg = axis->segment;
+    if (seg + 1U >= axis->count) {
+        seg = 0U;
+    }
+    while (seg > 0U && value < axis->points[seg]) {
+        seg--;
+    }
+    while (seg + 2U < axis->count && value >= axis->points[seg + 1U]) {
+        seg++;
+    }
+    axis->segment = seg;
+    
+    platform_float32_t frac = (value - axis->points[seg]) * axis->inv_span[seg];
+    if (frac < 0.0f) frac = 0.0f;
+    if (frac > 1.0f) frac = 1.0f;
+    return frac;
+}
+
+platform_status_t PlatformSchedule_Init(platform_gain_schedule_t* sched,
+                                        const platform_float32_t* x_points, platform_uint8_t x_count,
+                                        const platform_float32_t* y_points, platform_uint8_t y_count,
+                                        const platform_gain_set_t* table, platform_uint8_t stride) {
+    if (sched == NULL || table == NULL || stride < y_count) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+    if (PlatformSchedule_AxisInit(&sched->axis_x, x_points, x_count) != PLATFORM_STATUS_OK ||
+        PlatformSchedule_AxisInit(&sched->axis_y, y_points, y_count) != PLATFORM_STATUS_OK) {
+        return PLATFORM_STATUS_INVALID_PARAM;
+    }
+    sched->table = table;
+    sched->stride = stride;
+    return PLATFORM_STATUS_OK;
+}
+
+static platform_float32_t PlatformSchedule_Bilinear(platform_float32_t v00, platform_float32_t v01,
+                                                    platform_float32_t v10, platform_float32_t v11,
+                                                    platform_float32_t fx, platform_float32_t fy) {
+    platform_float32_t v0 = v00 + (v01 - v00) * fy;
+    platform_float32_t v1 = v10 + (v11 - v10) * fy;
+    return v0 + (v1 - v0) * fx;
+}
+
+void PlatformSchedule_Lookup(platform_gain_schedule_t* sched, platform_float32_t x, platform_float32_t y,
+                             platform_gain_set_t* gains) {
+    if (sched == NULL || sched->table == NULL || gains == NULL) {
+        return;
+    }
+    
+    platform_float32_t fx = PlatformSchedule_AxisLocate(&sched->axis_x, x);
+    platform_float32_t fy = PlatformSchedule_AxisLocate(&sched->axis_y, y);
+    
+    // 单点轴的相邻节点即自身，一维表按同一公式计算
+    platform_uint32_t step_x = (sched->axis_x.count > 1U) ? sched->stride : 0U;
+    platform_uint32_t step_y = (sched->axis_y.count > 1U) ? 1U : 0U;
+    const platform_gain_set_t* g00 = &sched->table[sched->axis_x.segment * sched->stride + sched->axis_y.segment];
+    const platform_gain_set_t* g01 = g00 + step_y;
+    const platform_gain_set_t* g10 = g00 + step_x;
+    const platform_gain_set_t* g11 = g10 + step_y;
+    
+    gains->kp = PlatformSchedule_Bilinear(g00->kp, g01->kp, g10->kp, g11->kp, fx, fy);
+    gains->ki = PlatformSchedule_Bilinear(g00->ki, g01->ki, g10->ki, g11->ki, fx, fy);
+    gains->kd = PlatformSchedule_Bilinear(g00->kd, g01->kd, g10->kd, g11->kd, fx, fy);
+    gains->feedforward = PlatformSchedule_Bilinear(g00->feedforward, g01->feedforward,
+                                                   g10->feedforward, g11->feedforward, fx, fy);
+}
+
+/*!
+ * @brief 初始化滑动平均滤波器
+ */
+void PlatformFilter_MovingAverageInit(platform_moving_average_t* ma, platform_uint8_t window) {
+    if (ma == NULL) {
+        return;
+    }
+    
+    // 窗口向下取整为2的幂，环形索引用掩码回绕
+    platform_uint8_t size = 1;
+    while ((platform_uint32_t)size * 2U <= window && (platform_uint32_t)size * 2U <= PLATFORM_MA_MAX_WINDOW) {
+        size = (platform_uint8_t)(size * 2U);
+    }
+    
+    memset(ma, 0, sizeof(platform_moving_average_t));
+    ma->window = size;
+    ma->mask = (platform_uint8_t)(size - 1U);
+    ma->inv_window = 1.0f / (platform_float32_t)size;
+    ma->resum_countdown = PLATFORM_MA_RESUM_PERIOD;
+}
+
+/*!
+ * @brief 滑动平均滤波器更新：累加和减去移出样本、加上新样本
+ */
+platform_float32_t PlatformFilter_MovingAverageUpdate(platform_moving_average_t* ma, platform_float32_t new_value) {
+    if (ma == NULL || ma->window == 0) {
+        return new_value;
+    }
+    
+    platform_float32_t oldest = ma->buffer[ma->index];
+    ma->buffer[ma->index] = new_value;
+    ma->index = (platform_uint8_t)((ma->index + 1U) & ma->mask);
+    
+    if (ma->count < ma->window) {
+        ma->count++;
+        ma->sum += new_value;
+    } else {
+        ma->sum += new_value - oldest;
+    }
+    
+    // 周期性重算累加和，消除增量更新的浮点累积误差
+    if (--ma->resum_countdown == 0U) {
+        platform_float32_t sum = 0.0f;
+        platform_uint8_t i;
+        for (i = 0; i < ma->count; i++) {
+            sum += ma->buffer[i];
+        }
+        ma->sum = sum;
+        ma->resum_countdown = PLATFORM_MA_RESUM_PERIOD;
+    }
+    
+    return PlatformFilter_MovingAverageGet(ma);
+}
+
+/*!
+ * @brief 获取滑动平均滤波器当前输出
+ */
+platform_float32_t PlatformFilter_MovingAverageGet(const platform_moving_average_t* ma) {
+    if (ma == NULL || ma->count == 0) {
+        return 0.0f;
+    }
+    if (ma->count == ma->window) {
+        return ma->sum * ma->inv_window;
+    }
+    return ma->sum / (platform_float32_t)ma->count;
+}
+
 /*!
  * @brief 平台无关移动平均滤波
  */
@@ -293,7 +1453,9 @@ platform_float32_t PlatformFilter_MovingAverage(platform_float32_t* buffer, plat
     }
     
     buffer[*index] = new_value;
-    *index = (*index + 1) % window_size;
+    if (++(*index) >= window_size) {
+        *index = 0;
+    }
     
     platform_float32_t sum = 0.0f;
     platform_uint8_t i;
@@ -6,19 +6,85 @@
  */
 
 #include "valve_control.h"
+#include "valve_current.h"
 #include "sensor.h"
+#include "pressure_capture.h"
+#include "valve_cycle_stats.h"
 #include "gpio_drv.h"
 #include "pwm_common.h"
 #include "pwm_output.h"
+#include "timer_drv.h"
+#include "ckgen_drv.h"
+#include "can_config.h"
 #include "osif.h"
+#include <math.h>
 #include <string.h>
 
+/* ============================================  Define  ============================================ */
+
+#define VALVE_OSC_TIMER_MASK              (1UL << DIRECTIONAL_VALVE_TIMER_CHANNEL)
+#define VALVE_OSC_IRQ                     ((IRQn_Type)((uint32_t)TIMER_CHANNEL0_IRQn + DIRECTIONAL_VALVE_TIMER_CHANNEL))
+#define VALVE_CMD_NONE                    0x00U
+
+#define BYPASS_PWM_INSTANCE               0U
+#define BYPASS_PWM_CLOCK_HZ               ((float)SYSTEM_CLOCK_FREQ_HZ / (float)(BYPASS_PWM_PRESCALER + 1U))
+#define BYPASS_PWM_DITHER_STEPS           32.0f       // 计数抖动分辨率：1/32计数（5位，32个PWM周期循环）
+#define BYPASS_PWM_CH_DITHER_POS          PWM_DITHER0_C2DHR_Pos
+#define BYPASS_PWM_TRIGGER_CHANNEL        PWM_CH_3    // 电流采样匹配触发（无引脚输出）
+
+/* ===========================================  Typedef  ============================================ */
+
+/*!
+ * @brief 换向周期参数（定时器计数）
+ */
+typedef struct {
+    uint32_t on_ticks;                        // 通电相长度
+    uint32_t off_ticks;                       // 断电相长度
+    uint8_t freq_hz;                          // 换向频率(Hz)
+    uint8_t duty;                             // 通电占比(%)
+} valve_osc_cycle_t;
+
 /* ==========================================  Variables  =========================================== */
 
 static valve_control_data_t g_valve_control_data;
 
+/* 定时换向（定时器中断与任务/CAN中断共享） */
+static bool g_osc_timer_ready = false;
+static uint32_t g_osc_clock_hz = 0U;
+static volatile bool g_osc_running = false;
+static volatile bool g_osc_stopping = false;              // 当前周期结束后停止
+static volatile bool g_osc_update = false;                // g_osc_pending待生效
+static volatile uint32_t g_osc_cycles = 0U;               // 已完成换向周期数
+static valve_osc_cycle_t g_osc_active;                    // 当前周期参数
+static valve_osc_cycle_t g_osc_next;                      // 已预装、下一周期使用的参数
+static valve_osc_cycle_t g_osc_pending;                   // 任务侧请求的参数
+static uint8_t g_osc_duty = DIRECTIONAL_VALVE_DEFAULT_DUTY;
+
+/* 旁通阀开度轨迹（PWM0溢出中断推进） */
+static volatile float g_bypass_target = 0.0f;             // 目标开度(%)
+static float g_bypass_velocity = 0.0f;                    // 当前变化速度(%/PWM周期)
+static volatile float g_bypass_rate_step = 0.0f;          // 每PWM周期最大变化量(%)，0为不限制
+static volatile float g_bypass_accel_step = 0.0f;         // 每PWM周期最大速度变化量(%)，0为不做S曲线
+static float g_bypass_rate = BYPASS_RAMP_DEFAULT_RATE;    // 斜率配置(%/s)
+static float g_bypass_accel = BYPASS_RAMP_DEFAULT_ACCEL;  // 加速度配置(%/s²)
+
+/* 旁通阀PWM载波与颤振 */
+static float g_bypass_counts = (float)(BYPASS_PWM_MAX_COUNT + 1U);  // 每周期计数（含MOD抖动小数部分）
+static float g_bypass_period_s = (float)(BYPASS_PWM_MAX_COUNT + 1U) / BYPASS_PWM_CLOCK_HZ;
+static volatile float g_dither_amplitude = 0.0f;          // 低频颤振幅值(%)，0为关闭
+static volatile float g_dither_phase_step = 0.0f;         // 颤振相位增量(周期/PWM周期)
+static float g_dither_phase = 0.0f;                       // 颤振相位(0~1)
+static uint16_t g_dither_freq_hz = BYPASS_DITHER_DEFAULT_FREQ_HZ;
+static bool g_bypass_trigger_enabled = false;            // 电流采样触发点随开度更新
+
+/* 换向命令（CAN中断受理，任务中应答） */
+static volatile uint8_t g_valve_pending_cmd = VALVE_CMD_NONE;
+static uint8_t g_valve_pending_data[CAN_MSG_DATA_MAX_SIZE];
+
 /* ==========================================  Functions  =========================================== */
 
+static void ValveControl_BypassRampCallback(uint8_t instance, uint32_t status, void *userData);
+
 void ValveControl_Init(void)
 {
     memset(&g_valve_control_data, 0, sizeof(valve_control_data_t));
@@ -29,18 +95,340 @@ void ValveControl_Init(void)
     g_valve_control_data.valve_mode = DIRECTIONAL_VALVE_MODE_AUTO;
     // auto_adjustment_enabled 字段已移除
     g_valve_control_data.last_update_time = OSIF_GetMilliseconds();
-    
+
+    // 旁通阀开度轨迹：溢出中断在目标变化时开启
+    ValveControl_SetBypassRamp(g_bypass_rate, g_bypass_accel);
+    NVIC_DisableIRQ(PWM0_OVERFLOW_IRQn);
+    PWM_DRV_InstallOverflowCallback(BYPASS_PWM_INSTANCE, ValveControl_BypassRampCallback);
+}
+
+/* ==================== 换向阀定时换向 ==================== */
+
+/*!
+ * @brief 换向沿通知：压力录波触发源、换向周期统计切分点（可在定时器中断中调用）
+ */
+static void ValveControl_NotifyDirectionalEdge(bool on)
+{
+    PressureCapture_NotifyValveEdge(on);
+    ValveCycleStats_NotifyValveEdge(on);
+}
+
+/*!
+ * @brief 写换向阀输出电平并通知换向沿（可在定时器中断中调用）
+ */
+static void ValveControl_WriteDirectionalPin(bool on)
+{
+    bool was_on = (g_valve_control_data.directional_valve_state == VALVE_STATE_ON);
+
+    if (on) {
+        GPIO_DRV_SetPins(GPIOB, 1U << DIRECTIONAL_VALVE_PIN);
+        g_valve_control_data.directional_valve_state = VALVE_STATE_ON;
+    } else {
+        GPIO_DRV_ClearPins(GPIOB, 1U << DIRECTIONAL_VALVE_PIN);
+        g_valve_control_data.directional_valve_state = VALVE_STATE_OFF;
+    }
+    if (on != was_on) {
+        ValveControl_NotifyDirectionalEdge(on);
+    }
+}
+
+/*!
+ * @brief 定时器每相结束中断：翻转输出并预装再下一相长度
+ *
+ * 装载值在本相结束时生效，进入中断时定时器已按上次预装值开始计本相，
+ * 此处写入的是本相结束后的下一相长度
+ */
+static void ValveControl_OscTimerCallback(void *device, uint32_t wpara, uint32_t lpara)
+{
+    (void)device;
+    (void)wpara;
+    (void)lpara;
+
+    if (!g_osc_running) {
+        return;
+    }
+
+    if (g_valve_control_data.directional_valve_state == VALVE_STATE_ON) {
+        // 通电相结束：进入断电相，确定下一周期参数并预装其通电相
+        ValveControl_WriteDirectionalPin(false);
+        if (g_osc_update) {
+            g_osc_next = g_osc_pending;
+            g_osc_update = false;
+        } else {
+            g_osc_next = g_osc_active;
+        }
+        TIMER_DRV_SetPeriodByCount(DIRECTIONAL_VALVE_TIMER_INSTANCE, DIRECTIONAL_VALVE_TIMER_CHANNEL,
+                                   g_osc_next.on_ticks - 1U);
+    } else {
+        // 断电相结束即周期边界
+        g_osc_cycles++;
+        if (g_osc_stopping) {
+            TIMER_DRV_StopChannels(DIRECTIONAL_VALVE_TIMER_INSTANCE, VALVE_OSC_TIMER_MASK);
+            g_osc_running = false;
+            g_osc_stopping = false;
+            return;
+        }
+        g_osc_active = g_osc_next;
+        ValveControl_WriteDirectionalPin(true);
+        TIMER_DRV_SetPeriodByCount(DIRECTIONAL_VALVE_TIMER_INSTANCE, DIRECTIONAL_VALVE_TIMER_CHANNEL,
+                                   g_osc_active.off_ticks - 1U);
+    }
+}
+
+/*!
+ * @brief 按频率和占比计算周期参数
+ */
+static void ValveControl_OscCycle(uint8_t freq_hz, uint8_t duty, valve_osc_cycle_t *cycle)
+{
+    uint32_t period = g_osc_clock_hz / freq_hz;
+
+    cycle->on_ticks = (uint32_t)(((uint64_t)period * duty) / 100U);
+    cycle->off_ticks = period - cycle->on_ticks;
+    cycle->freq_hz = freq_hz;
+    cycle->duty = duty;
 }
 
+/*!
+ * @brief 立即停止定时换向（输出电平不变，由调用方决定）
+ */
+static void ValveControl_OscStop(void)
+{
+    if (!g_osc_running) {
+        return;
+    }
+    NVIC_DisableIRQ(VALVE_OSC_IRQ);
+    TIMER_DRV_StopChannels(DIRECTIONAL_VALVE_TIMER_INSTANCE, VALVE_OSC_TIMER_MASK);
+    TIMER_DRV_ClearInterruptFlag(DIRECTIONAL_VALVE_TIMER_INSTANCE, VALVE_OSC_TIMER_MASK);
+    g_osc_running = false;
+    g_osc_stopping = false;
+    g_osc_update = false;
+    NVIC_ClearPendingIRQ(VALVE_OSC_IRQ);
+    NVIC_EnableIRQ(VALVE_OSC_IRQ);
+}
+
+/*!
+ * @brief 从通电相开始启动定时换向
+ */
+static bool ValveControl_OscStart(const valve_osc_cycle_t *cycle)
+{
+    if (!g_osc_timer_ready) {
+        // 只使能定时器模块时钟，不影响高速采集已配置的通道
+        TIMER_DRV_Init(DIRECTIONAL_VALVE_TIMER_INSTANCE, false);
+        g_osc_timer_ready = true;
+    }
+
+    timer_user_channel_config_t timer_config;
+    memset(&timer_config, 0, sizeof(timer_config));
+    TIMER_DRV_GetDefaultChanConfig(&timer_config);
+    timer_config.timerMode = TIMER_PERIODIC_COUNTER;
+    timer_config.periodUnits = TIMER_PERIOD_UNITS_COUNTS;
+    timer_config.period = cycle->on_ticks - 1U;
+    timer_config.triggerSource = TIMER_TRIGGER_SOURCE_INTERNAL;
+    timer_config.chainChannel = false;
+    timer_config.isInterruptEnabled = true;
+    timer_config.callback = ValveControl_OscTimerCallback;
+    if (TIMER_DRV_InitChannel(DIRECTIONAL_VALVE_TIMER_INSTANCE, DIRECTIONAL_VALVE_TIMER_CHANNEL, &timer_config) != STATUS_SUCCESS) {
+        return false;
+    }
+
+    g_osc_active = *cycle;
+    g_osc_next = *cycle;
+    g_osc_update = false;
+    g_osc_stopping = false;
+    g_osc_running = true;
+
+    // 通电沿与定时器启动同时发生，随后预装断电相长度（本相结束时生效）
+    ValveControl_WriteDirectionalPin(true);
+    TIMER_DRV_StartChannels(DIRECTIONAL_VALVE_TIMER_INSTANCE, VALVE_OSC_TIMER_MASK);
+    TIMER_DRV_SetPeriodByCount(DIRECTIONAL_VALVE_TIMER_INSTANCE, DIRECTIONAL_VALVE_TIMER_CHANNEL,
+                               cycle->off_ticks - 1U);
+    return true;
+}
+
+/*!
+ * @brief 请求按新参数换向：未运行时立即启动，运行中排入下一周期
+ */
+static bool ValveControl_OscRequest(uint8_t freq_hz, uint8_t duty)
+{
+    valve_osc_cycle_t cycle;
+    bool ok = true;
+
+    if (g_osc_clock_hz == 0U && CKGEN_DRV_GetFreq(TIMER_CLK, &g_osc_clock_hz) != STATUS_SUCCESS) {
+        g_osc_clock_hz = 0U;
+        return false;
+    }
+    ValveControl_OscCycle(freq_hz, duty, &cycle);
+
+    NVIC_DisableIRQ(VALVE_OSC_IRQ);
+    if (!g_osc_running) {
+        ok = ValveControl_OscStart(&cycle);
+    } else {
+        const valve_osc_cycle_t *target = g_osc_update ? &g_osc_pending : &g_osc_next;
+        if (g_osc_stopping || target->freq_hz != freq_hz || target->duty != duty) {
+            g_osc_pending = cycle;
+            g_osc_update = true;
+            g_osc_stopping = false;
+        }
+    }
+    NVIC_EnableIRQ(VALVE_OSC_IRQ);
+    return ok;
+}
+
+bool ValveControl_SetDirectionalOscillation(uint8_t freq_hz)
+{
+    if (freq_hz == 0U) {
+        if (g_osc_running) {
+            g_osc_stopping = true;
+        }
+        return true;
+    }
+    if (freq_hz > DIRECTIONAL_VALVE_MAX_FREQ_HZ) {
+        return false;
+    }
+    return ValveControl_OscRequest(freq_hz, g_osc_duty);
+}
+
+bool ValveControl_SetDirectionalDuty(uint8_t duty_percent)
+{
+    if (duty_percent < DIRECTIONAL_VALVE_MIN_DUTY || duty_percent > DIRECTIONAL_VALVE_MAX_DUTY) {
+        return false;
+    }
+    g_osc_duty = duty_percent;
+    if (g_osc_running && !g_osc_stopping) {
+        const valve_osc_cycle_t *target = g_osc_update ? &g_osc_pending : &g_osc_next;
+        return ValveControl_OscRequest(target->freq_hz, duty_percent);
+    }
+    return true;
+}
+
+uint8_t ValveControl_GetDirectionalFrequency(void)
+{
+    return (g_osc_running && !g_osc_stopping) ? g_osc_active.freq_hz : 0U;
+}
+
+bool ValveControl_IsDirectionalOscillating(void)
+{
+    return g_osc_running;
+}
+
+/* ==================== 阀门命令 ==================== */
+
+static uint16_t ValveControl_ToU16(float value)
+{
+    if (value <= 0.0f) return 0U;
+    if (value >= 65535.0f) return 65535U;
+    return (uint16_t)(value + 0.5f);
+}
+
+static void ValveControl_SendAck(uint8_t cmd, valve_control_result_t result)
+{
+    uint8_t data[8];
+
+    data[0] = cmd;
+    data[1] = (uint8_t)result;
+    if (cmd == VALVE_CMD_BYPASS_RAMP) {
+        uint16_t rate = ValveControl_ToU16(g_bypass_rate * 10.0f);
+        uint16_t accel = ValveControl_ToU16(g_bypass_accel);
+        uint16_t duty = ValveControl_ToU16(g_valve_control_data.bypass_valve_duty * 10.0f);
+        data[2] = (uint8_t)(rate & 0xFFU);
+        data[3] = (uint8_t)(rate >> 8);
+        data[4] = (uint8_t)(accel & 0xFFU);
+        data[5] = (uint8_t)(accel >> 8);
+        data[6] = (uint8_t)(duty & 0xFFU);
+        data[7] = (uint8_t)(duty >> 8);
+    } else if (cmd == VALVE_CMD_BYPASS_PWM) {
+        uint16_t carrier = (uint16_t)ValveControl_GetBypassPwmFrequency();
+        float amplitude = g_dither_amplitude * 10.0f;
+        data[2] = (uint8_t)(carrier & 0xFFU);
+        data[3] = (uint8_t)(carrier >> 8);
+        data[4] = (uint8_t)(amplitude + 0.5f);
+        data[5] = (uint8_t)(g_dither_freq_hz & 0xFFU);
+        data[6] = (uint8_t)(g_dither_freq_hz >> 8);
+        data[7] = 0U;
+    } else {
+        uint32_t cycles = g_osc_cycles;
+        data[2] = ValveControl_GetDirectionalFrequency();
+        data[3] = g_osc_duty;
+        data[4] = (uint8_t)(cycles & 0xFFU);
+        data[5] = (uint8_t)((cycles >> 8) & 0xFFU);
+        data[6] = (uint8_t)((cycles >> 16) & 0xFFU);
+        data[7] = (uint8_t)(cycles >> 24);
+    }
+
+    CAN_Config_SendMessage(CAN_MSG_PARAM_ACK_ID, data, 8, true);
+}
+
+bool ValveControl_HandleCanFrame(const uint8_t *data, uint8_t length)
+{
+    if (data == NULL || length < 1U) {
+        return false;
+    }
+
+    switch (data[0]) {
+        case VALVE_CMD_REVERSAL_DUTY:
+        case VALVE_CMD_REVERSAL_STATUS:
+        case VALVE_CMD_BYPASS_RAMP:
+        case VALVE_CMD_BYPASS_PWM:
+            // 上一条未处理完时丢弃（上位机超时重发）
+            if (g_valve_pending_cmd == VALVE_CMD_NONE) {
+                memset(g_valve_pending_data, 0, sizeof(g_valve_pending_data));
+                memcpy(g_valve_pending_data, data, (length > CAN_MSG_DATA_MAX_SIZE) ? CAN_MSG_DATA_MAX_SIZE : length);
+                g_valve_pending_cmd = data[0];
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void ValveControl_Task(void)
+{
+    uint8_t cmd = g_valve_pending_cmd;
+    valve_control_result_t result = VALVE_RESULT_OK;
+
+    if (cmd == VALVE_CMD_NONE) {
+        return;
+    }
+    if (cmd == VALVE_CMD_REVERSAL_DUTY) {
+        uint8_t duty = (g_valve_pending_data[1] == 0U) ? DIRECTIONAL_VALVE_DEFAULT_DUTY : g_valve_pending_data[1];
+        if (!ValveControl_SetDirectionalDuty(duty)) {
+            result = VALVE_RESULT_BAD_PARAM;
+        }
+    } else if (cmd == VALVE_CMD_BYPASS_RAMP) {
+        uint16_t rate = (uint16_t)(g_valve_pending_data[1] | ((uint16_t)g_valve_pending_data[2] << 8));
+        uint16_t accel = (uint16_t)(g_valve_pending_data[3] | ((uint16_t)g_valve_pending_data[4] << 8));
+        ValveControl_SetBypassRamp((float)rate * 0.1f, (float)accel);
+    } else if (cmd == VALVE_CMD_BYPASS_PWM) {
+        uint16_t carrier = (uint16_t)(g_valve_pending_data[1] | ((uint16_t)g_valve_pending_data[2] << 8));
+        uint16_t dither_hz = (uint16_t)(g_valve_pending_data[4] | ((uint16_t)g_valve_pending_data[5] << 8));
+        if (!ValveControl_SetBypassPwm(carrier, (float)g_valve_pending_data[3] * 0.1f, dither_hz)) {
+            result = VALVE_RESULT_BAD_PARAM;
+        }
+    }
+    ValveControl_SendAck(cmd, result);
+    g_valve_pending_cmd = VALVE_CMD_NONE;
+}
+
+/* ==================== 换向阀静态控制 ==================== */
+
 void ValveControl_SetDirectionalValve(bool enable)
 {
     printf("[VALVE] Directional Valve: %s (PB4)\r\n", enable ? "ON" : "OFF");
+    ValveControl_OscStop();
+    bool was_on = (g_valve_control_data.directional_valve_state == VALVE_STATE_ON);
     if (enable) {
         GPIO_DRV_SetPins(GPIOB, 1U << DIRECTIONAL_VALVE_PIN);
+        if (!was_on) {
+            ValveControl_NotifyDirectionalEdge(true);
+        }
         g_valve_control_data.directional_valve_state = VALVE_STATE_ON;
         printf("[VALVE] GPIO Set: PB4 = HIGH\r\n");
     } else {
         GPIO_DRV_ClearPins(GPIOB, 1U << DIRECTIONAL_VALVE_PIN);
+        if (was_on) {
+            ValveControl_NotifyDirectionalEdge(false);
+        }
         g_valve_control_data.directional_valve_state = VALVE_STATE_OFF;
         printf("[VALVE] GPIO Set: PB4 = LOW\r\n");
     }
@@ -52,27 +440,247 @@ valve_state_t ValveControl_GetDirectionalValveState(void)
     return g_valve_control_data.directional_valve_state;
 }
 
-void ValveControl_SetBypassValve(float duty)
+/* ==================== 旁通阀开度轨迹 ==================== */
+
+static float ValveControl_ClampBypassDuty(float duty)
 {
-    printf("[VALVE] Bypass Valve: %.2f%% (PWM0_CH2)\r\n", duty);
     if (duty < BYPASS_VALVE_MIN_DUTY) duty = BYPASS_VALVE_MIN_DUTY;
     if (duty > BYPASS_VALVE_MAX_DUTY) duty = BYPASS_VALVE_MAX_DUTY;
-    
-    // 使用PWM通道计数值来设置占空比
-    uint16_t max_count = PWM_DRV_GetMaxCountValue(0); // 使用PWM实例0
-    uint16_t count_value = (uint16_t)(max_count * duty / 100.0f);
-    printf("[VALVE] PWM Set: MaxCount=%u, CountValue=%u\r\n", max_count, count_value);
-    PWM_DRV_SetChannelCountValue(0, PWM_CH_2, count_value);  // 使用PWM_CH_2 (PC2)
+    return duty;
+}
+
+void ValveControl_OutputBypassPwm(float duty)
+{
+    float counts = g_bypass_counts * duty / 100.0f;
+    uint32_t whole = (uint32_t)counts;
+    uint32_t frac = (uint32_t)((counts - (float)whole) * BYPASS_PWM_DITHER_STEPS + 0.5f);
+
+    if (frac >= (uint32_t)BYPASS_PWM_DITHER_STEPS) {
+        whole++;
+        frac = 0U;
+    }
+    PWM_DRV_SetChannelCountValue(BYPASS_PWM_INSTANCE, PWM_CH_2, (uint16_t)whole);
+    PWM_DRV_SetChannelCounterDitherValue(BYPASS_PWM_INSTANCE, 0U, frac << BYPASS_PWM_CH_DITHER_POS);
+    if (g_bypass_trigger_enabled) {
+        // 采样点位于通电时间中点；关断时仍每周期触发一次，采样中断不中断
+        PWM_DRV_SetChannelCountValue(BYPASS_PWM_INSTANCE, BYPASS_PWM_TRIGGER_CHANNEL, (uint16_t)((whole > 2U) ? (whole >> 1) : 1U));
+    }
+}
+
+/* 开度轨迹输出：电流闭环时作为电流设定值，否则直接写PWM */
+static void ValveControl_WriteBypassPwm(float duty)
+{
+    if (ValveCurrent_IsActive()) {
+        ValveCurrent_SetDemand(duty);
+        return;
+    }
+    ValveControl_OutputBypassPwm(duty);
+}
+
+void ValveControl_EnableCurrentTrigger(void)
+{
+    g_bypass_trigger_enabled = true;
+    ValveControl_OutputBypassPwm(g_valve_control_data.bypass_valve_duty);
+    PWM_DRV_SetMatchTrigger(BYPASS_PWM_INSTANCE, BYPASS_PWM_TRIGGER_CHANNEL, true);
+}
+
+/* 更新实际开度并输出（颤振叠加在输出上，不计入实际开度） */
+static void ValveControl_ApplyBypassDuty(float duty)
+{
     g_valve_control_data.bypass_valve_duty = duty;
     g_valve_control_data.bypass_valve_state = (duty > 0.0f) ? VALVE_STATE_ON : VALVE_STATE_OFF;
+    ValveControl_WriteBypassPwm(duty);
+}
+
+/* 颤振仅在阀门开启时叠加 */
+static bool ValveControl_DitherActive(void)
+{
+    return g_dither_amplitude > 0.0f && g_valve_control_data.bypass_valve_duty > 0.0f;
+}
+
+/*!
+ * @brief PWM0计数溢出中断：按斜率/加速度限制推进一个PWM周期，叠加低频颤振
+ *
+ * 加速度限制时速度上限取 min(斜率, √(2·a·剩余距离))，接近目标时按相同加速度减速，
+ * 开度轨迹为S曲线（速度梯形）；颤振为三角波，幅值超出开度范围部分削顶
+ */
+static void ValveControl_BypassRampCallback(uint8_t instance, uint32_t status, void *userData)
+{
+    (void)instance;
+    (void)status;
+    (void)userData;
+
+    float target = g_bypass_target;
+    float output = g_valve_control_data.bypass_valve_duty;
+    float error = target - output;
+    float rate = g_bypass_rate_step;
+    float accel = g_bypass_accel_step;
+
+    if (rate <= 0.0f || (error < rate && error > -rate && accel <= 0.0f)) {
+        output = target;
+        g_bypass_velocity = 0.0f;
+    } else if (accel <= 0.0f) {
+        output += (error > 0.0f) ? rate : -rate;
+    } else {
+        float distance = (error > 0.0f) ? error : -error;
+        float v_limit = sqrtf(2.0f * accel * distance);
+        if (v_limit > rate) v_limit = rate;
+        float v_desired = (error > 0.0f) ? v_limit : -v_limit;
+        float dv = v_desired - g_bypass_velocity;
+        if (dv > accel) dv = accel;
+        if (dv < -accel) dv = -accel;
+        g_bypass_velocity += dv;
+        output += g_bypass_velocity;
+        // 越过目标或剩余距离不足一个加速度步时直接到位
+        if ((error > 0.0f && output >= target) || (error < 0.0f && output <= target) || distance <= accel) {
+            output = target;
+            g_bypass_velocity = 0.0f;
+        }
+    }
+
+    bool changed = (output != g_valve_control_data.bypass_valve_duty);
+    g_valve_control_data.bypass_valve_duty = output;
+    g_valve_control_data.bypass_valve_state = (output > 0.0f) ? VALVE_STATE_ON : VALVE_STATE_OFF;
+
+    if (ValveControl_DitherActive()) {
+        g_dither_phase += g_dither_phase_step;
+        if (g_dither_phase >= 1.0f) {
+            g_dither_phase -= 1.0f;
+        }
+        // 三角波：相位0→0.5由-1升至+1，0.5→1回落
+        float wave = (g_dither_phase < 0.5f) ? (4.0f * g_dither_phase - 1.0f) : (3.0f - 4.0f * g_dither_phase);
+        ValveControl_WriteBypassPwm(ValveControl_ClampBypassDuty(output + g_dither_amplitude * wave));
+        return;
+    }
+    if (changed || g_dither_phase != 0.0f) {
+        g_dither_phase = 0.0f;
+        ValveControl_WriteBypassPwm(output);
+    }
+
+    if (output == target) {
+        NVIC_DisableIRQ(PWM0_OVERFLOW_IRQn);
+        // 屏蔽期间被更高优先级中断改写目标时重新开启
+        if (g_bypass_target != target) {
+            NVIC_EnableIRQ(PWM0_OVERFLOW_IRQn);
+        }
+    }
+}
+
+void ValveControl_SetBypassValve(float duty)
+{
+    printf("[VALVE] Bypass Valve: %.2f%% (PWM0_CH2)\r\n", duty);
+    ValveControl_WriteBypassValveDuty(duty);
     g_valve_control_data.last_update_time = OSIF_GetMilliseconds();
 }
 
+void ValveControl_SetBypassValveImmediate(float duty)
+{
+    ValveControl_WriteBypassValveDutyImmediate(duty);
+    g_valve_control_data.last_update_time = OSIF_GetMilliseconds();
+}
+
+void ValveControl_WriteBypassValveDutyImmediate(float duty)
+{
+    duty = ValveControl_ClampBypassDuty(duty);
+
+    NVIC_DisableIRQ(PWM0_OVERFLOW_IRQn);
+    g_bypass_target = duty;
+    g_bypass_velocity = 0.0f;
+    ValveControl_ApplyBypassDuty(duty);
+    // 颤振继续叠加（保持相位），否则无需溢出中断
+    if (ValveControl_DitherActive()) {
+        NVIC_EnableIRQ(PWM0_OVERFLOW_IRQn);
+    } else {
+        g_dither_phase = 0.0f;
+    }
+}
+
+void ValveControl_WriteBypassValveDuty(float duty)
+{
+    g_bypass_target = ValveControl_ClampBypassDuty(duty);
+    NVIC_EnableIRQ(PWM0_OVERFLOW_IRQn);
+}
+
+/* 按当前PWM周期换算每周期步长 */
+static void ValveControl_UpdateBypassSteps(void)
+{
+    g_bypass_rate_step = g_bypass_rate * g_bypass_period_s;
+    g_bypass_accel_step = g_bypass_accel * g_bypass_period_s * g_bypass_period_s;
+    g_dither_phase_step = (float)g_dither_freq_hz * g_bypass_period_s;
+}
+
+void ValveControl_SetBypassRamp(float rate, float accel)
+{
+    g_bypass_rate = (rate > 0.0f) ? rate : 0.0f;
+    g_bypass_accel = (accel > 0.0f) ? accel : 0.0f;
+    ValveControl_UpdateBypassSteps();
+}
+
+bool ValveControl_SetBypassPwm(uint32_t carrier_hz, float dither_amplitude, uint16_t dither_freq_hz)
+{
+    uint32_t mod = BYPASS_PWM_MAX_COUNT;
+    uint32_t frac = 0U;
+
+    if (carrier_hz != 0U) {
+        if (carrier_hz < BYPASS_PWM_MIN_FREQ_HZ || carrier_hz > BYPASS_PWM_MAX_FREQ_HZ) {
+            return false;
+        }
+        // 周期计数 = 时钟/载波，整数部分写MOD（计数0~MOD），小数部分由MOD抖动以1/32计数输出
+        float counts = BYPASS_PWM_CLOCK_HZ / (float)carrier_hz;
+        mod = (uint32_t)counts - 1U;
+        frac = (uint32_t)((counts - (float)(mod + 1U)) * BYPASS_PWM_DITHER_STEPS + 0.5f);
+        if (frac >= (uint32_t)BYPASS_PWM_DITHER_STEPS) {
+            mod++;
+            frac = 0U;
+        }
+    }
+    // 颤振频率不超过载波的1/4，保证每个三角波周期至少4个PWM周期
+    if (dither_amplitude < 0.0f || dither_amplitude > BYPASS_DITHER_MAX_AMPLITUDE ||
+        (dither_amplitude > 0.0f && (dither_freq_hz < BYPASS_DITHER_MIN_FREQ_HZ || dither_freq_hz > BYPASS_DITHER_MAX_FREQ_HZ ||
+                                     (float)dither_freq_hz * 4.0f * (float)(mod + 1U) > BYPASS_PWM_CLOCK_HZ))) {
+        return false;
+    }
+
+    NVIC_DisableIRQ(PWM0_OVERFLOW_IRQn);
+    PWM_DRV_SetMaxCountValue(BYPASS_PWM_INSTANCE, (uint16_t)mod);
+    PWM_DRV_SetMaxCountDitherValue(BYPASS_PWM_INSTANCE, (uint8_t)frac);
+    g_bypass_counts = (float)(mod + 1U) + (float)frac / BYPASS_PWM_DITHER_STEPS;
+    g_bypass_period_s = g_bypass_counts / BYPASS_PWM_CLOCK_HZ;
+    if (dither_amplitude > 0.0f) {
+        g_dither_freq_hz = dither_freq_hz;
+    }
+    g_dither_amplitude = dither_amplitude;
+    g_dither_phase = 0.0f;
+    ValveControl_UpdateBypassSteps();
+
+    // 按新周期计数重写当前开度
+    ValveControl_WriteBypassPwm(g_valve_control_data.bypass_valve_duty);
+    if (ValveControl_DitherActive() || g_bypass_target != g_valve_control_data.bypass_valve_duty) {
+        NVIC_EnableIRQ(PWM0_OVERFLOW_IRQn);
+    }
+    return true;
+}
+
+float ValveControl_GetBypassPwmPeriod(void)
+{
+    return g_bypass_period_s;
+}
+
+uint32_t ValveControl_GetBypassPwmFrequency(void)
+{
+    return (uint32_t)(BYPASS_PWM_CLOCK_HZ / g_bypass_counts + 0.5f);
+}
+
 float ValveControl_GetBypassValveDuty(void)
 {
     return g_valve_control_data.bypass_valve_duty;
 }
 
+float ValveControl_GetBypassValveTarget(void)
+{
+    return g_bypass_target;
+}
+
 valve_state_t ValveControl_GetBypassValveState(void)
 {
     return g_valve_control_data.bypass_valve_state;
@@ -114,19 +722,18 @@ directional_valve_mode_t ValveControl_GetDirectionalValveMode(void)
 
 void ValveControl_ResetDirectionalValveControl(void)
 {
-    memset(&g_valve_control_data.stats, 0, sizeof(directional_valve_stats_t));
-    g_valve_control_data.stats.min_pressure_valley = 999.0f;
+    ValveCycleStats_Reset();
 }
 
+/* 统计由换向周期统计模块按压力高速采样逐周期计算 */
 directional_valve_stats_t ValveControl_GetDirectionalValveStats(void)
 {
-    return g_valve_control_data.stats;
+    return ValveCycleStats_GetStats();
 }
 
 void ValveControl_ResetDirectionalValveStats(void)
 {
-    memset(&g_valve_control_data.stats, 0, sizeof(directional_valve_stats_t));
-    g_valve_control_data.stats.min_pressure_valley = 999.0f;
+    ValveCycleStats_Reset();
 }
 
 // 已删除以下空函数 - 平台无关化后不再需要：
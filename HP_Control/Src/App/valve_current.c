@@ -0,0 +1,292 @@
+/*!
+ * @file valve_current.c
+ *
+ * @brief 旁通阀线圈电流采样与电流闭环实现
+ *
+ * 说明：
+ * - 触发链全部由硬件完成：PWM0_CH3匹配 → TRGMUX → PDT0 → TRGMUX → ADC0注入组，CPU只处理转换完成中断
+ * - 采样中断频率等于PWM载波频率，中断内只做一次乘法换算和一次PI计算
+ * - 闭环时开度轨迹（PWM0溢出中断）只更新电流设定值，PWM0_CH2只由本模块的采样中断写入
+ */
+
+#include "valve_current.h"
+#include "valve_control.h"
+#include "adc_drv.h"
+#include "pdt_drv.h"
+#include "ctu_drv.h"
+#include "gpio_drv.h"
+#include "can_config.h"
+#include "osif.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define VCUR_ADC_PORT                     PORTA
+#define VCUR_ADC_PIN                      0U
+#define VCUR_CTU_INSTANCE                 0U
+#define VCUR_ADC_TO_AMP                   (ADC_REFERENCE_VOLTAGE / ADC_MAX_VALUE / (VCUR_AMP_GAIN * VCUR_SHUNT_OHM))
+#define VCUR_FULL_SCALE_A                 (VCUR_COIL_SUPPLY_V / VCUR_COIL_RESISTANCE_OHM)
+#define VCUR_CMD_NONE                     0x00U
+
+/* ==========================================  Variables  =========================================== */
+
+static bool g_vcur_ready = false;
+static volatile bool g_vcur_active = false;
+static volatile float g_vcur_current = 0.0f;      // 最近一次采样电流(A)
+static volatile float g_vcur_setpoint = 0.0f;     // 电流设定值(A)
+static volatile uint32_t g_vcur_samples = 0U;     // 采样中断计数（采样链停止检测）
+static volatile uint8_t g_vcur_faults = VCUR_FAULT_NONE;
+static uint32_t g_vcur_last_samples = 0U;
+static float g_vcur_integral = 0.0f;              // 积分修正量(%)
+static volatile float g_vcur_kp = VCUR_DEFAULT_KP;
+static volatile float g_vcur_ki = VCUR_DEFAULT_KI;
+
+/* CAN命令（接收中断拷贝，参数服务任务处理） */
+static volatile uint8_t g_vcur_pending_cmd = VCUR_CMD_NONE;
+static uint8_t g_vcur_pending_data[CAN_MSG_DATA_MAX_SIZE];
+
+/* ==========================================  Functions  =========================================== */
+
+/* 退出闭环并按当前开度恢复开环输出 */
+static void ValveCurrent_Stop(uint8_t fault)
+{
+    g_vcur_active = false;
+    g_vcur_setpoint = 0.0f;
+    g_vcur_faults |= fault;
+    ValveControl_OutputBypassPwm(ValveControl_GetBypassValveDuty());
+}
+
+#if !HP_PLANT_SIM && HP_VALVE_CURRENT_ENABLE
+/*!
+ * @brief ADC0注入组转换完成中断：换算线圈电流，闭环时按前馈+PI更新占空比
+ *
+ * 前馈为设定电流对应的标称占空比，积分补偿线圈电阻与电源电压偏差；输出饱和时不再累积积分
+ */
+static void ValveCurrent_AdcCallback(adc_interrupt_info_t *info, void *parameter)
+{
+    (void)parameter;
+
+    if ((info->event & (uint32_t)ADC_EVENT_EOC) == 0U || info->sequence != ADC_ISEQ_0) {
+        return;
+    }
+
+    uint16_t raw = 0U;
+    ADC_DRV_GetSeqResult(VCUR_ADC_INSTANCE, ADC_ISEQ_0, &raw);
+    float current = (float)raw * VCUR_ADC_TO_AMP;
+    g_vcur_current = current;
+    g_vcur_samples++;
+
+    if (!g_vcur_active) {
+        return;
+    }
+    if (current > VCUR_OVERCURRENT_A) {
+        g_vcur_integral = 0.0f;
+        ValveCurrent_Stop(VCUR_FAULT_OVERCURRENT);
+        return;
+    }
+
+    float setpoint = g_vcur_setpoint;
+    if (setpoint <= 0.0f) {
+        g_vcur_integral = 0.0f;
+        ValveControl_OutputBypassPwm(0.0f);
+        return;
+    }
+
+    float error = setpoint - current;
+    float integral = g_vcur_integral + g_vcur_ki * ValveControl_GetBypassPwmPeriod() * error;
+    if (integral > VCUR_INTEGRAL_LIMIT) integral = VCUR_INTEGRAL_LIMIT;
+    if (integral < -VCUR_INTEGRAL_LIMIT) integral = -VCUR_INTEGRAL_LIMIT;
+
+    float duty = setpoint * (100.0f / VCUR_FULL_SCALE_A) + g_vcur_kp * error + integral;
+    if (duty > VCUR_MAX_PWM_DUTY) {
+        duty = VCUR_MAX_PWM_DUTY;
+    } else if (duty < 0.0f) {
+        duty = 0.0f;
+    } else {
+        g_vcur_integral = integral;
+    }
+    ValveControl_OutputBypassPwm(duty);
+}
+#endif
+
+void ValveCurrent_Init(void)
+{
+#if HP_PLANT_SIM || !HP_VALVE_CURRENT_ENABLE
+    // 仿真模式没有真实的线圈电流；采样硬件参数未确认时不占用PA0，保持开环
+    g_vcur_ready = false;
+#else
+    GPIO_DRV_SetMuxModeSel(VCUR_ADC_PORT, VCUR_ADC_PIN, PORT_PIN_DISABLED);  // 模拟输入
+
+    // ADC0：注入组1个通道，外部触发，转换完成中断
+    adc_converter_config_t adc_config;
+    ADC_DRV_InitConverterStruct(&adc_config);
+    adc_config.clockDivide = ADC_CLK_DIVIDE_1;
+    adc_config.resolution = ADC_RESOLUTION_12BIT;
+    adc_config.alignment = ADC_DATA_ALIGN_RIGHT;
+    adc_config.regularTrigger = ADC_TRIGGER_INTERNAL;
+    adc_config.injectTrigger = ADC_TRIGGER_EXTERNAL;
+    adc_config.voltageRef = ADC_VOLTAGEREF_VREF;
+    adc_config.scanModeEn = false;
+    adc_config.continuousModeEn = false;
+    adc_config.regularSequenceLength = 1;
+    adc_config.injectSequenceLength = 1;
+    adc_config.callback = ValveCurrent_AdcCallback;
+    adc_config.parameter = NULL;
+    adc_config.powerEn = true;
+    ADC_DRV_Init(VCUR_ADC_INSTANCE);
+    ADC_DRV_ConfigConverter(VCUR_ADC_INSTANCE, &adc_config);
+
+    adc_chan_config_t chan_config;
+    ADC_DRV_InitChanStruct(&chan_config);
+    chan_config.channel = (adc_inputchannel_t)VCUR_ADC_CHANNEL;
+    chan_config.spt = ADC_SPT_CLK_10;
+    chan_config.interruptEn = true;
+    ADC_DRV_ConfigChan(VCUR_ADC_INSTANCE, ADC_ISEQ_0, &chan_config);
+
+    // PDT0：硬件触发单次延时，DLY0输出启动ADC
+    pdt_timer_config_t pdt_config;
+    PDT_DRV_GetDefaultConfig(&pdt_config);
+    pdt_config.triggerInput = PDT_HARDWARE_TRIGGER;
+    pdt_config.continuousModeEnable = false;
+    pdt_config.intEnable = false;
+    pdt_config.callback = NULL;
+    PDT_DRV_Init(VCUR_PDT_INSTANCE, &pdt_config);
+
+    pdt_trigger_delay_config_t delay_config;
+    memset(&delay_config, 0, sizeof(delay_config));
+    delay_config.triggerDelayBypassEn = false;
+    delay_config.delayEnable = (1U << PDT_DLY_0);
+    delay_config.dly[PDT_DLY_0] = VCUR_PDT_DELAY_COUNTS;
+    PDT_DRV_ConfigTriggerDelay(VCUR_PDT_INSTANCE, &delay_config);
+    PDT_DRV_SetTimerModulusValue(VCUR_PDT_INSTANCE, 0xFFFFU);
+    PDT_DRV_LoadValuesCmd(VCUR_PDT_INSTANCE);
+    PDT_DRV_Enable(VCUR_PDT_INSTANCE);
+
+    // CTU触发路由：PWM0匹配 → PDT0 → ADC0注入组
+    CTU_DRV_Init(VCUR_CTU_INSTANCE);
+    if (TRGMUX_DRV_SetTrigSourceForTargetModule(VCUR_CTU_INSTANCE, TRGMUX_TRIG_SOURCE_PWM0_MATCH_TRIG,
+                                                TRGMUX_TARGET_MODULE_PDT0) != STATUS_SUCCESS ||
+        TRGMUX_DRV_SetTrigSourceForTargetModule(VCUR_CTU_INSTANCE, TRGMUX_TRIG_SOURCE_PDT0_TRIG,
+                                                TRGMUX_TARGET_MODULE_ADC0_INJECTION0) != STATUS_SUCCESS) {
+        printf("[VCUR] ERROR: trigger routing locked\r\n");
+        return;
+    }
+
+    // 采样点随开度更新（ValveControl_OutputBypassPwm写入CH3计数值）
+    ValveControl_EnableCurrentTrigger();
+    g_vcur_ready = true;
+#endif
+}
+
+bool ValveCurrent_SetMode(uint8_t mode)
+{
+    if (mode == VCUR_MODE_DUTY) {
+        if (g_vcur_active) {
+            ValveCurrent_Stop(VCUR_FAULT_NONE);
+        }
+        g_vcur_faults = VCUR_FAULT_NONE;
+        return true;
+    }
+    if (mode != VCUR_MODE_CURRENT || !g_vcur_ready) {
+        return false;
+    }
+
+    g_vcur_faults = VCUR_FAULT_NONE;
+    if (!g_vcur_active) {
+        g_vcur_integral = 0.0f;
+        g_vcur_last_samples = g_vcur_samples;
+        ValveCurrent_SetDemand(ValveControl_GetBypassValveDuty());
+        g_vcur_active = true;
+    }
+    return true;
+}
+
+void ValveCurrent_SetGains(float kp, float ki)
+{
+    g_vcur_kp = (kp > 0.0f) ? kp : 0.0f;
+    g_vcur_ki = (ki > 0.0f) ? ki : 0.0f;
+}
+
+bool ValveCurrent_IsActive(void)
+{
+    return g_vcur_active;
+}
+
+void ValveCurrent_SetDemand(float duty)
+{
+    g_vcur_setpoint = (duty > 0.0f) ? duty * (VCUR_FULL_SCALE_A / 100.0f) : 0.0f;
+}
+
+float ValveCurrent_GetCurrent(void)
+{
+    return g_vcur_current;
+}
+
+float ValveCurrent_GetSetpoint(void)
+{
+    return g_vcur_active ? g_vcur_setpoint : 0.0f;
+}
+
+uint8_t ValveCurrent_GetFaults(void)
+{
+    return g_vcur_faults;
+}
+
+/* ==================== CAN命令 ==================== */
+
+static uint16_t ValveCurrent_ToMilliamp(float current)
+{
+    if (current <= 0.0f) return 0U;
+    if (current >= 65.535f) return 65535U;
+    return (uint16_t)(current * 1000.0f + 0.5f);
+}
+
+bool ValveCurrent_HandleCanFrame(const uint8_t *data, uint8_t length)
+{
+    if (data == NULL || length < 1U || data[0] != VCUR_CMD_BYPASS_CURRENT) {
+        return false;
+    }
+    // 上一条未处理完时丢弃（上位机超时重发）
+    if (g_vcur_pending_cmd == VCUR_CMD_NONE) {
+        memset(g_vcur_pending_data, 0, sizeof(g_vcur_pending_data));
+        memcpy(g_vcur_pending_data, data, (length > CAN_MSG_DATA_MAX_SIZE) ? CAN_MSG_DATA_MAX_SIZE : length);
+        g_vcur_pending_cmd = data[0];
+    }
+    return true;
+}
+
+void ValveCurrent_Task(void)
+{
+    // 闭环运行期间两次任务之间应有数十个采样中断
+    uint32_t samples = g_vcur_samples;
+    if (g_vcur_active && samples == g_vcur_last_samples) {
+        ValveCurrent_Stop(VCUR_FAULT_SAMPLE_STALL);
+    }
+    g_vcur_last_samples = samples;
+
+    if (g_vcur_pending_cmd == VCUR_CMD_NONE) {
+        return;
+    }
+
+    uint16_t kp = (uint16_t)(g_vcur_pending_data[2] | ((uint16_t)g_vcur_pending_data[3] << 8));
+    uint16_t ki = (uint16_t)(g_vcur_pending_data[4] | ((uint16_t)g_vcur_pending_data[5] << 8));
+    ValveCurrent_SetGains((kp == 0U) ? VCUR_DEFAULT_KP : (float)kp * 0.1f,
+                          (ki == 0U) ? VCUR_DEFAULT_KI : (float)ki);
+    bool ok = ValveCurrent_SetMode(g_vcur_pending_data[1]);
+
+    uint8_t ack[8];
+    uint16_t current = ValveCurrent_ToMilliamp(g_vcur_current);
+    uint16_t setpoint = ValveCurrent_ToMilliamp(ValveCurrent_GetSetpoint());
+    ack[0] = VCUR_CMD_BYPASS_CURRENT;
+    ack[1] = ok ? 0U : 1U;
+    ack[2] = g_vcur_active ? VCUR_MODE_CURRENT : VCUR_MODE_DUTY;
+    ack[3] = g_vcur_faults;
+    ack[4] = (uint8_t)(current & 0xFFU);
+    ack[5] = (uint8_t)(current >> 8);
+    ack[6] = (uint8_t)(setpoint & 0xFFU);
+    ack[7] = (uint8_t)(setpoint >> 8);
+    CAN_Config_SendMessage(CAN_MSG_PARAM_ACK_ID, ack, 8, true);
+
+    g_vcur_pending_cmd = VCUR_CMD_NONE;
+}
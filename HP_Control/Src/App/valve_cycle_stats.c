@@ -0,0 +1,365 @@
+/*!
+ * @file valve_cycle_stats.c
+ *
+ * @brief 换向周期统计实现
+ *
+ * 说明：
+ * - 换向沿由阀门模块在定时器中断或任务中通知，只做电平记录和计数；采样中断比较计数得知两个采样之间的沿
+ * - 采样中断内只处理ADC码值（标定单调，峰谷位置与MPa一致），换算和浮点统计在任务中按周期进行
+ * - 周期记录为单生产者单消费者环形缓冲：采样中断只写head，任务只写tail
+ */
+
+#include "valve_cycle_stats.h"
+#include "valve_control.h"
+#include "sensor.h"
+#include "fault_diagnosis.h"
+#include "can_config.h"
+#include "osif.h"
+#include <string.h>
+
+/* ============================================  Define  ============================================ */
+
+#define VCYC_RING_MASK                    (VCYC_RING_SIZE - 1U)
+#define VCYC_NO_RESPONSE                  0xFFFFFFFFUL
+#define VCYC_MAX_PERIOD_US                2000000UL   // 超过该时长仍未出现下一个通电沿则放弃本周期（换向已停止）
+#define VCYC_SLOPE_SPAN_CODES             16U         // 计算标定斜率的码值半宽
+#define VCYC_FRAME_LAST                   0U
+#define VCYC_FRAME_AVERAGE                1U
+
+/* ===========================================  Typedef  ============================================ */
+
+/* 采样中断中记录的周期原始数据（码值/微秒） */
+typedef struct {
+    uint32_t period_us;
+    uint32_t peak_us;
+    uint32_t response_us;                     // VCYC_NO_RESPONSE为周期内未响应
+    uint16_t start_code;
+    uint16_t peak_code;
+    uint16_t valley_code;
+    uint16_t plateau_code;
+} vcyc_record_t;
+
+/* ==========================================  Variables  =========================================== */
+
+/* 换向沿（阀门模块写，采样中断读） */
+static volatile uint8_t g_vcyc_edge_count = 0U;
+static volatile bool g_vcyc_edge_level = false;
+
+/* 采样中断状态 */
+static uint8_t g_vcyc_edge_seen = 0U;
+static bool g_vcyc_in_cycle = false;
+static bool g_vcyc_off_seen = false;
+static uint32_t g_vcyc_elapsed_us = 0U;           // 当前采样距通电沿采样的时间
+static uint16_t g_vcyc_last_code = 0U;
+static vcyc_record_t g_vcyc_current;
+static volatile uint16_t g_vcyc_delta_code = 1U;  // VCYC_RESPONSE_DELTA_MPA对应码值（任务按标定更新）
+static volatile uint32_t g_vcyc_dropped = 0U;
+
+/* 周期记录环形缓冲 */
+static vcyc_record_t g_vcyc_ring[VCYC_RING_SIZE];
+static volatile uint32_t g_vcyc_head = 0U;
+static volatile uint32_t g_vcyc_tail = 0U;
+
+/* 任务侧统计 */
+static directional_valve_stats_t g_vcyc_stats;
+static valve_cycle_summary_t g_vcyc_summary;
+static bool g_vcyc_delay_seeded = false;
+static bool g_vcyc_unreported = false;
+static uint32_t g_vcyc_last_report = 0U;
+
+/* ==========================================  Functions  =========================================== */
+
+static void ValveCycleStats_Drop(void)
+{
+    if (g_vcyc_in_cycle) {
+        g_vcyc_in_cycle = false;
+        g_vcyc_dropped++;
+    }
+}
+
+static void ValveCycleStats_Begin(uint16_t code)
+{
+    g_vcyc_current.period_us = 0U;
+    g_vcyc_current.peak_us = 0U;
+    g_vcyc_current.response_us = VCYC_NO_RESPONSE;
+    g_vcyc_current.start_code = code;
+    g_vcyc_current.peak_code = code;
+    g_vcyc_current.valley_code = code;
+    g_vcyc_current.plateau_code = code;
+    g_vcyc_elapsed_us = 0U;
+    g_vcyc_off_seen = false;
+    g_vcyc_in_cycle = true;
+}
+
+/* 通电沿结束上一周期：沿发生在上一采样与本采样之间，周期计到本采样 */
+static void ValveCycleStats_Finish(uint32_t period_us)
+{
+    uint32_t head = g_vcyc_head;
+
+    g_vcyc_current.period_us = g_vcyc_elapsed_us + period_us;
+    if (!g_vcyc_off_seen) {
+        g_vcyc_current.plateau_code = g_vcyc_last_code;
+    }
+    if ((head - g_vcyc_tail) >= VCYC_RING_SIZE) {
+        g_vcyc_dropped++;
+        return;
+    }
+    g_vcyc_ring[head & VCYC_RING_MASK] = g_vcyc_current;
+    g_vcyc_head = head + 1U;
+}
+
+/*!
+ * @brief 采集流旁路监听（定时器中断上下文）：每个采样只做比较和累加
+ */
+static void ValveCycleStats_OnSample(uint16_t oil_pressure_raw, uint32_t period_us, bool restarted)
+{
+    uint8_t edges = g_vcyc_edge_count;
+    uint8_t new_edges = (uint8_t)(edges - g_vcyc_edge_seen);
+    g_vcyc_edge_seen = edges;
+
+    // 采样间隔不连续，或两个采样之间换向多次，沿的时刻无法确定
+    if (restarted || new_edges > 1U) {
+        ValveCycleStats_Drop();
+        g_vcyc_last_code = oil_pressure_raw;
+        return;
+    }
+
+    if (new_edges == 1U) {
+        if (g_vcyc_edge_level) {
+            if (g_vcyc_in_cycle) {
+                ValveCycleStats_Finish(period_us);
+            }
+            ValveCycleStats_Begin(oil_pressure_raw);
+            g_vcyc_last_code = oil_pressure_raw;
+            return;
+        }
+        if (g_vcyc_in_cycle && !g_vcyc_off_seen) {
+            g_vcyc_off_seen = true;
+            g_vcyc_current.plateau_code = g_vcyc_last_code;
+        }
+    }
+    g_vcyc_last_code = oil_pressure_raw;
+
+    if (!g_vcyc_in_cycle) {
+        return;
+    }
+    g_vcyc_elapsed_us += period_us;
+    if (g_vcyc_elapsed_us > VCYC_MAX_PERIOD_US) {
+        ValveCycleStats_Drop();
+        return;
+    }
+
+    if (oil_pressure_raw > g_vcyc_current.peak_code) {
+        g_vcyc_current.peak_code = oil_pressure_raw;
+        g_vcyc_current.peak_us = g_vcyc_elapsed_us;
+    }
+    if (oil_pressure_raw < g_vcyc_current.valley_code) {
+        g_vcyc_current.valley_code = oil_pressure_raw;
+    }
+    if (g_vcyc_current.response_us == VCYC_NO_RESPONSE) {
+        uint16_t start = g_vcyc_current.start_code;
+        uint16_t diff = (oil_pressure_raw > start) ? (uint16_t)(oil_pressure_raw - start)
+                                                   : (uint16_t)(start - oil_pressure_raw);
+        if (diff >= g_vcyc_delta_code) {
+            g_vcyc_current.response_us = g_vcyc_elapsed_us;
+        }
+    }
+}
+
+/* 按code附近的标定斜率换算响应判定码值 */
+static void ValveCycleStats_UpdateDeltaCode(uint16_t code)
+{
+    uint16_t code_lo = (code > VCYC_SLOPE_SPAN_CODES) ? (uint16_t)(code - VCYC_SLOPE_SPAN_CODES) : 0U;
+    uint16_t code_hi = (code < (uint16_t)ADC_MAX_VALUE - VCYC_SLOPE_SPAN_CODES) ?
+                       (uint16_t)(code + VCYC_SLOPE_SPAN_CODES) : (uint16_t)ADC_MAX_VALUE;
+    float mpa_per_code = (Sensor_ADCToOilPressure(code_hi) - Sensor_ADCToOilPressure(code_lo)) /
+                         (float)(code_hi - code_lo);
+    if (mpa_per_code <= 0.0f) {
+        return;   // 饱和区，保持上次值
+    }
+    float delta = VCYC_RESPONSE_DELTA_MPA / mpa_per_code + 0.5f;
+    g_vcyc_delta_code = (delta < 1.0f) ? 1U : ((delta > ADC_MAX_VALUE) ? (uint16_t)ADC_MAX_VALUE : (uint16_t)delta);
+}
+
+void ValveCycleStats_Reset(void)
+{
+    memset(&g_vcyc_stats, 0, sizeof(g_vcyc_stats));
+    g_vcyc_stats.min_pressure_valley = 999.0f;
+    memset(&g_vcyc_summary, 0, sizeof(g_vcyc_summary));
+    g_vcyc_delay_seeded = false;
+    g_vcyc_unreported = false;
+    g_vcyc_dropped = 0U;
+    g_vcyc_tail = g_vcyc_head;
+}
+
+void ValveCycleStats_Init(void)
+{
+    ValveCycleStats_Reset();
+    g_vcyc_edge_seen = g_vcyc_edge_count;
+    g_vcyc_in_cycle = false;
+    ValveCycleStats_UpdateDeltaCode((uint16_t)(ADC_MAX_VALUE / 2.0f));
+    Sensor_SetPressureStreamObserver(ValveCycleStats_OnSample);
+}
+
+void ValveCycleStats_NotifyValveEdge(bool valve_on)
+{
+    g_vcyc_edge_level = valve_on;
+    g_vcyc_edge_count++;
+}
+
+/* 滑动平均，首个值直接作为初值 */
+static float ValveCycleStats_Average(float average, float value, bool seeded)
+{
+    return seeded ? (average + VCYC_AVG_WEIGHT * (value - average)) : value;
+}
+
+static void ValveCycleStats_Process(const vcyc_record_t *record)
+{
+    valve_cycle_result_t *r = &g_vcyc_summary.last;
+    uint32_t now = OSIF_GetMilliseconds();
+
+    r->peak_mpa = Sensor_ADCToOilPressure(record->peak_code);
+    r->valley_mpa = Sensor_ADCToOilPressure(record->valley_code);
+    r->start_mpa = Sensor_ADCToOilPressure(record->start_code);
+    r->plateau_mpa = Sensor_ADCToOilPressure(record->plateau_code);
+    r->period_ms = (float)record->period_us * 0.001f;
+    r->time_to_peak_ms = (float)record->peak_us * 0.001f;
+    r->responded = (record->response_us != VCYC_NO_RESPONSE);
+    r->response_delay_ms = r->responded ? (float)record->response_us * 0.001f : r->period_ms;
+
+    // 超调按通电相压力变化方向计算：升压看峰值，降压看谷值
+    float rise = r->plateau_mpa - r->start_mpa;
+    r->overshoot_percent = 0.0f;
+    if (rise >= VCYC_RESPONSE_DELTA_MPA) {
+        r->overshoot_percent = (r->peak_mpa - r->plateau_mpa) * 100.0f / rise;
+    } else if (rise <= -VCYC_RESPONSE_DELTA_MPA) {
+        r->overshoot_percent = (r->plateau_mpa - r->valley_mpa) * 100.0f / -rise;
+    }
+
+    // 滑动统计
+    bool seeded = (g_vcyc_stats.total_cycles > 0U);
+    g_vcyc_summary.avg_period_ms = ValveCycleStats_Average(g_vcyc_summary.avg_period_ms, r->period_ms, seeded);
+    g_vcyc_summary.avg_time_to_peak_ms = ValveCycleStats_Average(g_vcyc_summary.avg_time_to_peak_ms,
+                                                                 r->time_to_peak_ms, seeded);
+    g_vcyc_summary.avg_overshoot_percent = ValveCycleStats_Average(g_vcyc_summary.avg_overshoot_percent,
+                                                                   r->overshoot_percent, seeded);
+    if (r->responded) {
+        g_vcyc_summary.avg_response_delay_ms = ValveCycleStats_Average(g_vcyc_summary.avg_response_delay_ms,
+                                                                       r->response_delay_ms, g_vcyc_delay_seeded);
+        g_vcyc_delay_seeded = true;
+    }
+
+    // 换向阀统计
+    g_vcyc_stats.total_cycles++;
+    if (r->responded) {
+        g_vcyc_stats.successful_cycles++;
+    } else {
+        g_vcyc_stats.fault_count++;
+    }
+    if (r->peak_mpa > g_vcyc_stats.max_pressure_peak) {
+        g_vcyc_stats.max_pressure_peak = r->peak_mpa;
+    }
+    if (r->valley_mpa < g_vcyc_stats.min_pressure_valley) {
+        g_vcyc_stats.min_pressure_valley = r->valley_mpa;
+    }
+    if (r->period_ms > 0.0f) {
+        g_vcyc_stats.average_frequency = ValveCycleStats_Average(g_vcyc_stats.average_frequency,
+                                                                 60000.0f / r->period_ms, seeded);
+    }
+    if (r->time_to_peak_ms > 0.0f) {
+        g_vcyc_stats.pressure_change_rate = (r->peak_mpa - r->start_mpa) * 1000.0f / r->time_to_peak_ms;
+    }
+    g_vcyc_stats.last_cycle_time = now;
+    g_vcyc_stats.uptime_hours = now / 3600000UL;
+
+    FaultDiagnosis_RecordValveCycle(r->responded);
+    ValveCycleStats_UpdateDeltaCode(record->start_code);
+    g_vcyc_unreported = true;
+}
+
+static uint16_t ValveCycleStats_ToU16(float value, float scale)
+{
+    float v = value * scale + 0.5f;
+    if (v <= 0.0f) return 0U;
+    if (v >= 65535.0f) return 65535U;
+    return (uint16_t)v;
+}
+
+static uint8_t ValveCycleStats_ToU8(float value, float scale)
+{
+    float v = value * scale + 0.5f;
+    if (v <= 0.0f) return 0U;
+    if (v >= 254.0f) return 254U;   // 0xFF保留为无响应
+    return (uint8_t)v;
+}
+
+static void ValveCycleStats_SendSummary(void)
+{
+    const valve_cycle_result_t *r = &g_vcyc_summary.last;
+    uint8_t seq = (uint8_t)((g_vcyc_stats.total_cycles & 0x0FU) << 4);
+    uint8_t data[8];
+    uint16_t v;
+
+    data[0] = (uint8_t)(seq | VCYC_FRAME_LAST);
+    v = ValveCycleStats_ToU16(r->peak_mpa, 100.0f);
+    data[1] = (uint8_t)(v & 0xFFU);
+    data[2] = (uint8_t)(v >> 8);
+    v = ValveCycleStats_ToU16(r->valley_mpa, 100.0f);
+    data[3] = (uint8_t)(v & 0xFFU);
+    data[4] = (uint8_t)(v >> 8);
+    data[5] = ValveCycleStats_ToU8(r->time_to_peak_ms, 1.0f);
+    data[6] = r->responded ? ValveCycleStats_ToU8(r->response_delay_ms, 1.0f) : 0xFFU;
+    data[7] = ValveCycleStats_ToU8(r->overshoot_percent, 1.0f);
+    CAN_Config_SendMessage(CAN_MSG_VALVE_CYCLE_ID, data, 8, true);
+
+    data[0] = (uint8_t)(seq | VCYC_FRAME_AVERAGE);
+    v = ValveCycleStats_ToU16(r->period_ms, 10.0f);
+    data[1] = (uint8_t)(v & 0xFFU);
+    data[2] = (uint8_t)(v >> 8);
+    v = ValveCycleStats_ToU16(g_vcyc_summary.avg_period_ms, 10.0f);
+    data[3] = (uint8_t)(v & 0xFFU);
+    data[4] = (uint8_t)(v >> 8);
+    data[5] = ValveCycleStats_ToU8(g_vcyc_summary.avg_response_delay_ms, 1.0f);
+    data[6] = ValveCycleStats_ToU8(g_vcyc_summary.avg_overshoot_percent, 1.0f);
+    data[7] = (uint8_t)((g_vcyc_stats.successful_cycles * 100U) / g_vcyc_stats.total_cycles);
+    CAN_Config_SendMessage(CAN_MSG_VALVE_CYCLE_ID, data, 8, true);
+}
+
+void ValveCycleStats_Task(void)
+{
+    uint32_t now = OSIF_GetMilliseconds();
+
+    // 定时换向期间保证有采样：采集流空闲时后台运行，被占用时共用占用者的采样
+    if (ValveControl_IsDirectionalOscillating()) {
+        if (!Sensor_IsPressureStreamRunning()) {
+            (void)Sensor_StartBackgroundPressureStream(VCYC_SAMPLE_PERIOD_US);
+        }
+    } else {
+        Sensor_StopBackgroundPressureStream();
+    }
+
+    uint32_t head = g_vcyc_head;
+    while (g_vcyc_tail != head) {
+        uint32_t tail = g_vcyc_tail;
+        vcyc_record_t record = g_vcyc_ring[tail & VCYC_RING_MASK];
+        g_vcyc_tail = tail + 1U;
+        ValveCycleStats_Process(&record);
+    }
+    g_vcyc_summary.dropped_cycles = g_vcyc_dropped;
+
+    if (g_vcyc_unreported && (now - g_vcyc_last_report) >= VCYC_REPORT_INTERVAL_MS) {
+        g_vcyc_unreported = false;
+        g_vcyc_last_report = now;
+        ValveCycleStats_SendSummary();
+    }
+}
+
+directional_valve_stats_t ValveCycleStats_GetStats(void)
+{
+    return g_vcyc_stats;
+}
+
+const valve_cycle_summary_t* ValveCycleStats_GetSummary(void)
+{
+    return &g_vcyc_summary;
+}